@@ -11,23 +11,71 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "file_utils.h" // Utilize file utilities for asset management
+#include "entity_array.h" // For asset handles
+#include "texture_format.h" // For cooked textures
 
 // Texture Asset Structure
 typedef struct {
-    uint32_t id;           // Texture ID
+    uintptr_t id;          // Renderer texture if isGPUResident, otherwise an SDL_Surface*
     int width;             // Texture width
     int height;            // Texture height
     const char* filepath;  // Path to the texture file
+    TextureFormat format;  // Upload format (RGBA8888 for decoded images)
+    int mipCount;          // Levels uploaded, 1 without mips
+    uint32_t flags;        // COOKED_TEXTURE_* flags
+    bool isGPUResident;    // Uploaded from a cooked texture (see Renderer_UploadTexture)
 } TextureAsset;
 
 // Audio Asset Structure
 typedef struct {
-    uint32_t id;           // Audio ID
+    uintptr_t id;          // Audio ID
     float duration;        // Duration in seconds
     const char* filepath;  // Path to the audio file
 } AudioAsset;
 
-// Asset Management Functions
+// Asset Handles: each handle holds one reference on a cached asset and goes stale once the asset is evicted
+typedef EntityHandle AssetHandle;
+#define ASSET_HANDLE_NONE ENTITY_HANDLE_NONE
+
+// Asset Types
+typedef enum {
+    ASSET_TYPE_TEXTURE,
+    ASSET_TYPE_AUDIO,
+    ASSET_TYPE_COUNT
+} AssetType;
+
+// Async Load Status
+typedef enum {
+    ASSET_LOAD_INVALID,     // Unknown or evicted handle
+    ASSET_LOAD_QUEUED,      // Waiting for an I/O thread
+    ASSET_LOAD_READING,     // File being read
+    ASSET_LOAD_DECODING,    // Image/audio being decoded
+    ASSET_LOAD_FINALIZING,  // Waiting for the main thread (GPU upload)
+    ASSET_LOAD_READY,
+    ASSET_LOAD_FAILED
+} AssetLoadStatus;
+
+// Completion callback (main thread, from AssetSystem_Update). asset is a TextureAsset* or AudioAsset*, NULL on failure.
+typedef void (*AssetLoadCallback)(AssetHandle handle, AssetType type, void* asset, void* userData);
+
+// Asset System Management
+EXPORT bool AssetSystem_Init();
+EXPORT void AssetSystem_Shutdown();
+EXPORT void AssetSystem_Update(float deltaTime);
+EXPORT void AssetSystem_SetFinalizeBudget(float milliseconds);
+EXPORT int AssetSystem_GetPendingCount();
+
+// Async Loading (returns immediately; poll the handle or pass a callback).
+// Loading a path that is already cached or in flight shares the asset and counts as a cache hit.
+EXPORT AssetHandle Asset_LoadTextureAsync(const char* filepath, AssetLoadCallback callback, void* userData);
+EXPORT AssetHandle Asset_LoadAudioAsync(const char* filepath, AssetLoadCallback callback, void* userData);
+EXPORT AssetLoadStatus Asset_GetLoadStatus(AssetHandle handle);
+EXPORT TextureAsset* Asset_GetTexture(AssetHandle handle);
+EXPORT AudioAsset* Asset_GetAudio(AssetHandle handle);
+EXPORT AssetHandle Asset_RetainHandle(AssetHandle handle);
+EXPORT void Asset_ReleaseHandle(AssetHandle handle);
+
+// Asset Management Functions (Load adds a reference, Unload drops it; unreferenced assets stay cached until evicted)
 EXPORT TextureAsset* Asset_LoadTexture(const char* filepath);
 EXPORT void Asset_UnloadTexture(TextureAsset* texture);
 
@@ -37,5 +85,24 @@ EXPORT void Asset_UnloadAudio(AudioAsset* audio);
 EXPORT bool Asset_IsLoaded(const char* filepath);
 EXPORT void Asset_UnloadAll();
 
+// Asset Cache Statistics (per asset type)
+typedef struct {
+    uint32_t hits;             // Loads served by a cached or in-flight asset
+    uint32_t misses;           // Loads that had to read the file
+    uint32_t evictions;        // Unreferenced assets freed to stay within budget
+    size_t residentBytes;      // Memory held by loaded assets
+    size_t peakResidentBytes;  // Highest residentBytes seen
+    size_t budgetBytes;        // Eviction threshold
+    int residentCount;         // Loaded assets
+    int unreferencedCount;     // Loaded assets waiting in the LRU list
+} AssetCacheStats;
+
+// Asset Cache Management
+EXPORT void AssetCache_SetBudget(AssetType type, size_t bytes);
+EXPORT bool AssetCache_GetStats(AssetType type, AssetCacheStats* stats);
+EXPORT float AssetCache_GetHitRate(AssetType type);
+EXPORT void AssetCache_ResetStats();
+EXPORT void AssetCache_Trim(); // Free every unreferenced asset
+
 #endif // ASSET_UTILS_H
 
@@ -0,0 +1,107 @@
+// async_io.h
+#ifndef ASYNC_IO_H
+#define ASYNC_IO_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Asynchronous file I/O. Requests are queued by priority and issued while the bytes in flight
+// stay under a limit; adjacent reads of the same file are merged into one request. Linux builds
+// with ZDK_USE_IO_URING issue reads and writes through io_uring, everything else runs on a
+// small worker pool. Paths go through the VFS; only loose files are read, since mounted packs
+// are already in memory.
+// Requests to the same file are not ordered against each other.
+
+#define ASYNC_IO_PATH_MAX 256
+#define ASYNC_IO_MAX_REQUESTS 256     // Queued plus in-flight requests
+
+// Priorities (a higher priority request is always issued first)
+typedef enum {
+    ASYNC_IO_PRIORITY_STREAMING,      // Data the game is waiting on
+    ASYNC_IO_PRIORITY_NORMAL,
+    ASYNC_IO_PRIORITY_BACKGROUND,     // Saves and prefetching
+    ASYNC_IO_PRIORITY_COUNT
+} AsyncIOPriority;
+
+typedef enum {
+    ASYNC_IO_PENDING,
+    ASYNC_IO_IN_FLIGHT,
+    ASYNC_IO_COMPLETE,
+    ASYNC_IO_FAILED,
+    ASYNC_IO_CANCELLED,
+    ASYNC_IO_INVALID                  // Unknown or already released request
+} AsyncIOStatus;
+
+// Write Flags
+typedef enum {
+    ASYNC_IO_WRITE_TRUNCATE = 1 << 0, // Drop existing contents first
+    ASYNC_IO_WRITE_SYNC = 1 << 1,     // Flush to the device before completing
+    ASYNC_IO_WRITE_ATOMIC = 1 << 2    // Replace the whole file as File_WriteAtomic does (offset ignored)
+} AsyncIOWriteFlags;
+
+typedef uint32_t AsyncIORequest;
+#define ASYNC_IO_REQUEST_NONE 0
+
+// Completion callback (runs on an I/O thread). Reads that asked for an allocated buffer
+// hand it over here; free it with free(). The request is released once this returns.
+typedef void (*AsyncIOCallback)(AsyncIORequest request, AsyncIOStatus status, void* buffer, size_t bytes, void* userData);
+
+// Request Description for batched submission
+typedef struct {
+    const char* filepath;
+    uint64_t offset;
+    void* buffer;             // Reads: destination, or NULL to allocate one. Writes: source, valid until completion.
+    size_t size;              // Reads: 0 reads to the end of the file
+    bool isWrite;
+    uint32_t writeFlags;      // AsyncIOWriteFlags
+    AsyncIOPriority priority;
+    AsyncIOCallback callback; // NULL to poll: the request must then be passed to AsyncIO_Wait once
+    void* userData;
+} AsyncIORequestDesc;
+
+typedef struct {
+    size_t maxBytesInFlight;  // 0 for the default (8 MB)
+    int maxRequestsInFlight;  // 0 for the default (32)
+    int workerThreads;        // Thread pool backend; 0 for the default (2)
+} AsyncIOConfig;
+
+typedef struct {
+    const char* backend;      // "io_uring" or "threads"
+    uint32_t submitted;
+    uint32_t completed;
+    uint32_t failed;
+    uint32_t coalesced;       // Requests merged into a neighbour's read
+    uint64_t bytesRead;
+    uint64_t bytesWritten;
+    size_t bytesInFlight;
+    size_t peakBytesInFlight;
+    int pending;              // Waiting for the bytes in flight to drop
+} AsyncIOStats;
+
+// System Management
+EXPORT bool AsyncIO_Init(const AsyncIOConfig* config); // NULL for defaults
+EXPORT void AsyncIO_Shutdown(); // Finishes every submitted request first
+EXPORT bool AsyncIO_IsRunning();
+
+// Submission (thread-safe). ASYNC_IO_REQUEST_NONE if the request could not be queued.
+EXPORT AsyncIORequest AsyncIO_Read(const char* filepath, uint64_t offset, void* buffer, size_t size,
+    AsyncIOPriority priority, AsyncIOCallback callback, void* userData);
+EXPORT AsyncIORequest AsyncIO_Write(const char* filepath, uint64_t offset, const void* data, size_t size, uint32_t flags,
+    AsyncIOPriority priority, AsyncIOCallback callback, void* userData);
+EXPORT int AsyncIO_SubmitBatch(const AsyncIORequestDesc* requests, int count, AsyncIORequest* outRequests); // Requests queued
+
+// Completion
+EXPORT AsyncIOStatus AsyncIO_GetStatus(AsyncIORequest request);
+EXPORT AsyncIOStatus AsyncIO_Wait(AsyncIORequest request, void** outBuffer, size_t* outBytes); // Releases the request
+EXPORT bool AsyncIO_Cancel(AsyncIORequest request); // Only requests not yet issued; callbacks run from here
+EXPORT void AsyncIO_WaitIdle(); // Block until every request and callback has finished
+EXPORT AsyncIOStats AsyncIO_GetStats();
+
+#endif // ASYNC_IO_H
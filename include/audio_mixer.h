@@ -0,0 +1,61 @@
+// audio_mixer.h
+#ifndef AUDIO_MIXER_H
+#define AUDIO_MIXER_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include "audio_system.h" // For loaded sounds
+#include "camera.h" // For the listener
+#include "math_utils.h" // For emitter positions
+#include <stdbool.h>
+#include <stdint.h>
+
+// Positional emitters are mixed by the SDK (SSE2/AVX2 kernels where available) in a
+// post-mix pass on top of SDL_mixer's channels, so hundreds of them cost no mixer channels.
+// Sounds are already in the device format (Mix_LoadWAV converts them with SDL_BuildAudioCVT);
+// pitched emitters are resampled to the device rate through an SDL_AudioStream first.
+#define AUDIO_MIXER_MAX_EMITTERS 1024
+#define AUDIO_MIXER_MAX_MIXED 128        // Loudest emitters mixed per buffer; the rest run silently
+#define AUDIO_MIXER_CULL_GAIN 0.001f     // About -60 dB; quieter emitters are not mixed
+#define AUDIO_MIXER_MIN_PITCH 0.25f
+#define AUDIO_MIXER_MAX_PITCH 4.0f
+
+// Emitter Handles (stale once the emitter finishes or is stopped)
+typedef uint32_t AudioEmitterHandle;
+#define AUDIO_EMITTER_NONE 0
+
+typedef struct {
+    int emitters;                  // Playing emitters
+    int mixed;                     // Emitters mixed in the last update
+    int culled;                    // Out of range, too quiet or over AUDIO_MIXER_MAX_MIXED
+    float lastMixMicroseconds;     // Cost of the last buffer
+    float averageMixMicroseconds;
+    float peakMixMicroseconds;
+    float bufferMicroseconds;      // Duration of the last buffer (cost / duration = share of the audio thread)
+    const char* kernel;            // "avx2", "sse2" or "scalar"
+} AudioMixerStats;
+
+// Mixer Management (started by AudioSystem_Init, updated by AudioSystem_Update)
+EXPORT bool AudioMixer_Init();
+EXPORT void AudioMixer_Shutdown();
+EXPORT void AudioMixer_Update();
+EXPORT void AudioMixer_SetListener(const Camera* camera);
+
+// Positional Emitters (main thread). Gain falls off as minDistance / distance past minDistance
+// and is cut to silence at maxDistance.
+EXPORT AudioEmitterHandle AudioEmitter_Play(AudioSoundID sound, Vector3 position, float volume, bool loop);
+EXPORT void AudioEmitter_Stop(AudioEmitterHandle emitter);
+EXPORT bool AudioEmitter_IsPlaying(AudioEmitterHandle emitter);
+EXPORT void AudioEmitter_SetPosition(AudioEmitterHandle emitter, Vector3 position);
+EXPORT void AudioEmitter_SetVolume(AudioEmitterHandle emitter, float volume);
+EXPORT void AudioEmitter_SetRange(AudioEmitterHandle emitter, float minDistance, float maxDistance);
+EXPORT void AudioEmitter_SetPitch(AudioEmitterHandle emitter, float pitch); // Playback rate, clamped to the range above
+
+// Statistics
+EXPORT AudioMixerStats AudioMixer_GetStats();
+
+#endif // AUDIO_MIXER_H
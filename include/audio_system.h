@@ -10,6 +10,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 // Audio Types
 typedef enum {
@@ -24,19 +25,57 @@ typedef struct {
     void* data;            // Platform-specific audio data
 } AudioFile;
 
+// Voice Pool: sound effects play on a fixed set of mixer channels
+#define AUDIO_MAX_VOICES 32
+
+// Loaded sound effect (stable for the lifetime of the audio system)
+typedef int AudioSoundID;
+#define AUDIO_SOUND_NONE (-1)
+
+// Playing voice; goes stale once the voice finishes or is stolen
+typedef uint32_t VoiceHandle;
+#define VOICE_HANDLE_NONE 0
+
+// Voice Priorities (a full pool steals the lowest priority, then the oldest voice)
+typedef enum {
+    VOICE_PRIORITY_LOW,
+    VOICE_PRIORITY_NORMAL,
+    VOICE_PRIORITY_HIGH,
+    VOICE_PRIORITY_CRITICAL   // Never stolen
+} VoicePriority;
+
+typedef struct {
+    int activeVoices;
+    int peakVoices;
+    uint32_t steals;          // Voices cut off to make room
+    uint32_t rejected;        // Plays dropped because every voice outranked them
+} VoiceStats;
+
 // Audio System Management
 EXPORT bool AudioSystem_Init();
 EXPORT void AudioSystem_Shutdown();
+EXPORT void AudioSystem_Update(float deltaTime);
 
 // Audio Playback
 EXPORT bool Audio_Play(const char* fileName, AudioType type, bool loop);
 EXPORT void Audio_Stop(const char* fileName);
 EXPORT void Audio_StopAll();
 
+// Handle-based Sound Effects (no string lookups once loaded)
+EXPORT AudioSoundID Audio_LoadSound(const char* fileName);
+EXPORT VoiceHandle Audio_PlaySound(AudioSoundID sound, VoicePriority priority, float volume, float pan, bool loop);
+EXPORT void Audio_StopVoice(VoiceHandle voice);
+EXPORT bool Audio_IsVoicePlaying(VoiceHandle voice);
+EXPORT void Audio_SetVoiceVolume(VoiceHandle voice, float volume);
+EXPORT void Audio_SetVoicePan(VoiceHandle voice, float pan); // -1 (left) to 1 (right)
+EXPORT VoiceStats Audio_GetVoiceStats();
+EXPORT bool Audio_GetSoundData(AudioSoundID sound, const void** outData, size_t* outSize); // PCM in the mixer's format
+
 // Audio Utilities
 EXPORT void Audio_SetVolume(const char* fileName, float volume);
 EXPORT void Audio_SetGlobalVolume(float volume);
 EXPORT bool Audio_IsPlaying(const char* fileName);
+EXPORT size_t AudioSystem_GetResidentBytes(); // Sound effects plus music stream buffers
 
 #endif // AUDIO_SYSTEM_H
 
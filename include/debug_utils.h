@@ -21,6 +21,11 @@ EXPORT void Debug_Enable();
 EXPORT void Debug_Disable();
 EXPORT bool Debug_IsEnabled();
 
+// Performance Metrics
+EXPORT void Debug_UpdateFrameMetrics();
+EXPORT void Debug_DisplayFrameRate();
+EXPORT void Debug_DisplayFrameTiming(); // Last frame's time split, and the p50/p99 frame times
+
 // Display Functions
 EXPORT void Debug_DisplayPosition(const char* label, Vector3 position);
 EXPORT void Debug_DisplayMatrix(const char* label, Matrix4x4 matrix);
@@ -30,5 +35,9 @@ EXPORT void Debug_DisplayItem(const char* itemName, int itemID, int quantity);
 EXPORT void Debug_TestCode(const char* codeSnippet);
 EXPORT void Debug_TestItemInteractions(int itemID);
 
+// Benchmarks
+EXPORT void Debug_BenchmarkEventQueue(int eventsPerProducer);
+EXPORT void Debug_BenchmarkSaveSchema(int recordCount);
+
 #endif // DEBUG_UTILS_H
 
@@ -0,0 +1,52 @@
+// entity_array.h
+#ifndef ENTITY_ARRAY_H
+#define ENTITY_ARRAY_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Entity Handles: slot index in the low 20 bits, generation in the high 12 bits.
+// A handle goes stale when its entity is removed, even if the slot is reused.
+typedef uint32_t EntityHandle;
+#define ENTITY_HANDLE_NONE 0
+#define ENTITY_ARRAY_MAX_SLOTS (1 << 20)
+
+// Dense array of entity pointers with stable handles.
+// entities[0..count) is packed for iteration; removal swaps the last entity into the hole.
+typedef struct {
+    void** entities;        // Packed entity pointers
+    uint32_t* denseToSlot;  // Slot owning each packed entry
+    int count;              // Number of entities
+    int capacity;           // Allocated packed entries
+
+    uint32_t* slots;        // Packed index for live slots, next free slot for free ones
+    uint16_t* generations;  // Current generation of each slot
+    int slotCount;          // Slots handed out so far
+    int slotCapacity;       // Allocated slots
+    int freeSlot;           // Head of the free slot list, -1 if empty
+} EntityArray;
+
+// Entity Array Management
+EXPORT void EntityArray_Init(EntityArray* array);
+EXPORT void EntityArray_Free(EntityArray* array);
+EXPORT void EntityArray_Clear(EntityArray* array);
+EXPORT bool EntityArray_Reserve(EntityArray* array, int capacity);
+
+// Insertion and Removal
+EXPORT EntityHandle EntityArray_Add(EntityArray* array, void* entity);
+EXPORT bool EntityArray_AddBulk(EntityArray* array, void* const* entities, int count, EntityHandle* outHandles); // All or nothing; false on a NULL entity
+EXPORT void* EntityArray_Remove(EntityArray* array, EntityHandle handle);
+
+// Lookup
+EXPORT void* EntityArray_Get(const EntityArray* array, EntityHandle handle);
+EXPORT bool EntityArray_IsValid(const EntityArray* array, EntityHandle handle);
+EXPORT EntityHandle EntityArray_FindHandle(const EntityArray* array, const void* entity);
+EXPORT EntityHandle EntityArray_GetHandleAt(const EntityArray* array, int denseIndex);
+
+#endif // ENTITY_ARRAY_H
@@ -10,6 +10,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "hash_utils.h" // For precomputed name hashes
 
 // Event Types
 typedef enum {
@@ -17,7 +18,8 @@ typedef enum {
     EVENT_TYPE_CUTSCENE,
     EVENT_TYPE_ITEM_GAINED,
     EVENT_TYPE_BATTLE_TRIGGERED,
-    EVENT_TYPE_CUSTOM
+    EVENT_TYPE_CUSTOM,
+    EVENT_TYPE_COUNT
 } EventType;
 
 // Event Data
@@ -26,7 +28,7 @@ typedef struct {
     union {
         struct { const char* dialogueText; } dialogueEvent;
         struct { const char* cutsceneName; } cutsceneEvent;
-        struct { const char* itemName; int quantity; } itemGainedEvent;
+        struct { const char* itemName; uint32_t itemNameHash; int quantity; } itemGainedEvent; // Resolve with Item_GetByHash
         struct { const char* enemyGroupName; } battleTriggeredEvent;
         struct { void* customData; } customEvent;
     } data;
@@ -35,6 +37,15 @@ typedef struct {
 // Event Callback Function
 typedef void (*EventCallback)(Event* event);
 
+// Per-Type Event Statistics
+typedef struct {
+    uint32_t triggeredCount;  // Events dispatched (immediate and queued)
+    uint32_t queuedCount;     // Events added to the queue
+    uint32_t coalescedCount;  // Queued events merged into an already pending one
+    uint32_t droppedCount;    // Events lost because the queue was full
+    uint64_t dispatchTimeNs;  // Total time spent in callbacks
+} EventTypeStats;
+
 // Event System Management
 EXPORT void EventSystem_Init();
 EXPORT void EventSystem_Shutdown();
@@ -42,6 +53,19 @@ EXPORT bool EventSystem_RegisterCallback(EventType type, EventCallback callback)
 EXPORT void EventSystem_UnregisterCallback(EventType type, EventCallback callback);
 EXPORT void EventSystem_TriggerEvent(Event* event);
 
+// Deferred Dispatch (events are queued and dispatched at sync points, e.g. once per SDK_Update).
+// EventSystem_QueueEvent is lock-free and may be called from any thread; everything else is main thread only.
+EXPORT bool EventSystem_QueueEvent(const Event* event);
+EXPORT int EventSystem_DispatchQueued();
+EXPORT int EventSystem_GetQueuedCount();
+EXPORT int EventSystem_GetDroppedCount();
+EXPORT void EventSystem_SetCoalescing(EventType type, bool enabled);
+
+// Statistics
+EXPORT bool EventSystem_GetStats(EventType type, EventTypeStats* stats);
+EXPORT void EventSystem_ResetStats();
+EXPORT double EventSystem_RunStressBenchmark(int producerCount, int eventsPerProducer);
+
 // Utilities for SDK
 EXPORT Event Event_CreateDialogue(const char* dialogueText);
 EXPORT Event Event_CreateCutscene(const char* cutsceneName);
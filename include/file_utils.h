@@ -10,13 +10,71 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h> // For FILE
 
-// File Utility Functions
+// Read-only view of a whole file (memory-mapped where supported)
+typedef struct {
+    const void* data;  // File contents
+    size_t size;       // Size in bytes
+    bool isMapped;     // True if data is a memory mapping, false if it was read into a heap buffer
+    bool isBorrowed;   // True if data points into a mounted pack (nothing to free)
+    int packMount;     // VfsMountID kept retained while data is borrowed
+} FileMapping;
+
+// File Utility Functions. Paths resolve through the VFS (mounts first, then the host file system);
+// writes land in the highest-priority writable mount covering the path.
 EXPORT bool File_Exists(const char* filepath);
 EXPORT size_t File_GetSize(const char* filepath);
 EXPORT char* File_ReadAllText(const char* filepath);
 EXPORT bool File_WriteAllText(const char* filepath, const char* content);
 EXPORT bool File_ReadBinary(const char* filepath, void* buffer, size_t size);
 EXPORT bool File_WriteBinary(const char* filepath, const void* buffer, size_t size);
+EXPORT bool File_Delete(const char* filepath); // Removes the file a write would replace
+
+// Durable Writes. File_WriteAtomic writes "<filepath>.tmp", syncs it and renames it over
+// filepath, so a crash leaves either the old or the new contents, never a torn file.
+EXPORT bool File_WriteAtomic(const char* filepath, const void* buffer, size_t size);
+EXPORT bool File_Sync(FILE* file); // Flush stdio buffers and the OS cache to the device
+
+// Access Patterns (readahead hints; ignored where the platform has none)
+typedef enum {
+    FILE_ACCESS_NORMAL,
+    FILE_ACCESS_SEQUENTIAL,  // Front to back: read well ahead of the position
+    FILE_ACCESS_RANDOM,      // Scattered reads: no readahead
+    FILE_ACCESS_WILLNEED     // Start reading the whole range now
+} FileAccessPattern;
+
+// Chunked Reader: streams a file through a caller-supplied buffer, so memory stays bounded
+// whatever the file size. Uncompressed pack entries are handed out in place without copying.
+typedef struct {
+    FILE* file;                // Loose file where there is no POSIX descriptor
+    int fd;                    // Loose file descriptor (-1 if none)
+    const uint8_t* memory;     // Pack entry data
+    void* ownedMemory;         // Compressed pack entry, unpacked once
+    int packMount;             // VfsMountID kept retained while memory points into the pack
+    uint64_t size;             // Total bytes
+    uint64_t position;         // Source offset of the next byte to fetch
+    uint8_t* buffer;           // Caller's chunk buffer
+    size_t bufferSize;
+    size_t bufferedOffset;     // Unconsumed bytes left in buffer by FileReader_Read
+    size_t bufferedCount;
+    uint64_t hintedUpTo;       // Readahead has been requested up to here
+    size_t readahead;          // Bytes kept hinted ahead of the position
+    bool failed;               // A read error occurred
+} FileReader;
+
+EXPORT bool FileReader_Open(FileReader* reader, const char* filepath, void* buffer, size_t bufferSize, FileAccessPattern pattern);
+EXPORT void FileReader_Close(FileReader* reader);
+EXPORT size_t FileReader_Next(FileReader* reader, const void** outChunk); // Up to bufferSize bytes; 0 at the end
+EXPORT size_t FileReader_Read(FileReader* reader, void* output, size_t size); // Copies; fewer bytes only at the end
+EXPORT bool FileReader_Seek(FileReader* reader, uint64_t position);
+EXPORT uint64_t FileReader_Tell(const FileReader* reader);
+
+// File Mapping
+EXPORT bool File_Map(const char* filepath, FileMapping* mapping);
+EXPORT bool File_MapHost(const char* hostPath, FileMapping* mapping); // No VFS lookup (offline tools)
+EXPORT void File_Unmap(FileMapping* mapping);
+EXPORT void File_AdviseMapping(const FileMapping* mapping, size_t offset, size_t size, FileAccessPattern pattern);
 
 #endif // FILE_UTILS_H
@@ -0,0 +1,113 @@
+// game_database.h
+#ifndef GAME_DATABASE_H
+#define GAME_DATABASE_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include "items.h"        // For item records
+#include "skills.h"       // For skill records
+#include "stats_system.h" // For stat tables
+#include "file_utils.h"   // For mapping the database file
+#include <stdbool.h>
+#include <stdint.h>
+
+// Binary layout (little-endian, all offsets relative to the start of the file):
+// [GameDBHeader][item records][skill records][stat records][string pool]
+// Records are fixed-size and sorted by nameHash; strings are NUL-terminated
+// and referenced by their offset into the string pool.
+#define GAMEDB_MAGIC 0x4B445A47 // "GZDK"
+#define GAMEDB_VERSION 1
+#define GAMEDB_ALIGNMENT 8
+#define GAMEDB_DEFAULT_PATH "data/content.gdb" // Loaded by SDK_Init
+
+typedef struct {
+    uint32_t magic;            // GAMEDB_MAGIC
+    uint32_t version;          // GAMEDB_VERSION
+    uint32_t fileSize;         // Total size of the blob
+    uint32_t itemOffset;       // Offset of the item records
+    uint32_t itemCount;        // Number of item records
+    uint32_t skillOffset;      // Offset of the skill records
+    uint32_t skillCount;       // Number of skill records
+    uint32_t statOffset;       // Offset of the stat records
+    uint32_t statCount;        // Number of stat records
+    uint32_t stringPoolOffset; // Offset of the string pool
+    uint32_t stringPoolSize;   // Size of the string pool
+    uint32_t reserved;
+} GameDBHeader;
+
+typedef struct {
+    uint32_t nameOffset;        // String pool offset of the name
+    uint32_t nameHash;          // Hash_String(name)
+    uint32_t descriptionOffset; // String pool offset of the description
+    int32_t type;               // ItemType
+    int32_t rarity;             // ItemRarity
+    int32_t value;
+    int32_t effectPower;
+    int32_t durability;
+} GameDBItemRecord;
+
+typedef struct {
+    uint32_t nameOffset;        // String pool offset of the name
+    uint32_t nameHash;          // Hash_String(name)
+    uint32_t descriptionOffset; // String pool offset of the description
+    int32_t type;               // SkillType
+    int32_t power;
+    int32_t element;            // ElementType
+    float range;
+    int32_t isAOE;
+    int32_t fusionIDs[2];
+} GameDBSkillRecord;
+
+typedef struct {
+    uint32_t nameOffset;        // String pool offset of the table name (e.g. class or enemy)
+    uint32_t nameHash;          // Hash_String(name)
+    int32_t level;
+    int32_t values[STAT_COUNT]; // Indexed by StatType
+} GameDBStatRecord;
+
+// Runtime Database (records are used in place from the mapped file)
+typedef struct {
+    FileMapping mapping;
+    const GameDBHeader* header;
+    const GameDBItemRecord* itemRecords;
+    const GameDBSkillRecord* skillRecords;
+    const GameDBStatRecord* statRecords;
+    const char* strings;
+    Item* items;      // Registry views of itemRecords (one allocation, strings point into the file)
+    Skill* skills;    // Registry views of skillRecords (one allocation, strings point into the file)
+    bool isRegistered;
+} GameDatabase;
+
+EXPORT GameDatabase* GameDB_Open(const char* filepath);
+EXPORT void GameDB_Close(GameDatabase* db);
+EXPORT bool GameDB_RegisterContent(GameDatabase* db);
+EXPORT void GameDB_UnregisterContent(GameDatabase* db);
+
+EXPORT const char* GameDB_GetString(const GameDatabase* db, uint32_t offset);
+EXPORT const GameDBItemRecord* GameDB_FindItem(const GameDatabase* db, const char* name);
+EXPORT const GameDBSkillRecord* GameDB_FindSkill(const GameDatabase* db, const char* name);
+EXPORT const GameDBStatRecord* GameDB_FindStatTable(const GameDatabase* db, const char* name);
+EXPORT Stats GameDB_GetStats(const GameDBStatRecord* record);
+
+// Offline Compiler
+typedef struct GameDBBuilder GameDBBuilder;
+
+EXPORT GameDBBuilder* GameDBBuilder_Create();
+EXPORT void GameDBBuilder_Destroy(GameDBBuilder* builder);
+EXPORT bool GameDBBuilder_AddItem(GameDBBuilder* builder, const Item* item);
+EXPORT bool GameDBBuilder_AddSkill(GameDBBuilder* builder, const Skill* skill);
+EXPORT bool GameDBBuilder_AddStatTable(GameDBBuilder* builder, const char* name, int level, const Stats* stats);
+EXPORT bool GameDBBuilder_Write(GameDBBuilder* builder, const char* outputPath);
+
+// Compile CSV tables into a database file. Any table path may be NULL. Formats (one row per line, '#' comments):
+//   items:  name,type,rarity,value,effectPower,durability,description
+//   skills: name,type,power,element,range,isAOE,description
+//   stats:  name,level,hp,sp,atk,def,spd,res,intel,luck
+EXPORT bool GameDB_CompileTables(const char* itemsPath, const char* skillsPath,
+    const char* statsPath, const char* outputPath);
+
+#endif // GAME_DATABASE_H
@@ -0,0 +1,50 @@
+// hash_utils.h
+#ifndef HASH_UTILS_H
+#define HASH_UTILS_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Hashing (32-bit FNV-1a, stable across platforms so it can be precomputed offline)
+EXPORT uint32_t Hash_String(const char* str);
+EXPORT uint32_t Hash_Bytes(const void* data, size_t size);
+
+// Checksums (CRC-32/IEEE, zlib-compatible). Pass 0 to start, or a previous result to continue.
+EXPORT uint32_t Hash_CRC32(uint32_t crc, const void* data, size_t size);
+
+// Open-addressing hash index: maps a 32-bit hash to an int value (e.g. a registry slot).
+// Several values may share a hash; walk them with FindFirst/FindNext. Lookups never allocate.
+typedef struct {
+    uint32_t* hashes;  // Hash stored in each slot
+    int32_t* values;   // Value stored in each slot, -1 when empty
+    int capacity;      // Number of slots (power of two)
+    int count;         // Number of occupied slots
+} HashIndex;
+
+EXPORT bool HashIndex_Init(HashIndex* index, int initialCapacity);
+EXPORT void HashIndex_Free(HashIndex* index);
+EXPORT void HashIndex_Clear(HashIndex* index);
+EXPORT bool HashIndex_Insert(HashIndex* index, uint32_t hash, int32_t value);
+EXPORT bool HashIndex_Remove(HashIndex* index, uint32_t hash, int32_t value);
+EXPORT bool HashIndex_Replace(HashIndex* index, uint32_t hash, int32_t oldValue, int32_t newValue);
+EXPORT int32_t HashIndex_FindFirst(const HashIndex* index, uint32_t hash, int* cursor);
+EXPORT int32_t HashIndex_FindNext(const HashIndex* index, uint32_t hash, int* cursor);
+
+// Interned Strings
+typedef uint32_t StringID;
+#define STRING_ID_NONE 0
+
+EXPORT StringID StringID_Intern(const char* str);
+EXPORT StringID StringID_Find(const char* str);
+EXPORT const char* StringID_GetString(StringID id);
+EXPORT uint32_t StringID_GetHash(StringID id);
+EXPORT void StringID_Shutdown();
+
+#endif // HASH_UTILS_H
@@ -10,6 +10,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "hash_utils.h" // For interned item names
 
 // Item Rarity
 typedef enum {
@@ -37,6 +38,9 @@ typedef struct {
     const char* description; // Description of the item
     int effectPower;         // Power of the item's effect (if applicable)
     int durability;          // Durability for weapons/armor (if applicable)
+    StringID nameID;         // Interned name
+    uint32_t nameHash;       // Hash_String(name), precomputed
+    bool isDatabaseRecord;   // Owned by a GameDatabase, not freed by Item_Destroy
 } Item;
 
 // Item Management
@@ -47,6 +51,9 @@ EXPORT void Item_Destroy(Item* item);
 EXPORT bool Item_Register(Item* item);
 EXPORT void Item_Unregister(Item* item);
 EXPORT Item* Item_GetByName(const char* name);
+EXPORT Item* Item_GetByHash(uint32_t nameHash);
+EXPORT Item* Item_GetByID(StringID nameID);
+EXPORT int Item_GetCount();
 EXPORT void Item_Display(const Item* item);
 
 // Predefined Items
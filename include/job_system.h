@@ -0,0 +1,37 @@
+// job_system.h
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include <stdbool.h>
+
+// Job Priorities (higher priority jobs are always picked first)
+typedef enum {
+    JOB_PRIORITY_HIGH,
+    JOB_PRIORITY_NORMAL,
+    JOB_PRIORITY_LOW,
+    JOB_PRIORITY_COUNT
+} JobPriority;
+
+// Job Function (runs on a worker thread)
+typedef void (*JobFunction)(void* data);
+
+// Worker thread pool
+typedef struct JobPool JobPool;
+
+// Job Pool Management
+EXPORT JobPool* JobPool_Create(const char* name, int threadCount);
+EXPORT void JobPool_Destroy(JobPool* pool);
+
+// Job Submission (thread-safe)
+EXPORT bool JobPool_Submit(JobPool* pool, JobFunction function, void* data, JobPriority priority);
+EXPORT void JobPool_WaitIdle(JobPool* pool);
+EXPORT int JobPool_GetPendingCount(JobPool* pool);
+EXPORT int JobPool_GetThreadCount(JobPool* pool);
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,99 @@
+// log_system.h
+#ifndef LOG_SYSTEM_H
+#define LOG_SYSTEM_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Logging. Messages are filtered at compile time (ZDK_LOG_MIN_LEVEL) and per category at run
+// time before any argument is evaluated. Accepted messages store their format string and copied
+// arguments in a lock-free ring; a background thread formats and prints them, so the calling
+// thread never takes the stdio lock. Only the format pointer is queued, so a format must be a
+// string literal or otherwise stay valid until the message is printed (LogSystem_Flush or
+// LogSystem_Shutdown); %s arguments are copied. Before LogSystem_Init and after
+// LogSystem_Shutdown messages print directly.
+
+typedef enum {
+    LOG_LEVEL_TRACE,      // Per-object, per-frame detail
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARNING,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_NONE
+} LogLevel;
+
+typedef enum {
+    LOG_CATEGORY_CORE,
+    LOG_CATEGORY_RENDERER,
+    LOG_CATEGORY_PHYSICS,
+    LOG_CATEGORY_AI,
+    LOG_CATEGORY_GAMEPLAY,
+    LOG_CATEGORY_AUDIO,
+    LOG_CATEGORY_ASSETS,
+    LOG_CATEGORY_IO,
+    LOG_CATEGORY_SAVE,
+    LOG_CATEGORY_MAP,
+    LOG_CATEGORY_EVENTS,
+    LOG_CATEGORY_COUNT
+} LogCategory;
+
+// Levels below this are compiled out
+#ifndef ZDK_LOG_MIN_LEVEL
+#define ZDK_LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+#if defined(__GNUC__)
+#define LOG_FORMAT_CHECK __attribute__((format(printf, 3, 4)))
+#else
+#define LOG_FORMAT_CHECK
+#endif
+
+#define LOG_DEFAULT_LEVEL LOG_LEVEL_INFO
+#define LOG_QUEUE_CAPACITY 1024         // Queued messages (power of two)
+#define LOG_MAX_ARGUMENT_BYTES 224      // Copied arguments per message, strings included
+#define LOG_MAX_LINE 1024               // Longest formatted message
+
+// Runtime minimum level per category (read by the LOG_* macros; set with LogSystem_SetLevel)
+EXPORT extern uint8_t gLogLevels[LOG_CATEGORY_COUNT];
+
+#define LOG_IS_ENABLED(level, category) ((level) >= ZDK_LOG_MIN_LEVEL && (level) >= gLogLevels[category])
+#define LOG_WRITE(level, category, ...) \
+    do { if (LOG_IS_ENABLED(level, category)) LogSystem_Write(level, category, __VA_ARGS__); } while (0)
+
+#define LOG_TRACE(category, ...) LOG_WRITE(LOG_LEVEL_TRACE, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) LOG_WRITE(LOG_LEVEL_DEBUG, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) LOG_WRITE(LOG_LEVEL_INFO, category, __VA_ARGS__)
+#define LOG_WARNING(category, ...) LOG_WRITE(LOG_LEVEL_WARNING, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) LOG_WRITE(LOG_LEVEL_ERROR, category, __VA_ARGS__)
+
+typedef struct {
+    uint32_t written;       // Messages queued
+    uint32_t printed;       // Messages formatted by the drain thread
+    uint32_t dropped;       // Messages lost to a full queue
+    uint32_t preformatted;  // Queued already formatted (arguments too large or not deferrable)
+    uint32_t truncated;     // Cut short (longer than LOG_MAX_LINE, or out of memory), ending in "..."
+} LogStats;
+
+// System Management
+EXPORT bool LogSystem_Init();
+EXPORT void LogSystem_Shutdown(); // Prints everything still queued
+EXPORT void LogSystem_Flush(); // Block until every queued message has been printed
+EXPORT bool LogSystem_SetFile(const char* filepath); // Also append to a file (NULL to stop)
+
+// Filtering
+EXPORT void LogSystem_SetLevel(LogCategory category, LogLevel level);
+EXPORT void LogSystem_SetAllLevels(LogLevel level);
+EXPORT LogLevel LogSystem_GetLevel(LogCategory category);
+EXPORT const char* LogSystem_GetCategoryName(LogCategory category);
+
+// Writing (prefer the LOG_* macros, which skip filtered messages without evaluating arguments)
+EXPORT void LogSystem_Write(LogLevel level, LogCategory category, const char* format, ...) LOG_FORMAT_CHECK;
+EXPORT LogStats LogSystem_GetStats();
+
+#endif // LOG_SYSTEM_H
@@ -0,0 +1,28 @@
+// lzss.h
+#ifndef LZSS_H
+#define LZSS_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// LZSS with a 4 KB window: small enough to decode on the Dreamcast with no working memory
+// beyond the output buffer. Each flag byte covers 8 tokens; a set bit is a literal byte,
+// a clear bit a 2-byte match (12-bit distance, 4-bit length of 3-18 bytes).
+#define LZSS_WINDOW_SIZE 4096
+#define LZSS_MIN_MATCH 3
+#define LZSS_MAX_MATCH 18
+
+// Compression (returns the compressed size, or 0 if it does not fit in outCapacity)
+EXPORT size_t Lzss_Compress(const void* input, size_t inputSize, void* output, size_t outCapacity);
+EXPORT size_t Lzss_GetBound(size_t inputSize); // Worst-case compressed size
+
+// Decompression (outputSize must be the exact original size)
+EXPORT bool Lzss_Decompress(const void* input, size_t inputSize, void* output, size_t outputSize);
+
+#endif // LZSS_H
@@ -13,7 +13,13 @@
 #include "ai_system.h" // For NPC management
 #include "items.h"    // For item placement
 #include "event_system.h" // For event triggers
+#include "entity_array.h" // For entity lists and handles
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Streaming state for chunked maps (internal)
+typedef struct MapStreaming MapStreaming;
 
 // Map Structure
 typedef struct {
@@ -22,19 +28,48 @@ typedef struct {
     void* modelData;           // Loaded 3D model data (platform-specific)
     bool isLoaded;             // Is the map currently loaded?
 
-    NPC** npcs;                // List of NPCs on the map
-    int npcCount;              // Number of NPCs
-
-    Item** items;              // List of items on the map
-    int itemCount;             // Number of items
+    EntityArray npcs;          // NPCs on the map (entities are NPC*)
+    EntityArray items;         // Items on the map (entities are Item*)
+    EntityArray events;        // Events on the map (entities are Event*)
 
-    Event** events;            // List of events on the map
-    int eventCount;            // Number of events
+    MapStreaming* streaming;   // Chunk streaming state (NULL if the map is loaded as one unit)
 } Map;
 
+// Chunk callbacks (main thread). data stays valid until the chunk is deactivated.
+typedef void (*MapChunkActivateFunction)(Map* map, int chunkX, int chunkZ, const void* data, size_t size, void* userData);
+typedef void (*MapChunkDeactivateFunction)(Map* map, int chunkX, int chunkZ, void* userData);
+
+// Streaming Configuration
+typedef struct {
+    float chunkSize;              // World units per chunk edge (X/Z plane)
+    int gridWidth;                // Chunks along X
+    int gridDepth;                // Chunks along Z
+    int loadRadius;               // Chunks kept active around the focus
+    int prefetchDistance;         // Chunks to look ahead along the movement direction
+    size_t memoryBudget;          // Maximum bytes of resident chunk data
+    float activationBudgetMs;     // Main-thread time per frame spent activating chunks
+    const char* chunkPathFormat;  // printf format taking (modelPath, x, z); NULL for "%s.%d_%d.chunk"
+    MapChunkActivateFunction onActivate;
+    MapChunkDeactivateFunction onDeactivate;
+    void* userData;
+} MapStreamingConfig;
+
+// Streaming Statistics
+typedef struct {
+    int trackedChunks;        // Chunks queued, loading, loaded or active
+    int activeChunks;         // Chunks handed to onActivate
+    int loadsInFlight;        // Background loads not finished yet
+    size_t residentBytes;     // Chunk data currently in memory
+    size_t peakResidentBytes; // Highest residentBytes seen
+    uint32_t loadsCompleted;  // Chunk loads finished
+    uint32_t failedLoads;     // Chunk loads that failed
+    uint32_t evictions;       // Chunks released
+} MapStreamingStats;
+
 // Map System Management
 EXPORT bool MapSystem_Init();
 EXPORT void MapSystem_Shutdown();
+EXPORT void MapSystem_Update(float deltaTime);
 
 // Map Management
 EXPORT Map* Map_Load(const char* name, const char* modelPath);
@@ -43,10 +78,24 @@ EXPORT void Map_Render(Map* map);
 EXPORT void Map_SetActive(Map* map);
 EXPORT Map* Map_GetActive();
 
-// Asset Management on Maps
-EXPORT bool Map_AddNPC(Map* map, NPC* npc);
-EXPORT bool Map_AddItem(Map* map, Item* item);
-EXPORT bool Map_AddEvent(Map* map, Event* event);
+// Chunk Streaming
+EXPORT bool Map_EnableStreaming(Map* map, const MapStreamingConfig* config);
+EXPORT void Map_UpdateStreaming(Map* map, Vector3 focus, Vector3 velocity);
+EXPORT bool Map_GetStreamingStats(Map* map, MapStreamingStats* stats);
+
+// Asset Management on Maps (handles stay valid until the entity is removed)
+EXPORT EntityHandle Map_AddNPC(Map* map, NPC* npc);
+EXPORT EntityHandle Map_AddItem(Map* map, Item* item);
+EXPORT EntityHandle Map_AddEvent(Map* map, Event* event);
+EXPORT bool Map_AddNPCs(Map* map, NPC** npcs, int count, EntityHandle* outHandles);
+EXPORT bool Map_AddItems(Map* map, Item** items, int count, EntityHandle* outHandles);
+EXPORT bool Map_AddEvents(Map* map, Event** events, int count, EntityHandle* outHandles);
+EXPORT NPC* Map_GetNPC(Map* map, EntityHandle handle);
+EXPORT Item* Map_GetItem(Map* map, EntityHandle handle);
+EXPORT Event* Map_GetEvent(Map* map, EntityHandle handle);
+EXPORT NPC* Map_RemoveNPCByHandle(Map* map, EntityHandle handle);
+EXPORT Item* Map_RemoveItemByHandle(Map* map, EntityHandle handle);
+EXPORT Event* Map_RemoveEventByHandle(Map* map, EntityHandle handle);
 EXPORT void Map_RemoveNPC(Map* map, NPC* npc);
 EXPORT void Map_RemoveItem(Map* map, Item* item);
 EXPORT void Map_RemoveEvent(Map* map, Event* event);
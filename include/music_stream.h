@@ -0,0 +1,76 @@
+// music_stream.h
+#ifndef MUSIC_STREAM_H
+#define MUSIC_STREAM_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Streams decode on a background thread into a small ring buffer that the mixer
+// drains, so a track costs MUSIC_STREAM_RING_BYTES no matter how long it is.
+#define MUSIC_STREAM_MAX_STREAMS 4         // Music plus ambience/crossfade layers
+#define MUSIC_STREAM_RING_BYTES (64 * 1024) // ~370 ms of 44.1 kHz stereo S16
+#define MUSIC_STREAM_CHUNK_BYTES 4096       // Decode granularity
+
+// Stream Handles (stale once the stream stops)
+typedef uint32_t MusicStreamHandle;
+#define MUSIC_STREAM_NONE 0
+
+// Encoded input: a loose file read incrementally, or a packed entry read in place
+typedef struct MusicSource MusicSource;
+
+EXPORT size_t MusicSource_Read(MusicSource* source, void* buffer, size_t size);
+EXPORT bool MusicSource_Seek(MusicSource* source, size_t position);
+EXPORT size_t MusicSource_GetSize(const MusicSource* source);
+
+// Decoded PCM layout (converted to the mixer's format by the stream)
+typedef struct {
+    int frequency;
+    uint16_t format;  // SDL audio format (AUDIO_S16LSB, AUDIO_F32LSB, ...)
+    int channels;
+} MusicFormat;
+
+// Decoder interface. open returns NULL if the source is not in this decoder's format.
+// decode runs on the stream thread and returns 0 at the end of the track.
+typedef struct {
+    const char* name;
+    void* (*open)(MusicSource* source, MusicFormat* outFormat);
+    size_t (*decode)(void* state, void* buffer, size_t size);
+    bool (*rewind)(void* state);
+    void (*close)(void* state);
+} MusicDecoder;
+
+// Resident memory and health of the streaming path
+typedef struct {
+    int activeStreams;
+    size_t residentBytes;      // Ring, staging and source buffers of active streams
+    size_t peakResidentBytes;
+    uint32_t underruns;        // Mixer callbacks that found a ring short of data
+    uint64_t decodedBytes;     // Mixer-format bytes produced since init
+} MusicStreamStats;
+
+// Music Stream System (Init after Mix_OpenAudio; Update on the main thread)
+EXPORT bool MusicStream_Init();
+EXPORT void MusicStream_Shutdown();
+EXPORT void MusicStream_Update();
+EXPORT bool MusicStream_RegisterDecoder(const MusicDecoder* decoder);
+EXPORT bool MusicStream_CanStream(const char* filepath);
+
+// Playback
+EXPORT MusicStreamHandle MusicStream_Play(const char* filepath, bool loop, float volume);
+EXPORT void MusicStream_Stop(MusicStreamHandle handle);
+EXPORT void MusicStream_StopAll();
+EXPORT bool MusicStream_IsPlaying(MusicStreamHandle handle);
+EXPORT void MusicStream_SetVolume(MusicStreamHandle handle, float volume);
+EXPORT void MusicStream_SetMasterVolume(float volume);
+
+// Statistics
+EXPORT MusicStreamStats MusicStream_GetStats();
+
+#endif // MUSIC_STREAM_H
@@ -0,0 +1,91 @@
+// pack_archive.h
+#ifndef PACK_ARCHIVE_H
+#define PACK_ARCHIVE_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include "file_utils.h" // For mapping the archive
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Binary layout (little-endian, offsets relative to the start of the file):
+// [PackHeader][PackEntry table sorted by pathHash][path string pool][entry data...]
+// Entry data starts on PACK_ALIGNMENT boundaries so uncompressed assets can be used in place.
+#define PACK_MAGIC 0x4B41505A // "ZPAK"
+#define PACK_VERSION 1
+#define PACK_ALIGNMENT 32
+#define PACK_MAX_PATH 512
+
+// Per-entry compression (LZ4/zstd need ZDK_USE_LZ4/ZDK_USE_ZSTD at build time)
+typedef enum {
+    PACK_COMPRESSION_NONE,
+    PACK_COMPRESSION_LZ4,
+    PACK_COMPRESSION_ZSTD
+} PackCompression;
+
+typedef struct {
+    uint32_t magic;            // PACK_MAGIC
+    uint32_t version;          // PACK_VERSION
+    uint32_t entryCount;       // Number of entries
+    uint32_t entryOffset;      // Offset of the entry table
+    uint32_t stringPoolOffset; // Offset of the path string pool
+    uint32_t stringPoolSize;   // Size of the path string pool
+    uint64_t fileSize;         // Total size of the archive
+} PackHeader;
+
+typedef struct {
+    uint32_t pathHash;         // Hash_String(normalized path)
+    uint32_t pathOffset;       // String pool offset of the normalized path
+    uint64_t dataOffset;       // Offset of the stored bytes (PACK_ALIGNMENT aligned)
+    uint64_t storedSize;       // Bytes stored in the archive
+    uint64_t size;             // Bytes after decompression
+    uint32_t compression;      // PackCompression
+    uint32_t reserved;
+} PackEntry;
+
+// Runtime Archive (the entry table and uncompressed data are used in place)
+typedef struct {
+    FileMapping mapping;
+    const PackHeader* header;
+    const PackEntry* entries;
+    const char* strings;
+    char* filepath;
+} PackArchive;
+
+// Archive Access
+EXPORT PackArchive* PackArchive_Open(const char* filepath);
+EXPORT void PackArchive_Close(PackArchive* pack);
+EXPORT const PackEntry* PackArchive_Find(const PackArchive* pack, const char* path);
+EXPORT const char* PackArchive_GetPath(const PackArchive* pack, const PackEntry* entry);
+EXPORT const void* PackArchive_GetData(const PackArchive* pack, const PackEntry* entry); // NULL if compressed
+EXPORT bool PackArchive_Read(const PackArchive* pack, const PackEntry* entry, void* buffer, size_t size);
+EXPORT void* PackArchive_ReadAlloc(const PackArchive* pack, const PackEntry* entry, size_t* outSize);
+
+// Mounted Archives: VFS pack mounts at the root with VFS_PRIORITY_BASE (newest first).
+// Use Vfs_MountPack for mount points and overlay priorities. Mount and unmount on the
+// main thread; an archive with mapped or streamed entries is not unmounted.
+EXPORT PackArchive* PackArchive_Mount(const char* filepath);
+EXPORT void PackArchive_Unmount(PackArchive* pack);
+EXPORT void PackArchive_UnmountAll();
+EXPORT const PackEntry* PackArchive_Resolve(const char* path, const PackArchive** outPack);
+
+// Offline Packer
+typedef struct PackBuilder PackBuilder;
+
+EXPORT PackBuilder* PackBuilder_Create();
+EXPORT void PackBuilder_Destroy(PackBuilder* builder);
+EXPORT bool PackBuilder_AddData(PackBuilder* builder, const char* path, const void* data, size_t size, PackCompression compression);
+EXPORT bool PackBuilder_AddFile(PackBuilder* builder, const char* sourcePath, const char* path, PackCompression compression); // sourcePath is a host path, read without the VFS
+EXPORT bool PackBuilder_Write(PackBuilder* builder, const char* outputPath);
+
+// Build an archive from a list file. One entry per line ('#' comments):
+//   sourcePath[,archivePath[,none|lz4|zstd]]
+// archivePath defaults to sourcePath.
+EXPORT bool PackArchive_BuildFromList(const char* listPath, const char* outputPath);
+
+#endif // PACK_ARCHIVE_H
@@ -0,0 +1,70 @@
+// profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// CPU Profiler. Builds with ZDK_PROFILER record nested zones into a lock-free ring per thread,
+// timestamped with the performance counter; without it the PROFILE_* macros compile to
+// nothing. Zone names must outlive the capture (use string literals). Rings keep the most
+// recent PROFILER_RING_EVENTS events, so exports cover the last few frames; pause recording
+// with Profiler_SetEnabled(false) for an exact capture while other threads are running.
+
+#define PROFILER_MAX_THREADS 32
+#define PROFILER_RING_EVENTS 65536      // Per thread (power of two)
+#define PROFILER_MAX_DEPTH 64           // Nesting tracked by the frame summary
+#define PROFILER_MAX_SUMMARY_ZONES 128  // Distinct zones summarized per frame
+
+#ifdef ZDK_PROFILER
+#define PROFILE_BEGIN(name) Profiler_BeginZone(name)
+#define PROFILE_END() Profiler_EndZone()
+#define PROFILE_FRAME() Profiler_FrameMark()
+#define PROFILE_THREAD(name) Profiler_SetThreadName(name)
+#else
+#define PROFILE_BEGIN(name) ((void)0)
+#define PROFILE_END() ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
+
+// Time spent in one zone over a frame, summed across threads
+typedef struct {
+    const char* name;
+    double totalMs;     // Including nested zones
+    double selfMs;      // Excluding nested zones
+    uint32_t calls;
+} ProfilerZoneSummary;
+
+typedef struct {
+    uint64_t frameIndex;
+    double frameMs;                 // Between the two frame marks
+    int zoneCount;                  // Sorted by self time, longest first
+    uint32_t droppedEvents;         // Overwritten before the summary saw them
+    ProfilerZoneSummary zones[PROFILER_MAX_SUMMARY_ZONES];
+} ProfilerFrameSummary;
+
+// Recording (any thread; use the PROFILE_* macros so disabled builds pay nothing)
+EXPORT void Profiler_BeginZone(const char* name);
+EXPORT void Profiler_EndZone();
+EXPORT void Profiler_SetThreadName(const char* name); // Copied
+EXPORT void Profiler_FrameMark(); // Main thread: closes the frame and summarizes it
+
+// Control
+EXPORT void Profiler_SetEnabled(bool enabled);
+EXPORT bool Profiler_IsEnabled();
+EXPORT void Profiler_Shutdown(); // After every profiled thread has stopped
+
+// Reports
+EXPORT const ProfilerFrameSummary* Profiler_GetFrameSummary(); // Last completed frame
+EXPORT void Profiler_PrintFrameSummary(int topCount);
+EXPORT bool Profiler_ExportChromeTrace(const char* filepath); // chrome://tracing or Perfetto JSON
+EXPORT bool Profiler_ExportCapture(const char* filepath); // Compact binary, see profiler.c
+
+#endif // PROFILER_H
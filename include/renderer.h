@@ -10,7 +10,9 @@
 
 #include "math_utils.h" // For matrix and vector operations
 #include "shader_system.h" // For shader management
+#include "texture_format.h" // For cooked texture uploads
 #include <stdbool.h>
+#include <stdint.h>
 
 // Renderer Initialization and Shutdown
 EXPORT bool Renderer_Init();
@@ -25,6 +27,10 @@ EXPORT void Renderer_Clear();
 EXPORT void Renderer_BeginFrame();
 EXPORT void Renderer_EndFrame();
 
+// Texture Upload (cooked textures go straight to the GPU without conversion)
+EXPORT uintptr_t Renderer_UploadTexture(const CookedTextureHeader* header, const void* data);
+EXPORT void Renderer_DestroyTexture(uintptr_t texture);
+
 // 3D Model Rendering
 EXPORT bool Renderer_LoadModel(const char* modelPath, void** modelData);
 EXPORT void Renderer_UnloadModel(void* modelData);
@@ -0,0 +1,83 @@
+// save_schema.h
+#ifndef SAVE_SCHEMA_H
+#define SAVE_SCHEMA_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include "save_system.h" // For capturing records into snapshots
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Table-driven binary records. Each field is written as a tag and a wire type, so a decoder
+// skips tags it does not know (saves from newer builds) and leaves fields missing from older
+// saves untouched. Values are stored in host byte order (little-endian on every target).
+
+// Field Types
+typedef enum {
+    SCHEMA_FIELD_INT32,
+    SCHEMA_FIELD_UINT32,
+    SCHEMA_FIELD_FLOAT,
+    SCHEMA_FIELD_BOOL,      // bool member, stored as 4 bytes
+    SCHEMA_FIELD_ENUM,      // int-sized enum member
+    SCHEMA_FIELD_VECTOR3,
+    SCHEMA_FIELD_STRING,    // const char* member; decoded strings are interned (main thread only)
+    SCHEMA_FIELD_RECORD     // Nested struct described by another schema
+} SchemaFieldType;
+
+typedef struct SaveSchema SaveSchema;
+
+// Field Description. The tag identifies the field on disk: never renumber or reuse a shipped tag.
+typedef struct {
+    uint16_t tag;
+    uint16_t type;            // SchemaFieldType
+    uint16_t count;           // Fixed array length (1 for a single value)
+    uint32_t offset;          // offsetof() the member
+    int32_t countOffset;      // offsetof() an int holding the live element count, or -1
+    const SaveSchema* record; // Element schema for SCHEMA_FIELD_RECORD
+} SaveSchemaField;
+
+// Record Description
+struct SaveSchema {
+    const char* name;         // Identifies the record type in saves
+    uint16_t version;         // Bump when a field changes meaning; adding or dropping fields needs no bump
+    size_t structSize;
+    const SaveSchemaField* fields;
+    int fieldCount;
+    void (*postLoad)(void* record, uint16_t savedVersion); // Rebuild caches or upgrade old data (optional)
+};
+
+// Output Buffer. Encoding past the capacity sets overflow but keeps counting bytes,
+// so encoding into an empty writer measures the output.
+typedef struct {
+    uint8_t* data;
+    size_t capacity;
+    size_t size;              // Bytes encoded, or needed after an overflow
+    bool overflow;
+} SaveWriter;
+
+EXPORT void SaveWriter_Init(SaveWriter* writer, void* buffer, size_t capacity);
+
+// Encoding and Decoding (stride 0 means schema->structSize). Records are encoded in bulk
+// as one block; nothing is allocated per record or per field.
+EXPORT size_t SaveSchema_Measure(const SaveSchema* schema, const void* records, int count, size_t stride);
+EXPORT bool SaveSchema_Encode(const SaveSchema* schema, const void* records, int count, size_t stride, SaveWriter* writer);
+EXPORT int SaveSchema_GetRecordCount(const SaveSchema* schema, const void* data, size_t size); // -1 if not a block of this schema
+EXPORT int SaveSchema_Decode(const SaveSchema* schema, const void* data, size_t size,
+    void* records, int maxCount, size_t stride, size_t* outConsumed); // Records decoded, -1 on malformed data
+
+// Encode records straight into a snapshot section
+EXPORT bool SaveSchema_Capture(SaveSnapshot* snapshot, const char* section, const SaveSchema* schema,
+    const void* records, int count, size_t stride);
+
+// Built-in Schemas
+EXPORT const SaveSchema* SaveSchema_GetCharacterStats();
+EXPORT const SaveSchema* SaveSchema_GetItem();
+EXPORT const SaveSchema* SaveSchema_GetPlayer();
+EXPORT const SaveSchema* SaveSchema_GetNPC();
+
+#endif // SAVE_SCHEMA_H
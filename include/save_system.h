@@ -10,13 +10,19 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 // Save System Platforms
 typedef enum {
     SAVE_PLATFORM_PC,
-    SAVE_PLATFORM_DREAMCAST_VMU
+    SAVE_PLATFORM_DREAMCAST_VMU  // Always used on DREAMCAST; on PC, saves go to an emulated card image
 } SavePlatform;
 
+// Emulated VMU used by SAVE_PLATFORM_DREAMCAST_VMU on PC
+#ifndef SAVE_VMU_IMAGE_PATH
+#define SAVE_VMU_IMAGE_PATH "vmu_a1.img"
+#endif
+
 // Save File Structure
 typedef struct {
     const char* fileName; // File name
@@ -24,9 +30,73 @@ typedef struct {
     size_t size;          // Size of save data
 } SaveFile;
 
+// Autosave Journal: each commit is diffed against the previous snapshot in fixed blocks and
+// only the changed bytes are appended to "<fileName>.journal". Every few deltas (or when the
+// journal would outgrow a full snapshot) the whole state is rewritten atomically to fileName
+// and the journal restarts, so loading never replays more than one interval of deltas.
+#define SAVE_JOURNAL_BLOCK_SIZE 256
+#define SAVE_JOURNAL_CHECKPOINT_INTERVAL 16 // Deltas between full checkpoints
+
+typedef struct SaveJournal SaveJournal;
+
+typedef struct {
+    uint32_t sequence;              // Snapshot number of the last commit
+    uint32_t checkpoints;           // Full snapshots written since the journal was opened
+    uint32_t deltas;                // Delta records appended since the journal was opened
+    uint32_t deltasSinceCheckpoint; // Deltas a load would replay
+    size_t journalBytes;            // Current size of the journal file
+    size_t lastBytesWritten;        // Bytes written by the last commit (0 if nothing changed)
+    size_t totalBytesWritten;
+    float lastChangedRatio;         // Fraction of blocks that differed in the last commit
+    float lastCommitMilliseconds;   // Stall of the last commit, including the sync
+} SaveJournalStats;
+
+// Background Saves: state is copied into a pooled snapshot arena at a frame boundary
+// (Begin/Capture/Submit), then transformed and written on the save thread. The completion
+// callback runs on the main thread from SaveSystem_Update. Arenas are reused, so a steady
+// stream of saves allocates nothing once they have grown to fit. A journal passed to Submit
+// belongs to the save thread until that save's callback has run.
+#define SAVE_SNAPSHOT_POOL_SIZE 2 // Snapshots that can be capturing or in flight at once
+
+typedef struct SaveSnapshot SaveSnapshot;
+
+// Called on the main thread once a submitted save has been written (or has failed)
+typedef void (*SaveCompleteCallback)(const char* fileName, bool success, void* userData);
+
+// Optional save-thread pass over the captured sections (serialization, compression...).
+// Returns false on failure; *output must be allocated with malloc and is freed by the SDK.
+typedef bool (*SaveTransformFunction)(const void* input, size_t inputSize, void** output, size_t* outputSize, void* userData);
+
+typedef struct {
+    uint32_t completed;
+    uint32_t failed;
+    uint32_t dropped;               // Begin calls refused because every snapshot was busy
+    int pending;                    // Snapshots submitted but not yet reported
+    size_t lastBytesWritten;
+    float lastCaptureMicroseconds;  // Main-thread time from Begin to Submit
+    float peakCaptureMicroseconds;
+    float lastBackgroundMilliseconds; // Transform and write on the save thread
+} SaveStats;
+
 // Save System Management
 EXPORT bool SaveSystem_Init(SavePlatform platform);
-EXPORT void SaveSystem_Shutdown();
+EXPORT void SaveSystem_Shutdown(); // Finishes saves in flight first
+EXPORT void SaveSystem_Update(float deltaTime); // Reports finished saves
+EXPORT void SaveSystem_Flush(); // Blocks until every submitted save is written and reported
+EXPORT SaveStats SaveSystem_GetStats();
+
+// Snapshot Capture (main thread). Sections are looked up by name when the save is loaded.
+// Reserve returns space for a section to be filled in place; the pointer is valid until
+// the next Reserve or Capture on the same snapshot.
+EXPORT SaveSnapshot* SaveSnapshot_Begin(const char* fileName); // NULL while every snapshot is busy
+EXPORT void* SaveSnapshot_Reserve(SaveSnapshot* snapshot, const char* section, size_t size);
+EXPORT bool SaveSnapshot_Capture(SaveSnapshot* snapshot, const char* section, const void* data, size_t size);
+EXPORT void SaveSnapshot_SetTransform(SaveSnapshot* snapshot, SaveTransformFunction transform, void* userData);
+EXPORT bool SaveSnapshot_Submit(SaveSnapshot* snapshot, SaveJournal* journal, SaveCompleteCallback callback, void* userData); // journal: NULL for a full atomic write
+EXPORT void SaveSnapshot_Cancel(SaveSnapshot* snapshot);
+
+// Captured Save Data (from SaveFile_Load or SaveJournal_GetSnapshot, untransformed)
+EXPORT const void* SaveData_FindSection(const void* data, size_t size, const char* section, size_t* outSize);
 
 // Save File Management
 EXPORT bool SaveFile_Create(const char* fileName, void* data, size_t size);
@@ -34,6 +104,15 @@ EXPORT SaveFile* SaveFile_Load(const char* fileName);
 EXPORT bool SaveFile_Delete(const char* fileName);
 EXPORT bool SaveFile_Copy(const char* sourceFileName, const char* destFileName);
 
+// Autosave Journal Management
+EXPORT SaveJournal* SaveJournal_Open(const char* fileName); // Recovers the latest intact snapshot, if any
+EXPORT void SaveJournal_Close(SaveJournal* journal);
+EXPORT bool SaveJournal_Commit(SaveJournal* journal, const void* data, size_t size);
+EXPORT bool SaveJournal_Checkpoint(SaveJournal* journal, const void* data, size_t size);
+EXPORT const void* SaveJournal_GetSnapshot(const SaveJournal* journal, size_t* outSize);
+EXPORT void SaveJournal_SetCheckpointInterval(SaveJournal* journal, int deltas);
+EXPORT SaveJournalStats SaveJournal_GetStats(const SaveJournal* journal);
+
 // Platform-Specific Utilities
 EXPORT bool SaveSystem_CheckSpace(size_t sizeNeeded);
 EXPORT size_t SaveSystem_GetFreeSpace();
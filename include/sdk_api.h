@@ -20,6 +20,7 @@
 #include "stats_system.h"
 #include "items.h"
 #include "skills.h"
+#include "game_database.h"
 #include "cutscenes.h"
 #include "dialogue.h"
 #include "map_system.h"
@@ -27,6 +28,11 @@
 #include "event_system.h"
 #include "save_system.h"
 #include "audio_system.h"
+#include "asset_utils.h"
+#include "pack_archive.h"
+#include "texture_format.h"
+#include "music_stream.h"
+#include "audio_mixer.h"
 
 // SDK API Management
 EXPORT bool SDK_Init();
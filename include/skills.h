@@ -10,6 +10,7 @@
 
 #include "stats_system.h" // For character stats
 #include "battle_system.h" // For skill targeting and effectiveness
+#include "hash_utils.h" // For interned skill names
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -30,6 +31,9 @@ typedef struct {
     bool isAOE;            // Is it an area-of-effect skill?
     const char* description; // Skill description for UI
     int fusionIDs[2];      // Skill IDs required for fusion (if applicable)
+    StringID nameID;       // Interned name
+    uint32_t nameHash;     // Hash_String(name), precomputed
+    bool isDatabaseRecord; // Owned by a GameDatabase, not freed by Skills_Destroy
 } Skill;
 
 // Skill Management
@@ -37,6 +41,9 @@ EXPORT Skill* Skills_Create(const char* name, SkillType type, int power, Element
     float range, bool isAOE, const char* description);
 EXPORT void Skills_Destroy(Skill* skill);
 EXPORT Skill* Skills_GetByName(const char* name);
+EXPORT Skill* Skills_GetByHash(uint32_t nameHash);
+EXPORT Skill* Skills_GetByID(StringID nameID);
+EXPORT int Skills_GetCount();
 EXPORT bool Skills_Register(Skill* skill);
 EXPORT void Skills_Unregister(Skill* skill);
 
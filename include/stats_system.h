@@ -11,28 +11,67 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+// Stat Types (index into Stats.values)
+typedef enum {
+    STAT_HP,
+    STAT_SP,
+    STAT_ATK,
+    STAT_DEF,
+    STAT_SPD,
+    STAT_RES,
+    STAT_INT,
+    STAT_LUCK,
+    STAT_COUNT,
+    STAT_INVALID = -1
+} StatType;
+
 // Stat Parameters
-typedef struct {
-    int hp;     // Health Points
-    int sp;     // Skill Points
-    int atk;    // Attack
-    int def;    // Defense
-    int spd;    // Speed
-    int res;    // Resistance
-    int intel;  // Intelligence
-    int luck;   // Luck
+typedef union {
+    struct {
+        int hp;     // Health Points
+        int sp;     // Skill Points
+        int atk;    // Attack
+        int def;    // Defense
+        int spd;    // Speed
+        int res;    // Resistance
+        int intel;  // Intelligence
+        int luck;   // Luck
+    };
+    int values[STAT_COUNT]; // Same stats, indexed by StatType
 } Stats;
 
-// Character Level and Stats
+// Stat Modifier Types
+typedef enum {
+    STAT_MODIFIER_FLAT,    // Adds value to the stat
+    STAT_MODIFIER_PERCENT  // Scales the stat by value percent
+} StatModifierType;
+
+// Stat Modifier (buff or debuff)
 typedef struct {
-    int level;      // Character level (1-99)
-    Stats baseStats; // Base stats of the character
-    Stats currentStats; // Current stats (can be buffed or debuffed)
-} CharacterStats;
+    StatType stat;          // Affected stat
+    StatModifierType type;  // Flat or percent
+    int value;              // Amount (negative for debuffs)
+    float duration;         // Remaining duration; <= 0 means it lasts until removed
+    uint32_t id;            // Identifier returned by Stats_AddModifier
+} StatModifier;
 
 // Constants
 #define MAX_LEVEL 99
 #define MAX_STAT_VALUE 99999
+#define MAX_STAT_MODIFIERS 16
+
+// Character Level and Stats
+typedef struct {
+    int level;      // Character level (1-99)
+    Stats baseStats; // Base stats of the character
+    Stats currentStats; // Cached totals (base + modifiers), see Stats_GetCurrent
+
+    StatModifier modifiers[MAX_STAT_MODIFIERS]; // Active modifier stack
+    int modifierCount;   // Number of active modifiers
+    uint32_t nextModifierID; // Next modifier identifier
+    uint32_t adjustmentIDs[STAT_COUNT]; // Modifier each stat's ApplyBuff/ApplyDebuff calls add up in (0 if none)
+    bool isDirty;        // currentStats must be recomputed
+} CharacterStats;
 
 // Initialization
 EXPORT void Stats_Init(CharacterStats* stats, int level, Stats baseStats);
@@ -40,10 +79,28 @@ EXPORT void Stats_Init(CharacterStats* stats, int level, Stats baseStats);
 // Level Up
 EXPORT void Stats_LevelUp(CharacterStats* stats);
 
+// Stat Access
+EXPORT StatType Stats_GetTypeByName(const char* statName);
+EXPORT int Stats_GetBase(const CharacterStats* stats, StatType stat);
+EXPORT int Stats_GetCurrent(CharacterStats* stats, StatType stat);
+EXPORT const Stats* Stats_GetCurrentStats(CharacterStats* stats);
+
+// Modifier Stack
+EXPORT uint32_t Stats_AddModifier(CharacterStats* stats, StatType stat, StatModifierType type,
+    int value, float duration);
+EXPORT bool Stats_RemoveModifier(CharacterStats* stats, uint32_t modifierID);
+EXPORT void Stats_ClearModifiers(CharacterStats* stats);
+EXPORT void Stats_TickModifiers(CharacterStats* stats, float elapsed);
+EXPORT void Stats_TickModifiersBatch(CharacterStats** characters, int count, float elapsed);
+
+// Buffs and Debuffs (by name, kept for scripting). Calls on one stat add up in a single permanent
+// modifier; HP and SP heal only what was lost and cannot drop below zero.
+EXPORT void Stats_ApplyBuff(CharacterStats* stats, const char* statName, int value);
+EXPORT void Stats_ApplyDebuff(CharacterStats* stats, const char* statName, int value);
+
 // Utility Functions
 EXPORT bool Stats_IsMaxLevel(CharacterStats* stats);
 EXPORT bool Stats_IsStatMaxed(int stat);
 EXPORT void Stats_Display(const CharacterStats* stats);
 
 #endif // STATS_SYSTEM_H
-
@@ -0,0 +1,70 @@
+// texture_format.h
+#ifndef TEXTURE_FORMAT_H
+#define TEXTURE_FORMAT_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Cooked texture layout (little-endian):
+// [CookedTextureHeader][pixel data for every mip level]
+// Pixels are already in the upload format, so loading is a read plus an upload.
+#define COOKED_TEXTURE_MAGIC 0x5845545A // "ZTEX"
+#define COOKED_TEXTURE_VERSION 1
+#define COOKED_TEXTURE_MAX_MIPS 12 // Up to 2048x2048
+#define COOKED_TEXTURE_ALIGNMENT 32
+
+// Pixel Formats (16-bit formats match the PVR's native formats)
+typedef enum {
+    TEXTURE_FORMAT_RGBA8888,   // Bytes R, G, B, A
+    TEXTURE_FORMAT_RGB565,
+    TEXTURE_FORMAT_ARGB1555,
+    TEXTURE_FORMAT_ARGB4444,
+    TEXTURE_FORMAT_COUNT
+} TextureFormat;
+
+// Cooked Texture Flags
+#define COOKED_TEXTURE_TWIDDLED 0x1    // Dreamcast twiddled (Morton) texel order
+#define COOKED_TEXTURE_PVR_MIPMAPS 0x2 // Mips stored smallest first in the PVR layout
+
+typedef struct {
+    uint32_t magic;                              // COOKED_TEXTURE_MAGIC
+    uint32_t version;                            // COOKED_TEXTURE_VERSION
+    uint32_t format;                             // TextureFormat
+    uint32_t flags;                              // COOKED_TEXTURE_* flags
+    uint32_t width;                              // Size of mip 0
+    uint32_t height;
+    uint32_t mipCount;                           // 1 if the texture has no mips
+    uint32_t dataOffset;                         // Offset of the pixel data from the start of the file
+    uint32_t dataSize;                           // Bytes of pixel data (all mips, upload as one block on PVR)
+    uint32_t mipOffsets[COOKED_TEXTURE_MAX_MIPS]; // Offset of each level relative to dataOffset
+} CookedTextureHeader;
+
+// Cooker Options
+typedef struct {
+    TextureFormat format;
+    bool generateMips;  // Box-filtered chain down to 1x1 (power-of-two sizes only)
+    bool twiddle;       // Dreamcast output: twiddled texels and PVR mip layout
+} TextureCookOptions;
+
+// Format Queries
+EXPORT int TextureFormat_GetBytesPerPixel(TextureFormat format);
+EXPORT const char* TextureFormat_GetName(TextureFormat format);
+EXPORT TextureFormat TextureFormat_GetByName(const char* name);
+
+// Runtime Access
+EXPORT const CookedTextureHeader* CookedTexture_Validate(const void* data, size_t size);
+EXPORT const void* CookedTexture_GetMip(const CookedTextureHeader* header, const void* data, int level, int* outWidth, int* outHeight);
+
+// Offline Cooker (source pixels are RGBA8888, row-major, top row first)
+EXPORT bool TextureCooker_Cook(const uint8_t* rgba, int width, int height, const TextureCookOptions* options,
+    void** outData, size_t* outSize);
+EXPORT bool TextureCooker_CookFile(const char* sourcePath, const char* outputPath, const TextureCookOptions* options);
+
+#endif // TEXTURE_FORMAT_H
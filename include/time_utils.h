@@ -10,16 +10,74 @@
 
 #include <stdint.h>
 
+// Timestamps come from a monotonic nanosecond clock, so deltas are real elapsed time whether
+// the frame spent it working, sleeping or blocked on the GPU. A frame runs from one
+// Timer_BeginFrame to the next; gameplay reads the previous frame's delta.
+
+#define TIMER_NS_PER_SECOND 1000000000ull
+#define TIMER_DEFAULT_SMOOTHING 0.5f   // Weight of the running average against a new delta
+#define TIMER_DEFAULT_MAX_DELTA 0.25f  // Longest delta handed to gameplay (hitches, breakpoints)
+#define TIMER_FRAME_HISTORY 256        // Frames kept for the pacing percentiles
+
+// Frame Pacing Modes. Every mode keeps an absolute deadline per frame, so a late frame is made
+// up by the next one instead of pushing every later frame back.
+typedef enum {
+    TIMER_PACING_SLEEP,    // Sleep only (cheapest, oversleeps by the OS timer slack)
+    TIMER_PACING_HYBRID,   // Sleep most of the wait, then spin the last stretch against the clock
+    TIMER_PACING_VSYNC     // Hybrid, with the frame time rounded to whole display refreshes
+} TimerPacingMode;
+
+// Accounting for the last completed frame
+typedef struct {
+    uint64_t frameIndex;
+    uint64_t wallNs;       // Frame start to the next frame start
+    uint64_t workNs;       // Frame start to Timer_EndFrame, before pacing
+    uint64_t cpuNs;        // Main-thread CPU time (work minus GPU wait where there is no thread clock)
+    uint64_t gpuWaitNs;    // Blocked on the GPU or vsync, between Timer_BeginGPUWait and Timer_EndGPUWait
+    uint64_t idleNs;       // Sleeping to hold the target frame rate
+    float rawDelta;        // Seconds
+    float smoothedDelta;   // Seconds, as returned by Timer_GetDeltaTime
+} FrameTiming;
+
+// Frame time distribution over the last TIMER_FRAME_HISTORY frames
+typedef struct {
+    int frames;
+    double meanMs;
+    double p50Ms;
+    double p99Ms;
+    double minMs;
+    double maxMs;
+    uint32_t missedDeadlines;  // Frames that ended after their deadline
+    uint32_t resyncs;          // Deadlines dropped after falling more than a frame behind
+    double spinMarginUs;       // Current sleep-to-spin handover before a deadline
+    int refreshRate;           // Display refresh used by TIMER_PACING_VSYNC (0 if unknown)
+} FramePacingStats;
+
+// Clocks
+EXPORT uint64_t Timer_GetTimeNs(); // Monotonic, arbitrary origin
+EXPORT uint64_t Timer_GetThreadCPUTimeNs(); // 0 where the platform has no thread clock
+EXPORT double Timer_GetElapsedSeconds(); // Since Timer_Start
+
 // Timing Functions
 EXPORT void Timer_Start();
-EXPORT float Timer_GetDeltaTime();
+EXPORT float Timer_GetDeltaTime(); // Smoothed and clamped
+EXPORT float Timer_GetRawDeltaTime();
+EXPORT void Timer_SetDeltaSmoothing(float smoothing, float maxDelta); // 0 smoothing uses raw deltas
 EXPORT void Timer_Delay(uint32_t milliseconds);
+EXPORT void Timer_SleepUntil(uint64_t deadlineNs); // Hybrid sleep and spin to a Timer_GetTimeNs time
 
 // Frame Rate Control
 EXPORT void Timer_SetTargetFPS(int fps);
 EXPORT void Timer_BeginFrame();
 EXPORT void Timer_EndFrame();
 EXPORT float Timer_GetCurrentFPS();
+EXPORT void Timer_SetPacingMode(TimerPacingMode mode);
+EXPORT TimerPacingMode Timer_GetPacingMode();
+EXPORT FramePacingStats Timer_GetPacingStats();
 
-#endif // TIME_UTILS_H
+// Frame Accounting
+EXPORT void Timer_BeginGPUWait();
+EXPORT void Timer_EndGPUWait();
+EXPORT FrameTiming Timer_GetFrameTiming();
 
+#endif // TIME_UTILS_H
@@ -0,0 +1,76 @@
+// vfs.h
+#ifndef VFS_H
+#define VFS_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include "pack_archive.h" // For pack mounts
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Virtual File System. Mounts attach pack archives and host directories under a virtual
+// prefix; a path is served by the highest-priority mount that has it (the newest mount on a
+// tie), and by the host file system unchanged when no mount does. Resolutions are cached, so
+// repeated lookups cost one hash probe. Mount and unmount on the main thread; resolving is
+// thread-safe. A resolution's pack and entry pointers stay valid only while the mount does: code
+// that keeps them (mapped files, streams) resolves with Vfs_ResolveRetained, and Vfs_Unmount
+// refuses a mount that is still retained.
+
+#define VFS_MAX_PATH 512
+#define VFS_MAX_MOUNTS 16
+
+// Overlay Priorities (any int works; these leave room in between)
+#define VFS_PRIORITY_BASE 0
+#define VFS_PRIORITY_PATCH 100
+#define VFS_PRIORITY_MOD 200
+
+typedef int VfsMountID;
+#define VFS_MOUNT_NONE 0
+
+typedef enum {
+    VFS_MOUNT_PACK,
+    VFS_MOUNT_DIRECTORY
+} VfsMountType;
+
+// Where a path lives
+typedef struct {
+    VfsMountID mount;             // VFS_MOUNT_NONE when no mount has the path
+    const PackArchive* pack;      // Pack entries
+    const PackEntry* entry;
+    char hostPath[VFS_MAX_PATH];  // Loose file to open (the path itself when unmounted)
+} VfsResolution;
+
+typedef struct {
+    uint32_t lookups;
+    uint32_t cacheHits;
+    uint32_t hostProbes;          // File system checks made on cache misses
+    int cachedPaths;
+    int mountCount;
+} VfsStats;
+
+// Mounting ("" mounts at the root; a mount point "mods/x" serves "mods/x/...")
+EXPORT VfsMountID Vfs_MountPack(const char* packPath, const char* mountPoint, int priority);
+EXPORT VfsMountID Vfs_MountDirectory(const char* directory, const char* mountPoint, int priority, bool isWritable);
+EXPORT bool Vfs_Unmount(VfsMountID mount); // False if unknown or still retained
+EXPORT void Vfs_UnmountAll(); // Retained mounts stay
+EXPORT PackArchive* Vfs_GetPack(VfsMountID mount);
+EXPORT VfsMountID Vfs_FindPackMount(const PackArchive* pack); // NULL finds any pack mount
+
+// Resolution
+EXPORT bool Vfs_Resolve(const char* path, VfsResolution* resolution); // False only for invalid paths
+EXPORT bool Vfs_ResolveRetained(const char* path, VfsResolution* resolution); // Pack entries stay mounted until released
+EXPORT void Vfs_ReleaseResolution(const VfsResolution* resolution);
+EXPORT bool Vfs_RetainMount(VfsMountID mount); // False if it is no longer mounted
+EXPORT void Vfs_ReleaseMount(VfsMountID mount);
+EXPORT bool Vfs_GetWritePath(const char* path, char* hostPath, size_t size); // Highest-priority writable mount, else the path
+EXPORT void Vfs_Invalidate(const char* path); // After creating or deleting a file behind the VFS's back
+EXPORT void Vfs_InvalidateAll();
+EXPORT bool Vfs_NormalizePath(const char* path, char* normalized, size_t size);
+EXPORT VfsStats Vfs_GetStats();
+
+#endif // VFS_H
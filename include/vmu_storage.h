@@ -0,0 +1,48 @@
+// vmu_storage.h
+#ifndef VMU_STORAGE_H
+#define VMU_STORAGE_H
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// VMU Geometry (standard VMU file system: root block 255, FAT 254, directory 253-241)
+#define VMU_BLOCK_SIZE 512
+#define VMU_TOTAL_BLOCKS 256
+#define VMU_USER_BLOCKS 200
+#define VMU_MAX_FILE_NAME 12
+
+// Save containers are stored in whole blocks; each block ends in a CRC-32 of the rest
+#define VMU_CONTAINER_BLOCK_PAYLOAD (VMU_BLOCK_SIZE - 4)
+
+// Memory card, either a real VMU or a file-backed image with the same layout
+typedef struct VmuDevice VmuDevice;
+
+// Device Management
+EXPORT VmuDevice* VmuDevice_OpenImage(const char* path); // Formats a blank image if the file is missing
+#ifdef DREAMCAST
+EXPORT VmuDevice* VmuDevice_OpenPort(int port, int unit); // e.g. (0, 1) for the card in controller A, slot 1
+#endif
+EXPORT void VmuDevice_Close(VmuDevice* device);
+
+// Files (thread-safe). Each file starts with a VMS header and blank icon so the BIOS can list it;
+// ReadFile returns exactly the bytes that were written. Block counts include the header.
+EXPORT int VmuDevice_GetFreeBlocks(VmuDevice* device);
+EXPORT int VmuDevice_GetFileBlocks(VmuDevice* device, const char* name); // -1 if missing
+EXPORT int VmuDevice_GetBlocksNeeded(size_t size); // Blocks a file of size bytes takes, header included
+EXPORT bool VmuDevice_WriteFile(VmuDevice* device, const char* name, const void* data, size_t size);
+EXPORT void* VmuDevice_ReadFile(VmuDevice* device, const char* name, size_t* outSize); // Free with free()
+EXPORT bool VmuDevice_DeleteFile(VmuDevice* device, const char* name);
+
+// Save Containers: LZSS-compressed (stored raw when that is smaller), split into CRC-checked blocks
+EXPORT size_t VmuContainer_GetBound(size_t size); // Largest container for size bytes (whole blocks)
+EXPORT size_t VmuContainer_Pack(const void* data, size_t size, void* output, size_t outCapacity); // 0 on failure
+EXPORT void* VmuContainer_Unpack(const void* container, size_t size, size_t* outSize); // Free with free(); NULL if a block is corrupt
+
+#endif // VMU_STORAGE_H
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include "log_system.h" // For per-NPC trace output
 
 #define MAX_NPCS 256
 
@@ -13,7 +14,7 @@ static int npcCount = 0;
 void AI_Init() {
     npcCount = 0;
     memset(npcRegistry, 0, sizeof(npcRegistry));
-    printf("AI system initialized.\n");
+    LOG_INFO(LOG_CATEGORY_AI, "AI system initialized.");
 }
 
 // Shutdown the AI system
@@ -22,13 +23,13 @@ void AI_Shutdown() {
         AI_DestroyNPC(npcRegistry[i]);
     }
     npcCount = 0;
-    printf("AI system shut down.\n");
+    LOG_INFO(LOG_CATEGORY_AI, "AI system shut down.");
 }
 
 // Create an NPC
 NPC* AI_CreateNPC(const char* name, Vector3 position, NPCBehaviorType behavior) {
     if (npcCount >= MAX_NPCS) {
-        printf("Error: Maximum NPC count reached.\n");
+        LOG_ERROR(LOG_CATEGORY_AI, "Maximum NPC count reached.");
         return NULL;
     }
 
@@ -45,7 +46,7 @@ NPC* AI_CreateNPC(const char* name, Vector3 position, NPCBehaviorType behavior)
     npc->dialogue = NULL;
 
     npcRegistry[npcCount++] = npc;
-    printf("NPC created: %s\n", name);
+    LOG_DEBUG(LOG_CATEGORY_AI, "NPC created: %s", name);
     return npc;
 }
 
@@ -65,7 +66,7 @@ void AI_SetBehavior(NPC* npc, NPCBehaviorType behavior, void (*customBehavior)(v
 
     npc->behavior = behavior;
     npc->customBehavior = customBehavior;
-    printf("Behavior set for NPC: %s\n", npc->name);
+    LOG_DEBUG(LOG_CATEGORY_AI, "Behavior set for NPC: %s", npc->name);
 }
 
 // Update NPC
@@ -88,22 +89,22 @@ void AI_UpdateNPC(NPC* npc, float deltaTime) {
 
     case NPC_BEHAVIOR_FOLLOW_PLAYER:
         // Example logic for following the player (stubbed out)
-        printf("%s is following the player.\n", npc->name);
+        LOG_TRACE(LOG_CATEGORY_AI, "%s is following the player.", npc->name);
         break;
 
     case NPC_BEHAVIOR_GUARD:
         // Guard behavior can be implemented here
-        printf("%s is guarding its position.\n", npc->name);
+        LOG_TRACE(LOG_CATEGORY_AI, "%s is guarding its position.", npc->name);
         break;
 
     case NPC_BEHAVIOR_SHOP:
         // Shop behavior
-        printf("%s is ready to open the shop.\n", npc->name);
+        LOG_TRACE(LOG_CATEGORY_AI, "%s is ready to open the shop.", npc->name);
         break;
 
     case NPC_BEHAVIOR_CONVERSATION:
         // Conversation behavior
-        printf("%s is ready for a conversation.\n", npc->name);
+        LOG_TRACE(LOG_CATEGORY_AI, "%s is ready for a conversation.", npc->name);
         break;
 
     case NPC_BEHAVIOR_CUSTOM:
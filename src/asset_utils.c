@@ -1,148 +1,916 @@
 // asset_utils.c
 #include "asset_utils.h"
+#include "async_io.h"
+#include "hash_utils.h"
+#include "job_system.h"
+#include "pack_archive.h"
+#include "profiler.h"
+#include "renderer.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #ifdef DREAMCAST
 #include <kos.h>
+#include <SDL2/SDL.h> // Threads, atomics and timers for the async pipeline
 #else
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
 #endif
 
-// Asset Tracking
-#define MAX_ASSETS 1024
-static TextureAsset textureAssets[MAX_ASSETS];
-static AudioAsset audioAssets[MAX_ASSETS];
-static int textureCount = 0;
-static int audioCount = 0;
+// Cache Budgets
+#ifdef DREAMCAST
+#define ASSET_DEFAULT_TEXTURE_BUDGET (6 * 1024 * 1024)  // Most of the 8MB of PVR memory
+#define ASSET_DEFAULT_AUDIO_BUDGET (1536 * 1024)        // Most of the 2MB of sound memory
+#else
+#define ASSET_DEFAULT_TEXTURE_BUDGET (256 * 1024 * 1024)
+#define ASSET_DEFAULT_AUDIO_BUDGET (64 * 1024 * 1024)
+#endif
 
-// Helper Function: Find Asset
-static bool FindAsset(const char* filepath) {
-    for (int i = 0; i < textureCount; i++) {
-        if (strcmp(textureAssets[i].filepath, filepath) == 0) {
-            return true;
-        }
-    }
-    for (int i = 0; i < audioCount; i++) {
-        if (strcmp(audioAssets[i].filepath, filepath) == 0) {
-            return true;
+// Async Loading
+#define ASSET_IO_THREADS 1
+#define ASSET_MAX_DECODE_THREADS 4
+#define ASSET_DEFAULT_FINALIZE_BUDGET_MS 2.0f
+
+// Callback waiting for an asset to finish loading
+typedef struct {
+    AssetLoadCallback callback;
+    void* userData;
+} AssetCallback;
+
+// Cached Asset
+typedef struct CacheEntry {
+    union {
+        TextureAsset texture;
+        AudioAsset audio;
+    } asset;                        // Public view handed to callers
+    AssetType type;
+    char* filepath;
+    uint32_t pathHash;
+    AssetHandle handle;
+    int tableIndex;                 // Position in cacheTable (indexed by cacheIndex)
+    int refCount;
+    size_t sizeBytes;               // Counted in residentBytes once ready
+    SDL_atomic_t status;            // AssetLoadStatus
+
+    // Load pipeline (owned by worker threads while isInPipeline)
+    bool isInPipeline;              // Submitted and not yet drained by AssetSystem_Update
+    FileMapping file;               // Raw file contents, in place for packed assets (I/O -> decode)
+    void* decoded;                  // SDL_Surface* / Mix_Chunk* waiting for finalize
+    bool isCooked;                  // Cooked texture: decoded points into file and is uploaded as-is
+    AssetCallback* callbacks;       // Fired once the load completes
+    int callbackCount;
+    int callbackCapacity;
+    struct CacheEntry* next;        // Completion queue link
+    bool isCompleted;               // On the completion queue (guarded by completionMutex)
+
+    // LRU list of unreferenced, loaded assets (least recently used at the head)
+    struct CacheEntry* lruPrev;
+    struct CacheEntry* lruNext;
+    bool isInLRU;
+} CacheEntry;
+
+// Per-type cache state
+typedef struct {
+    CacheEntry* lruHead;
+    CacheEntry* lruTail;
+    AssetCacheStats stats;
+} AssetCacheBucket;
+
+static CacheEntry** cacheTable = NULL;      // Every entry, indexed through cacheIndex
+static int cacheCount = 0;
+static int cacheCapacity = 0;
+static HashIndex cacheIndex = { 0 };        // Path hash -> cacheTable position
+static EntityArray cacheHandles;            // Handle -> CacheEntry*
+static AssetCacheBucket cacheBuckets[ASSET_TYPE_COUNT];
+static bool isCacheInitialized = false;
+
+static JobPool* ioPool = NULL;
+static JobPool* decodePool = NULL;
+static SDL_mutex* completionMutex = NULL;
+static SDL_cond* completionSignal = NULL;   // Broadcast when an entry reaches the completion queue
+static CacheEntry* completionHead = NULL;   // Entries waiting for the main thread
+static CacheEntry* completionTail = NULL;
+static int pipelineCount = 0;
+static float finalizeBudgetMs = ASSET_DEFAULT_FINALIZE_BUDGET_MS;
+static bool isAssetSystemInitialized = false;
+
+// Pending callbacks for assets that were already loaded when requested
+static AssetCallback* readyCallbacks = NULL;
+static AssetHandle* readyCallbackHandles = NULL;
+static int readyCallbackCount = 0;
+static int readyCallbackCapacity = 0;
+
+static void WaitForCompletion(CacheEntry* entry);
+static bool AddCallback(CacheEntry* entry, AssetLoadCallback callback, void* userData);
+
+// Set up the cache tables on first use
+static bool EnsureCache() {
+    if (isCacheInitialized) return true;
+    if (!HashIndex_Init(&cacheIndex, 256)) return false;
+
+    EntityArray_Init(&cacheHandles);
+    memset(cacheBuckets, 0, sizeof(cacheBuckets));
+    cacheBuckets[ASSET_TYPE_TEXTURE].stats.budgetBytes = ASSET_DEFAULT_TEXTURE_BUDGET;
+    cacheBuckets[ASSET_TYPE_AUDIO].stats.budgetBytes = ASSET_DEFAULT_AUDIO_BUDGET;
+    isCacheInitialized = true;
+    return true;
+}
+
+// Find a cached or in-flight asset; failed loads are skipped so they can be retried
+static CacheEntry* FindEntry(AssetType type, const char* filepath, uint32_t hash) {
+    if (!isCacheInitialized) return NULL;
+
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(&cacheIndex, hash, &cursor); i >= 0;
+        i = HashIndex_FindNext(&cacheIndex, hash, &cursor)) {
+        CacheEntry* entry = cacheTable[i];
+        if (entry->type == type && SDL_AtomicGet(&entry->status) != ASSET_LOAD_FAILED &&
+            strcmp(entry->filepath, filepath) == 0) {
+            return entry;
         }
     }
-    return false;
+    return NULL;
 }
 
-// Texture Asset Management
-TextureAsset* Asset_LoadTexture(const char* filepath) {
-    if (FindAsset(filepath)) {
-        printf("Texture already loaded: %s\n", filepath);
-        return NULL;
+// Create an entry for a path (main thread)
+static CacheEntry* CreateEntry(AssetType type, const char* filepath, uint32_t hash) {
+    if (!EnsureCache()) return NULL;
+
+    if (cacheCount >= cacheCapacity) {
+        int capacity = cacheCapacity ? cacheCapacity * 2 : 64;
+        CacheEntry** table = (CacheEntry**)realloc(cacheTable, sizeof(CacheEntry*) * capacity);
+        if (!table) return NULL;
+        cacheTable = table;
+        cacheCapacity = capacity;
     }
 
-    if (textureCount >= MAX_ASSETS) {
-        printf("Texture asset limit reached.\n");
+    CacheEntry* entry = (CacheEntry*)calloc(1, sizeof(CacheEntry));
+    if (!entry) return NULL;
+
+    entry->type = type;
+    entry->filepath = strdup(filepath);
+    entry->pathHash = hash;
+    entry->tableIndex = cacheCount;
+    entry->handle = EntityArray_Add(&cacheHandles, entry);
+    if (!entry->filepath || entry->handle == ASSET_HANDLE_NONE ||
+        !HashIndex_Insert(&cacheIndex, hash, entry->tableIndex)) {
+        EntityArray_Remove(&cacheHandles, entry->handle);
+        free(entry->filepath);
+        free(entry);
         return NULL;
     }
 
-    TextureAsset* texture = &textureAssets[textureCount++];
-    texture->filepath = filepath;
+    cacheTable[cacheCount++] = entry;
+    SDL_AtomicSet(&entry->status, ASSET_LOAD_QUEUED);
+    return entry;
+}
+
+// Unlink an entry from its LRU list
+static void RemoveFromLRU(CacheEntry* entry) {
+    if (!entry->isInLRU) return;
+
+    AssetCacheBucket* bucket = &cacheBuckets[entry->type];
+    if (entry->lruPrev) entry->lruPrev->lruNext = entry->lruNext;
+    else bucket->lruHead = entry->lruNext;
+    if (entry->lruNext) entry->lruNext->lruPrev = entry->lruPrev;
+    else bucket->lruTail = entry->lruPrev;
+
+    entry->lruPrev = NULL;
+    entry->lruNext = NULL;
+    entry->isInLRU = false;
+    bucket->stats.unreferencedCount--;
+}
+
+// Append an entry to the most recently used end of its LRU list
+static void PushToLRU(CacheEntry* entry) {
+    AssetCacheBucket* bucket = &cacheBuckets[entry->type];
+
+    entry->lruPrev = bucket->lruTail;
+    entry->lruNext = NULL;
+    if (bucket->lruTail) bucket->lruTail->lruNext = entry;
+    else bucket->lruHead = entry;
+    bucket->lruTail = entry;
+    entry->isInLRU = true;
+    bucket->stats.unreferencedCount++;
+}
+
+// Free the platform resource behind a decoded or loaded asset
+static void FreeAssetData(AssetType type, void* data) {
+    if (!data) return;
 
 #ifdef DREAMCAST
-    // Load texture for Dreamcast
-    pvr_ptr_t tex = pvr_mem_malloc(256 * 256 * 2); // Example allocation
-    pvr_txr_load_kimg(tex, filepath);
-    texture->id = (uint32_t)tex;
-    texture->width = 256; // Example dimensions
-    texture->height = 256;
+    if (type == ASSET_TYPE_TEXTURE) {
+        pvr_mem_free((pvr_ptr_t)data);
+    }
+    // Audio is a placeholder on Dreamcast
 #else
-    // Load texture for SDL2
-    SDL_Surface* surface = IMG_Load(filepath);
-    if (!surface) {
-        printf("Failed to load texture: %s\n", filepath);
-        return NULL;
+    if (type == ASSET_TYPE_TEXTURE) {
+        SDL_FreeSurface((SDL_Surface*)data);
+    }
+    else {
+        Mix_FreeChunk((Mix_Chunk*)data);
     }
-    texture->width = surface->w;
-    texture->height = surface->h;
-    texture->id = (uint32_t)surface; // Using surface as a stand-in for the ID
 #endif
+}
 
-    return texture;
+// Release a request's intermediate load data
+static void FreeLoadData(CacheEntry* entry) {
+#ifndef DREAMCAST
+    if (!entry->isCooked) {
+        FreeAssetData(entry->type, entry->decoded);
+    }
+#endif
+    entry->decoded = NULL; // Cooked textures and Dreamcast data only mark the raw file data as usable
+    File_Unmap(&entry->file);
 }
 
-void Asset_UnloadTexture(TextureAsset* texture) {
-    if (!texture || texture->id == 0) return;
+// Remove an entry from the cache and free it (main thread, entry must be out of the pipeline)
+static void DestroyEntry(CacheEntry* entry) {
+    AssetCacheBucket* bucket = &cacheBuckets[entry->type];
 
-#ifdef DREAMCAST
-    // Unload Dreamcast texture
-    pvr_mem_free((pvr_ptr_t)texture->id);
-#else
-    // Unload SDL2 texture
-    SDL_FreeSurface((SDL_Surface*)texture->id);
-#endif
+    RemoveFromLRU(entry);
+    if (SDL_AtomicGet(&entry->status) == ASSET_LOAD_READY) {
+        if (entry->type == ASSET_TYPE_TEXTURE && entry->asset.texture.isGPUResident) {
+            Renderer_DestroyTexture(entry->asset.texture.id);
+        }
+        else {
+            FreeAssetData(entry->type, (void*)(entry->type == ASSET_TYPE_TEXTURE ? entry->asset.texture.id : entry->asset.audio.id));
+        }
+        bucket->stats.residentBytes -= entry->sizeBytes;
+        bucket->stats.residentCount--;
+    }
+    FreeLoadData(entry);
 
-    memset(texture, 0, sizeof(TextureAsset));
+    // Swap-remove from the table and repoint the moved entry in the index
+    HashIndex_Remove(&cacheIndex, entry->pathHash, entry->tableIndex);
+    int last = --cacheCount;
+    if (entry->tableIndex != last) {
+        CacheEntry* moved = cacheTable[last];
+        HashIndex_Replace(&cacheIndex, moved->pathHash, last, entry->tableIndex);
+        moved->tableIndex = entry->tableIndex;
+        cacheTable[entry->tableIndex] = moved;
+    }
+
+    EntityArray_Remove(&cacheHandles, entry->handle);
+    free(entry->callbacks);
+    free(entry->filepath);
+    free(entry);
 }
 
-// Audio Asset Management
-AudioAsset* Asset_LoadAudio(const char* filepath) {
-    if (FindAsset(filepath)) {
-        printf("Audio already loaded: %s\n", filepath);
-        return NULL;
+// Evict least recently used assets until a type is back within budget
+static void EnforceBudget(AssetType type) {
+    AssetCacheBucket* bucket = &cacheBuckets[type];
+
+    while (bucket->stats.residentBytes > bucket->stats.budgetBytes && bucket->lruHead) {
+        DestroyEntry(bucket->lruHead);
+        bucket->stats.evictions++;
     }
+}
 
-    if (audioCount >= MAX_ASSETS) {
-        printf("Audio asset limit reached.\n");
-        return NULL;
+// Add a reference to an entry
+static void AcquireEntry(CacheEntry* entry) {
+    RemoveFromLRU(entry);
+    entry->refCount++;
+}
+
+// Drop a reference; unreferenced assets stay cached in the LRU list
+static void ReleaseEntry(CacheEntry* entry) {
+    if (entry->refCount <= 0) return;
+    if (--entry->refCount > 0) return;
+
+    entry->callbackCount = 0; // Nobody is waiting for this load anymore
+    if (entry->isInPipeline) return; // Handled when AssetSystem_Update drains it
+
+    if (SDL_AtomicGet(&entry->status) == ASSET_LOAD_READY) {
+        PushToLRU(entry);
+        EnforceBudget(entry->type);
+    }
+    else {
+        DestroyEntry(entry);
     }
+}
+
+// Count a cache lookup
+static void RecordLookup(AssetType type, bool isHit) {
+    if (isHit) cacheBuckets[type].stats.hits++;
+    else cacheBuckets[type].stats.misses++;
+}
+
+// Mark an entry as loaded and account for its memory
+static void CommitEntry(CacheEntry* entry, uintptr_t id, int width, int height, size_t sizeBytes) {
+    AssetCacheBucket* bucket = &cacheBuckets[entry->type];
 
-    AudioAsset* audio = &audioAssets[audioCount++];
-    audio->filepath = filepath;
+    if (entry->type == ASSET_TYPE_TEXTURE) {
+        entry->asset.texture.id = id;
+        entry->asset.texture.width = width;
+        entry->asset.texture.height = height;
+        entry->asset.texture.filepath = entry->filepath;
+    }
+    else {
+        entry->asset.audio.id = id;
+        entry->asset.audio.duration = 0.0f; // SDL2 does not provide duration directly
+        entry->asset.audio.filepath = entry->filepath;
+    }
+
+    entry->sizeBytes = sizeBytes;
+    SDL_AtomicSet(&entry->status, ASSET_LOAD_READY);
+    bucket->stats.residentBytes += sizeBytes;
+    bucket->stats.residentCount++;
+    if (bucket->stats.residentBytes > bucket->stats.peakResidentBytes) {
+        bucket->stats.peakResidentBytes = bucket->stats.residentBytes;
+    }
+    EnforceBudget(entry->type); // Only unreferenced assets are evicted, never this one
+}
+
+// Find the cache entry behind a TextureAsset/AudioAsset pointer
+static CacheEntry* EntryFromAsset(const void* asset, const char* filepath, AssetType type) {
+    if (!asset || !filepath || !isCacheInitialized) return NULL;
+
+    CacheEntry* entry = FindEntry(type, filepath, Hash_String(filepath));
+    return entry && (const void*)&entry->asset == asset ? entry : NULL;
+}
+
+// Decode file contents (any thread)
+static void DecodeFile(CacheEntry* entry) {
+    // Cooked textures are already in the upload format; keep the mapping for finalize
+    if (entry->type == ASSET_TYPE_TEXTURE && CookedTexture_Validate(entry->file.data, entry->file.size)) {
+        entry->isCooked = true;
+        entry->decoded = (void*)entry->file.data;
+        return;
+    }
 
 #ifdef DREAMCAST
-    // Load audio for Dreamcast (placeholder)
-    audio->id = 1; // Placeholder ID
-    audio->duration = 0.0f; // Placeholder duration
+    // Audio is copied to sound memory during finalize; textures must be cooked
+    if (entry->type == ASSET_TYPE_AUDIO) {
+        entry->decoded = (void*)entry->file.data;
+    }
+    else {
+        printf("Textures must be cooked for Dreamcast: %s\n", entry->filepath);
+    }
 #else
-    // Load audio for SDL2
-    Mix_Chunk* chunk = Mix_LoadWAV(filepath);
-    if (!chunk) {
-        printf("Failed to load audio: %s\n", filepath);
-        return NULL;
+    SDL_RWops* rw = SDL_RWFromConstMem(entry->file.data, (int)entry->file.size);
+    if (rw) {
+        // Both loaders close the RWops
+        if (entry->type == ASSET_TYPE_TEXTURE) {
+            entry->decoded = IMG_Load_RW(rw, 1);
+        }
+        else {
+            entry->decoded = Mix_LoadWAV_RW(rw, 1);
+        }
     }
-    audio->id = (uint32_t)chunk;
-    audio->duration = 0.0f; // SDL2 does not provide duration directly
+    File_Unmap(&entry->file); // Decoders copy what they need
 #endif
-
-    return audio;
 }
 
-void Asset_UnloadAudio(AudioAsset* audio) {
-    if (!audio || audio->id == 0) return;
-
+// Create the decoded asset on the main thread (GPU upload happens here)
+static void FinalizeEntry(CacheEntry* entry) {
+    if (entry->decoded && entry->isCooked) {
+        // Straight from the file (or pack) into texture memory
+        const CookedTextureHeader* header = (const CookedTextureHeader*)entry->file.data;
+        uintptr_t texture = Renderer_UploadTexture(header, entry->file.data);
+        if (texture) {
+            TextureAsset* asset = &entry->asset.texture;
+            asset->format = (TextureFormat)header->format;
+            asset->mipCount = (int)header->mipCount;
+            asset->flags = header->flags;
+            asset->isGPUResident = true;
+            CommitEntry(entry, texture, (int)header->width, (int)header->height, header->dataSize);
+        }
+    }
+    else if (entry->decoded) {
 #ifdef DREAMCAST
-    // Unload Dreamcast audio (placeholder)
+        CommitEntry(entry, 1, 0, 0, 0); // Placeholder until Dreamcast audio is supported
 #else
-    // Unload SDL2 audio
-    Mix_FreeChunk((Mix_Chunk*)audio->id);
+        if (entry->type == ASSET_TYPE_TEXTURE) {
+            SDL_Surface* surface = (SDL_Surface*)entry->decoded;
+            entry->asset.texture.format = TEXTURE_FORMAT_RGBA8888;
+            entry->asset.texture.mipCount = 1;
+            CommitEntry(entry, (uintptr_t)surface, surface->w, surface->h, (size_t)surface->pitch * surface->h);
+        }
+        else {
+            Mix_Chunk* chunk = (Mix_Chunk*)entry->decoded;
+            CommitEntry(entry, (uintptr_t)chunk, 0, 0, chunk->alen);
+        }
 #endif
+        entry->decoded = NULL; // Owned by the cache now
+    }
+    FreeLoadData(entry);
+
+    if (SDL_AtomicGet(&entry->status) != ASSET_LOAD_READY) {
+        printf("Failed to load %s: %s\n", entry->type == ASSET_TYPE_TEXTURE ? "texture" : "audio", entry->filepath);
+        SDL_AtomicSet(&entry->status, ASSET_LOAD_FAILED);
+    }
+}
+
+// Load an asset synchronously through the cache
+static CacheEntry* LoadSync(AssetType type, const char* filepath) {
+    if (!filepath || !EnsureCache()) return NULL;
+
+    uint32_t hash = Hash_String(filepath);
+    CacheEntry* entry = FindEntry(type, filepath, hash);
+    RecordLookup(type, entry != NULL);
+
+    if (entry) {
+        AcquireEntry(entry);
+
+        // In flight on the async pipeline: wait for this entry alone and finalize it here. Its
+        // callbacks, like every other completion, are left to the next AssetSystem_Update.
+        if (entry->isInPipeline) {
+            WaitForCompletion(entry);
+            entry->isInPipeline = false;
+            pipelineCount--;
+            FinalizeEntry(entry);
+
+            AssetCallback* callbacks = entry->callbacks;
+            int callbackCount = entry->callbackCount;
+            entry->callbacks = NULL;
+            entry->callbackCount = 0;
+            entry->callbackCapacity = 0;
+            for (int i = 0; i < callbackCount; ++i) {
+                AddCallback(entry, callbacks[i].callback, callbacks[i].userData);
+            }
+            free(callbacks);
+        }
+
+        if (SDL_AtomicGet(&entry->status) != ASSET_LOAD_READY) {
+            ReleaseEntry(entry);
+            return NULL;
+        }
+        return entry;
+    }
+
+    entry = CreateEntry(type, filepath, hash);
+    if (!entry) return NULL;
+    entry->refCount = 1;
+
+    // Same steps as the async pipeline, on the calling thread
+    if (File_Map(filepath, &entry->file)) {
+        DecodeFile(entry);
+    }
+    FinalizeEntry(entry);
+
+    if (SDL_AtomicGet(&entry->status) != ASSET_LOAD_READY) {
+        DestroyEntry(entry);
+        return NULL;
+    }
+    return entry;
+}
+
+// Texture Asset Management
+TextureAsset* Asset_LoadTexture(const char* filepath) {
+    CacheEntry* entry = LoadSync(ASSET_TYPE_TEXTURE, filepath);
+    return entry ? &entry->asset.texture : NULL;
+}
+
+void Asset_UnloadTexture(TextureAsset* texture) {
+    CacheEntry* entry = EntryFromAsset(texture, texture ? texture->filepath : NULL, ASSET_TYPE_TEXTURE);
+    if (entry) ReleaseEntry(entry);
+}
+
+// Audio Asset Management
+AudioAsset* Asset_LoadAudio(const char* filepath) {
+    CacheEntry* entry = LoadSync(ASSET_TYPE_AUDIO, filepath);
+    return entry ? &entry->asset.audio : NULL;
+}
 
-    memset(audio, 0, sizeof(AudioAsset));
+void Asset_UnloadAudio(AudioAsset* audio) {
+    CacheEntry* entry = EntryFromAsset(audio, audio ? audio->filepath : NULL, ASSET_TYPE_AUDIO);
+    if (entry) ReleaseEntry(entry);
 }
 
 // Asset Management
 bool Asset_IsLoaded(const char* filepath) {
-    return FindAsset(filepath);
+    if (!filepath || !isCacheInitialized) return false;
+
+    uint32_t hash = Hash_String(filepath);
+    for (int type = 0; type < ASSET_TYPE_COUNT; ++type) {
+        CacheEntry* entry = FindEntry((AssetType)type, filepath, hash);
+        if (entry && SDL_AtomicGet(&entry->status) == ASSET_LOAD_READY) return true;
+    }
+    return false;
 }
 
+// Free every asset regardless of references (loads still in flight are kept)
 void Asset_UnloadAll() {
-    for (int i = 0; i < textureCount; i++) {
-        Asset_UnloadTexture(&textureAssets[i]);
+    for (int i = cacheCount - 1; i >= 0; --i) {
+        if (i < cacheCount && !cacheTable[i]->isInPipeline) {
+            DestroyEntry(cacheTable[i]);
+        }
+    }
+}
+
+// Set the memory budget for a type, evicting unreferenced assets if needed
+void AssetCache_SetBudget(AssetType type, size_t bytes) {
+    if (type < 0 || type >= ASSET_TYPE_COUNT || !EnsureCache()) return;
+
+    cacheBuckets[type].stats.budgetBytes = bytes;
+    EnforceBudget(type);
+}
+
+// Get cache statistics for a type
+bool AssetCache_GetStats(AssetType type, AssetCacheStats* stats) {
+    if (type < 0 || type >= ASSET_TYPE_COUNT || !stats || !EnsureCache()) return false;
+
+    *stats = cacheBuckets[type].stats;
+    return true;
+}
+
+// Get the fraction of loads served from the cache
+float AssetCache_GetHitRate(AssetType type) {
+    if (type < 0 || type >= ASSET_TYPE_COUNT) return 0.0f;
+
+    const AssetCacheStats* stats = &cacheBuckets[type].stats;
+    uint32_t lookups = stats->hits + stats->misses;
+    return lookups ? (float)stats->hits / (float)lookups : 0.0f;
+}
+
+// Reset hit, miss, eviction and peak counters
+void AssetCache_ResetStats() {
+    for (int type = 0; type < ASSET_TYPE_COUNT; ++type) {
+        AssetCacheStats* stats = &cacheBuckets[type].stats;
+        stats->hits = 0;
+        stats->misses = 0;
+        stats->evictions = 0;
+        stats->peakResidentBytes = stats->residentBytes;
+    }
+}
+
+// Free every unreferenced asset
+void AssetCache_Trim() {
+    for (int type = 0; type < ASSET_TYPE_COUNT; ++type) {
+        while (cacheBuckets[type].lruHead) {
+            DestroyEntry(cacheBuckets[type].lruHead);
+            cacheBuckets[type].stats.evictions++;
+        }
+    }
+}
+
+// Hand an entry to the main thread for finalizing
+static void PushCompletion(CacheEntry* entry) {
+    entry->next = NULL;
+
+    SDL_LockMutex(completionMutex);
+    if (completionTail) {
+        completionTail->next = entry;
+    }
+    else {
+        completionHead = entry;
+    }
+    completionTail = entry;
+    entry->isCompleted = true;
+    SDL_CondBroadcast(completionSignal);
+    SDL_UnlockMutex(completionMutex);
+}
+
+// Take the oldest entry waiting for the main thread
+static CacheEntry* PopCompletion() {
+    SDL_LockMutex(completionMutex);
+    CacheEntry* entry = completionHead;
+    if (entry) {
+        completionHead = entry->next;
+        if (!completionHead) completionTail = NULL;
+    }
+    SDL_UnlockMutex(completionMutex);
+    return entry;
+}
+
+// Block until one entry reaches the completion queue, then take it out of the queue (main thread)
+static void WaitForCompletion(CacheEntry* entry) {
+    SDL_LockMutex(completionMutex);
+    while (!entry->isCompleted) {
+        SDL_CondWait(completionSignal, completionMutex);
+    }
+
+    CacheEntry* previous = NULL;
+    for (CacheEntry* queued = completionHead; queued; previous = queued, queued = queued->next) {
+        if (queued != entry) continue;
+
+        if (previous) previous->next = entry->next;
+        else completionHead = entry->next;
+        if (completionTail == entry) completionTail = previous;
+        break;
+    }
+    entry->next = NULL;
+    SDL_UnlockMutex(completionMutex);
+}
+
+// Decode job: turn file bytes into a surface or chunk (decode pool)
+static void DecodeAssetJob(void* data) {
+    CacheEntry* entry = (CacheEntry*)data;
+    DecodeFile(entry);
+
+    // Failures also go through finalize; only the main thread sets READY/FAILED
+    SDL_AtomicSet(&entry->status, ASSET_LOAD_FINALIZING);
+    PushCompletion(entry);
+}
+
+// I/O job: map or read the whole file (I/O pool), then hand it to the decode pool
+static void ReadAssetJob(void* data) {
+    CacheEntry* entry = (CacheEntry*)data;
+    SDL_AtomicSet(&entry->status, ASSET_LOAD_READING);
+
+    if (File_Map(entry->filepath, &entry->file)) {
+        // Decoders read front to back; start the disk reads now so the decode pool does not fault them in
+        File_AdviseMapping(&entry->file, 0, entry->file.size, FILE_ACCESS_SEQUENTIAL);
+        File_AdviseMapping(&entry->file, 0, entry->file.size, FILE_ACCESS_WILLNEED);
+        SDL_AtomicSet(&entry->status, ASSET_LOAD_DECODING);
+        if (JobPool_Submit(decodePool, DecodeAssetJob, entry, JOB_PRIORITY_NORMAL)) return;
+    }
+
+    SDL_AtomicSet(&entry->status, ASSET_LOAD_FINALIZING);
+    PushCompletion(entry);
+}
+
+// Async read finished (I/O thread): hand the file to the decode pool
+static void OnAssetFileRead(AsyncIORequest request, AsyncIOStatus status, void* buffer, size_t bytes, void* userData) {
+    (void)request;
+    CacheEntry* entry = (CacheEntry*)userData;
+    if (status == ASYNC_IO_COMPLETE && buffer) {
+        // Freed with the rest of the load data, like a mapping that fell back to the heap
+        entry->file.data = buffer;
+        entry->file.size = bytes;
+        entry->file.isMapped = false;
+        entry->file.isBorrowed = false;
+        SDL_AtomicSet(&entry->status, ASSET_LOAD_DECODING);
+        if (JobPool_Submit(decodePool, DecodeAssetJob, entry, JOB_PRIORITY_NORMAL)) return;
+    }
+    else {
+        free(buffer);
+    }
+
+    SDL_AtomicSet(&entry->status, ASSET_LOAD_FINALIZING);
+    PushCompletion(entry);
+}
+
+// Fire callbacks queued for assets that were already loaded when requested
+static void FlushReadyCallbacks() {
+    // Callbacks may queue more loads, so only fire the ones pending on entry
+    int count = readyCallbackCount;
+    if (count == 0) return;
+
+    for (int i = 0; i < count; ++i) {
+        AssetHandle handle = readyCallbackHandles[i];
+        CacheEntry* entry = (CacheEntry*)EntityArray_Get(&cacheHandles, handle);
+        if (entry && entry->refCount > 0) {
+            void* asset = SDL_AtomicGet(&entry->status) == ASSET_LOAD_READY ? &entry->asset : NULL;
+            readyCallbacks[i].callback(handle, entry->type, asset, readyCallbacks[i].userData);
+        }
+    }
+
+    memmove(readyCallbacks, readyCallbacks + count, sizeof(AssetCallback) * (readyCallbackCount - count));
+    memmove(readyCallbackHandles, readyCallbackHandles + count, sizeof(AssetHandle) * (readyCallbackCount - count));
+    readyCallbackCount -= count;
+}
+
+// Initialize the async loading pipeline
+bool AssetSystem_Init() {
+    if (isAssetSystemInitialized) return true;
+    if (!EnsureCache()) return false;
+
+    int decodeThreads = SDL_GetCPUCount() - 1;
+    if (decodeThreads < 1) decodeThreads = 1;
+    if (decodeThreads > ASSET_MAX_DECODE_THREADS) decodeThreads = ASSET_MAX_DECODE_THREADS;
+
+    completionMutex = SDL_CreateMutex();
+    completionSignal = SDL_CreateCond();
+    ioPool = JobPool_Create("AssetIO", ASSET_IO_THREADS);
+    decodePool = JobPool_Create("AssetDecode", decodeThreads);
+    if (!completionMutex || !completionSignal || !ioPool || !decodePool) {
+        printf("Failed to initialize asset system.\n");
+        JobPool_Destroy(ioPool);
+        JobPool_Destroy(decodePool);
+        if (completionMutex) SDL_DestroyMutex(completionMutex);
+        if (completionSignal) SDL_DestroyCond(completionSignal);
+        ioPool = NULL;
+        decodePool = NULL;
+        completionMutex = NULL;
+        completionSignal = NULL;
+        return false;
+    }
+
+    isAssetSystemInitialized = true;
+    printf("Asset system initialized.\n");
+    return true;
+}
+
+// Shutdown the async pipeline and free the cache
+void AssetSystem_Shutdown() {
+    if (isAssetSystemInitialized) {
+        // I/O jobs and async reads feed the decode pool, so drain them first
+        AsyncIO_WaitIdle();
+        JobPool_Destroy(ioPool);
+        JobPool_Destroy(decodePool);
+        ioPool = NULL;
+        decodePool = NULL;
+
+        // Every pipeline entry is now on the completion queue
+        for (CacheEntry* entry = PopCompletion(); entry; entry = PopCompletion()) {
+            entry->isInPipeline = false;
+        }
+        pipelineCount = 0;
+
+        SDL_DestroyMutex(completionMutex);
+        SDL_DestroyCond(completionSignal);
+        completionMutex = NULL;
+        completionSignal = NULL;
+        isAssetSystemInitialized = false;
+        printf("Asset system shut down.\n");
+    }
+
+    if (isCacheInitialized) {
+        Asset_UnloadAll();
+        free(cacheTable);
+        cacheTable = NULL;
+        cacheCapacity = 0;
+        HashIndex_Free(&cacheIndex);
+        EntityArray_Free(&cacheHandles);
+        isCacheInitialized = false;
+    }
+
+    free(readyCallbacks);
+    free(readyCallbackHandles);
+    readyCallbacks = NULL;
+    readyCallbackHandles = NULL;
+    readyCallbackCount = 0;
+    readyCallbackCapacity = 0;
+}
+
+// Finalize completed loads on the main thread within the per-frame budget
+void AssetSystem_Update(float deltaTime) {
+    (void)deltaTime;
+    if (!isAssetSystemInitialized) return;
+
+    PROFILE_BEGIN("Asset_FlushCallbacks");
+    FlushReadyCallbacks();
+    PROFILE_END();
+
+    PROFILE_BEGIN("Asset_Finalize");
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 budgetTicks = (Uint64)(finalizeBudgetMs * 0.001 * (double)SDL_GetPerformanceFrequency());
+
+    // Always finalize at least one entry so loading makes progress on slow frames
+    do {
+        CacheEntry* entry = PopCompletion();
+        if (!entry) break;
+
+        entry->isInPipeline = false;
+        pipelineCount--;
+        FinalizeEntry(entry);
+
+        // Callbacks may release handles (even this one), so fire from a detached list
+        AssetCallback* callbacks = entry->callbacks;
+        int callbackCount = entry->callbackCount;
+        AssetHandle handle = entry->handle;
+        AssetType type = entry->type;
+        void* asset = SDL_AtomicGet(&entry->status) == ASSET_LOAD_READY ? &entry->asset : NULL;
+        entry->callbacks = NULL;
+        entry->callbackCount = 0;
+        entry->callbackCapacity = 0;
+
+        if (entry->refCount == 0) {
+            // Every requester let go while loading: keep the result cached, or drop a failure
+            if (asset) {
+                PushToLRU(entry);
+                EnforceBudget(type);
+            }
+            else {
+                DestroyEntry(entry);
+            }
+        }
+
+        for (int i = 0; i < callbackCount; ++i) {
+            callbacks[i].callback(handle, type, asset, callbacks[i].userData);
+        }
+        free(callbacks);
+    } while (SDL_GetPerformanceCounter() - start < budgetTicks);
+    PROFILE_END();
+}
+
+// Set the main-thread time spent finalizing loads per frame
+void AssetSystem_SetFinalizeBudget(float milliseconds) {
+    finalizeBudgetMs = milliseconds > 0.0f ? milliseconds : 0.0f;
+}
+
+// Get the number of async loads not yet finalized
+int AssetSystem_GetPendingCount() {
+    return pipelineCount;
+}
+
+// Register a callback for an entry
+static bool AddCallback(CacheEntry* entry, AssetLoadCallback callback, void* userData) {
+    if (!callback) return true;
+
+    if (!entry->isInPipeline) {
+        // Already finished: deliver from the next AssetSystem_Update
+        if (readyCallbackCount >= readyCallbackCapacity) {
+            int capacity = readyCallbackCapacity ? readyCallbackCapacity * 2 : 16;
+            AssetCallback* callbacks = (AssetCallback*)realloc(readyCallbacks, sizeof(AssetCallback) * capacity);
+            if (!callbacks) return false;
+            readyCallbacks = callbacks;
+            AssetHandle* handles = (AssetHandle*)realloc(readyCallbackHandles, sizeof(AssetHandle) * capacity);
+            if (!handles) return false;
+            readyCallbackHandles = handles;
+            readyCallbackCapacity = capacity;
+        }
+        readyCallbacks[readyCallbackCount] = (AssetCallback){ callback, userData };
+        readyCallbackHandles[readyCallbackCount++] = entry->handle;
+        return true;
+    }
+
+    if (entry->callbackCount >= entry->callbackCapacity) {
+        int capacity = entry->callbackCapacity ? entry->callbackCapacity * 2 : 2;
+        AssetCallback* callbacks = (AssetCallback*)realloc(entry->callbacks, sizeof(AssetCallback) * capacity);
+        if (!callbacks) return false;
+        entry->callbacks = callbacks;
+        entry->callbackCapacity = capacity;
     }
-    textureCount = 0;
+    entry->callbacks[entry->callbackCount++] = (AssetCallback){ callback, userData };
+    return true;
+}
 
-    for (int i = 0; i < audioCount; i++) {
-        Asset_UnloadAudio(&audioAssets[i]);
+// Queue an async load, sharing cached and in-flight assets
+static AssetHandle LoadAsync(AssetType type, const char* filepath, AssetLoadCallback callback, void* userData) {
+    if (!filepath) return ASSET_HANDLE_NONE;
+    if (!isAssetSystemInitialized) {
+        printf("Asset system not initialized.\n");
+        return ASSET_HANDLE_NONE;
     }
-    audioCount = 0;
+
+    uint32_t hash = Hash_String(filepath);
+    CacheEntry* entry = FindEntry(type, filepath, hash);
+    RecordLookup(type, entry != NULL);
+
+    if (entry) {
+        AcquireEntry(entry);
+        AddCallback(entry, callback, userData);
+        return entry->handle;
+    }
+
+    entry = CreateEntry(type, filepath, hash);
+    if (!entry) return ASSET_HANDLE_NONE;
+
+    entry->refCount = 1;
+    entry->isInPipeline = true;
+    pipelineCount++;
+    AddCallback(entry, callback, userData);
+
+    // Loose files stream through the shared I/O queue; pack entries are already in memory and are mapped
+    bool isQueued = false;
+    if (AsyncIO_IsRunning() && !PackArchive_Resolve(filepath, NULL)) {
+        SDL_AtomicSet(&entry->status, ASSET_LOAD_READING);
+        isQueued = AsyncIO_Read(entry->filepath, 0, NULL, 0, ASYNC_IO_PRIORITY_STREAMING,
+            OnAssetFileRead, entry) != ASYNC_IO_REQUEST_NONE;
+    }
+    if (!isQueued && !JobPool_Submit(ioPool, ReadAssetJob, entry, JOB_PRIORITY_NORMAL)) {
+        SDL_AtomicSet(&entry->status, ASSET_LOAD_FINALIZING);
+        PushCompletion(entry);
+    }
+    return entry->handle;
+}
+
+// Load a texture in the background
+AssetHandle Asset_LoadTextureAsync(const char* filepath, AssetLoadCallback callback, void* userData) {
+    return LoadAsync(ASSET_TYPE_TEXTURE, filepath, callback, userData);
+}
+
+// Load an audio clip in the background
+AssetHandle Asset_LoadAudioAsync(const char* filepath, AssetLoadCallback callback, void* userData) {
+    return LoadAsync(ASSET_TYPE_AUDIO, filepath, callback, userData);
+}
+
+// Poll the status of an async load
+AssetLoadStatus Asset_GetLoadStatus(AssetHandle handle) {
+    CacheEntry* entry = (CacheEntry*)EntityArray_Get(&cacheHandles, handle);
+    return entry ? (AssetLoadStatus)SDL_AtomicGet(&entry->status) : ASSET_LOAD_INVALID;
+}
+
+// Get the texture behind a handle, NULL until ready
+TextureAsset* Asset_GetTexture(AssetHandle handle) {
+    CacheEntry* entry = (CacheEntry*)EntityArray_Get(&cacheHandles, handle);
+    if (!entry || entry->type != ASSET_TYPE_TEXTURE || SDL_AtomicGet(&entry->status) != ASSET_LOAD_READY) return NULL;
+    return &entry->asset.texture;
+}
+
+// Get the audio clip behind a handle, NULL until ready
+AudioAsset* Asset_GetAudio(AssetHandle handle) {
+    CacheEntry* entry = (CacheEntry*)EntityArray_Get(&cacheHandles, handle);
+    if (!entry || entry->type != ASSET_TYPE_AUDIO || SDL_AtomicGet(&entry->status) != ASSET_LOAD_READY) return NULL;
+    return &entry->asset.audio;
+}
+
+// Add a reference through an existing handle (each retain needs its own release)
+AssetHandle Asset_RetainHandle(AssetHandle handle) {
+    CacheEntry* entry = (CacheEntry*)EntityArray_Get(&cacheHandles, handle);
+    if (!entry || entry->refCount <= 0) return ASSET_HANDLE_NONE;
+
+    AcquireEntry(entry);
+    return handle;
+}
+
+// Drop the reference held by a handle. Once no references remain, pending callbacks are
+// discarded and the asset moves to the LRU list, to be evicted when its budget is exceeded.
+void Asset_ReleaseHandle(AssetHandle handle) {
+    CacheEntry* entry = (CacheEntry*)EntityArray_Get(&cacheHandles, handle);
+    if (entry) ReleaseEntry(entry);
 }
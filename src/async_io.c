@@ -0,0 +1,1047 @@
+// async_io.c
+#include "async_io.h"
+#include "file_utils.h"
+#include "hash_utils.h"
+#include "job_system.h"
+#include "profiler.h" // For transfer zones
+#include "vfs.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef DREAMCAST
+#include <sys/stat.h> // For sizing whole-file reads
+#endif
+
+#if !defined(DREAMCAST) && !defined(_WIN32)
+#define ASYNC_IO_HAVE_PREAD
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(ZDK_USE_IO_URING) && defined(__linux__)
+#define ASYNC_IO_HAVE_URING
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+#define ASYNC_IO_DEFAULT_BYTES_IN_FLIGHT (8 * 1024 * 1024)
+#define ASYNC_IO_DEFAULT_REQUESTS_IN_FLIGHT 32
+#define ASYNC_IO_DEFAULT_THREADS 2
+#define ASYNC_IO_MAX_GROUPS 64       // Upper bound on requests in flight
+#define ASYNC_IO_MAX_COALESCE 16     // Reads merged into one transfer
+
+// Queued or in-flight request
+typedef struct {
+    bool isUsed;
+    uint16_t generation;
+    uint8_t status;           // AsyncIOStatus
+    bool isWrite;
+    bool ownsBuffer;          // Read buffer allocated on the I/O thread
+    uint32_t writeFlags;
+    AsyncIOPriority priority;
+    char filepath[ASYNC_IO_PATH_MAX];
+    uint32_t pathHash;
+    uint64_t offset;
+    uint8_t* buffer;
+    size_t size;
+    size_t bytes;             // Transferred
+    AsyncIOCallback callback;
+    void* userData;
+    int next;                 // Pending queue or free list link
+} AsyncIOOp;
+
+// Requests issued as one transfer: a single request, or adjacent reads of one file
+typedef struct AsyncIOGroup {
+    bool isUsed;
+    int ops[ASYNC_IO_MAX_COALESCE];
+    int opCount;
+    bool isWrite;
+    uint32_t writeFlags;
+    uint64_t offset;          // File offset of the first request
+    size_t total;             // Bytes requested across every request
+    size_t done;              // Bytes transferred so far
+    bool failed;
+    struct AsyncIOGroup* next; // Ring inbox or failed-dispatch list link
+#ifdef ASYNC_IO_HAVE_URING
+    int fd;
+    bool isSyncing;           // Transfer finished, fsync in flight
+    struct iovec iov[ASYNC_IO_MAX_COALESCE];
+#endif
+} AsyncIOGroup;
+
+// Callback to fire once the lock is released
+typedef struct {
+    AsyncIORequest request;
+    AsyncIOStatus status;
+    void* buffer;
+    size_t bytes;
+    AsyncIOCallback callback;
+    void* userData;
+} AsyncIOCompletion;
+
+static bool isRunning = false;
+static SDL_mutex* ioMutex = NULL;
+static SDL_cond* ioCond = NULL;  // Signalled on every completion
+static JobPool* ioPool = NULL;
+
+static AsyncIOOp ops[ASYNC_IO_MAX_REQUESTS];
+static int freeOpHead = -1;
+static int queueHeads[ASYNC_IO_PRIORITY_COUNT];
+static int queueTails[ASYNC_IO_PRIORITY_COUNT];
+static AsyncIOGroup groups[ASYNC_IO_MAX_GROUPS];
+static AsyncIOGroup* failedDispatches = NULL;
+
+static size_t maxBytesInFlight = ASYNC_IO_DEFAULT_BYTES_IN_FLIGHT;
+static int maxRequestsInFlight = ASYNC_IO_DEFAULT_REQUESTS_IN_FLIGHT;
+static int requestsInFlight = 0;
+static int activeCount = 0;      // Queued and in-flight requests plus callbacks still running
+static AsyncIOStats ioStats;
+
+static void CompleteGroup(AsyncIOGroup* group);
+
+// io_uring Backend (raw system calls, so there is no liburing dependency)
+
+#ifdef ASYNC_IO_HAVE_URING
+#define ASYNC_IO_RING_ENTRIES 128   // Room for every group plus the wake-up read
+#define ASYNC_IO_WAKE_TAG 0         // user_data of the eventfd read
+
+typedef struct {
+    int fd;
+    void* sqRing;
+    size_t sqRingSize;
+    void* cqRing;
+    size_t cqRingSize;
+    struct io_uring_sqe* sqes;
+    size_t sqesSize;
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned* sqArray;
+    unsigned sqMask;
+    unsigned sqEntries;
+    unsigned sqLocalTail;
+    unsigned toSubmit;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned cqMask;
+    struct io_uring_cqe* cqes;
+
+    int wakeFd;               // Submitters write here to wake the ring thread
+    uint64_t wakeValue;
+    struct iovec wakeIov;
+    SDL_Thread* thread;
+    AsyncIOGroup* inbox;      // Groups dispatched to the ring thread (under ioMutex)
+    AsyncIOGroup* inboxTail;
+    bool isStopping;
+} AsyncIORing;
+
+static AsyncIORing ring;
+static bool isRingActive = false;
+
+// Next free submission entry (ring thread only)
+static struct io_uring_sqe* Ring_GetSqe() {
+    unsigned head = __atomic_load_n(ring.sqHead, __ATOMIC_ACQUIRE);
+    if (ring.sqLocalTail - head >= ring.sqEntries) return NULL;
+
+    unsigned index = ring.sqLocalTail & ring.sqMask;
+    struct io_uring_sqe* sqe = &ring.sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    ring.sqArray[index] = index;
+    ring.sqLocalTail++;
+    ring.toSubmit++;
+    return sqe;
+}
+
+// Publish queued entries and wait for at least one completion
+static void Ring_SubmitAndWait() {
+    __atomic_store_n(ring.sqTail, ring.sqLocalTail, __ATOMIC_RELEASE);
+    int submitted = (int)syscall(__NR_io_uring_enter, ring.fd, ring.toSubmit, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+    if (submitted >= 0) {
+        ring.toSubmit -= (unsigned)submitted;
+    }
+    else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+        printf("io_uring_enter failed (errno %d).\n", errno);
+    }
+}
+
+// Keep a read of the wake eventfd queued so submissions interrupt the wait
+static void Ring_ArmWake() {
+    struct io_uring_sqe* sqe = Ring_GetSqe();
+    if (!sqe) return;
+    ring.wakeIov.iov_base = &ring.wakeValue;
+    ring.wakeIov.iov_len = sizeof(ring.wakeValue);
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = ring.wakeFd;
+    sqe->addr = (uint64_t)(uintptr_t)&ring.wakeIov;
+    sqe->len = 1;
+    sqe->user_data = ASYNC_IO_WAKE_TAG;
+}
+
+// Queue the untransferred part of a group as one vectored read or write
+static bool Ring_QueueTransfer(AsyncIOGroup* group) {
+    int count = 0;
+    size_t skip = group->done;
+    for (int i = 0; i < group->opCount; ++i) {
+        AsyncIOOp* op = &ops[group->ops[i]];
+        if (skip >= op->size) {
+            skip -= op->size;
+            continue;
+        }
+        group->iov[count].iov_base = op->buffer + skip;
+        group->iov[count].iov_len = op->size - skip;
+        count++;
+        skip = 0;
+    }
+
+    struct io_uring_sqe* sqe = Ring_GetSqe();
+    if (!sqe) return false;
+    sqe->opcode = group->isWrite ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = group->fd;
+    sqe->addr = (uint64_t)(uintptr_t)group->iov;
+    sqe->len = (uint32_t)count;
+    sqe->off = group->offset + group->done;
+    sqe->user_data = (uint64_t)(uintptr_t)group;
+    return true;
+}
+
+// Queue the rest of a transfer; true if the group has to finish now instead
+static bool Ring_Continue(AsyncIOGroup* group) {
+    if (Ring_QueueTransfer(group)) return false;
+    group->failed = true;
+    return true;
+}
+
+// Handle a completion for a group; true once the group has finished
+static bool Ring_Advance(AsyncIOGroup* group, int result) {
+    if (group->isSyncing) {
+        if (result < 0) group->failed = true;
+        return true;
+    }
+
+    if (result == -EINTR || result == -EAGAIN) return Ring_Continue(group);
+    if (result < 0) {
+        group->failed = true;
+        return true;
+    }
+
+    // Short transfers continue where they stopped; a read returning 0 is the end of the file
+    group->done += (size_t)result;
+    if (result > 0 && group->done < group->total) return Ring_Continue(group);
+    if (group->isWrite && group->done < group->total) group->failed = true;
+
+    if (group->isWrite && (group->writeFlags & ASYNC_IO_WRITE_SYNC) && !group->failed) {
+        struct io_uring_sqe* sqe = Ring_GetSqe();
+        if (!sqe) {
+            group->failed = true;
+            return true;
+        }
+        sqe->opcode = IORING_OP_FSYNC;
+        sqe->fd = group->fd;
+        sqe->user_data = (uint64_t)(uintptr_t)group;
+        group->isSyncing = true;
+        return false;
+    }
+    return true;
+}
+
+static bool AllocateReadBuffers(AsyncIOGroup* group);
+static int OpenGroupFile(const AsyncIOGroup* group);
+
+// Ring thread: turn dispatched groups into submissions and completions into callbacks
+static int Ring_Thread(void* data) {
+    (void)data;
+    int inFlight = 0;
+    PROFILE_THREAD("AsyncIORing");
+    Ring_ArmWake();
+
+    for (;;) {
+        SDL_LockMutex(ioMutex);
+        AsyncIOGroup* group = ring.inbox;
+        ring.inbox = ring.inboxTail = NULL;
+        bool isStopping = ring.isStopping;
+        SDL_UnlockMutex(ioMutex);
+
+        while (group) {
+            AsyncIOGroup* next = group->next;
+            group->fd = -1;
+            group->isSyncing = false;
+            if (AllocateReadBuffers(group)) group->fd = OpenGroupFile(group);
+
+            if (group->fd >= 0 && Ring_QueueTransfer(group)) {
+                inFlight++;
+            }
+            else {
+                if (group->fd >= 0) close(group->fd);
+                group->failed = true;
+                CompleteGroup(group);
+            }
+            group = next;
+        }
+
+        if (isStopping && inFlight == 0) break;
+        Ring_SubmitAndWait();
+
+        unsigned head = *ring.cqHead;
+        unsigned tail = __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            struct io_uring_cqe* cqe = &ring.cqes[head & ring.cqMask];
+            if (cqe->user_data == ASYNC_IO_WAKE_TAG) {
+                Ring_ArmWake();
+                continue;
+            }
+
+            AsyncIOGroup* finished = (AsyncIOGroup*)(uintptr_t)cqe->user_data;
+            if (Ring_Advance(finished, cqe->res)) {
+                close(finished->fd);
+                inFlight--;
+                CompleteGroup(finished);
+            }
+        }
+        __atomic_store_n(ring.cqHead, head, __ATOMIC_RELEASE);
+    }
+    return 0;
+}
+
+// Wake the ring thread (called with ioMutex held)
+static void Ring_Wake() {
+    uint64_t one = 1;
+    if (write(ring.wakeFd, &one, sizeof(one)) < 0) {
+        printf("Failed to wake the I/O ring thread.\n");
+    }
+}
+
+// Release the ring's mappings and descriptors
+static void Ring_Destroy() {
+    if (ring.sqes) munmap(ring.sqes, ring.sqesSize);
+    if (ring.cqRing && ring.cqRing != ring.sqRing) munmap(ring.cqRing, ring.cqRingSize);
+    if (ring.sqRing) munmap(ring.sqRing, ring.sqRingSize);
+    if (ring.wakeFd >= 0) close(ring.wakeFd);
+    if (ring.fd >= 0) close(ring.fd);
+    memset(&ring, 0, sizeof(ring));
+    ring.fd = ring.wakeFd = -1;
+}
+
+// Set up a ring and its thread; false if the kernel does not allow io_uring
+static bool Ring_Start() {
+    memset(&ring, 0, sizeof(ring));
+    ring.wakeFd = -1;
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring.fd = (int)syscall(__NR_io_uring_setup, ASYNC_IO_RING_ENTRIES, &params);
+    if (ring.fd < 0) return false;
+
+    ring.sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring.cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool isSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (isSingleMap && ring.cqRingSize > ring.sqRingSize) ring.sqRingSize = ring.cqRingSize;
+
+    ring.sqRing = mmap(NULL, ring.sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQ_RING);
+    if (ring.sqRing == MAP_FAILED) {
+        ring.sqRing = NULL;
+        Ring_Destroy();
+        return false;
+    }
+    ring.cqRing = isSingleMap ? ring.sqRing :
+        mmap(NULL, ring.cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_CQ_RING);
+    ring.sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring.sqes = (struct io_uring_sqe*)mmap(NULL, ring.sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQES);
+    if (ring.cqRing == MAP_FAILED) ring.cqRing = NULL;
+    if (ring.sqes == MAP_FAILED) ring.sqes = NULL;
+    if (!ring.cqRing || !ring.sqes) {
+        Ring_Destroy();
+        return false;
+    }
+
+    uint8_t* sq = (uint8_t*)ring.sqRing;
+    ring.sqHead = (unsigned*)(sq + params.sq_off.head);
+    ring.sqTail = (unsigned*)(sq + params.sq_off.tail);
+    ring.sqArray = (unsigned*)(sq + params.sq_off.array);
+    ring.sqMask = *(unsigned*)(sq + params.sq_off.ring_mask);
+    ring.sqEntries = params.sq_entries;
+    ring.sqLocalTail = *ring.sqTail;
+
+    uint8_t* cq = (uint8_t*)ring.cqRing;
+    ring.cqHead = (unsigned*)(cq + params.cq_off.head);
+    ring.cqTail = (unsigned*)(cq + params.cq_off.tail);
+    ring.cqMask = *(unsigned*)(cq + params.cq_off.ring_mask);
+    ring.cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+
+    ring.wakeFd = eventfd(0, EFD_CLOEXEC);
+    ring.thread = ring.wakeFd >= 0 ? SDL_CreateThread(Ring_Thread, "AsyncIORing", NULL) : NULL;
+    if (!ring.thread) {
+        Ring_Destroy();
+        return false;
+    }
+    return true;
+}
+
+// Stop the ring thread once it has nothing in flight
+static void Ring_Stop() {
+    SDL_LockMutex(ioMutex);
+    ring.isStopping = true;
+    Ring_Wake();
+    SDL_UnlockMutex(ioMutex);
+
+    SDL_WaitThread(ring.thread, NULL);
+    Ring_Destroy();
+}
+#endif
+
+// Request Slots
+
+// Encode a slot as a handle (never ASYNC_IO_REQUEST_NONE: generations start at 1)
+static AsyncIORequest MakeHandle(int index) {
+    return ((AsyncIORequest)ops[index].generation << 16) | (AsyncIORequest)index;
+}
+
+// Look up a live request (ioMutex held)
+static AsyncIOOp* GetOp(AsyncIORequest request) {
+    uint32_t index = request & 0xFFFF;
+    if (index >= ASYNC_IO_MAX_REQUESTS) return NULL;
+    AsyncIOOp* op = &ops[index];
+    return op->isUsed && op->generation == (uint16_t)(request >> 16) ? op : NULL;
+}
+
+// Return a request slot to the free list (ioMutex held)
+static void ReleaseOp(AsyncIOOp* op) {
+    int index = (int)(op - ops);
+    op->isUsed = false;
+    op->generation = (uint16_t)(op->generation + 1);
+    if (op->generation == 0) op->generation = 1;
+    op->next = freeOpHead;
+    freeOpHead = index;
+}
+
+// Remove a request from its priority queue (ioMutex held)
+static void UnlinkPending(AsyncIOPriority priority, int index, int previous) {
+    int next = ops[index].next;
+    if (previous >= 0) ops[previous].next = next;
+    else queueHeads[priority] = next;
+    if (queueTails[priority] == index) queueTails[priority] = previous;
+    ops[index].next = -1;
+    ioStats.pending--;
+}
+
+// Host file behind a path: reads go through the VFS, writes to its writable mount
+static bool GetHostPath(const char* filepath, bool isWrite, char* hostPath) {
+    if (isWrite) return Vfs_GetWritePath(filepath, hostPath, VFS_MAX_PATH);
+
+    VfsResolution resolution;
+    if (!Vfs_Resolve(filepath, &resolution) || resolution.entry) return false; // Pack entries are not loose files
+    strcpy(hostPath, resolution.hostPath);
+    return true;
+}
+
+// Size of a loose file on disk
+static bool GetLooseFileSize(const char* filepath, uint64_t* outSize) {
+    char hostPath[VFS_MAX_PATH];
+    if (!GetHostPath(filepath, false, hostPath)) return false;
+#ifdef DREAMCAST
+    FILE* file = fopen(hostPath, "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    if (size < 0) return false;
+    *outSize = (uint64_t)size;
+    return true;
+#else
+    struct stat info;
+    if (stat(hostPath, &info) != 0) return false;
+    *outSize = (uint64_t)info.st_size;
+    return true;
+#endif
+}
+
+// Dispatch
+
+// Map request priorities onto the worker pool's
+static JobPriority GetJobPriority(AsyncIOPriority priority) {
+    switch (priority) {
+    case ASYNC_IO_PRIORITY_STREAMING: return JOB_PRIORITY_HIGH;
+    case ASYNC_IO_PRIORITY_BACKGROUND: return JOB_PRIORITY_LOW;
+    default: return JOB_PRIORITY_NORMAL;
+    }
+}
+
+// Merge pending reads that continue where the group ends (ioMutex held)
+static void CoalesceReads(AsyncIOGroup* group, size_t bytesInFlight) {
+    const AsyncIOOp* first = &ops[group->ops[0]];
+    bool isMerged = true;
+    while (isMerged && group->opCount < ASYNC_IO_MAX_COALESCE) {
+        isMerged = false;
+        uint64_t end = group->offset + group->total;
+
+        for (int priority = 0; priority < ASYNC_IO_PRIORITY_COUNT && !isMerged; ++priority) {
+            int previous = -1;
+            for (int index = queueHeads[priority]; index >= 0; previous = index, index = ops[index].next) {
+                AsyncIOOp* candidate = &ops[index];
+                if (candidate->isWrite || candidate->offset != end || candidate->pathHash != first->pathHash) continue;
+                if (bytesInFlight + group->total + candidate->size > maxBytesInFlight) continue;
+                if (strcmp(candidate->filepath, first->filepath) != 0) continue;
+
+                UnlinkPending((AsyncIOPriority)priority, index, previous);
+                group->ops[group->opCount++] = index;
+                group->total += candidate->size;
+                candidate->status = ASYNC_IO_IN_FLIGHT;
+                ioStats.coalesced++;
+                isMerged = true;
+                break;
+            }
+        }
+    }
+}
+
+static void RunGroupJob(void* data);
+
+// Issue queued requests, highest priority first, while the in-flight limits allow (ioMutex held)
+static void PumpQueue() {
+    while (requestsInFlight < maxRequestsInFlight) {
+        int priority = 0;
+        while (priority < ASYNC_IO_PRIORITY_COUNT && queueHeads[priority] < 0) priority++;
+        if (priority == ASYNC_IO_PRIORITY_COUNT) return;
+
+        // Lower priorities wait as well, so a large streaming read cannot be starved
+        int index = queueHeads[priority];
+        AsyncIOOp* op = &ops[index];
+        if (ioStats.bytesInFlight > 0 && ioStats.bytesInFlight + op->size > maxBytesInFlight) return;
+
+        AsyncIOGroup* group = NULL;
+        for (int i = 0; i < ASYNC_IO_MAX_GROUPS && !group; ++i) {
+            if (!groups[i].isUsed) group = &groups[i];
+        }
+        if (!group) return;
+
+        UnlinkPending((AsyncIOPriority)priority, index, -1);
+        memset(group, 0, sizeof(AsyncIOGroup));
+        group->isUsed = true;
+        group->ops[0] = index;
+        group->opCount = 1;
+        group->isWrite = op->isWrite;
+        group->writeFlags = op->writeFlags;
+        group->offset = op->offset;
+        group->total = op->size;
+        op->status = ASYNC_IO_IN_FLIGHT;
+        if (!op->isWrite) CoalesceReads(group, ioStats.bytesInFlight);
+
+        requestsInFlight++;
+        ioStats.bytesInFlight += group->total;
+        if (ioStats.bytesInFlight > ioStats.peakBytesInFlight) ioStats.peakBytesInFlight = ioStats.bytesInFlight;
+
+#ifdef ASYNC_IO_HAVE_URING
+        // Atomic replacement needs a rename, so it always runs on the pool
+        if (isRingActive && !(group->isWrite && (group->writeFlags & ASYNC_IO_WRITE_ATOMIC))) {
+            group->next = NULL;
+            if (ring.inboxTail) ring.inboxTail->next = group;
+            else ring.inbox = group;
+            ring.inboxTail = group;
+            Ring_Wake();
+            continue;
+        }
+#endif
+        if (!JobPool_Submit(ioPool, RunGroupJob, group, GetJobPriority(op->priority))) {
+            group->failed = true;
+            group->next = failedDispatches;
+            failedDispatches = group;
+        }
+    }
+}
+
+// Issue what the limits allow, then release ioMutex and fail anything that could not be dispatched
+static void PumpAndUnlock() {
+    PumpQueue();
+    AsyncIOGroup* failed = failedDispatches;
+    failedDispatches = NULL;
+    SDL_UnlockMutex(ioMutex);
+
+    while (failed) {
+        AsyncIOGroup* next = failed->next;
+        CompleteGroup(failed);
+        failed = next;
+    }
+}
+
+// Finish every request in a group and run their callbacks (any thread, ioMutex not held)
+static void CompleteGroup(AsyncIOGroup* group) {
+    AsyncIOCompletion completions[ASYNC_IO_MAX_COALESCE];
+    int completionCount = 0;
+
+    // Atomic writes were already invalidated by File_WriteAtomic
+    if (group->isWrite && !group->failed && !(group->writeFlags & ASYNC_IO_WRITE_ATOMIC)) {
+        Vfs_Invalidate(ops[group->ops[0]].filepath);
+    }
+
+    SDL_LockMutex(ioMutex);
+    size_t remaining = group->done;
+    for (int i = 0; i < group->opCount; ++i) {
+        AsyncIOOp* op = &ops[group->ops[i]];
+        op->bytes = remaining < op->size ? remaining : op->size;
+        remaining -= op->bytes;
+        op->status = group->failed ? ASYNC_IO_FAILED : ASYNC_IO_COMPLETE;
+
+        if (group->failed) {
+            ioStats.failed++;
+            if (op->ownsBuffer) {
+                free(op->buffer);
+                op->buffer = NULL;
+            }
+        }
+        else {
+            ioStats.completed++;
+            if (op->isWrite) ioStats.bytesWritten += op->bytes;
+            else ioStats.bytesRead += op->bytes;
+        }
+
+        if (op->callback) {
+            AsyncIOCompletion* completion = &completions[completionCount++];
+            completion->request = MakeHandle(group->ops[i]);
+            completion->status = (AsyncIOStatus)op->status;
+            completion->buffer = op->buffer;
+            completion->bytes = op->bytes;
+            completion->callback = op->callback;
+            completion->userData = op->userData;
+            ReleaseOp(op);
+        }
+        else {
+            activeCount--; // Reported through AsyncIO_Wait
+        }
+    }
+
+    requestsInFlight--;
+    ioStats.bytesInFlight -= group->total;
+    group->isUsed = false;
+    SDL_CondBroadcast(ioCond);
+    PumpAndUnlock();
+
+    for (int i = 0; i < completionCount; ++i) {
+        AsyncIOCompletion* completion = &completions[i];
+        completion->callback(completion->request, completion->status, completion->buffer, completion->bytes, completion->userData);
+    }
+
+    if (completionCount > 0) {
+        SDL_LockMutex(ioMutex);
+        activeCount -= completionCount;
+        SDL_CondBroadcast(ioCond);
+        SDL_UnlockMutex(ioMutex);
+    }
+}
+
+// Transfers
+
+// Allocate buffers for reads that asked for one (I/O thread)
+static bool AllocateReadBuffers(AsyncIOGroup* group) {
+    for (int i = 0; i < group->opCount; ++i) {
+        AsyncIOOp* op = &ops[group->ops[i]];
+        if (!op->ownsBuffer || op->buffer || op->size == 0) continue;
+        op->buffer = (uint8_t*)malloc(op->size);
+        if (!op->buffer) return false;
+    }
+    return true;
+}
+
+#ifdef ASYNC_IO_HAVE_PREAD
+// Open the file a group transfers to or from (-1 on failure)
+static int OpenGroupFile(const AsyncIOGroup* group) {
+    char hostPath[VFS_MAX_PATH];
+    if (!GetHostPath(ops[group->ops[0]].filepath, group->isWrite, hostPath)) return -1;
+    if (!group->isWrite) return open(hostPath, O_RDONLY | O_CLOEXEC);
+
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+    if (group->writeFlags & ASYNC_IO_WRITE_TRUNCATE) flags |= O_TRUNC;
+    return open(hostPath, flags, 0644);
+}
+
+// Blocking transfer with positional reads and writes (worker thread)
+static void TransferGroup(AsyncIOGroup* group) {
+    int fd = OpenGroupFile(group);
+    if (fd < 0) {
+        group->failed = true;
+        return;
+    }
+
+    bool isEndOfFile = false;
+    for (int i = 0; i < group->opCount && !isEndOfFile && !group->failed; ++i) {
+        AsyncIOOp* op = &ops[group->ops[i]];
+        size_t transferred = 0;
+        while (transferred < op->size) {
+            off_t position = (off_t)(op->offset + transferred);
+            ssize_t count = group->isWrite
+                ? pwrite(fd, op->buffer + transferred, op->size - transferred, position)
+                : pread(fd, op->buffer + transferred, op->size - transferred, position);
+            if (count < 0 && errno == EINTR) continue;
+            if (count < 0 || (count == 0 && group->isWrite)) {
+                group->failed = true;
+                break;
+            }
+            if (count == 0) {
+                isEndOfFile = true;
+                break;
+            }
+            transferred += (size_t)count;
+        }
+        group->done += transferred;
+    }
+
+    if (group->isWrite && (group->writeFlags & ASYNC_IO_WRITE_SYNC) && !group->failed && fsync(fd) != 0) {
+        group->failed = true;
+    }
+    close(fd);
+}
+#else
+// Blocking transfer through stdio (worker thread)
+static void TransferGroup(AsyncIOGroup* group) {
+    char hostPath[VFS_MAX_PATH];
+    FILE* file = NULL;
+    if (!GetHostPath(ops[group->ops[0]].filepath, group->isWrite, hostPath)) {
+        group->failed = true;
+        return;
+    }
+
+    if (!group->isWrite) {
+        file = fopen(hostPath, "rb");
+    }
+    else if (group->writeFlags & ASYNC_IO_WRITE_TRUNCATE) {
+        file = fopen(hostPath, "wb");
+    }
+    else {
+        file = fopen(hostPath, "r+b"); // Keep existing contents around the write
+        if (!file) file = fopen(hostPath, "wb");
+    }
+    if (!file) {
+        group->failed = true;
+        return;
+    }
+
+#ifdef _WIN32
+    bool isPositioned = _fseeki64(file, (__int64)group->offset, SEEK_SET) == 0;
+#else
+    bool isPositioned = fseek(file, (long)group->offset, SEEK_SET) == 0;
+#endif
+
+    // Grouped requests are contiguous, so one pass covers them all
+    for (int i = 0; i < group->opCount && isPositioned; ++i) {
+        AsyncIOOp* op = &ops[group->ops[i]];
+        size_t count = group->isWrite ? fwrite(op->buffer, 1, op->size, file) : fread(op->buffer, 1, op->size, file);
+        group->done += count;
+        if (count < op->size) break;
+    }
+
+    if (!isPositioned || ferror(file) || (group->isWrite && group->done < group->total)) group->failed = true;
+    if (group->isWrite && (group->writeFlags & ASYNC_IO_WRITE_SYNC) && !group->failed && !File_Sync(file)) group->failed = true;
+    if (fclose(file) != 0 && group->isWrite) group->failed = true;
+}
+#endif
+
+// Worker pool job: run a group to completion
+static void RunGroupJob(void* data) {
+    AsyncIOGroup* group = (AsyncIOGroup*)data;
+    const AsyncIOOp* first = &ops[group->ops[0]];
+    PROFILE_BEGIN("AsyncIO_Transfer");
+
+    if (!AllocateReadBuffers(group)) {
+        group->failed = true;
+    }
+    else if (group->isWrite && (group->writeFlags & ASYNC_IO_WRITE_ATOMIC)) {
+        group->failed = !File_WriteAtomic(first->filepath, first->buffer, first->size);
+        group->done = group->failed ? 0 : group->total;
+    }
+    else {
+        TransferGroup(group);
+    }
+    PROFILE_END();
+    CompleteGroup(group);
+}
+
+// System Management
+
+// Start the I/O threads
+bool AsyncIO_Init(const AsyncIOConfig* config) {
+    if (isRunning) return true;
+
+    AsyncIOConfig settings = { 0 };
+    if (config) settings = *config;
+    maxBytesInFlight = settings.maxBytesInFlight > 0 ? settings.maxBytesInFlight : ASYNC_IO_DEFAULT_BYTES_IN_FLIGHT;
+    maxRequestsInFlight = settings.maxRequestsInFlight > 0 ? settings.maxRequestsInFlight : ASYNC_IO_DEFAULT_REQUESTS_IN_FLIGHT;
+    if (maxRequestsInFlight > ASYNC_IO_MAX_GROUPS) maxRequestsInFlight = ASYNC_IO_MAX_GROUPS;
+    int workerThreads = settings.workerThreads > 0 ? settings.workerThreads : ASYNC_IO_DEFAULT_THREADS;
+
+    memset(ops, 0, sizeof(ops));
+    memset(groups, 0, sizeof(groups));
+    for (int i = 0; i < ASYNC_IO_MAX_REQUESTS; ++i) {
+        ops[i].generation = 1;
+        ops[i].next = i + 1 < ASYNC_IO_MAX_REQUESTS ? i + 1 : -1;
+    }
+    freeOpHead = 0;
+    for (int i = 0; i < ASYNC_IO_PRIORITY_COUNT; ++i) {
+        queueHeads[i] = queueTails[i] = -1;
+    }
+    failedDispatches = NULL;
+    requestsInFlight = 0;
+    activeCount = 0;
+    memset(&ioStats, 0, sizeof(ioStats));
+    ioStats.backend = "threads";
+
+    ioMutex = SDL_CreateMutex();
+    ioCond = SDL_CreateCond();
+    if (!ioMutex || !ioCond) {
+        printf("Failed to initialize async I/O.\n");
+        if (ioMutex) SDL_DestroyMutex(ioMutex);
+        if (ioCond) SDL_DestroyCond(ioCond);
+        ioMutex = NULL;
+        ioCond = NULL;
+        return false;
+    }
+
+#ifdef ASYNC_IO_HAVE_URING
+    isRingActive = Ring_Start();
+    if (isRingActive) {
+        ioStats.backend = "io_uring";
+        workerThreads = 1; // Only atomic replacements run on the pool
+    }
+    else {
+        printf("io_uring unavailable; async I/O falls back to worker threads.\n");
+    }
+#endif
+
+    ioPool = JobPool_Create("AsyncIO", workerThreads);
+    if (!ioPool) {
+        printf("Failed to start the async I/O threads.\n");
+#ifdef ASYNC_IO_HAVE_URING
+        if (isRingActive) Ring_Stop();
+        isRingActive = false;
+#endif
+        SDL_DestroyMutex(ioMutex);
+        SDL_DestroyCond(ioCond);
+        ioMutex = NULL;
+        ioCond = NULL;
+        return false;
+    }
+
+    isRunning = true;
+    printf("Async I/O initialized (%s backend).\n", ioStats.backend);
+    return true;
+}
+
+// Finish outstanding requests and stop the I/O threads
+void AsyncIO_Shutdown() {
+    if (!isRunning) return;
+    AsyncIO_WaitIdle();
+
+#ifdef ASYNC_IO_HAVE_URING
+    if (isRingActive) Ring_Stop();
+    isRingActive = false;
+#endif
+    JobPool_Destroy(ioPool);
+    ioPool = NULL;
+
+    // Polled requests nobody waited for: hand back the buffers allocated for them
+    for (int i = 0; i < ASYNC_IO_MAX_REQUESTS; ++i) {
+        if (ops[i].isUsed && ops[i].ownsBuffer) free(ops[i].buffer);
+    }
+    memset(ops, 0, sizeof(ops));
+
+    SDL_DestroyMutex(ioMutex);
+    SDL_DestroyCond(ioCond);
+    ioMutex = NULL;
+    ioCond = NULL;
+    isRunning = false;
+    printf("Async I/O shut down.\n");
+}
+
+// Check whether requests can be submitted
+bool AsyncIO_IsRunning() {
+    return isRunning;
+}
+
+// Submission
+
+// Queue one read
+AsyncIORequest AsyncIO_Read(const char* filepath, uint64_t offset, void* buffer, size_t size,
+    AsyncIOPriority priority, AsyncIOCallback callback, void* userData) {
+    AsyncIORequestDesc desc = { filepath, offset, buffer, size, false, 0, priority, callback, userData };
+    AsyncIORequest request = ASYNC_IO_REQUEST_NONE;
+    AsyncIO_SubmitBatch(&desc, 1, &request);
+    return request;
+}
+
+// Queue one write
+AsyncIORequest AsyncIO_Write(const char* filepath, uint64_t offset, const void* data, size_t size, uint32_t flags,
+    AsyncIOPriority priority, AsyncIOCallback callback, void* userData) {
+    AsyncIORequestDesc desc = { filepath, offset, (void*)data, size, true, flags, priority, callback, userData };
+    AsyncIORequest request = ASYNC_IO_REQUEST_NONE;
+    AsyncIO_SubmitBatch(&desc, 1, &request);
+    return request;
+}
+
+// Queue several requests under one lock; rejected entries get ASYNC_IO_REQUEST_NONE
+int AsyncIO_SubmitBatch(const AsyncIORequestDesc* requests, int count, AsyncIORequest* outRequests) {
+    if (!requests || count <= 0) return 0;
+    if (!isRunning) {
+        if (outRequests) memset(outRequests, 0, sizeof(AsyncIORequest) * (size_t)count);
+        return 0;
+    }
+
+    // Whole-file reads are sized before taking the lock
+    uint64_t* sizes = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)count);
+    if (!sizes) return 0;
+    for (int i = 0; i < count; ++i) {
+        const AsyncIORequestDesc* desc = &requests[i];
+        sizes[i] = desc->size;
+        if (!desc->isWrite && desc->size == 0 && desc->filepath) {
+            uint64_t fileSize = 0;
+            sizes[i] = GetLooseFileSize(desc->filepath, &fileSize) && fileSize > desc->offset
+                ? fileSize - desc->offset : 0;
+            if (sizes[i] > (uint64_t)(size_t)-1) sizes[i] = 0; // Larger than this platform can hold
+        }
+    }
+
+    int submitted = 0;
+    SDL_LockMutex(ioMutex);
+    for (int i = 0; i < count; ++i) {
+        const AsyncIORequestDesc* desc = &requests[i];
+        if (outRequests) outRequests[i] = ASYNC_IO_REQUEST_NONE;
+
+        // Reads to the end of a file need a buffer allocated for them; writes need their data
+        bool isValid = desc->filepath && strlen(desc->filepath) < ASYNC_IO_PATH_MAX &&
+            (desc->isWrite ? (desc->buffer || desc->size == 0) : (!desc->buffer || desc->size > 0));
+        if (!isValid) continue;
+        if (freeOpHead < 0) {
+            printf("Async I/O queue is full (%d requests).\n", ASYNC_IO_MAX_REQUESTS);
+            break;
+        }
+
+        int index = freeOpHead;
+        AsyncIOOp* op = &ops[index];
+        freeOpHead = op->next;
+
+        op->isUsed = true;
+        op->status = ASYNC_IO_PENDING;
+        op->isWrite = desc->isWrite;
+        op->ownsBuffer = !desc->isWrite && !desc->buffer;
+        op->writeFlags = desc->isWrite ? desc->writeFlags : 0;
+        op->priority = desc->priority >= 0 && desc->priority < ASYNC_IO_PRIORITY_COUNT ? desc->priority : ASYNC_IO_PRIORITY_NORMAL;
+        strcpy(op->filepath, desc->filepath);
+        op->pathHash = Hash_String(desc->filepath);
+        op->offset = (op->writeFlags & ASYNC_IO_WRITE_ATOMIC) ? 0 : desc->offset;
+        op->buffer = (uint8_t*)desc->buffer;
+        op->size = (size_t)sizes[i];
+        op->bytes = 0;
+        op->callback = desc->callback;
+        op->userData = desc->userData;
+        op->next = -1;
+
+        if (queueTails[op->priority] >= 0) ops[queueTails[op->priority]].next = index;
+        else queueHeads[op->priority] = index;
+        queueTails[op->priority] = index;
+
+        ioStats.pending++;
+        ioStats.submitted++;
+        activeCount++;
+        if (outRequests) outRequests[i] = MakeHandle(index);
+        submitted++;
+    }
+    PumpAndUnlock();
+
+    free(sizes);
+    return submitted;
+}
+
+// Completion
+
+// Get a request's current state
+AsyncIOStatus AsyncIO_GetStatus(AsyncIORequest request) {
+    if (!isRunning) return ASYNC_IO_INVALID;
+    SDL_LockMutex(ioMutex);
+    AsyncIOOp* op = GetOp(request);
+    AsyncIOStatus status = op ? (AsyncIOStatus)op->status : ASYNC_IO_INVALID;
+    SDL_UnlockMutex(ioMutex);
+    return status;
+}
+
+// Block until a polled request finishes, then release it
+AsyncIOStatus AsyncIO_Wait(AsyncIORequest request, void** outBuffer, size_t* outBytes) {
+    if (outBuffer) *outBuffer = NULL;
+    if (outBytes) *outBytes = 0;
+    if (!isRunning) return ASYNC_IO_INVALID;
+
+    SDL_LockMutex(ioMutex);
+    AsyncIOOp* op = GetOp(request);
+    if (!op || op->callback) {
+        SDL_UnlockMutex(ioMutex);
+        return ASYNC_IO_INVALID; // Callback requests are released when their callback returns
+    }
+
+    while (op->status == ASYNC_IO_PENDING || op->status == ASYNC_IO_IN_FLIGHT) {
+        SDL_CondWait(ioCond, ioMutex);
+    }
+
+    AsyncIOStatus status = (AsyncIOStatus)op->status;
+    if (outBuffer) *outBuffer = op->buffer;
+    else if (op->ownsBuffer) free(op->buffer);
+    if (outBytes) *outBytes = op->bytes;
+    ReleaseOp(op);
+    SDL_UnlockMutex(ioMutex);
+    return status;
+}
+
+// Cancel a request that has not been issued yet; its callback reports ASYNC_IO_CANCELLED from here
+bool AsyncIO_Cancel(AsyncIORequest request) {
+    if (!isRunning) return false;
+
+    SDL_LockMutex(ioMutex);
+    AsyncIOOp* op = GetOp(request);
+    if (!op || op->status != ASYNC_IO_PENDING) {
+        SDL_UnlockMutex(ioMutex);
+        return false;
+    }
+
+    int index = (int)(op - ops);
+    int previous = -1;
+    for (int i = queueHeads[op->priority]; i >= 0 && i != index; i = ops[i].next) previous = i;
+    UnlinkPending(op->priority, index, previous);
+    op->status = ASYNC_IO_CANCELLED;
+
+    AsyncIOCallback callback = op->callback;
+    void* userData = op->userData;
+    if (callback) ReleaseOp(op);
+    else activeCount--;
+    SDL_CondBroadcast(ioCond);
+    SDL_UnlockMutex(ioMutex);
+
+    if (callback) {
+        callback(request, ASYNC_IO_CANCELLED, NULL, 0, userData);
+        SDL_LockMutex(ioMutex);
+        activeCount--;
+        SDL_CondBroadcast(ioCond);
+        SDL_UnlockMutex(ioMutex);
+    }
+    return true;
+}
+
+// Block until every submitted request has completed and its callback has returned
+void AsyncIO_WaitIdle() {
+    if (!isRunning) return;
+    SDL_LockMutex(ioMutex);
+    while (activeCount > 0) {
+        SDL_CondWait(ioCond, ioMutex);
+    }
+    SDL_UnlockMutex(ioMutex);
+}
+
+// Get queue and throughput statistics
+AsyncIOStats AsyncIO_GetStats() {
+    AsyncIOStats stats = { 0 };
+    stats.backend = "threads";
+    if (!isRunning) return stats;
+
+    SDL_LockMutex(ioMutex);
+    stats = ioStats;
+    SDL_UnlockMutex(ioMutex);
+    return stats;
+}
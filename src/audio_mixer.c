@@ -0,0 +1,635 @@
+// audio_mixer.c
+#include "audio_mixer.h"
+#include "profiler.h" // For mix zones
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_MIXER_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(AUDIO_MIXER_SSE2) && defined(__GNUC__)
+#define AUDIO_MIXER_AVX2 // Built with a per-function target and picked at runtime
+#include <immintrin.h>
+#endif
+
+#define MIX_CHUNK_FRAMES 4096        // Accumulator size; longer buffers are mixed in chunks
+#define DEFAULT_MIN_DISTANCE 1.0f
+#define DEFAULT_MAX_DISTANCE 30.0f
+#define COST_AVERAGE_WEIGHT 0.05f
+#define RESAMPLER_LOOKAHEAD 16       // Extra source frames fed so the resampler can produce a whole run
+
+// Emitter (main thread)
+typedef struct {
+    AudioSoundID sound;
+    Vector3 position;
+    float volume;
+    float minDistance;
+    float maxDistance;
+    float pitch;             // Playback rate (1 plays at the mixer rate)
+    bool loop;
+    bool isActive;
+    uint32_t generation;     // Bumped on every play so old handles go stale
+    int activeIndex;         // Position in activeEmitters
+} Emitter;
+
+// Emitter as published to the audio thread
+typedef struct {
+    int emitter;
+    uint32_t generation;
+    const int16_t* samples;  // Interleaved stereo S16
+    uint32_t frameCount;
+    int sourceRate;          // Rate the samples are read at; differs from the mixer's when pitched
+    bool loop;
+    float gainLeft;          // 0 for culled emitters, which still advance so they finish on time
+    float gainRight;
+} MixVoice;
+
+// Playback state of an emitter (audio thread)
+typedef struct {
+    uint32_t generation;     // Play the cursor belongs to
+    uint32_t cursor;         // Next frame
+    float gainLeft;          // Gains reached at the end of the last buffer (start of the next ramp)
+    float gainRight;
+    SDL_AudioStream* converter; // Resampler for pitched plays (created on first use)
+    int converterRate;       // Source rate the converter was built for
+    bool isFlushed;          // Converter flushed after the last source frame
+} EmitterPlayback;
+
+// Mix kernels: accumulate gain-ramped stereo S16 into floats, then add the floats to the output with saturation
+typedef void (*MixKernel)(float* accumulator, const int16_t* samples, int frames,
+    float gainLeft, float gainRight, float stepLeft, float stepRight);
+typedef void (*ResolveKernel)(int16_t* output, const float* accumulator, int samples);
+
+static bool isInitialized = false;
+static int mixerFrequency = 0;
+static MixKernel mixKernel = NULL;
+static ResolveKernel resolveKernel = NULL;
+
+// Main thread state
+static Emitter emitters[AUDIO_MIXER_MAX_EMITTERS];
+static int activeEmitters[AUDIO_MIXER_MAX_EMITTERS];
+static int activeCount = 0;
+static int freeEmitters[AUDIO_MIXER_MAX_EMITTERS];
+static int freeCount = 0;
+static MixVoice candidates[AUDIO_MIXER_MAX_EMITTERS];
+static Vector3 listenerPosition = { 0.0f, 0.0f, 0.0f };
+static Vector3 listenerRight = { 1.0f, 0.0f, 0.0f };
+
+// Shared with the audio thread
+static MixVoice publishedVoices[AUDIO_MIXER_MAX_EMITTERS];
+static int publishedCount = 0;
+static SDL_SpinLock publishLock = 0;
+static SDL_atomic_t finishedGenerations[AUDIO_MIXER_MAX_EMITTERS]; // Set by the audio thread when a one-shot ends
+static AudioMixerStats stats;
+static SDL_SpinLock statsLock = 0;
+
+// Audio thread state
+static MixVoice mixVoices[AUDIO_MIXER_MAX_EMITTERS];
+static EmitterPlayback playbacks[AUDIO_MIXER_MAX_EMITTERS];
+static float* mixBuffer = NULL;       // Float accumulator for one chunk
+static int16_t* resampled = NULL;     // Converter output for one chunk
+
+// Scalar Kernels
+static void MixScalar(float* accumulator, const int16_t* samples, int frames,
+    float gainLeft, float gainRight, float stepLeft, float stepRight) {
+    for (int i = 0; i < frames; ++i) {
+        accumulator[i * 2] += samples[i * 2] * gainLeft;
+        accumulator[i * 2 + 1] += samples[i * 2 + 1] * gainRight;
+        gainLeft += stepLeft;
+        gainRight += stepRight;
+    }
+}
+
+static void ResolveScalar(int16_t* output, const float* accumulator, int samples) {
+    for (int i = 0; i < samples; ++i) {
+        // Same rounding and saturation order as the SIMD paths
+        float mixed = accumulator[i] > 32767.0f ? 32767.0f : (accumulator[i] < -32768.0f ? -32768.0f : accumulator[i]);
+        int value = output[i] + (int)lrintf(mixed);
+        output[i] = (int16_t)(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+    }
+}
+
+#ifdef AUDIO_MIXER_SSE2
+// SSE2 Kernels (4 frames per iteration)
+static void MixSSE2(float* accumulator, const int16_t* samples, int frames,
+    float gainLeft, float gainRight, float stepLeft, float stepRight) {
+    __m128 gain = _mm_setr_ps(gainLeft, gainRight, gainLeft + stepLeft, gainRight + stepRight);
+    __m128 step = _mm_setr_ps(stepLeft * 2.0f, stepRight * 2.0f, stepLeft * 2.0f, stepRight * 2.0f);
+    int i = 0;
+
+    for (; i + 4 <= frames; i += 4) {
+        __m128i pcm = _mm_loadu_si128((const __m128i*)(samples + i * 2));
+        __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(pcm, pcm), 16)); // Sign-extend
+        __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(pcm, pcm), 16));
+
+        _mm_storeu_ps(accumulator + i * 2, _mm_add_ps(_mm_loadu_ps(accumulator + i * 2), _mm_mul_ps(low, gain)));
+        gain = _mm_add_ps(gain, step);
+        _mm_storeu_ps(accumulator + i * 2 + 4, _mm_add_ps(_mm_loadu_ps(accumulator + i * 2 + 4), _mm_mul_ps(high, gain)));
+        gain = _mm_add_ps(gain, step);
+    }
+
+    float tail[4];
+    _mm_storeu_ps(tail, gain);
+    MixScalar(accumulator + i * 2, samples + i * 2, frames - i, tail[0], tail[1], stepLeft, stepRight);
+}
+
+static void ResolveSSE2(int16_t* output, const float* accumulator, int samples) {
+    int i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        __m128i low = _mm_cvtps_epi32(_mm_loadu_ps(accumulator + i));
+        __m128i high = _mm_cvtps_epi32(_mm_loadu_ps(accumulator + i + 4));
+        __m128i mixed = _mm_packs_epi32(low, high);
+        __m128i existing = _mm_loadu_si128((const __m128i*)(output + i));
+        _mm_storeu_si128((__m128i*)(output + i), _mm_adds_epi16(existing, mixed));
+    }
+    ResolveScalar(output + i, accumulator + i, samples - i);
+}
+#endif
+
+#ifdef AUDIO_MIXER_AVX2
+// AVX2 Kernels (8 frames per iteration)
+__attribute__((target("avx2")))
+static void MixAVX2(float* accumulator, const int16_t* samples, int frames,
+    float gainLeft, float gainRight, float stepLeft, float stepRight) {
+    __m256 gain = _mm256_setr_ps(gainLeft, gainRight, gainLeft + stepLeft, gainRight + stepRight,
+        gainLeft + stepLeft * 2.0f, gainRight + stepRight * 2.0f, gainLeft + stepLeft * 3.0f, gainRight + stepRight * 3.0f);
+    __m256 step = _mm256_setr_ps(stepLeft * 4.0f, stepRight * 4.0f, stepLeft * 4.0f, stepRight * 4.0f,
+        stepLeft * 4.0f, stepRight * 4.0f, stepLeft * 4.0f, stepRight * 4.0f);
+    int i = 0;
+
+    for (; i + 8 <= frames; i += 8) {
+        __m256 low = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(samples + i * 2))));
+        __m256 high = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(samples + i * 2 + 8))));
+
+        _mm256_storeu_ps(accumulator + i * 2, _mm256_add_ps(_mm256_loadu_ps(accumulator + i * 2), _mm256_mul_ps(low, gain)));
+        gain = _mm256_add_ps(gain, step);
+        _mm256_storeu_ps(accumulator + i * 2 + 8, _mm256_add_ps(_mm256_loadu_ps(accumulator + i * 2 + 8), _mm256_mul_ps(high, gain)));
+        gain = _mm256_add_ps(gain, step);
+    }
+
+    float tail[8];
+    _mm256_storeu_ps(tail, gain);
+    MixScalar(accumulator + i * 2, samples + i * 2, frames - i, tail[0], tail[1], stepLeft, stepRight);
+}
+
+__attribute__((target("avx2")))
+static void ResolveAVX2(int16_t* output, const float* accumulator, int samples) {
+    int i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m256i low = _mm256_cvtps_epi32(_mm256_loadu_ps(accumulator + i));
+        __m256i high = _mm256_cvtps_epi32(_mm256_loadu_ps(accumulator + i + 8));
+        __m256i mixed = _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8); // packs works per 128-bit lane
+        __m256i existing = _mm256_loadu_si256((const __m256i*)(output + i));
+        _mm256_storeu_si256((__m256i*)(output + i), _mm256_adds_epi16(existing, mixed));
+    }
+    ResolveScalar(output + i, accumulator + i, samples - i);
+}
+#endif
+
+// Get a converter from the voice's source rate to the mixer rate (audio thread)
+static SDL_AudioStream* GetConverter(EmitterPlayback* playback, int sourceRate) {
+    if (playback->converter && playback->converterRate == sourceRate) return playback->converter;
+
+    SDL_FreeAudioStream(playback->converter);
+    playback->converter = SDL_NewAudioStream(AUDIO_S16SYS, 2, sourceRate, AUDIO_S16SYS, 2, mixerFrequency);
+    playback->converterRate = sourceRate;
+    playback->isFlushed = false;
+    return playback->converter;
+}
+
+// Pull resampled frames for a pitched voice; fewer than asked for once a one-shot has drained
+static int PullResampled(SDL_AudioStream* converter, const MixVoice* voice, EmitterPlayback* playback,
+    int16_t* output, int frames) {
+    const int frameBytes = (int)(sizeof(int16_t) * 2);
+    int produced = 0;
+
+    while (produced < frames) {
+        int got = SDL_AudioStreamGet(converter, output + produced * 2, (frames - produced) * frameBytes);
+        if (got < 0) break;
+        produced += got / frameBytes;
+        if (produced >= frames) break;
+
+        if (playback->cursor >= voice->frameCount) {
+            if (voice->loop && voice->frameCount > 0) {
+                playback->cursor = 0;
+            }
+            else if (!playback->isFlushed) {
+                SDL_AudioStreamFlush(converter); // Push out the resampler's tail
+                playback->isFlushed = true;
+                continue;
+            }
+            else {
+                break;
+            }
+        }
+
+        // Feed roughly what the rest of the run needs at this rate
+        uint32_t feed = (uint32_t)((int64_t)(frames - produced) * voice->sourceRate / mixerFrequency) + RESAMPLER_LOOKAHEAD;
+        if (feed > voice->frameCount - playback->cursor) feed = voice->frameCount - playback->cursor;
+        if (SDL_AudioStreamPut(converter, voice->samples + (size_t)playback->cursor * 2, (int)feed * frameBytes) != 0) break;
+        playback->cursor += feed;
+    }
+    return produced;
+}
+
+// Post-mix callback (audio thread): adds every published emitter on top of SDL_mixer's output
+static void SDLCALL MixEmitters(void* userData, Uint8* stream, int length) {
+    (void)userData;
+    PROFILE_BEGIN("AudioMixer_MixEmitters");
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    SDL_AtomicLock(&publishLock);
+    int count = publishedCount;
+    memcpy(mixVoices, publishedVoices, sizeof(MixVoice) * count);
+    SDL_AtomicUnlock(&publishLock);
+
+    int16_t* output = (int16_t*)stream;
+    int totalFrames = length / (int)(sizeof(int16_t) * 2);
+
+    for (int i = 0; i < count; ++i) {
+        MixVoice* voice = &mixVoices[i];
+        EmitterPlayback* playback = &playbacks[voice->emitter];
+        if (playback->generation != voice->generation) {
+            // New play: start at the target gains rather than ramping from the previous sound
+            playback->generation = voice->generation;
+            playback->cursor = 0;
+            playback->gainLeft = voice->gainLeft;
+            playback->gainRight = voice->gainRight;
+            playback->isFlushed = false;
+            if (playback->converter) SDL_AudioStreamClear(playback->converter);
+        }
+    }
+
+    for (int chunkStart = 0; chunkStart < totalFrames; chunkStart += MIX_CHUNK_FRAMES) {
+        int frames = totalFrames - chunkStart < MIX_CHUNK_FRAMES ? totalFrames - chunkStart : MIX_CHUNK_FRAMES;
+        bool hasAudio = false;
+        memset(mixBuffer, 0, sizeof(float) * frames * 2);
+
+        for (int i = 0; i < count; ++i) {
+            MixVoice* voice = &mixVoices[i];
+            EmitterPlayback* playback = &playbacks[voice->emitter];
+
+            // Ramp linearly to the new gains across the whole buffer (no zipper noise)
+            float stepLeft = (voice->gainLeft - playback->gainLeft) / totalFrames;
+            float stepRight = (voice->gainRight - playback->gainRight) / totalFrames;
+            bool isAudible = voice->gainLeft > 0.0f || voice->gainRight > 0.0f ||
+                playback->gainLeft > 0.0f || playback->gainRight > 0.0f;
+            bool isPitched = voice->sourceRate != mixerFrequency;
+
+            // Pitched: resample through SDL's converter, then mix the result like any other run
+            SDL_AudioStream* converter = isPitched && isAudible ? GetConverter(playback, voice->sourceRate) : NULL;
+            if (converter) {
+                int produced = PullResampled(converter, voice, playback, resampled, frames);
+                if (produced > 0) {
+                    mixKernel(mixBuffer, resampled, produced, playback->gainLeft + stepLeft * chunkStart,
+                        playback->gainRight + stepRight * chunkStart, stepLeft, stepRight);
+                    hasAudio = true;
+                }
+                if (produced < frames) {
+                    SDL_AtomicSet(&finishedGenerations[voice->emitter], (int)voice->generation);
+                }
+                continue;
+            }
+            if (playback->converter) {
+                SDL_AudioStreamClear(playback->converter); // Culled or unpitched: drop what was buffered ahead
+                playback->isFlushed = false;
+            }
+
+            // Culled pitched voices advance by the source frames they would have consumed
+            int sourceFrames = isPitched ? (int)((int64_t)frames * voice->sourceRate / mixerFrequency) : frames;
+            int done = 0;
+            while (done < sourceFrames) {
+                if (playback->cursor >= voice->frameCount) {
+                    if (!voice->loop || voice->frameCount == 0) {
+                        SDL_AtomicSet(&finishedGenerations[voice->emitter], (int)voice->generation);
+                        break;
+                    }
+                    playback->cursor = 0;
+                }
+
+                int run = sourceFrames - done;
+                if ((uint32_t)run > voice->frameCount - playback->cursor) run = (int)(voice->frameCount - playback->cursor);
+                if (isAudible) {
+                    int offset = chunkStart + done;
+                    mixKernel(mixBuffer + done * 2, voice->samples + (size_t)playback->cursor * 2, run,
+                        playback->gainLeft + stepLeft * offset, playback->gainRight + stepRight * offset, stepLeft, stepRight);
+                    hasAudio = true;
+                }
+                playback->cursor += (uint32_t)run;
+                done += run;
+            }
+        }
+
+        if (hasAudio) {
+            resolveKernel(output + chunkStart * 2, mixBuffer, frames * 2);
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        playbacks[mixVoices[i].emitter].gainLeft = mixVoices[i].gainLeft;
+        playbacks[mixVoices[i].emitter].gainRight = mixVoices[i].gainRight;
+    }
+
+    // Mix cost against the buffer's duration
+    float elapsed = (float)((double)(SDL_GetPerformanceCounter() - start) * 1000000.0 / (double)SDL_GetPerformanceFrequency());
+    SDL_AtomicLock(&statsLock);
+    stats.lastMixMicroseconds = elapsed;
+    stats.averageMixMicroseconds += (elapsed - stats.averageMixMicroseconds) * COST_AVERAGE_WEIGHT;
+    if (elapsed > stats.peakMixMicroseconds) stats.peakMixMicroseconds = elapsed;
+    stats.bufferMicroseconds = totalFrames * 1000000.0f / mixerFrequency;
+    SDL_AtomicUnlock(&statsLock);
+    PROFILE_END();
+}
+
+// Initialize the mixer stage (after Mix_OpenAudio)
+bool AudioMixer_Init() {
+    if (isInitialized) return true;
+
+    Uint16 format = 0;
+    int channels = 0;
+    if (!Mix_QuerySpec(&mixerFrequency, &format, &channels) || format != AUDIO_S16SYS || channels != 2) {
+        printf("Positional audio needs a 16-bit stereo mixer.\n");
+        return false;
+    }
+
+    mixBuffer = (float*)malloc(sizeof(float) * MIX_CHUNK_FRAMES * 2);
+    resampled = (int16_t*)malloc(sizeof(int16_t) * MIX_CHUNK_FRAMES * 2);
+    if (!mixBuffer || !resampled) {
+        free(mixBuffer);
+        free(resampled);
+        mixBuffer = NULL;
+        resampled = NULL;
+        return false;
+    }
+
+    memset(emitters, 0, sizeof(emitters));
+    memset(playbacks, 0, sizeof(playbacks));
+    memset(&stats, 0, sizeof(stats));
+    for (int i = 0; i < AUDIO_MIXER_MAX_EMITTERS; ++i) {
+        freeEmitters[i] = AUDIO_MIXER_MAX_EMITTERS - 1 - i;
+        SDL_AtomicSet(&finishedGenerations[i], 0);
+    }
+    freeCount = AUDIO_MIXER_MAX_EMITTERS;
+    activeCount = 0;
+    publishedCount = 0;
+
+    mixKernel = MixScalar;
+    resolveKernel = ResolveScalar;
+    stats.kernel = "scalar";
+#ifdef AUDIO_MIXER_SSE2
+    mixKernel = MixSSE2;
+    resolveKernel = ResolveSSE2;
+    stats.kernel = "sse2";
+#endif
+#ifdef AUDIO_MIXER_AVX2
+    if (SDL_HasAVX2()) {
+        mixKernel = MixAVX2;
+        resolveKernel = ResolveAVX2;
+        stats.kernel = "avx2";
+    }
+#endif
+
+    Mix_SetPostMix(MixEmitters, NULL);
+    isInitialized = true;
+    printf("Audio mixer initialized (%s kernels, %d emitters).\n", stats.kernel, AUDIO_MIXER_MAX_EMITTERS);
+    return true;
+}
+
+// Stop mixing and release the accumulator
+void AudioMixer_Shutdown() {
+    if (!isInitialized) return;
+
+    Mix_SetPostMix(NULL, NULL); // Waits for the audio thread
+    for (int i = 0; i < AUDIO_MIXER_MAX_EMITTERS; ++i) {
+        SDL_FreeAudioStream(playbacks[i].converter);
+        playbacks[i].converter = NULL;
+    }
+    free(mixBuffer);
+    free(resampled);
+    mixBuffer = NULL;
+    resampled = NULL;
+    activeCount = 0;
+    publishedCount = 0;
+    isInitialized = false;
+}
+
+// Place the listener at the camera's focus, with its screen-right as the stereo axis
+void AudioMixer_SetListener(const Camera* camera) {
+    if (!camera) return;
+
+    listenerPosition.x = camera->targetX;
+    listenerPosition.y = camera->targetY;
+    listenerPosition.z = camera->targetZ;
+
+    // Horizontal view direction (z is up); a camera looking straight down falls back to its compass angle
+    float forwardX = camera->targetX - camera->x;
+    float forwardY = camera->targetY - camera->y;
+    float length = sqrtf(forwardX * forwardX + forwardY * forwardY);
+    if (length < 0.0001f) {
+        float angle = camera->currentAngle * 3.14159265f / 4.0f;
+        forwardX = -cosf(angle);
+        forwardY = -sinf(angle);
+        length = 1.0f;
+    }
+
+    listenerRight.x = forwardY / length;
+    listenerRight.y = -forwardX / length;
+    listenerRight.z = 0.0f;
+}
+
+// Build the handle for an emitter's current play
+static AudioEmitterHandle MakeEmitterHandle(int index) {
+    return ((emitters[index].generation & 0xFFFFF) << 12) | (uint32_t)(index + 1);
+}
+
+// Find the emitter behind a handle
+static Emitter* GetEmitter(AudioEmitterHandle handle) {
+    int index = (int)(handle & 0xFFF) - 1;
+    if (!isInitialized || index < 0 || index >= AUDIO_MIXER_MAX_EMITTERS) return NULL;
+    if (!emitters[index].isActive || MakeEmitterHandle(index) != handle) return NULL;
+    return &emitters[index];
+}
+
+// Return an emitter to the free list
+static void ReleaseEmitter(int index) {
+    Emitter* emitter = &emitters[index];
+    int last = activeEmitters[--activeCount];
+    activeEmitters[emitter->activeIndex] = last;
+    emitters[last].activeIndex = emitter->activeIndex;
+
+    emitter->isActive = false;
+    freeEmitters[freeCount++] = index;
+}
+
+// Order candidates loudest first
+static int CompareLoudness(const void* a, const void* b) {
+    float loudnessA = ((const MixVoice*)a)->gainLeft + ((const MixVoice*)a)->gainRight;
+    float loudnessB = ((const MixVoice*)b)->gainLeft + ((const MixVoice*)b)->gainRight;
+    return (loudnessA < loudnessB) - (loudnessA > loudnessB);
+}
+
+// Attenuate, pan and cull every emitter, then publish the result to the audio thread
+void AudioMixer_Update() {
+    if (!isInitialized) return;
+
+    // Retire one-shots the audio thread has finished
+    for (int i = 0; i < activeCount;) {
+        int index = activeEmitters[i];
+        if (!emitters[index].loop && (uint32_t)SDL_AtomicGet(&finishedGenerations[index]) == emitters[index].generation) {
+            ReleaseEmitter(index); // Swaps another emitter into position i
+            continue;
+        }
+        i++;
+    }
+
+    int audible = 0;
+    for (int i = 0; i < activeCount; ++i) {
+        int index = activeEmitters[i];
+        Emitter* emitter = &emitters[index];
+        MixVoice* voice = &candidates[i];
+        const void* data = NULL;
+        size_t size = 0;
+
+        Audio_GetSoundData(emitter->sound, &data, &size);
+        voice->emitter = index;
+        voice->generation = emitter->generation;
+        voice->samples = (const int16_t*)data;
+        voice->frameCount = (uint32_t)(size / (sizeof(int16_t) * 2));
+        voice->sourceRate = (int)lrintf(mixerFrequency * emitter->pitch);
+        voice->loop = emitter->loop;
+        voice->gainLeft = 0.0f;
+        voice->gainRight = 0.0f;
+
+        float dx = emitter->position.x - listenerPosition.x;
+        float dy = emitter->position.y - listenerPosition.y;
+        float dz = emitter->position.z - listenerPosition.z;
+        float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+        if (distance >= emitter->maxDistance) continue;
+
+        float gain = emitter->volume;
+        if (distance > emitter->minDistance) {
+            gain *= emitter->minDistance / distance; // Inverse distance, clamped inside minDistance
+        }
+        if (gain < AUDIO_MIXER_CULL_GAIN) continue;
+
+        // Constant-power pan from the horizontal direction, scaled so center is full volume
+        float horizontal = sqrtf(dx * dx + dy * dy);
+        float pan = horizontal > 0.0001f ? (dx * listenerRight.x + dy * listenerRight.y) / horizontal : 0.0f;
+        float angle = (pan + 1.0f) * 0.25f * 3.14159265f;
+        voice->gainLeft = gain * fminf(cosf(angle) * 1.41421356f, 1.0f);
+        voice->gainRight = gain * fminf(sinf(angle) * 1.41421356f, 1.0f);
+        audible++;
+    }
+
+    // Over budget: keep the loudest, the rest keep running silently
+    if (audible > AUDIO_MIXER_MAX_MIXED) {
+        qsort(candidates, activeCount, sizeof(MixVoice), CompareLoudness);
+        for (int i = AUDIO_MIXER_MAX_MIXED; i < activeCount; ++i) {
+            candidates[i].gainLeft = 0.0f;
+            candidates[i].gainRight = 0.0f;
+        }
+    }
+
+    SDL_AtomicLock(&publishLock);
+    memcpy(publishedVoices, candidates, sizeof(MixVoice) * activeCount);
+    publishedCount = activeCount;
+    SDL_AtomicUnlock(&publishLock);
+
+    int mixed = audible < AUDIO_MIXER_MAX_MIXED ? audible : AUDIO_MIXER_MAX_MIXED;
+    SDL_AtomicLock(&statsLock);
+    stats.emitters = activeCount;
+    stats.mixed = mixed;
+    stats.culled = activeCount - mixed;
+    SDL_AtomicUnlock(&statsLock);
+}
+
+// Start a positional sound
+AudioEmitterHandle AudioEmitter_Play(AudioSoundID sound, Vector3 position, float volume, bool loop) {
+    if (!isInitialized) return AUDIO_EMITTER_NONE;
+
+    const void* data = NULL;
+    size_t size = 0;
+    if (!Audio_GetSoundData(sound, &data, &size)) return AUDIO_EMITTER_NONE;
+    if (freeCount == 0) {
+        printf("Error: Maximum number of audio emitters reached.\n");
+        return AUDIO_EMITTER_NONE;
+    }
+
+    int index = freeEmitters[--freeCount];
+    Emitter* emitter = &emitters[index];
+    emitter->sound = sound;
+    emitter->position = position;
+    emitter->volume = volume < 0.0f ? 0.0f : (volume > 1.0f ? 1.0f : volume);
+    emitter->minDistance = DEFAULT_MIN_DISTANCE;
+    emitter->maxDistance = DEFAULT_MAX_DISTANCE;
+    emitter->pitch = 1.0f;
+    emitter->loop = loop;
+    emitter->isActive = true;
+    emitter->generation++;
+    emitter->activeIndex = activeCount;
+    activeEmitters[activeCount++] = index;
+    return MakeEmitterHandle(index); // Audible from the next AudioMixer_Update
+}
+
+// Stop a positional sound
+void AudioEmitter_Stop(AudioEmitterHandle handle) {
+    Emitter* emitter = GetEmitter(handle);
+    if (emitter) {
+        ReleaseEmitter((int)(emitter - emitters));
+    }
+}
+
+// Check if a positional sound is still playing
+bool AudioEmitter_IsPlaying(AudioEmitterHandle handle) {
+    Emitter* emitter = GetEmitter(handle);
+    if (!emitter) return false;
+
+    int index = (int)(emitter - emitters);
+    return emitter->loop || (uint32_t)SDL_AtomicGet(&finishedGenerations[index]) != emitter->generation;
+}
+
+// Move an emitter
+void AudioEmitter_SetPosition(AudioEmitterHandle handle, Vector3 position) {
+    Emitter* emitter = GetEmitter(handle);
+    if (emitter) {
+        emitter->position = position;
+    }
+}
+
+// Set an emitter's volume (0..1)
+void AudioEmitter_SetVolume(AudioEmitterHandle handle, float volume) {
+    Emitter* emitter = GetEmitter(handle);
+    if (emitter) {
+        emitter->volume = volume < 0.0f ? 0.0f : (volume > 1.0f ? 1.0f : volume);
+    }
+}
+
+// Set the distances where attenuation starts and where the emitter is culled
+void AudioEmitter_SetRange(AudioEmitterHandle handle, float minDistance, float maxDistance) {
+    Emitter* emitter = GetEmitter(handle);
+    if (!emitter) return;
+
+    emitter->minDistance = minDistance > 0.01f ? minDistance : 0.01f;
+    emitter->maxDistance = maxDistance > emitter->minDistance ? maxDistance : emitter->minDistance;
+}
+
+// Set an emitter's playback rate (resampled on the audio thread when not 1)
+void AudioEmitter_SetPitch(AudioEmitterHandle handle, float pitch) {
+    Emitter* emitter = GetEmitter(handle);
+    if (emitter) {
+        emitter->pitch = pitch < AUDIO_MIXER_MIN_PITCH ? AUDIO_MIXER_MIN_PITCH : (pitch > AUDIO_MIXER_MAX_PITCH ? AUDIO_MIXER_MAX_PITCH : pitch);
+    }
+}
+
+// Get mixer statistics
+AudioMixerStats AudioMixer_GetStats() {
+    SDL_AtomicLock(&statsLock);
+    AudioMixerStats result = stats;
+    SDL_AtomicUnlock(&statsLock);
+    return result;
+}
@@ -1,8 +1,15 @@
 // audio_system.c
 #include "audio_system.h"
+#include "audio_mixer.h"
+#include "file_utils.h"
+#include "hash_utils.h"
+#include "music_stream.h"
+#include "vfs.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #define MAX_AUDIO_FILES 256
@@ -11,14 +18,41 @@ typedef struct {
     const char* fileName;
     AudioType type;
     Mix_Chunk* soundEffect;
-    Mix_Music* music;
-    bool isPlaying;
+    Mix_Music* music;              // Only for formats without a streaming decoder
+    FileMapping musicFile;         // Pack-mounted music: SDL_mixer reads it from memory while loaded
+    MusicStreamHandle stream;      // Streamed music (decoded on the fly, nothing resident)
+    bool isStreamed;
+    float volume;
+    bool isPlaying;                // Music only; sound effects are tracked per voice
 } LoadedAudio;
 
+// Voice (one per mixer channel)
+typedef struct {
+    SDL_atomic_t isActive;         // Set on play, cleared by the mixer when the channel finishes
+    uint32_t generation;           // Bumped on every play so old handles go stale
+    AudioSoundID sound;
+    VoicePriority priority;
+    uint32_t startOrder;           // Oldest voices are stolen first
+    float volume;
+    float pan;
+} Voice;
+
 static LoadedAudio audioFiles[MAX_AUDIO_FILES];
 static int audioFileCount = 0;
+static HashIndex audioIndex;       // Hash_String(fileName) -> audioFiles index
 static float globalVolume = 1.0f;
 
+static Voice voices[AUDIO_MAX_VOICES];
+static uint32_t playCounter = 0;
+static VoiceStats voiceStats;
+
+// Mixer callback (audio thread, or inside Mix_HaltChannel): only flips the atomic
+static void OnChannelFinished(int channel) {
+    if (channel >= 0 && channel < AUDIO_MAX_VOICES) {
+        SDL_AtomicSet(&voices[channel].isActive, 0);
+    }
+}
+
 // Initialize the audio system
 bool AudioSystem_Init() {
     if (SDL_Init(SDL_INIT_AUDIO) != 0) {
@@ -32,78 +66,319 @@ bool AudioSystem_Init() {
     }
 
     memset(audioFiles, 0, sizeof(audioFiles));
+    audioFileCount = 0;
+    if (!HashIndex_Init(&audioIndex, MAX_AUDIO_FILES)) {
+        printf("Failed to allocate the audio file index.\n");
+        return false;
+    }
+
+    memset(voices, 0, sizeof(voices));
+    memset(&voiceStats, 0, sizeof(voiceStats));
+    Mix_AllocateChannels(AUDIO_MAX_VOICES);
+    Mix_ChannelFinished(OnChannelFinished);
+
+    if (!MusicStream_Init()) {
+        printf("Music streaming unavailable; music will be loaded with SDL_mixer.\n");
+    }
+    if (!AudioMixer_Init()) {
+        printf("Positional audio unavailable.\n");
+    }
     printf("Audio system initialized.\n");
     return true;
 }
 
 // Shutdown the audio system
 void AudioSystem_Shutdown() {
+    AudioMixer_Shutdown();
+    MusicStream_Shutdown();
+    Mix_ChannelFinished(NULL);
+    Mix_HaltChannel(-1);
     for (int i = 0; i < audioFileCount; ++i) {
         if (audioFiles[i].music) {
             Mix_FreeMusic(audioFiles[i].music);
         }
+        File_Unmap(&audioFiles[i].musicFile);
         if (audioFiles[i].soundEffect) {
             Mix_FreeChunk(audioFiles[i].soundEffect);
         }
+        free((void*)audioFiles[i].fileName);
     }
+    audioFileCount = 0;
+    HashIndex_Free(&audioIndex);
     Mix_CloseAudio();
     SDL_QuitSubSystem(SDL_INIT_AUDIO);
     printf("Audio system shut down.\n");
 }
 
+// Find a loaded audio file by name, -1 if not loaded
+static int FindAudioFile(const char* fileName, uint32_t hash) {
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(&audioIndex, hash, &cursor); i >= 0;
+        i = HashIndex_FindNext(&audioIndex, hash, &cursor)) {
+        if (strcmp(audioFiles[i].fileName, fileName) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 // Load an audio file
 static LoadedAudio* LoadAudioFile(const char* fileName, AudioType type) {
+    uint32_t hash = Hash_String(fileName);
+    int existing = FindAudioFile(fileName, hash);
+    if (existing >= 0) {
+        return &audioFiles[existing];
+    }
+
     if (audioFileCount >= MAX_AUDIO_FILES) {
         printf("Error: Maximum number of audio files reached.\n");
         return NULL;
     }
 
-    for (int i = 0; i < audioFileCount; ++i) {
-        if (strcmp(audioFiles[i].fileName, fileName) == 0) {
-            return &audioFiles[i];
-        }
-    }
-
-    LoadedAudio* audio = &audioFiles[audioFileCount++];
-    audio->fileName = strdup(fileName);
+    LoadedAudio* audio = &audioFiles[audioFileCount];
+    memset(audio, 0, sizeof(LoadedAudio));
     audio->type = type;
-    audio->isPlaying = false;
+    audio->volume = 1.0f;
 
-    if (type == AUDIO_TYPE_MUSIC) {
-        audio->music = Mix_LoadMUS(fileName);
+    if (type == AUDIO_TYPE_MUSIC && MusicStream_CanStream(fileName)) {
+        audio->isStreamed = true; // The stream is opened on play
+    }
+    else if (type == AUDIO_TYPE_MUSIC) {
+        // Pack entries have no host file, so SDL_mixer reads them from a mapping kept for the music's life
+        VfsResolution resolution;
+        if (!Vfs_Resolve(fileName, &resolution)) {
+            audio->music = NULL;
+        }
+        else if (resolution.entry) {
+            if (File_Map(fileName, &audio->musicFile)) {
+                audio->music = Mix_LoadMUS_RW(SDL_RWFromConstMem(audio->musicFile.data, (int)audio->musicFile.size), 1);
+            }
+        }
+        else {
+            audio->music = Mix_LoadMUS(resolution.hostPath);
+        }
         if (!audio->music) {
             printf("Failed to load music: %s\n", Mix_GetError());
+            File_Unmap(&audio->musicFile);
             return NULL;
         }
     }
     else if (type == AUDIO_TYPE_SOUND_EFFECT) {
-        audio->soundEffect = Mix_LoadWAV(fileName);
+        // Mapped so pack entries and overlay mounts load as well as loose files; the chunk is a copy
+        FileMapping mapping;
+        if (File_Map(fileName, &mapping)) {
+            audio->soundEffect = Mix_LoadWAV_RW(SDL_RWFromConstMem(mapping.data, (int)mapping.size), 1);
+            File_Unmap(&mapping);
+        }
         if (!audio->soundEffect) {
             printf("Failed to load sound effect: %s\n", Mix_GetError());
             return NULL;
         }
     }
 
+    // Only successful loads take a slot, so failures can be retried
+    audio->fileName = strdup(fileName);
+    HashIndex_Insert(&audioIndex, hash, audioFileCount);
+    audioFileCount++;
     return audio;
 }
 
+// Build the handle for a voice's current play
+static VoiceHandle MakeVoiceHandle(int channel) {
+    return ((voices[channel].generation & 0xFFFFFF) << 8) | (uint32_t)(channel + 1);
+}
+
+// Find the voice behind a handle, NULL once it has finished or been reused
+static Voice* GetVoice(VoiceHandle handle) {
+    int channel = (int)(handle & 0xFF) - 1;
+    if (channel < 0 || channel >= AUDIO_MAX_VOICES) return NULL;
+    if (MakeVoiceHandle(channel) != handle || !SDL_AtomicGet(&voices[channel].isActive)) return NULL;
+    return &voices[channel];
+}
+
+// Clamp a value to a range
+static float ClampFloat(float value, float min, float max) {
+    return value < min ? min : (value > max ? max : value);
+}
+
+// Push a voice's volume and pan to its channel
+static void ApplyVoiceMix(int channel) {
+    Voice* voice = &voices[channel];
+    Mix_Volume(channel, (int)(voice->volume * globalVolume * MIX_MAX_VOLUME));
+
+    // Constant-power pan scaled so center is full volume; centered voices skip the panning effect
+    if (voice->pan == 0.0f) {
+        Mix_SetPanning(channel, 255, 255);
+    }
+    else {
+        float angle = (voice->pan + 1.0f) * 0.25f * 3.14159265f;
+        float left = ClampFloat(cosf(angle) * 1.41421356f, 0.0f, 1.0f);
+        float right = ClampFloat(sinf(angle) * 1.41421356f, 0.0f, 1.0f);
+        Mix_SetPanning(channel, (Uint8)(left * 255.0f), (Uint8)(right * 255.0f));
+    }
+}
+
+// Pick a channel for a new voice: a free one, else steal the lowest priority (then oldest) voice it does not outrank
+static int AcquireVoice(VoicePriority priority) {
+    int victim = -1;
+    for (int i = 0; i < AUDIO_MAX_VOICES; ++i) {
+        Voice* voice = &voices[i];
+        if (!SDL_AtomicGet(&voice->isActive)) return i;
+        if (voice->priority > priority || voice->priority == VOICE_PRIORITY_CRITICAL) continue;
+
+        if (victim < 0 || voice->priority < voices[victim].priority ||
+            (voice->priority == voices[victim].priority && (int32_t)(voice->startOrder - voices[victim].startOrder) < 0)) {
+            victim = i;
+        }
+    }
+
+    if (victim >= 0) {
+        Mix_HaltChannel(victim); // Fires OnChannelFinished before returning
+        voiceStats.steals++;
+    }
+    return victim;
+}
+
+// Preload a sound effect and get an ID for handle-based playback
+AudioSoundID Audio_LoadSound(const char* fileName) {
+    if (!fileName) return AUDIO_SOUND_NONE;
+
+    LoadedAudio* audio = LoadAudioFile(fileName, AUDIO_TYPE_SOUND_EFFECT);
+    if (!audio || !audio->soundEffect) return AUDIO_SOUND_NONE;
+    return (AudioSoundID)(audio - audioFiles);
+}
+
+// Play a loaded sound effect on a pooled voice
+VoiceHandle Audio_PlaySound(AudioSoundID sound, VoicePriority priority, float volume, float pan, bool loop) {
+    if (sound < 0 || sound >= audioFileCount || !audioFiles[sound].soundEffect) return VOICE_HANDLE_NONE;
+
+    int channel = AcquireVoice(priority);
+    if (channel < 0) {
+        voiceStats.rejected++;
+        return VOICE_HANDLE_NONE;
+    }
+
+    Voice* voice = &voices[channel];
+    voice->generation++;
+    voice->sound = sound;
+    voice->priority = priority;
+    voice->startOrder = playCounter++;
+    voice->volume = ClampFloat(volume, 0.0f, 1.0f);
+    voice->pan = ClampFloat(pan, -1.0f, 1.0f);
+    ApplyVoiceMix(channel);
+
+    // Active before playing so a sound that finishes immediately still clears it
+    SDL_AtomicSet(&voice->isActive, 1);
+    if (Mix_PlayChannel(channel, audioFiles[sound].soundEffect, loop ? -1 : 0) == -1) {
+        SDL_AtomicSet(&voice->isActive, 0);
+        printf("Failed to play sound effect: %s\n", Mix_GetError());
+        return VOICE_HANDLE_NONE;
+    }
+
+    int active = 0;
+    for (int i = 0; i < AUDIO_MAX_VOICES; ++i) {
+        active += SDL_AtomicGet(&voices[i].isActive) ? 1 : 0;
+    }
+    if (active > voiceStats.peakVoices) {
+        voiceStats.peakVoices = active;
+    }
+    return MakeVoiceHandle(channel);
+}
+
+// Stop one voice
+void Audio_StopVoice(VoiceHandle handle) {
+    if (GetVoice(handle)) {
+        Mix_HaltChannel((int)(handle & 0xFF) - 1);
+    }
+}
+
+// Check if a voice is still playing
+bool Audio_IsVoicePlaying(VoiceHandle handle) {
+    return GetVoice(handle) != NULL;
+}
+
+// Set the volume of one voice (0..1)
+void Audio_SetVoiceVolume(VoiceHandle handle, float volume) {
+    Voice* voice = GetVoice(handle);
+    if (!voice) return;
+
+    voice->volume = ClampFloat(volume, 0.0f, 1.0f);
+    ApplyVoiceMix((int)(handle & 0xFF) - 1);
+}
+
+// Set the pan of one voice (-1 left, 0 center, 1 right)
+void Audio_SetVoicePan(VoiceHandle handle, float pan) {
+    Voice* voice = GetVoice(handle);
+    if (!voice) return;
+
+    voice->pan = ClampFloat(pan, -1.0f, 1.0f);
+    ApplyVoiceMix((int)(handle & 0xFF) - 1);
+}
+
+// Get the PCM of a loaded sound (already converted to the mixer's format by SDL_mixer)
+bool Audio_GetSoundData(AudioSoundID sound, const void** outData, size_t* outSize) {
+    if (sound < 0 || sound >= audioFileCount || !audioFiles[sound].soundEffect) return false;
+
+    *outData = audioFiles[sound].soundEffect->abuf;
+    *outSize = audioFiles[sound].soundEffect->alen;
+    return true;
+}
+
+// Get voice pool statistics
+VoiceStats Audio_GetVoiceStats() {
+    VoiceStats stats = voiceStats;
+    stats.activeVoices = 0;
+    for (int i = 0; i < AUDIO_MAX_VOICES; ++i) {
+        stats.activeVoices += SDL_AtomicGet(&voices[i].isActive) ? 1 : 0;
+    }
+    return stats;
+}
+
+// Stop the current music track (one track plays at a time, like Mix_PlayMusic)
+static void StopMusic() {
+    for (int i = 0; i < audioFileCount; ++i) {
+        if (audioFiles[i].type == AUDIO_TYPE_MUSIC && audioFiles[i].isPlaying) {
+            if (audioFiles[i].isStreamed) {
+                MusicStream_Stop(audioFiles[i].stream);
+            }
+            else {
+                Mix_HaltMusic();
+            }
+            audioFiles[i].isPlaying = false;
+        }
+    }
+}
+
+// Stop every voice playing a sound
+static void StopSoundVoices(AudioSoundID sound) {
+    for (int i = 0; i < AUDIO_MAX_VOICES; ++i) {
+        if (voices[i].sound == sound && SDL_AtomicGet(&voices[i].isActive)) {
+            Mix_HaltChannel(i);
+        }
+    }
+}
+
 // Play an audio file
 bool Audio_Play(const char* fileName, AudioType type, bool loop) {
     LoadedAudio* audio = LoadAudioFile(fileName, type);
     if (!audio) return false;
 
-    if (type == AUDIO_TYPE_MUSIC) {
+    if (type == AUDIO_TYPE_SOUND_EFFECT) {
+        return Audio_PlaySound((AudioSoundID)(audio - audioFiles), VOICE_PRIORITY_NORMAL, 1.0f, 0.0f, loop) != VOICE_HANDLE_NONE;
+    }
+
+    StopMusic();
+    if (audio->isStreamed) {
+        audio->stream = MusicStream_Play(fileName, loop, audio->volume);
+        if (audio->stream == MUSIC_STREAM_NONE) return false;
+    }
+    else {
+        MusicStream_StopAll(); // The stream mixer hook replaces SDL_mixer's music player
         if (Mix_PlayMusic(audio->music, loop ? -1 : 1) == -1) {
             printf("Failed to play music: %s\n", Mix_GetError());
             return false;
         }
     }
-    else if (type == AUDIO_TYPE_SOUND_EFFECT) {
-        if (Mix_PlayChannel(-1, audio->soundEffect, loop ? -1 : 0) == -1) {
-            printf("Failed to play sound effect: %s\n", Mix_GetError());
-            return false;
-        }
-    }
 
     audio->isPlaying = true;
     return true;
@@ -111,24 +386,29 @@ bool Audio_Play(const char* fileName, AudioType type, bool loop) {
 
 // Stop an audio file
 void Audio_Stop(const char* fileName) {
-    for (int i = 0; i < audioFileCount; ++i) {
-        if (strcmp(audioFiles[i].fileName, fileName) == 0) {
-            if (audioFiles[i].type == AUDIO_TYPE_MUSIC) {
-                Mix_HaltMusic();
-            }
-            else if (audioFiles[i].type == AUDIO_TYPE_SOUND_EFFECT) {
-                Mix_HaltChannel(-1);
-            }
-            audioFiles[i].isPlaying = false;
-            printf("Audio stopped: %s\n", fileName);
-            return;
-        }
+    int index = FindAudioFile(fileName, Hash_String(fileName));
+    if (index < 0) {
+        printf("Audio not found: %s\n", fileName);
+        return;
+    }
+
+    LoadedAudio* audio = &audioFiles[index];
+    if (audio->isStreamed) {
+        MusicStream_Stop(audio->stream);
     }
-    printf("Audio not found: %s\n", fileName);
+    else if (audio->type == AUDIO_TYPE_MUSIC) {
+        Mix_HaltMusic();
+    }
+    else if (audio->type == AUDIO_TYPE_SOUND_EFFECT) {
+        StopSoundVoices(index); // Only this sound's voices
+    }
+    audio->isPlaying = false;
+    printf("Audio stopped: %s\n", fileName);
 }
 
 // Stop all audio
 void Audio_StopAll() {
+    MusicStream_StopAll();
     Mix_HaltMusic();
     Mix_HaltChannel(-1);
     for (int i = 0; i < audioFileCount; ++i) {
@@ -139,37 +419,71 @@ void Audio_StopAll() {
 
 // Set volume for a specific audio file
 void Audio_SetVolume(const char* fileName, float volume) {
-    for (int i = 0; i < audioFileCount; ++i) {
-        if (strcmp(audioFiles[i].fileName, fileName) == 0) {
-            int sdlVolume = (int)(volume * MIX_MAX_VOLUME);
-            if (audioFiles[i].type == AUDIO_TYPE_MUSIC) {
-                Mix_VolumeMusic(sdlVolume);
-            }
-            else if (audioFiles[i].type == AUDIO_TYPE_SOUND_EFFECT) {
-                Mix_VolumeChunk(audioFiles[i].soundEffect, sdlVolume);
-            }
-            printf("Volume set for %s: %.2f\n", fileName, volume);
-            return;
-        }
+    int index = FindAudioFile(fileName, Hash_String(fileName));
+    if (index < 0) {
+        printf("Audio not found: %s\n", fileName);
+        return;
     }
-    printf("Audio not found: %s\n", fileName);
+
+    LoadedAudio* audio = &audioFiles[index];
+    int sdlVolume = (int)(volume * MIX_MAX_VOLUME);
+    audio->volume = volume;
+    if (audio->isStreamed) {
+        MusicStream_SetVolume(audio->stream, volume);
+    }
+    else if (audio->type == AUDIO_TYPE_MUSIC) {
+        Mix_VolumeMusic(sdlVolume);
+    }
+    else if (audio->type == AUDIO_TYPE_SOUND_EFFECT) {
+        Mix_VolumeChunk(audio->soundEffect, sdlVolume);
+    }
+    printf("Volume set for %s: %.2f\n", fileName, volume);
 }
 
 // Set global volume
 void Audio_SetGlobalVolume(float volume) {
     globalVolume = volume;
     int sdlVolume = (int)(volume * MIX_MAX_VOLUME);
-    Mix_Volume(-1, sdlVolume);
+    for (int i = 0; i < AUDIO_MAX_VOICES; ++i) {
+        Mix_Volume(i, (int)(voices[i].volume * volume * MIX_MAX_VOLUME)); // Keeps per-voice volumes
+    }
     Mix_VolumeMusic(sdlVolume);
+    MusicStream_SetMasterVolume(volume); // Hooked streams bypass Mix_VolumeMusic
     printf("Global volume set: %.2f\n", volume);
 }
 
 // Check if an audio file is playing
 bool Audio_IsPlaying(const char* fileName) {
+    int index = FindAudioFile(fileName, Hash_String(fileName));
+    if (index < 0) return false;
+
+    LoadedAudio* audio = &audioFiles[index];
+    if (audio->type == AUDIO_TYPE_SOUND_EFFECT) {
+        for (int i = 0; i < AUDIO_MAX_VOICES; ++i) {
+            if (voices[i].sound == index && SDL_AtomicGet(&voices[i].isActive)) return true;
+        }
+        return false;
+    }
+    if (audio->isStreamed) {
+        return audio->isPlaying && MusicStream_IsPlaying(audio->stream);
+    }
+    return audio->isPlaying;
+}
+
+// Update the audio system (frees finished streams, refreshes positional audio)
+void AudioSystem_Update(float deltaTime) {
+    (void)deltaTime;
+    MusicStream_Update();
+    AudioMixer_Update();
+}
+
+// Get the memory held by loaded sound effects and active music streams
+size_t AudioSystem_GetResidentBytes() {
+    size_t bytes = MusicStream_GetStats().residentBytes;
     for (int i = 0; i < audioFileCount; ++i) {
-        if (strcmp(audioFiles[i].fileName, fileName) == 0) {
-            return audioFiles[i].isPlaying;
+        if (audioFiles[i].soundEffect) {
+            bytes += audioFiles[i].soundEffect->alen;
         }
     }
-    return false;
+    return bytes;
 }
@@ -1,8 +1,17 @@
 // debug_utils.c
 #include "debug_utils.h"
+#include "event_system.h"
+#include "save_schema.h"
+#include "stats_system.h"
+#include "items.h"
+#include "player_movement.h"
+#include "ai_system.h"
+#include "time_utils.h" // For frame timing
+#include "log_system.h" // For queued log output
+#include <SDL2/SDL.h>
+#include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
-#include <time.h>
 #ifdef _WIN32
 #include <windows.h>
 #include <psapi.h>
@@ -13,26 +22,26 @@
 #endif
 
 static bool debugEnabled = false;
-static clock_t lastFrameTime = 0;
+static uint64_t lastFrameTime = 0;
 static int frameCount = 0;
 static float fps = 0.0f;
 
 // Logging Functions
 void Log_Info(const char* message) {
     if (debugEnabled) {
-        printf("[INFO]: %s\n", message);
+        LOG_INFO(LOG_CATEGORY_CORE, "%s", message);
     }
 }
 
 void Log_Warning(const char* message) {
     if (debugEnabled) {
-        printf("[WARNING]: %s\n", message);
+        LOG_WARNING(LOG_CATEGORY_CORE, "%s", message);
     }
 }
 
 void Log_Error(const char* message) {
     if (debugEnabled) {
-        printf("[ERROR]: %s\n", message);
+        LOG_ERROR(LOG_CATEGORY_CORE, "%s", message);
     }
 }
 
@@ -40,7 +49,7 @@ void Log_Error(const char* message) {
 void Debug_Enable() {
     debugEnabled = true;
     printf("Debugging enabled.\n");
-    lastFrameTime = clock();
+    lastFrameTime = Timer_GetTimeNs();
     frameCount = 0;
     fps = 0.0f;
 }
@@ -58,9 +67,9 @@ bool Debug_IsEnabled() {
 void Debug_UpdateFrameMetrics() {
     if (!debugEnabled) return;
 
-    clock_t currentTime = clock();
+    uint64_t currentTime = Timer_GetTimeNs();
     frameCount++;
-    double elapsedTime = (double)(currentTime - lastFrameTime) / CLOCKS_PER_SEC;
+    double elapsedTime = (double)(currentTime - lastFrameTime) / (double)TIMER_NS_PER_SECOND;
 
     if (elapsedTime >= 1.0) {
         fps = frameCount / elapsedTime;
@@ -74,6 +83,19 @@ void Debug_DisplayFrameRate() {
     printf("FPS: %.2f\n", fps);
 }
 
+// Print where the last frame's time went
+void Debug_DisplayFrameTiming() {
+    if (!debugEnabled) return;
+    FrameTiming timing = Timer_GetFrameTiming();
+    printf("Frame %llu: wall %.3f ms (work %.3f, CPU %.3f, GPU wait %.3f, idle %.3f), delta %.4f s (raw %.4f s)\n",
+        (unsigned long long)timing.frameIndex, timing.wallNs / 1e6, timing.workNs / 1e6, timing.cpuNs / 1e6,
+        timing.gpuWaitNs / 1e6, timing.idleNs / 1e6, timing.smoothedDelta, timing.rawDelta);
+
+    FramePacingStats pacing = Timer_GetPacingStats();
+    printf("Last %d frames: p50 %.3f ms, p99 %.3f ms, min %.3f ms, max %.3f ms, %u missed deadlines\n",
+        pacing.frames, pacing.p50Ms, pacing.p99Ms, pacing.minMs, pacing.maxMs, pacing.missedDeadlines);
+}
+
 void Debug_DisplayMemoryUsage() {
     if (!debugEnabled) return;
 #ifdef _WIN32
@@ -165,3 +187,95 @@ void Debug_TestSceneSetup(const char* sceneName) {
     // Placeholder for scene setup test logic
     printf("Scene setup test complete.\n");
 }
+
+// Benchmarks
+void Debug_BenchmarkEventQueue(int eventsPerProducer) {
+    printf("Benchmarking event queue (%d events per producer)...\n", eventsPerProducer);
+    for (int producers = 1; producers <= 16; producers *= 2) {
+        EventSystem_RunStressBenchmark(producers, eventsPerProducer);
+    }
+    printf("Event queue benchmark complete.\n");
+}
+
+// Encode and decode one array of records repeatedly and report MB/s of encoded data
+static void BenchmarkSchema(const SaveSchema* schema, const void* records, void* decoded, int count) {
+    size_t size = SaveSchema_Measure(schema, records, count, 0);
+    void* buffer = malloc(size);
+    if (!buffer) return;
+
+    const int iterations = 20;
+    SaveWriter writer;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < iterations; ++i) {
+        SaveWriter_Init(&writer, buffer, size);
+        SaveSchema_Encode(schema, records, count, 0, &writer);
+    }
+    double encodeSeconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+
+    int result = 0;
+    start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < iterations; ++i) {
+        result = SaveSchema_Decode(schema, buffer, size, decoded, count, 0, NULL);
+    }
+    double decodeSeconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+
+    double megabytes = (double)size * iterations / (1024.0 * 1024.0);
+    printf("  %-15s %8d records %9zu bytes  save %8.1f MB/s  load %8.1f MB/s%s\n", schema->name, count, size,
+        megabytes / encodeSeconds, megabytes / decodeSeconds, result == count ? "" : "  (decode failed)");
+    free(buffer);
+}
+
+// Benchmark save and load throughput of the built-in schemas
+void Debug_BenchmarkSaveSchema(int recordCount) {
+    if (recordCount <= 0) return;
+    printf("Benchmarking save schemas (%d records each)...\n", recordCount);
+
+    CharacterStats* stats = (CharacterStats*)calloc(recordCount * 2, sizeof(CharacterStats));
+    Player* players = (Player*)calloc(recordCount * 2, sizeof(Player));
+    NPC* npcs = (NPC*)calloc(recordCount * 2, sizeof(NPC));
+    Item* items = (Item*)calloc(recordCount * 2, sizeof(Item));
+    if (!stats || !players || !npcs || !items) {
+        free(stats);
+        free(players);
+        free(npcs);
+        free(items);
+        return;
+    }
+
+    for (int i = 0; i < recordCount; ++i) {
+        Stats base = { { 100 + i % 50, 30, 12, 10, 8, 6, 9, 5 } };
+        Stats_Init(&stats[i], 1 + i % MAX_LEVEL, base);
+        for (int m = 0; m < i % 4; ++m) {
+            Stats_AddModifier(&stats[i], (StatType)(m % STAT_COUNT), STAT_MODIFIER_FLAT, 5 + m, 10.0f);
+        }
+
+        players[i].position = (Vector3){ (float)i, 0.0f, (float)-i };
+        players[i].direction = (Vector3){ 0.0f, 0.0f, 1.0f };
+        players[i].speed = 4.5f;
+        players[i].state = PLAYER_STATE_WALKING;
+
+        npcs[i].name = "Villager";
+        npcs[i].position = (Vector3){ (float)i, 0.0f, 2.0f };
+        npcs[i].targetPosition = (Vector3){ (float)i + 5.0f, 0.0f, 2.0f };
+        npcs[i].behavior = NPC_BEHAVIOR_WANDER;
+        npcs[i].speed = 1.5f;
+        npcs[i].dialogue = "Lovely weather today.";
+
+        items[i].name = "Potion";
+        items[i].type = ITEM_TYPE_CONSUMABLE;
+        items[i].value = 50;
+        items[i].description = "Restores 50 HP.";
+        items[i].effectPower = 50;
+    }
+
+    BenchmarkSchema(SaveSchema_GetCharacterStats(), stats, stats + recordCount, recordCount);
+    BenchmarkSchema(SaveSchema_GetPlayer(), players, players + recordCount, recordCount);
+    BenchmarkSchema(SaveSchema_GetNPC(), npcs, npcs + recordCount, recordCount);
+    BenchmarkSchema(SaveSchema_GetItem(), items, items + recordCount, recordCount);
+
+    free(stats);
+    free(players);
+    free(npcs);
+    free(items);
+    printf("Save schema benchmark complete.\n");
+}
@@ -0,0 +1,224 @@
+// entity_array.c
+#include "entity_array.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define ENTITY_ARRAY_MIN_CAPACITY 16
+#define ENTITY_SLOT_BITS 20
+#define ENTITY_SLOT_MASK ((1u << ENTITY_SLOT_BITS) - 1)
+#define ENTITY_GENERATION_MASK 0xFFFu
+
+// Build a handle from a slot and its generation
+static EntityHandle MakeHandle(uint32_t slot, uint16_t generation) {
+    return ((uint32_t)generation << ENTITY_SLOT_BITS) | slot;
+}
+
+// Resolve a handle to its slot, -1 if stale or invalid
+static int ResolveSlot(const EntityArray* array, EntityHandle handle) {
+    if (handle == ENTITY_HANDLE_NONE) return -1;
+
+    uint32_t slot = handle & ENTITY_SLOT_MASK;
+    uint16_t generation = (uint16_t)(handle >> ENTITY_SLOT_BITS);
+    if (slot >= (uint32_t)array->slotCount || array->generations[slot] != generation) return -1;
+    return (int)slot;
+}
+
+// Advance a slot generation, wrapping within 12 bits and skipping 0
+static uint16_t NextGeneration(uint16_t generation) {
+    return (uint16_t)((generation % ENTITY_GENERATION_MASK) + 1);
+}
+
+// Grow to the next power of two at or above the requested size
+static int NextCapacity(int current, int required) {
+    int capacity = current ? current : ENTITY_ARRAY_MIN_CAPACITY;
+    while (capacity < required) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+// Grow slot storage to hold at least the requested number of slots
+static bool ReserveSlots(EntityArray* array, int required) {
+    if (required <= array->slotCapacity) return true;
+    if (required > ENTITY_ARRAY_MAX_SLOTS) {
+        printf("Entity array is full (%d slots).\n", ENTITY_ARRAY_MAX_SLOTS);
+        return false;
+    }
+
+    int capacity = NextCapacity(array->slotCapacity, required);
+    if (capacity > ENTITY_ARRAY_MAX_SLOTS) capacity = ENTITY_ARRAY_MAX_SLOTS;
+
+    uint32_t* slots = (uint32_t*)realloc(array->slots, sizeof(uint32_t) * capacity);
+    if (!slots) return false;
+    array->slots = slots;
+
+    uint16_t* generations = (uint16_t*)realloc(array->generations, sizeof(uint16_t) * capacity);
+    if (!generations) return false;
+    array->generations = generations;
+
+    array->slotCapacity = capacity;
+    return true;
+}
+
+// Take a free slot (reusing removed ones first) and point it at a packed index
+static uint32_t AcquireSlot(EntityArray* array, int denseIndex) {
+    uint32_t slot;
+    if (array->freeSlot >= 0) {
+        slot = (uint32_t)array->freeSlot;
+        array->freeSlot = (int)array->slots[slot];
+    }
+    else {
+        slot = (uint32_t)array->slotCount++;
+        array->generations[slot] = 1; // Generation 0 is never used, so no live handle is 0
+    }
+
+    array->slots[slot] = (uint32_t)denseIndex;
+    return slot;
+}
+
+// Initialize an empty entity array
+void EntityArray_Init(EntityArray* array) {
+    if (!array) return;
+
+    memset(array, 0, sizeof(EntityArray));
+    array->freeSlot = -1;
+}
+
+// Release an entity array (the entities themselves are not freed)
+void EntityArray_Free(EntityArray* array) {
+    if (!array) return;
+
+    free(array->entities);
+    free(array->denseToSlot);
+    free(array->slots);
+    free(array->generations);
+    EntityArray_Init(array);
+}
+
+// Remove all entities, keeping capacity; existing handles go stale
+void EntityArray_Clear(EntityArray* array) {
+    if (!array) return;
+
+    for (int i = 0; i < array->count; ++i) {
+        uint32_t slot = array->denseToSlot[i];
+        array->generations[slot] = NextGeneration(array->generations[slot]);
+        array->slots[slot] = (uint32_t)array->freeSlot;
+        array->freeSlot = (int)slot;
+    }
+    array->count = 0;
+}
+
+// Make room for at least capacity entities without further allocation
+bool EntityArray_Reserve(EntityArray* array, int capacity) {
+    if (!array || capacity < 0) return false;
+
+    if (capacity > array->capacity) {
+        int grown = NextCapacity(array->capacity, capacity);
+
+        void** entities = (void**)realloc(array->entities, sizeof(void*) * grown);
+        if (!entities) return false;
+        array->entities = entities;
+
+        uint32_t* denseToSlot = (uint32_t*)realloc(array->denseToSlot, sizeof(uint32_t) * grown);
+        if (!denseToSlot) return false;
+        array->denseToSlot = denseToSlot;
+
+        array->capacity = grown;
+    }
+    return ReserveSlots(array, capacity);
+}
+
+// Add an entity, returning its handle (ENTITY_HANDLE_NONE on failure)
+EntityHandle EntityArray_Add(EntityArray* array, void* entity) {
+    if (!array || !entity) return ENTITY_HANDLE_NONE;
+
+    // Geometric growth: amortized O(1) per insert
+    int required = array->count + 1;
+    if (required > array->capacity || (array->freeSlot < 0 && array->slotCount >= array->slotCapacity)) {
+        if (!EntityArray_Reserve(array, required)) return ENTITY_HANDLE_NONE;
+    }
+
+    int denseIndex = array->count++;
+    uint32_t slot = AcquireSlot(array, denseIndex);
+    array->entities[denseIndex] = entity;
+    array->denseToSlot[denseIndex] = slot;
+    return MakeHandle(slot, array->generations[slot]);
+}
+
+// Add many entities with a single reservation; outHandles may be NULL
+bool EntityArray_AddBulk(EntityArray* array, void* const* entities, int count, EntityHandle* outHandles) {
+    if (!array || !entities || count < 0) return false;
+    for (int i = 0; i < count; ++i) {
+        if (!entities[i]) return false; // Like EntityArray_Add; nothing is inserted
+    }
+    if (!EntityArray_Reserve(array, array->count + count)) return false;
+
+    for (int i = 0; i < count; ++i) {
+        int denseIndex = array->count++;
+        uint32_t slot = AcquireSlot(array, denseIndex);
+        array->entities[denseIndex] = entities[i];
+        array->denseToSlot[denseIndex] = slot;
+        if (outHandles) {
+            outHandles[i] = MakeHandle(slot, array->generations[slot]);
+        }
+    }
+    return true;
+}
+
+// Remove an entity by handle in O(1), returning it (NULL if the handle is stale)
+void* EntityArray_Remove(EntityArray* array, EntityHandle handle) {
+    if (!array) return NULL;
+
+    int slot = ResolveSlot(array, handle);
+    if (slot < 0) return NULL;
+
+    int denseIndex = (int)array->slots[slot];
+    void* entity = array->entities[denseIndex];
+
+    // Move the last entity into the hole and repoint its slot
+    int last = --array->count;
+    if (denseIndex != last) {
+        array->entities[denseIndex] = array->entities[last];
+        array->denseToSlot[denseIndex] = array->denseToSlot[last];
+        array->slots[array->denseToSlot[denseIndex]] = (uint32_t)denseIndex;
+    }
+
+    array->generations[slot] = NextGeneration(array->generations[slot]);
+    array->slots[slot] = (uint32_t)array->freeSlot;
+    array->freeSlot = slot;
+    return entity;
+}
+
+// Get the entity for a handle, NULL if stale
+void* EntityArray_Get(const EntityArray* array, EntityHandle handle) {
+    if (!array) return NULL;
+
+    int slot = ResolveSlot(array, handle);
+    return slot >= 0 ? array->entities[array->slots[slot]] : NULL;
+}
+
+// Check if a handle still refers to a live entity
+bool EntityArray_IsValid(const EntityArray* array, EntityHandle handle) {
+    return array && ResolveSlot(array, handle) >= 0;
+}
+
+// Find the handle of an entity pointer (linear scan)
+EntityHandle EntityArray_FindHandle(const EntityArray* array, const void* entity) {
+    if (!array || !entity) return ENTITY_HANDLE_NONE;
+
+    for (int i = 0; i < array->count; ++i) {
+        if (array->entities[i] == entity) {
+            return EntityArray_GetHandleAt(array, i);
+        }
+    }
+    return ENTITY_HANDLE_NONE;
+}
+
+// Get the handle of the entity at a packed index
+EntityHandle EntityArray_GetHandleAt(const EntityArray* array, int denseIndex) {
+    if (!array || denseIndex < 0 || denseIndex >= array->count) return ENTITY_HANDLE_NONE;
+
+    uint32_t slot = array->denseToSlot[denseIndex];
+    return MakeHandle(slot, array->generations[slot]);
+}
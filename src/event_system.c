@@ -3,48 +3,162 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <SDL2/SDL.h>
 
-#define MAX_CALLBACKS 32
+#define MAX_SUBSCRIBERS_PER_TYPE 32
+#define EVENT_QUEUE_CAPACITY 4096  // Must be a power of two
+#define EVENT_DRAIN_BATCH_SIZE 64
 
-// Callback registration structure
+// Queue cell; sequence tells producers and the consumer whose turn it is
 typedef struct {
-    EventType type;
-    EventCallback callback;
-} EventCallbackEntry;
+    SDL_atomic_t sequence;
+    Event event;
+} EventQueueCell;
 
-static EventCallbackEntry gEventCallbacks[MAX_CALLBACKS];
-static int gCallbackCount = 0;
+// Bounded lock-free multi-producer/single-consumer queue
+typedef struct {
+    EventQueueCell* cells;
+    int capacity;
+    int mask;
+    SDL_atomic_t enqueuePos;  // Shared by producers
+    int dequeuePos;           // Owned by the consumer (main thread)
+    SDL_atomic_t droppedCount;
+} EventQueue;
+
+// Subscribers, grouped by event type and kept in registration order (main thread only)
+static EventCallback gSubscribers[EVENT_TYPE_COUNT][MAX_SUBSCRIBERS_PER_TYPE];
+static int gSubscriberCounts[EVENT_TYPE_COUNT];
+
+static EventQueue gEventQueue;
+static bool gCoalescing[EVENT_TYPE_COUNT];
+static EventTypeStats gEventStats[EVENT_TYPE_COUNT];     // Consumer-side counters
+static SDL_atomic_t gQueuedCounts[EVENT_TYPE_COUNT];     // Producer-side counters
+static SDL_atomic_t gDroppedCounts[EVENT_TYPE_COUNT];
+static double gNanosecondsPerTick = 0.0;
+
+// Check if an event type is valid
+static bool IsValidType(EventType type) {
+    return type >= 0 && type < EVENT_TYPE_COUNT;
+}
+
+// Allocate queue cells and reset positions
+static bool EventQueue_Init(EventQueue* queue, int capacity) {
+    queue->cells = (EventQueueCell*)malloc(sizeof(EventQueueCell) * capacity);
+    if (!queue->cells) return false;
+
+    queue->capacity = capacity;
+    queue->mask = capacity - 1;
+    for (int i = 0; i < capacity; ++i) {
+        SDL_AtomicSet(&queue->cells[i].sequence, i);
+    }
+    SDL_AtomicSet(&queue->enqueuePos, 0);
+    queue->dequeuePos = 0;
+    SDL_AtomicSet(&queue->droppedCount, 0);
+    return true;
+}
+
+// Release queue cells
+static void EventQueue_Free(EventQueue* queue) {
+    free(queue->cells);
+    memset(queue, 0, sizeof(EventQueue));
+}
+
+// Push an event; safe from any thread. Fails (and counts a drop) when full.
+static bool EventQueue_Push(EventQueue* queue, const Event* event) {
+    int pos = SDL_AtomicGet(&queue->enqueuePos);
+
+    for (;;) {
+        EventQueueCell* cell = &queue->cells[pos & queue->mask];
+        int diff = (int)((unsigned int)SDL_AtomicGet(&cell->sequence) - (unsigned int)pos);
+
+        if (diff == 0) {
+            // Cell is free for this position; claim it
+            if (SDL_AtomicCAS(&queue->enqueuePos, pos, (int)((unsigned int)pos + 1))) {
+                cell->event = *event;
+                SDL_AtomicSet(&cell->sequence, (int)((unsigned int)pos + 1)); // Publish
+                return true;
+            }
+            pos = SDL_AtomicGet(&queue->enqueuePos);
+        }
+        else if (diff < 0) {
+            // The consumer has not freed this cell yet: queue is full
+            SDL_AtomicAdd(&queue->droppedCount, 1);
+            return false;
+        }
+        else {
+            // Another producer claimed this position; retry with the current one
+            pos = SDL_AtomicGet(&queue->enqueuePos);
+        }
+    }
+}
+
+// Pop an event; consumer thread only. Returns false if nothing is published.
+static bool EventQueue_Pop(EventQueue* queue, Event* event) {
+    int pos = queue->dequeuePos;
+    EventQueueCell* cell = &queue->cells[pos & queue->mask];
+
+    if (SDL_AtomicGet(&cell->sequence) != (int)((unsigned int)pos + 1)) return false;
+
+    *event = cell->event;
+    SDL_AtomicSet(&cell->sequence, (int)((unsigned int)pos + (unsigned int)queue->capacity)); // Free the cell
+    queue->dequeuePos = (int)((unsigned int)pos + 1);
+    return true;
+}
+
+// Number of claimed positions not yet consumed (approximate while producers are active)
+static int EventQueue_GetCount(EventQueue* queue) {
+    return (int)((unsigned int)SDL_AtomicGet(&queue->enqueuePos) - (unsigned int)queue->dequeuePos);
+}
 
 // Initialize the event system
 void EventSystem_Init() {
-    gCallbackCount = 0;
-    memset(gEventCallbacks, 0, sizeof(gEventCallbacks));
+    memset(gSubscribers, 0, sizeof(gSubscribers));
+    memset(gSubscriberCounts, 0, sizeof(gSubscriberCounts));
+    memset(gCoalescing, 0, sizeof(gCoalescing));
+    EventSystem_ResetStats();
+    gNanosecondsPerTick = 1e9 / (double)SDL_GetPerformanceFrequency();
+
+    if (!EventQueue_Init(&gEventQueue, EVENT_QUEUE_CAPACITY)) {
+        printf("Error: Failed to allocate event queue.\n");
+    }
     printf("Event system initialized.\n");
 }
 
 // Shutdown the event system
 void EventSystem_Shutdown() {
-    gCallbackCount = 0;
+    int pending = gEventQueue.cells ? EventQueue_GetCount(&gEventQueue) : 0;
+    if (pending > 0) {
+        printf("Warning: %d queued events discarded.\n", pending);
+    }
+    EventQueue_Free(&gEventQueue);
+    memset(gSubscriberCounts, 0, sizeof(gSubscriberCounts));
     printf("Event system shut down.\n");
 }
 
 // Register a callback for a specific event type
 bool EventSystem_RegisterCallback(EventType type, EventCallback callback) {
-    if (gCallbackCount >= MAX_CALLBACKS) {
-        printf("Error: Maximum number of event callbacks reached.\n");
+    if (!IsValidType(type) || !callback) return false;
+
+    if (gSubscriberCounts[type] >= MAX_SUBSCRIBERS_PER_TYPE) {
+        printf("Error: Maximum number of callbacks reached for event type %d.\n", type);
         return false;
     }
 
-    gEventCallbacks[gCallbackCount++] = (EventCallbackEntry){ type, callback };
+    gSubscribers[type][gSubscriberCounts[type]++] = callback;
     printf("Callback registered for event type %d.\n", type);
     return true;
 }
 
 // Unregister a callback for a specific event type
 void EventSystem_UnregisterCallback(EventType type, EventCallback callback) {
-    for (int i = 0; i < gCallbackCount; ++i) {
-        if (gEventCallbacks[i].type == type && gEventCallbacks[i].callback == callback) {
-            gEventCallbacks[i] = gEventCallbacks[--gCallbackCount];
+    if (!IsValidType(type)) return;
+
+    EventCallback* subscribers = gSubscribers[type];
+    int count = gSubscriberCounts[type];
+    for (int i = 0; i < count; ++i) {
+        if (subscribers[i] == callback) {
+            memmove(&subscribers[i], &subscribers[i + 1], sizeof(EventCallback) * (count - i - 1));
+            gSubscriberCounts[type]--;
             printf("Callback unregistered for event type %d.\n", type);
             return;
         }
@@ -52,16 +166,231 @@ void EventSystem_UnregisterCallback(EventType type, EventCallback callback) {
     printf("Warning: Callback not found for event type %d.\n", type);
 }
 
-// Trigger an event
+// Dispatch an event to its subscribers
+static void DispatchEvent(Event* event) {
+    EventTypeStats* stats = &gEventStats[event->type];
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    for (int i = 0; i < gSubscriberCounts[event->type]; ++i) {
+        gSubscribers[event->type][i](event);
+    }
+
+    stats->triggeredCount++;
+    stats->dispatchTimeNs += (uint64_t)((double)(SDL_GetPerformanceCounter() - start) * gNanosecondsPerTick);
+}
+
+// Trigger an event immediately (main thread only)
 void EventSystem_TriggerEvent(Event* event) {
-    if (!event) return;
+    if (!event || !IsValidType(event->type)) return;
 
-    printf("Event triggered: type %d.\n", event->type);
-    for (int i = 0; i < gCallbackCount; ++i) {
-        if (gEventCallbacks[i].type == event->type) {
-            gEventCallbacks[i].callback(event);
+    DispatchEvent(event);
+}
+
+// Compare two names that may be NULL
+static bool IsSameName(const char* a, const char* b) {
+    return a == b || (a && b && strcmp(a, b) == 0);
+}
+
+// Check if two events of the same type carry the same payload key
+static bool IsSamePayload(const Event* a, const Event* b) {
+    switch (a->type) {
+    case EVENT_TYPE_DIALOGUE:
+        return a->data.dialogueEvent.dialogueText == b->data.dialogueEvent.dialogueText;
+    case EVENT_TYPE_CUTSCENE:
+        return a->data.cutsceneEvent.cutsceneName == b->data.cutsceneEvent.cutsceneName;
+    case EVENT_TYPE_ITEM_GAINED:
+        return a->data.itemGainedEvent.itemNameHash == b->data.itemGainedEvent.itemNameHash &&
+            IsSameName(a->data.itemGainedEvent.itemName, b->data.itemGainedEvent.itemName);
+    case EVENT_TYPE_BATTLE_TRIGGERED:
+        return a->data.battleTriggeredEvent.enemyGroupName == b->data.battleTriggeredEvent.enemyGroupName;
+    case EVENT_TYPE_CUSTOM:
+        return a->data.customEvent.customData == b->data.customEvent.customData;
+    default:
+        return false;
+    }
+}
+
+// Merge an event into a matching one earlier in the batch; returns true if it was absorbed
+static bool CoalesceEvent(Event* batch, int count, const Event* event) {
+    for (int i = 0; i < count; ++i) {
+        Event* pending = &batch[i];
+        if (pending->type != event->type || !IsSamePayload(pending, event)) continue;
+
+        // Item gains add up; any other duplicate is simply dropped
+        if (event->type == EVENT_TYPE_ITEM_GAINED) {
+            pending->data.itemGainedEvent.quantity += event->data.itemGainedEvent.quantity;
         }
+        return true;
     }
+    return false;
+}
+
+// Queue an event for the next dispatch point (safe from any thread)
+bool EventSystem_QueueEvent(const Event* event) {
+    if (!event || !IsValidType(event->type) || !gEventQueue.cells) return false;
+
+    if (!EventQueue_Push(&gEventQueue, event)) {
+        SDL_AtomicAdd(&gDroppedCounts[event->type], 1);
+        return false;
+    }
+    SDL_AtomicAdd(&gQueuedCounts[event->type], 1);
+    return true;
+}
+
+// Dispatch the events queued so far in batches (main thread only).
+// Events queued while draining, including by callbacks, wait for the next call.
+int EventSystem_DispatchQueued() {
+    if (!gEventQueue.cells) return 0;
+
+    Event batch[EVENT_DRAIN_BATCH_SIZE];
+    int remaining = EventQueue_GetCount(&gEventQueue);
+    int dispatched = 0;
+
+    while (remaining > 0) {
+        int count = 0;
+        while (count < EVENT_DRAIN_BATCH_SIZE && remaining > 0 && EventQueue_Pop(&gEventQueue, &batch[count])) {
+            remaining--;
+            if (gCoalescing[batch[count].type] && CoalesceEvent(batch, count, &batch[count])) {
+                gEventStats[batch[count].type].coalescedCount++;
+                continue;
+            }
+            count++;
+        }
+        if (count == 0) break; // Remaining positions are claimed but not yet published
+
+        for (int i = 0; i < count; ++i) {
+            DispatchEvent(&batch[i]);
+        }
+        dispatched += count;
+    }
+    return dispatched;
+}
+
+// Get the number of events waiting for dispatch
+int EventSystem_GetQueuedCount() {
+    return gEventQueue.cells ? EventQueue_GetCount(&gEventQueue) : 0;
+}
+
+// Get the number of events lost to a full queue since the last reset
+int EventSystem_GetDroppedCount() {
+    return SDL_AtomicGet(&gEventQueue.droppedCount);
+}
+
+// Enable or disable coalescing of queued events of a type (merged within each drain batch)
+void EventSystem_SetCoalescing(EventType type, bool enabled) {
+    if (!IsValidType(type)) return;
+    gCoalescing[type] = enabled;
+}
+
+// Get statistics for an event type
+bool EventSystem_GetStats(EventType type, EventTypeStats* stats) {
+    if (!IsValidType(type) || !stats) return false;
+
+    *stats = gEventStats[type];
+    stats->queuedCount = (uint32_t)SDL_AtomicGet(&gQueuedCounts[type]);
+    stats->droppedCount = (uint32_t)SDL_AtomicGet(&gDroppedCounts[type]);
+    return true;
+}
+
+// Reset all event statistics
+void EventSystem_ResetStats() {
+    memset(gEventStats, 0, sizeof(gEventStats));
+    for (int i = 0; i < EVENT_TYPE_COUNT; ++i) {
+        SDL_AtomicSet(&gQueuedCounts[i], 0);
+        SDL_AtomicSet(&gDroppedCounts[i], 0);
+    }
+    SDL_AtomicSet(&gEventQueue.droppedCount, 0);
+}
+
+// Spin briefly, then give up the time slice (keeps the benchmark honest on few cores)
+static void BenchmarkBackoff(int* spins) {
+    if (++*spins < 64) {
+        SDL_CPUPauseInstruction();
+    }
+    else {
+        SDL_Delay(0);
+        *spins = 0;
+    }
+}
+
+// Stress benchmark producer state
+typedef struct {
+    EventQueue* queue;
+    int eventCount;
+    SDL_atomic_t* startFlag;
+    SDL_atomic_t* finishedCount;
+} BenchmarkProducer;
+
+// Stress benchmark producer thread: pushes events, retrying while the queue is full
+static int SDLCALL BenchmarkProducerThread(void* data) {
+    BenchmarkProducer* producer = (BenchmarkProducer*)data;
+    Event event = Event_CreateCustom(producer);
+    int spins = 0;
+
+    while (SDL_AtomicGet(producer->startFlag) == 0) {
+        BenchmarkBackoff(&spins);
+    }
+    for (int i = 0; i < producer->eventCount; ++i) {
+        while (!EventQueue_Push(producer->queue, &event)) {
+            BenchmarkBackoff(&spins);
+        }
+    }
+    SDL_AtomicAdd(producer->finishedCount, 1);
+    return 0;
+}
+
+// Measure queue throughput with several producer threads and one draining consumer.
+// Uses a private queue, so it does not disturb live events. Returns events per second.
+double EventSystem_RunStressBenchmark(int producerCount, int eventsPerProducer) {
+    if (producerCount < 1 || producerCount > 64 || eventsPerProducer < 1) return 0.0;
+
+    EventQueue queue;
+    if (!EventQueue_Init(&queue, EVENT_QUEUE_CAPACITY)) return 0.0;
+
+    SDL_Thread* threads[64];
+    BenchmarkProducer producers[64];
+    SDL_atomic_t startFlag;
+    SDL_atomic_t finishedCount;
+    SDL_AtomicSet(&startFlag, 0);
+    SDL_AtomicSet(&finishedCount, 0);
+
+    int started = 0;
+    for (int i = 0; i < producerCount; ++i) {
+        producers[i] = (BenchmarkProducer){ &queue, eventsPerProducer, &startFlag, &finishedCount };
+        threads[i] = SDL_CreateThread(BenchmarkProducerThread, "EventBenchProducer", &producers[i]);
+        if (!threads[i]) break;
+        started++;
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    SDL_AtomicSet(&startFlag, 1);
+
+    // Drain in batches until every producer is done and the queue is empty
+    long long received = 0;
+    long long expected = (long long)started * eventsPerProducer;
+    Event event;
+    int spins = 0;
+    while (received < expected) {
+        int drained = 0;
+        while (drained < EVENT_DRAIN_BATCH_SIZE && EventQueue_Pop(&queue, &event)) {
+            drained++;
+        }
+        received += drained;
+        if (drained == 0) {
+            BenchmarkBackoff(&spins);
+        }
+    }
+
+    double seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    for (int i = 0; i < started; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    EventQueue_Free(&queue);
+
+    double eventsPerSecond = seconds > 0.0 ? (double)received / seconds : 0.0;
+    printf("Event queue benchmark: %d producers, %lld events, %.2f M events/s\n",
+        started, received, eventsPerSecond / 1e6);
+    return eventsPerSecond;
 }
 
 // Utilities for creating events
@@ -82,7 +411,7 @@ Event Event_CreateCutscene(const char* cutsceneName) {
 Event Event_CreateItemGained(const char* itemName, int quantity) {
     return (Event) {
         .type = EVENT_TYPE_ITEM_GAINED,
-            .data.itemGainedEvent = { .itemName = itemName, .quantity = quantity }
+            .data.itemGainedEvent = { .itemName = itemName, .itemNameHash = Hash_String(itemName), .quantity = quantity }
     };
 }
 
@@ -1,5 +1,7 @@
 // file_utils.c
 #include "file_utils.h"
+#include "pack_archive.h"
+#include "vfs.h" // Paths resolve through mounts before the host file system
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -10,45 +12,84 @@
 #include <sys/stat.h> // For checking file existence and size on PC
 #endif
 
-// Check if a file exists
-bool File_Exists(const char* filepath) {
+#if !defined(DREAMCAST) && !defined(_WIN32)
+#define FILE_UTILS_HAVE_MMAP
+#include <sys/mman.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h> // For MoveFileEx
+#include <io.h>      // For _commit
+#endif
+
+// Get the size of a file on the host file system (false if it does not exist)
+static bool GetHostFileSize(const char* hostPath, size_t* outSize) {
 #ifdef DREAMCAST
-    FILE* file = fopen(filepath, "r");
-    if (file) {
-        fclose(file);
-        return true;
-    }
-    return false;
+    FILE* file = fopen(hostPath, "r");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    *outSize = ftell(file);
+    fclose(file);
+    return true;
 #else
     struct stat buffer;
-    return (stat(filepath, &buffer) == 0);
+    if (stat(hostPath, &buffer) != 0) return false;
+    *outSize = buffer.st_size;
+    return true;
 #endif
 }
 
+// Check if a file exists
+bool File_Exists(const char* filepath) {
+    VfsResolution resolution;
+    if (!Vfs_Resolve(filepath, &resolution)) return false;
+    if (resolution.mount != VFS_MOUNT_NONE) return true; // Found in a pack or a mounted directory
+
+    size_t size = 0;
+    return GetHostFileSize(resolution.hostPath, &size);
+}
+
 // Get the size of a file
 size_t File_GetSize(const char* filepath) {
-#ifdef DREAMCAST
-    FILE* file = fopen(filepath, "r");
-    if (!file) return 0;
-    fseek(file, 0, SEEK_END);
-    size_t size = ftell(file);
-    fclose(file);
-    return size;
-#else
-    struct stat buffer;
-    if (stat(filepath, &buffer) == 0) {
-        return buffer.st_size;
+    VfsResolution resolution;
+    if (!Vfs_ResolveRetained(filepath, &resolution)) return 0;
+    if (resolution.entry) {
+        size_t entrySize = (size_t)resolution.entry->size;
+        Vfs_ReleaseResolution(&resolution);
+        return entrySize;
     }
-    return 0;
-#endif
+
+    size_t size = 0;
+    return GetHostFileSize(resolution.hostPath, &size) ? size : 0;
 }
 
 // Read all text from a file
 char* File_ReadAllText(const char* filepath) {
-    size_t size = File_GetSize(filepath);
-    if (size == 0) return NULL;
+    VfsResolution resolution;
+    if (!Vfs_ResolveRetained(filepath, &resolution)) return NULL;
+
+    const PackArchive* pack = resolution.pack;
+    const PackEntry* entry = resolution.entry;
+    if (entry) {
+        char* content = (char*)malloc((size_t)entry->size + 1);
+        if (content && PackArchive_Read(pack, entry, content, (size_t)entry->size)) {
+            content[entry->size] = '\0';
+        }
+        else {
+            free(content);
+            content = NULL;
+        }
+        Vfs_ReleaseResolution(&resolution);
+        return content;
+    }
+
+    size_t size = 0;
+    if (!GetHostFileSize(resolution.hostPath, &size) || size == 0) return NULL;
 
-    FILE* file = fopen(filepath, "r");
+    FILE* file = fopen(resolution.hostPath, "r");
     if (!file) return NULL;
 
     char* content = (char*)malloc(size + 1);
@@ -57,39 +98,537 @@ char* File_ReadAllText(const char* filepath) {
         return NULL;
     }
 
-    fread(content, 1, size, file);
-    content[size] = '\0';
-
+    // Text mode may translate line endings, so the count read can be short of the file size
+    size_t read = fread(content, 1, size, file);
+    bool failed = ferror(file) != 0;
     fclose(file);
+    if (failed) {
+        free(content);
+        return NULL;
+    }
+
+    content[read] = '\0';
     return content;
 }
 
 // Write text to a file
 bool File_WriteAllText(const char* filepath, const char* content) {
-    FILE* file = fopen(filepath, "w");
+    char hostPath[VFS_MAX_PATH];
+    if (!Vfs_GetWritePath(filepath, hostPath, sizeof(hostPath))) return false;
+
+    FILE* file = fopen(hostPath, "w");
     if (!file) return false;
 
-    fprintf(file, "%s", content);
-    fclose(file);
-    return true;
+    bool written = fputs(content, file) >= 0;
+    written = fclose(file) == 0 && written;
+    Vfs_Invalidate(filepath);
+    return written;
 }
 
 // Read binary data from a file
 bool File_ReadBinary(const char* filepath, void* buffer, size_t size) {
-    FILE* file = fopen(filepath, "rb");
+    VfsResolution resolution;
+    if (!Vfs_ResolveRetained(filepath, &resolution)) return false;
+
+    const PackArchive* pack = resolution.pack;
+    const PackEntry* entry = resolution.entry;
+    if (entry) {
+        bool isRead;
+        if (size >= entry->size) {
+            isRead = PackArchive_Read(pack, entry, buffer, size);
+        }
+        else {
+            // Partial read: only possible in place for uncompressed entries
+            const void* data = PackArchive_GetData(pack, entry);
+            if (data) memcpy(buffer, data, size);
+            isRead = data != NULL;
+        }
+        Vfs_ReleaseResolution(&resolution);
+        return isRead;
+    }
+
+    FILE* file = fopen(resolution.hostPath, "rb");
     if (!file) return false;
 
-    fread(buffer, 1, size, file);
+    // Asking for more than the file holds is allowed; a read error is not
+    size_t read = fread(buffer, 1, size, file);
+    bool succeeded = read == size || (feof(file) && !ferror(file));
     fclose(file);
-    return true;
+    return succeeded;
 }
 
 // Write binary data to a file
 bool File_WriteBinary(const char* filepath, const void* buffer, size_t size) {
+    char hostPath[VFS_MAX_PATH];
+    if (!Vfs_GetWritePath(filepath, hostPath, sizeof(hostPath))) return false;
+
+    FILE* file = fopen(hostPath, "wb");
+    if (!file) return false;
+
+    bool written = fwrite(buffer, 1, size, file) == size;
+    written = fclose(file) == 0 && written;
+    Vfs_Invalidate(filepath);
+    return written;
+}
+
+// Flush a stream all the way to the storage device
+bool File_Sync(FILE* file) {
+    if (!file || fflush(file) != 0) return false;
+
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#elif defined(DREAMCAST)
+    return true; // KOS file systems write through on flush
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+#if !defined(DREAMCAST) && !defined(_WIN32)
+// Sync the directory holding a file so a rename into it survives a power loss
+static void SyncParentDirectory(const char* filepath) {
+    char directory[512];
+    const char* slash = strrchr(filepath, '/');
+    if (!slash) {
+        strcpy(directory, ".");
+    }
+    else {
+        size_t length = (size_t)(slash - filepath);
+        if (length == 0) length = 1; // File in the root directory
+        if (length >= sizeof(directory)) return;
+        memcpy(directory, filepath, length);
+        directory[length] = '\0';
+    }
+
+    int fd = open(directory, O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+#endif
+
+// Replace a host file atomically: write a temp file, sync it, then rename it over the target
+static bool ReplaceHostFile(const char* filepath, const void* buffer, size_t size) {
+#ifdef DREAMCAST
+    // VMU and SD file systems have no rename; the whole file is rewritten in one pass
     FILE* file = fopen(filepath, "wb");
     if (!file) return false;
+    bool written = fwrite(buffer, 1, size, file) == size;
+    written = File_Sync(file) && written;
+    return fclose(file) == 0 && written;
+#else
+    char tempPath[512];
+    if (snprintf(tempPath, sizeof(tempPath), "%s.tmp", filepath) >= (int)sizeof(tempPath)) return false;
+
+    FILE* file = fopen(tempPath, "wb");
+    if (!file) return false;
+
+    bool written = fwrite(buffer, 1, size, file) == size;
+    written = File_Sync(file) && written;
+    written = fclose(file) == 0 && written;
+    if (!written) {
+        remove(tempPath);
+        return false;
+    }
+
+#ifdef _WIN32
+    if (!MoveFileExA(tempPath, filepath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        remove(tempPath);
+        return false;
+    }
+#else
+    if (rename(tempPath, filepath) != 0) {
+        remove(tempPath);
+        return false;
+    }
+    SyncParentDirectory(filepath);
+#endif
+    return true;
+#endif
+}
+
+// Replace a file atomically (in the writable mount covering it, if any)
+bool File_WriteAtomic(const char* filepath, const void* buffer, size_t size) {
+    if (!filepath || (!buffer && size > 0)) return false;
+
+    char hostPath[VFS_MAX_PATH];
+    if (!Vfs_GetWritePath(filepath, hostPath, sizeof(hostPath))) return false;
+
+    bool written = ReplaceHostFile(hostPath, buffer, size);
+    Vfs_Invalidate(filepath);
+    return written;
+}
+
+// Delete a file from the writable mount (or the host path when none)
+bool File_Delete(const char* filepath) {
+    if (!filepath) return false;
+
+    char hostPath[VFS_MAX_PATH];
+    if (!Vfs_GetWritePath(filepath, hostPath, sizeof(hostPath))) return false;
+
+    bool deleted = remove(hostPath) == 0;
+    Vfs_Invalidate(filepath);
+    return deleted;
+}
+
+// Map a whole file read-only (falls back to reading it into memory)
+bool File_Map(const char* filepath, FileMapping* mapping) {
+    if (!filepath || !mapping) return false;
+    memset(mapping, 0, sizeof(FileMapping));
+
+    VfsResolution resolution;
+    if (!Vfs_ResolveRetained(filepath, &resolution)) return false;
+
+    // Uncompressed pack entries are used in place, keeping the pack mounted until File_Unmap;
+    // compressed ones are unpacked to the heap
+    const PackArchive* pack = resolution.pack;
+    const PackEntry* entry = resolution.entry;
+    if (entry) {
+        const void* data = PackArchive_GetData(pack, entry);
+        if (data) {
+            mapping->data = data;
+            mapping->isBorrowed = true;
+            mapping->packMount = resolution.mount;
+        }
+        else {
+            mapping->data = PackArchive_ReadAlloc(pack, entry, NULL);
+            Vfs_ReleaseResolution(&resolution);
+        }
+        mapping->size = (size_t)entry->size;
+        return mapping->data != NULL;
+    }
+
+    return File_MapHost(resolution.hostPath, mapping);
+}
+
+// Map a host file directly, bypassing the VFS (offline tools reading their sources)
+bool File_MapHost(const char* hostPath, FileMapping* mapping) {
+    if (!hostPath || !mapping) return false;
+    memset(mapping, 0, sizeof(FileMapping));
+
+#ifdef FILE_UTILS_HAVE_MMAP
+    int fd = open(hostPath, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps its own reference to the file
+    if (data == MAP_FAILED) return false;
 
-    fwrite(buffer, 1, size, file);
+    mapping->data = data;
+    mapping->size = (size_t)info.st_size;
+    mapping->isMapped = true;
+    return true;
+#else
+    size_t size = 0;
+    if (!GetHostFileSize(hostPath, &size) || size == 0) return false;
+
+    void* data = malloc(size);
+    if (!data) return false;
+
+    FILE* file = fopen(hostPath, "rb");
+    if (!file || fread(data, 1, size, file) != size) {
+        if (file) fclose(file);
+        free(data);
+        return false;
+    }
     fclose(file);
+
+    mapping->data = data;
+    mapping->size = size;
+    mapping->isMapped = false;
     return true;
+#endif
+}
+
+// Release a file mapping
+void File_Unmap(FileMapping* mapping) {
+    if (!mapping || !mapping->data) return;
+    if (mapping->isBorrowed) {
+        Vfs_ReleaseMount(mapping->packMount);
+        memset(mapping, 0, sizeof(FileMapping));
+        return;
+    }
+
+#ifdef FILE_UTILS_HAVE_MMAP
+    if (mapping->isMapped) {
+        munmap((void*)mapping->data, mapping->size);
+    }
+    else {
+        free((void*)mapping->data);
+    }
+#else
+    free((void*)mapping->data);
+#endif
+
+    memset(mapping, 0, sizeof(FileMapping));
+}
+
+// Hint how a mapped range will be read (no-op for heap and pack-backed mappings)
+void File_AdviseMapping(const FileMapping* mapping, size_t offset, size_t size, FileAccessPattern pattern) {
+    if (!mapping || !mapping->isMapped || offset >= mapping->size) return;
+    if (size > mapping->size - offset) size = mapping->size - offset;
+
+#ifdef FILE_UTILS_HAVE_MMAP
+    int advice = MADV_NORMAL;
+    switch (pattern) {
+    case FILE_ACCESS_SEQUENTIAL: advice = MADV_SEQUENTIAL; break;
+    case FILE_ACCESS_RANDOM:     advice = MADV_RANDOM; break;
+    case FILE_ACCESS_WILLNEED:   advice = MADV_WILLNEED; break;
+    default: break;
+    }
+
+    // madvise works on whole pages; the mapping itself starts on a page boundary
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)mapping->data + offset;
+    uintptr_t alignedStart = start & ~(pageSize - 1);
+    madvise((void*)alignedStart, size + (size_t)(start - alignedStart), advice);
+#else
+    (void)pattern;
+#endif
+}
+
+// Chunked Reader
+
+#define FILE_READER_MIN_READAHEAD (256 * 1024)
+
+#if defined(FILE_UTILS_HAVE_MMAP) && defined(POSIX_FADV_WILLNEED)
+#define FILE_UTILS_HAVE_FADVISE
+#endif
+
+// Keep readahead requested ahead of the position, in batches of half the window
+static void RequestReadahead(FileReader* reader) {
+#ifdef FILE_UTILS_HAVE_FADVISE
+    if (reader->fd < 0 || reader->readahead == 0) return;
+
+    uint64_t target = reader->position + reader->readahead;
+    if (target > reader->size) target = reader->size;
+    if (target <= reader->hintedUpTo) return;
+    if (target - reader->hintedUpTo < reader->readahead / 2 && target < reader->size) return;
+
+    uint64_t from = reader->hintedUpTo > reader->position ? reader->hintedUpTo : reader->position;
+    posix_fadvise(reader->fd, (off_t)from, (off_t)(target - from), POSIX_FADV_WILLNEED);
+    reader->hintedUpTo = target;
+#else
+    (void)reader;
+#endif
+}
+
+// Fetch the next bytes from the source into a destination; short only at the end or on error
+static size_t FetchBytes(FileReader* reader, void* destination, size_t size) {
+    uint64_t remaining = reader->size - reader->position;
+    if (size > remaining) size = (size_t)remaining;
+    if (size == 0 || reader->failed) return 0;
+
+    size_t total = 0;
+    if (reader->memory) {
+        memcpy(destination, reader->memory + reader->position, size);
+        total = size;
+    }
+    else {
+        RequestReadahead(reader);
+#ifdef FILE_UTILS_HAVE_MMAP
+        while (total < size) {
+            ssize_t count = read(reader->fd, (uint8_t*)destination + total, size - total);
+            if (count < 0 && errno == EINTR) continue;
+            if (count <= 0) break;
+            total += (size_t)count;
+        }
+#else
+        total = fread(destination, 1, size, reader->file);
+#endif
+        if (total < size) reader->failed = true; // The file shrank or the device failed
+    }
+
+    reader->position += total;
+    return total;
+}
+
+// Open a file for chunked reading through a caller-owned buffer
+bool FileReader_Open(FileReader* reader, const char* filepath, void* buffer, size_t bufferSize, FileAccessPattern pattern) {
+    if (!reader || !filepath || !buffer || bufferSize == 0) return false;
+    memset(reader, 0, sizeof(FileReader));
+    reader->fd = -1;
+    reader->buffer = (uint8_t*)buffer;
+    reader->bufferSize = bufferSize;
+
+    VfsResolution resolution;
+    if (!Vfs_ResolveRetained(filepath, &resolution)) return false;
+
+    // Pack entries are already in memory: uncompressed ones are read in place, keeping the pack
+    // mounted until FileReader_Close
+    const PackArchive* pack = resolution.pack;
+    const PackEntry* entry = resolution.entry;
+    if (entry) {
+        reader->memory = (const uint8_t*)PackArchive_GetData(pack, entry);
+        if (reader->memory) {
+            reader->packMount = resolution.mount;
+        }
+        else {
+            reader->ownedMemory = PackArchive_ReadAlloc(pack, entry, NULL);
+            reader->memory = (const uint8_t*)reader->ownedMemory;
+            Vfs_ReleaseResolution(&resolution);
+        }
+        reader->size = entry->size;
+        return reader->memory != NULL;
+    }
+
+#ifdef FILE_UTILS_HAVE_MMAP
+    reader->fd = open(resolution.hostPath, O_RDONLY);
+    if (reader->fd < 0) return false;
+
+    struct stat info;
+    if (fstat(reader->fd, &info) != 0) {
+        close(reader->fd);
+        reader->fd = -1;
+        return false;
+    }
+    reader->size = (uint64_t)info.st_size;
+#else
+    // Reads go straight into the caller's buffer, so stdio's own buffer would only add a copy
+    reader->file = fopen(resolution.hostPath, "rb");
+    if (!reader->file) return false;
+    setvbuf(reader->file, NULL, _IONBF, 0);
+
+    fseek(reader->file, 0, SEEK_END);
+    long size = ftell(reader->file);
+    fseek(reader->file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(reader->file);
+        reader->file = NULL;
+        return false;
+    }
+    reader->size = (uint64_t)size;
+#endif
+
+    switch (pattern) {
+    case FILE_ACCESS_RANDOM:
+        reader->readahead = 0;
+        break;
+    case FILE_ACCESS_NORMAL:
+        reader->readahead = bufferSize * 2;
+        break;
+    default:
+        reader->readahead = bufferSize * 4;
+        if (reader->readahead < FILE_READER_MIN_READAHEAD) reader->readahead = FILE_READER_MIN_READAHEAD;
+        break;
+    }
+
+#ifdef FILE_UTILS_HAVE_FADVISE
+    int advice = POSIX_FADV_NORMAL;
+    if (pattern == FILE_ACCESS_SEQUENTIAL || pattern == FILE_ACCESS_WILLNEED) advice = POSIX_FADV_SEQUENTIAL;
+    else if (pattern == FILE_ACCESS_RANDOM) advice = POSIX_FADV_RANDOM;
+    posix_fadvise(reader->fd, 0, 0, advice);
+
+    if (pattern == FILE_ACCESS_WILLNEED) {
+        posix_fadvise(reader->fd, 0, 0, POSIX_FADV_WILLNEED);
+        reader->hintedUpTo = reader->size;
+    }
+#endif
+    return true;
+}
+
+// Close a reader (the caller's buffer is left alone)
+void FileReader_Close(FileReader* reader) {
+    if (!reader) return;
+#ifdef FILE_UTILS_HAVE_MMAP
+    if (reader->fd >= 0) close(reader->fd);
+#endif
+    if (reader->file) fclose(reader->file);
+    free(reader->ownedMemory);
+    Vfs_ReleaseMount(reader->packMount);
+    memset(reader, 0, sizeof(FileReader));
+    reader->fd = -1;
+}
+
+// Get the next chunk: pack entries point into the pack, loose files into the caller's buffer
+size_t FileReader_Next(FileReader* reader, const void** outChunk) {
+    if (!reader || !outChunk) return 0;
+    *outChunk = NULL;
+
+    // Bytes FileReader_Read fetched but did not consume come first
+    if (reader->bufferedCount > 0) {
+        size_t count = reader->bufferedCount;
+        *outChunk = reader->buffer + reader->bufferedOffset;
+        reader->bufferedCount = 0;
+        return count;
+    }
+
+    if (reader->memory) {
+        uint64_t remaining = reader->size - reader->position;
+        size_t count = remaining < reader->bufferSize ? (size_t)remaining : reader->bufferSize;
+        *outChunk = reader->memory + reader->position;
+        reader->position += count;
+        return count;
+    }
+
+    size_t count = FetchBytes(reader, reader->buffer, reader->bufferSize);
+    if (count > 0) *outChunk = reader->buffer;
+    return count;
+}
+
+// Copy the next bytes out; large reads bypass the chunk buffer
+size_t FileReader_Read(FileReader* reader, void* output, size_t size) {
+    if (!reader || (!output && size > 0)) return 0;
+
+    uint8_t* destination = (uint8_t*)output;
+    size_t total = 0;
+    while (total < size) {
+        if (reader->bufferedCount > 0) {
+            size_t count = size - total;
+            if (count > reader->bufferedCount) count = reader->bufferedCount;
+            memcpy(destination + total, reader->buffer + reader->bufferedOffset, count);
+            reader->bufferedOffset += count;
+            reader->bufferedCount -= count;
+            total += count;
+            continue;
+        }
+
+        size_t count;
+        if (reader->memory || size - total >= reader->bufferSize) {
+            count = FetchBytes(reader, destination + total, size - total);
+            total += count;
+            break;
+        }
+
+        // Small read: fill the buffer once and serve the rest from it
+        count = FetchBytes(reader, reader->buffer, reader->bufferSize);
+        if (count == 0) break;
+        reader->bufferedOffset = 0;
+        reader->bufferedCount = count;
+    }
+    return total;
+}
+
+// Move to an absolute position (past the end clamps to the end)
+bool FileReader_Seek(FileReader* reader, uint64_t position) {
+    if (!reader) return false;
+    if (position > reader->size) position = reader->size;
+    reader->bufferedCount = 0;
+    reader->bufferedOffset = 0;
+
+    if (!reader->memory) {
+#ifdef FILE_UTILS_HAVE_MMAP
+        if (lseek(reader->fd, (off_t)position, SEEK_SET) < 0) return false;
+#else
+        if (fseek(reader->file, (long)position, SEEK_SET) != 0) return false;
+#endif
+    }
+
+    reader->position = position;
+    reader->failed = false;
+    if (reader->hintedUpTo < position || reader->hintedUpTo > position + reader->readahead) {
+        reader->hintedUpTo = position;
+    }
+    return true;
+}
+
+// Get the position of the next byte Next or Read returns
+uint64_t FileReader_Tell(const FileReader* reader) {
+    return reader ? reader->position - reader->bufferedCount : 0;
 }
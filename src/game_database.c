@@ -0,0 +1,536 @@
+// game_database.c
+#include "game_database.h"
+#include "hash_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Offline builder state
+struct GameDBBuilder {
+    GameDBItemRecord* items;
+    int itemCount;
+    int itemCapacity;
+
+    GameDBSkillRecord* skills;
+    int skillCount;
+    int skillCapacity;
+
+    GameDBStatRecord* stats;
+    int statCount;
+    int statCapacity;
+
+    char* strings;          // String pool being built
+    size_t stringSize;
+    size_t stringCapacity;
+    HashIndex stringIndex;  // Deduplicates pooled strings (hash -> offset)
+};
+
+// Round an offset up to the record alignment
+static uint32_t AlignOffset(uint32_t offset) {
+    return (offset + (GAMEDB_ALIGNMENT - 1)) & ~(uint32_t)(GAMEDB_ALIGNMENT - 1);
+}
+
+// Check that a section lies inside the file
+static bool IsSectionValid(uint32_t offset, uint32_t count, size_t recordSize, uint32_t fileSize) {
+    if (count == 0) return true;
+    if (offset % GAMEDB_ALIGNMENT != 0 || offset > fileSize) return false;
+    return (uint64_t)count * recordSize <= (uint64_t)(fileSize - offset);
+}
+
+// Open and validate a database file
+GameDatabase* GameDB_Open(const char* filepath) {
+    if (!filepath) return NULL;
+
+    GameDatabase* db = (GameDatabase*)calloc(1, sizeof(GameDatabase));
+    if (!db) return NULL;
+
+    if (!File_Map(filepath, &db->mapping)) {
+        printf("Failed to open game database: %s\n", filepath);
+        free(db);
+        return NULL;
+    }
+
+    const uint8_t* base = (const uint8_t*)db->mapping.data;
+    const GameDBHeader* header = (const GameDBHeader*)base;
+    bool isValid = db->mapping.size >= sizeof(GameDBHeader) &&
+        header->magic == GAMEDB_MAGIC &&
+        header->version == GAMEDB_VERSION &&
+        header->fileSize <= db->mapping.size &&
+        IsSectionValid(header->itemOffset, header->itemCount, sizeof(GameDBItemRecord), header->fileSize) &&
+        IsSectionValid(header->skillOffset, header->skillCount, sizeof(GameDBSkillRecord), header->fileSize) &&
+        IsSectionValid(header->statOffset, header->statCount, sizeof(GameDBStatRecord), header->fileSize) &&
+        header->stringPoolSize > 0 &&
+        IsSectionValid(header->stringPoolOffset, header->stringPoolSize, 1, header->fileSize) &&
+        base[header->stringPoolOffset + header->stringPoolSize - 1] == '\0';
+
+    if (!isValid) {
+        printf("Invalid game database: %s\n", filepath);
+        File_Unmap(&db->mapping);
+        free(db);
+        return NULL;
+    }
+
+    db->header = header;
+    db->itemRecords = (const GameDBItemRecord*)(base + header->itemOffset);
+    db->skillRecords = (const GameDBSkillRecord*)(base + header->skillOffset);
+    db->statRecords = (const GameDBStatRecord*)(base + header->statOffset);
+    db->strings = (const char*)(base + header->stringPoolOffset);
+
+    printf("Game database opened: %s (%u items, %u skills, %u stat tables)\n", filepath,
+        header->itemCount, header->skillCount, header->statCount);
+    return db;
+}
+
+// Close a database, unregistering its content first
+void GameDB_Close(GameDatabase* db) {
+    if (!db) return;
+
+    GameDB_UnregisterContent(db);
+    File_Unmap(&db->mapping);
+    free(db);
+}
+
+// Register all items and skills with their registries (all or nothing)
+bool GameDB_RegisterContent(GameDatabase* db) {
+    if (!db || db->isRegistered) return false;
+
+    uint32_t itemCount = db->header->itemCount;
+    uint32_t skillCount = db->header->skillCount;
+
+    db->items = itemCount ? (Item*)malloc(sizeof(Item) * itemCount) : NULL;
+    db->skills = skillCount ? (Skill*)malloc(sizeof(Skill) * skillCount) : NULL;
+    if ((itemCount && !db->items) || (skillCount && !db->skills)) {
+        free(db->items);
+        free(db->skills);
+        db->items = NULL;
+        db->skills = NULL;
+        return false;
+    }
+
+    for (uint32_t i = 0; i < itemCount; ++i) {
+        const GameDBItemRecord* record = &db->itemRecords[i];
+        Item* item = &db->items[i];
+
+        item->name = GameDB_GetString(db, record->nameOffset);
+        item->type = (ItemType)record->type;
+        item->rarity = (ItemRarity)record->rarity;
+        item->value = record->value;
+        item->description = GameDB_GetString(db, record->descriptionOffset);
+        item->effectPower = record->effectPower;
+        item->durability = record->durability;
+        item->nameID = StringID_Intern(item->name);
+        item->nameHash = record->nameHash;
+        item->isDatabaseRecord = true;
+        if (!Item_Register(item)) {
+            printf("Failed to register database item %u: %s\n", i, item->name);
+            db->isRegistered = true; // Roll back what was registered so far
+            GameDB_UnregisterContent(db);
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < skillCount; ++i) {
+        const GameDBSkillRecord* record = &db->skillRecords[i];
+        Skill* skill = &db->skills[i];
+
+        skill->name = GameDB_GetString(db, record->nameOffset);
+        skill->type = (SkillType)record->type;
+        skill->power = record->power;
+        skill->element = (ElementType)record->element;
+        skill->range = record->range;
+        skill->isAOE = record->isAOE != 0;
+        skill->description = GameDB_GetString(db, record->descriptionOffset);
+        skill->fusionIDs[0] = record->fusionIDs[0];
+        skill->fusionIDs[1] = record->fusionIDs[1];
+        skill->nameID = StringID_Intern(skill->name);
+        skill->nameHash = record->nameHash;
+        skill->isDatabaseRecord = true;
+        if (!Skills_Register(skill)) {
+            printf("Failed to register database skill %u: %s\n", i, skill->name);
+            db->isRegistered = true; // Roll back what was registered so far
+            GameDB_UnregisterContent(db);
+            return false;
+        }
+    }
+
+    db->isRegistered = true;
+    return true;
+}
+
+// Remove this database's items and skills from their registries
+void GameDB_UnregisterContent(GameDatabase* db) {
+    if (!db || !db->isRegistered) return;
+
+    for (uint32_t i = 0; i < db->header->itemCount; ++i) {
+        Item_Unregister(&db->items[i]);
+    }
+    for (uint32_t i = 0; i < db->header->skillCount; ++i) {
+        Skills_Unregister(&db->skills[i]);
+    }
+
+    free(db->items);
+    free(db->skills);
+    db->items = NULL;
+    db->skills = NULL;
+    db->isRegistered = false;
+}
+
+// Get a string from the pool ("" if the offset is out of range)
+const char* GameDB_GetString(const GameDatabase* db, uint32_t offset) {
+    if (!db || offset >= db->header->stringPoolSize) return "";
+    return db->strings + offset;
+}
+
+// Binary search a record array sorted by nameHash; records start with nameOffset, nameHash
+static const void* FindRecord(const GameDatabase* db, const void* records, uint32_t count,
+    size_t recordSize, const char* name) {
+    if (!db || !name) return NULL;
+
+    const uint8_t* base = (const uint8_t*)records;
+    uint32_t hash = Hash_String(name);
+    uint32_t low = 0;
+    uint32_t high = count;
+
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        const uint32_t* fields = (const uint32_t*)(base + mid * recordSize);
+        if (fields[1] < hash) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+
+    for (uint32_t i = low; i < count; ++i) {
+        const uint32_t* fields = (const uint32_t*)(base + i * recordSize);
+        if (fields[1] != hash) break;
+        if (strcmp(GameDB_GetString(db, fields[0]), name) == 0) {
+            return fields;
+        }
+    }
+    return NULL;
+}
+
+// Find an item record by name
+const GameDBItemRecord* GameDB_FindItem(const GameDatabase* db, const char* name) {
+    if (!db) return NULL;
+    return (const GameDBItemRecord*)FindRecord(db, db->itemRecords, db->header->itemCount,
+        sizeof(GameDBItemRecord), name);
+}
+
+// Find a skill record by name
+const GameDBSkillRecord* GameDB_FindSkill(const GameDatabase* db, const char* name) {
+    if (!db) return NULL;
+    return (const GameDBSkillRecord*)FindRecord(db, db->skillRecords, db->header->skillCount,
+        sizeof(GameDBSkillRecord), name);
+}
+
+// Find a stat table by name
+const GameDBStatRecord* GameDB_FindStatTable(const GameDatabase* db, const char* name) {
+    if (!db) return NULL;
+    return (const GameDBStatRecord*)FindRecord(db, db->statRecords, db->header->statCount,
+        sizeof(GameDBStatRecord), name);
+}
+
+// Copy a stat table into a Stats value
+Stats GameDB_GetStats(const GameDBStatRecord* record) {
+    Stats stats;
+    memset(&stats, 0, sizeof(Stats));
+    if (record) {
+        memcpy(stats.values, record->values, sizeof(stats.values));
+    }
+    return stats;
+}
+
+// Grow a builder array to hold one more record
+static bool ReserveRecord(void** records, int count, int* capacity, size_t recordSize) {
+    if (count < *capacity) return true;
+
+    int newCapacity = *capacity ? *capacity * 2 : 64;
+    void* grown = realloc(*records, recordSize * newCapacity);
+    if (!grown) return false;
+
+    *records = grown;
+    *capacity = newCapacity;
+    return true;
+}
+
+// Add a string to the pool, returning its offset (identical strings are shared)
+static uint32_t PoolString(GameDBBuilder* builder, const char* str) {
+    if (!str) str = "";
+
+    uint32_t hash = Hash_String(str);
+    int cursor;
+    for (int32_t offset = HashIndex_FindFirst(&builder->stringIndex, hash, &cursor); offset >= 0;
+        offset = HashIndex_FindNext(&builder->stringIndex, hash, &cursor)) {
+        if (strcmp(builder->strings + offset, str) == 0) {
+            return (uint32_t)offset;
+        }
+    }
+
+    size_t length = strlen(str) + 1;
+    if (builder->stringSize + length > builder->stringCapacity) {
+        size_t capacity = builder->stringCapacity ? builder->stringCapacity * 2 : 4096;
+        while (capacity < builder->stringSize + length) {
+            capacity *= 2;
+        }
+        char* grown = (char*)realloc(builder->strings, capacity);
+        if (!grown) return 0;
+        builder->strings = grown;
+        builder->stringCapacity = capacity;
+    }
+
+    uint32_t offset = (uint32_t)builder->stringSize;
+    memcpy(builder->strings + offset, str, length);
+    builder->stringSize += length;
+    HashIndex_Insert(&builder->stringIndex, hash, (int32_t)offset);
+    return offset;
+}
+
+// Create an empty database builder
+GameDBBuilder* GameDBBuilder_Create() {
+    GameDBBuilder* builder = (GameDBBuilder*)calloc(1, sizeof(GameDBBuilder));
+    if (!builder) return NULL;
+
+    if (!HashIndex_Init(&builder->stringIndex, 1024)) {
+        free(builder);
+        return NULL;
+    }
+    PoolString(builder, ""); // Offset 0 is always the empty string
+    return builder;
+}
+
+// Destroy a database builder
+void GameDBBuilder_Destroy(GameDBBuilder* builder) {
+    if (!builder) return;
+
+    free(builder->items);
+    free(builder->skills);
+    free(builder->stats);
+    free(builder->strings);
+    HashIndex_Free(&builder->stringIndex);
+    free(builder);
+}
+
+// Add an item record
+bool GameDBBuilder_AddItem(GameDBBuilder* builder, const Item* item) {
+    if (!builder || !item || !item->name) return false;
+    if (!ReserveRecord((void**)&builder->items, builder->itemCount, &builder->itemCapacity,
+        sizeof(GameDBItemRecord))) return false;
+
+    GameDBItemRecord* record = &builder->items[builder->itemCount++];
+    record->nameOffset = PoolString(builder, item->name);
+    record->nameHash = Hash_String(item->name);
+    record->descriptionOffset = PoolString(builder, item->description);
+    record->type = item->type;
+    record->rarity = item->rarity;
+    record->value = item->value;
+    record->effectPower = item->effectPower;
+    record->durability = item->durability;
+    return true;
+}
+
+// Add a skill record
+bool GameDBBuilder_AddSkill(GameDBBuilder* builder, const Skill* skill) {
+    if (!builder || !skill || !skill->name) return false;
+    if (!ReserveRecord((void**)&builder->skills, builder->skillCount, &builder->skillCapacity,
+        sizeof(GameDBSkillRecord))) return false;
+
+    GameDBSkillRecord* record = &builder->skills[builder->skillCount++];
+    record->nameOffset = PoolString(builder, skill->name);
+    record->nameHash = Hash_String(skill->name);
+    record->descriptionOffset = PoolString(builder, skill->description);
+    record->type = skill->type;
+    record->power = skill->power;
+    record->element = skill->element;
+    record->range = skill->range;
+    record->isAOE = skill->isAOE ? 1 : 0;
+    record->fusionIDs[0] = skill->fusionIDs[0];
+    record->fusionIDs[1] = skill->fusionIDs[1];
+    return true;
+}
+
+// Add a named stat table
+bool GameDBBuilder_AddStatTable(GameDBBuilder* builder, const char* name, int level, const Stats* stats) {
+    if (!builder || !name || !stats) return false;
+    if (!ReserveRecord((void**)&builder->stats, builder->statCount, &builder->statCapacity,
+        sizeof(GameDBStatRecord))) return false;
+
+    GameDBStatRecord* record = &builder->stats[builder->statCount++];
+    record->nameOffset = PoolString(builder, name);
+    record->nameHash = Hash_String(name);
+    record->level = level;
+    memcpy(record->values, stats->values, sizeof(record->values));
+    return true;
+}
+
+// Sort records by nameHash (nameHash is the second field of every record type)
+static int CompareRecordHash(const void* a, const void* b) {
+    uint32_t hashA = ((const uint32_t*)a)[1];
+    uint32_t hashB = ((const uint32_t*)b)[1];
+    return (hashA > hashB) - (hashA < hashB);
+}
+
+// Write a zero-padded section at an aligned offset
+static bool WriteSection(FILE* file, uint32_t* position, uint32_t offset, const void* data, size_t size) {
+    static const uint8_t padding[GAMEDB_ALIGNMENT] = { 0 };
+
+    if (offset > *position && fwrite(padding, 1, offset - *position, file) != offset - *position) return false;
+    if (size > 0 && fwrite(data, 1, size, file) != size) return false;
+
+    *position = offset + (uint32_t)size;
+    return true;
+}
+
+// Write the database blob
+bool GameDBBuilder_Write(GameDBBuilder* builder, const char* outputPath) {
+    if (!builder || !outputPath) return false;
+
+    qsort(builder->items, builder->itemCount, sizeof(GameDBItemRecord), CompareRecordHash);
+    qsort(builder->skills, builder->skillCount, sizeof(GameDBSkillRecord), CompareRecordHash);
+    qsort(builder->stats, builder->statCount, sizeof(GameDBStatRecord), CompareRecordHash);
+
+    GameDBHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = GAMEDB_MAGIC;
+    header.version = GAMEDB_VERSION;
+    header.itemOffset = AlignOffset(sizeof(GameDBHeader));
+    header.itemCount = (uint32_t)builder->itemCount;
+    header.skillOffset = AlignOffset(header.itemOffset + header.itemCount * sizeof(GameDBItemRecord));
+    header.skillCount = (uint32_t)builder->skillCount;
+    header.statOffset = AlignOffset(header.skillOffset + header.skillCount * sizeof(GameDBSkillRecord));
+    header.statCount = (uint32_t)builder->statCount;
+    header.stringPoolOffset = AlignOffset(header.statOffset + header.statCount * sizeof(GameDBStatRecord));
+    header.stringPoolSize = (uint32_t)builder->stringSize;
+    header.fileSize = header.stringPoolOffset + header.stringPoolSize;
+
+    FILE* file = fopen(outputPath, "wb");
+    if (!file) {
+        printf("Failed to create game database: %s\n", outputPath);
+        return false;
+    }
+
+    uint32_t position = 0;
+    bool isWritten = WriteSection(file, &position, 0, &header, sizeof(header)) &&
+        WriteSection(file, &position, header.itemOffset, builder->items, header.itemCount * sizeof(GameDBItemRecord)) &&
+        WriteSection(file, &position, header.skillOffset, builder->skills, header.skillCount * sizeof(GameDBSkillRecord)) &&
+        WriteSection(file, &position, header.statOffset, builder->stats, header.statCount * sizeof(GameDBStatRecord)) &&
+        WriteSection(file, &position, header.stringPoolOffset, builder->strings, builder->stringSize);
+
+    if (fclose(file) != 0) isWritten = false;
+    if (!isWritten) {
+        printf("Failed to write game database: %s\n", outputPath);
+        remove(outputPath);
+        return false;
+    }
+
+    printf("Game database written: %s (%u bytes)\n", outputPath, header.fileSize);
+    return true;
+}
+
+// Split a CSV row into at most maxFields fields; the last field keeps any remaining commas
+static int SplitRow(char* line, char** fields, int maxFields) {
+    int count = 0;
+    char* cursor = line;
+
+    while (count < maxFields) {
+        fields[count++] = cursor;
+        if (count == maxFields) break;
+
+        char* comma = strchr(cursor, ',');
+        if (!comma) break;
+        *comma = '\0';
+        cursor = comma + 1;
+    }
+    return count;
+}
+
+// Compile one CSV table, calling addRow for every data row
+static bool CompileTable(const char* path, GameDBBuilder* builder, int fieldCount,
+    bool (*addRow)(GameDBBuilder* builder, char** fields)) {
+    if (!path) return true;
+
+    char* text = File_ReadAllText(path);
+    if (!text) {
+        printf("Failed to read table: %s\n", path);
+        return false;
+    }
+
+    bool isValid = true;
+    int lineNumber = 0;
+    char* line = text;
+    while (line && *line) {
+        char* next = strchr(line, '\n');
+        if (next) *next++ = '\0';
+        lineNumber++;
+
+        size_t length = strlen(line);
+        if (length > 0 && line[length - 1] == '\r') line[length - 1] = '\0';
+
+        if (line[0] != '\0' && line[0] != '#') {
+            char* fields[STAT_COUNT + 2];
+            if (SplitRow(line, fields, fieldCount) != fieldCount || !addRow(builder, fields)) {
+                printf("Invalid row in %s at line %d.\n", path, lineNumber);
+                isValid = false;
+                break;
+            }
+        }
+        line = next;
+    }
+
+    free(text);
+    return isValid;
+}
+
+// Row handlers for GameDB_CompileTables
+static bool AddItemRow(GameDBBuilder* builder, char** fields) {
+    Item item;
+    memset(&item, 0, sizeof(item));
+    item.name = fields[0];
+    item.type = (ItemType)atoi(fields[1]);
+    item.rarity = (ItemRarity)atoi(fields[2]);
+    item.value = atoi(fields[3]);
+    item.effectPower = atoi(fields[4]);
+    item.durability = atoi(fields[5]);
+    item.description = fields[6];
+    return GameDBBuilder_AddItem(builder, &item);
+}
+
+static bool AddSkillRow(GameDBBuilder* builder, char** fields) {
+    Skill skill;
+    memset(&skill, 0, sizeof(skill));
+    skill.name = fields[0];
+    skill.type = (SkillType)atoi(fields[1]);
+    skill.power = atoi(fields[2]);
+    skill.element = (ElementType)atoi(fields[3]);
+    skill.range = (float)atof(fields[4]);
+    skill.isAOE = atoi(fields[5]) != 0;
+    skill.description = fields[6];
+    skill.fusionIDs[0] = -1;
+    skill.fusionIDs[1] = -1;
+    return GameDBBuilder_AddSkill(builder, &skill);
+}
+
+static bool AddStatRow(GameDBBuilder* builder, char** fields) {
+    Stats stats;
+    for (int stat = 0; stat < STAT_COUNT; ++stat) {
+        stats.values[stat] = atoi(fields[2 + stat]);
+    }
+    return GameDBBuilder_AddStatTable(builder, fields[0], atoi(fields[1]), &stats);
+}
+
+// Compile CSV tables into a database file
+bool GameDB_CompileTables(const char* itemsPath, const char* skillsPath,
+    const char* statsPath, const char* outputPath) {
+    GameDBBuilder* builder = GameDBBuilder_Create();
+    if (!builder) return false;
+
+    bool isCompiled = CompileTable(itemsPath, builder, 7, AddItemRow) &&
+        CompileTable(skillsPath, builder, 7, AddSkillRow) &&
+        CompileTable(statsPath, builder, 2 + STAT_COUNT, AddStatRow) &&
+        GameDBBuilder_Write(builder, outputPath);
+
+    GameDBBuilder_Destroy(builder);
+    return isCompiled;
+}
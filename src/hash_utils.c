@@ -0,0 +1,337 @@
+// hash_utils.c
+#include "hash_utils.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+#define HASH_INDEX_MIN_CAPACITY 16
+#define HASH_INDEX_EMPTY -1
+#define STRING_ARENA_CHUNK_SIZE (64 * 1024)
+
+// Interned string entry
+typedef struct {
+    const char* str;
+    uint32_t hash;
+} InternedString;
+
+static InternedString* internTable = NULL; // Entry i holds StringID i + 1
+static int internCount = 0;
+static int internCapacity = 0;
+static HashIndex internIndex = { 0 };
+
+// Interned strings are copied into large chunks rather than allocated one by one
+typedef struct StringArenaChunk {
+    struct StringArenaChunk* next;
+    size_t used;
+    size_t capacity;
+    char data[];
+} StringArenaChunk;
+
+static StringArenaChunk* stringArena = NULL;
+
+// Hash a NUL-terminated string
+uint32_t Hash_String(const char* str) {
+    uint32_t hash = FNV_OFFSET_BASIS;
+    if (!str) return hash;
+
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Hash a block of bytes
+uint32_t Hash_Bytes(const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t hash = FNV_OFFSET_BASIS;
+
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// CRC-32 remainders for each 4-bit value (reflected polynomial 0xEDB88320)
+static const uint32_t crcNibbleTable[16] = {
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu, 0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu, 0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
+// Checksum a block of bytes, continuing from a previous CRC
+uint32_t Hash_CRC32(uint32_t crc, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    crc = ~crc;
+
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ crcNibbleTable[crc & 0x0F];
+        crc = (crc >> 4) ^ crcNibbleTable[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+// Allocate slot arrays for a given power-of-two capacity
+static bool AllocateSlots(HashIndex* index, int capacity) {
+    uint32_t* hashes = (uint32_t*)malloc(sizeof(uint32_t) * capacity);
+    int32_t* values = (int32_t*)malloc(sizeof(int32_t) * capacity);
+    if (!hashes || !values) {
+        free(hashes);
+        free(values);
+        printf("Failed to allocate hash index.\n");
+        return false;
+    }
+
+    memset(values, 0xFF, sizeof(int32_t) * capacity); // All slots empty (-1)
+    index->hashes = hashes;
+    index->values = values;
+    index->capacity = capacity;
+    index->count = 0;
+    return true;
+}
+
+// Place an entry without checking load or duplicates
+static void InsertSlot(HashIndex* index, uint32_t hash, int32_t value) {
+    int mask = index->capacity - 1;
+    int slot = (int)(hash & (uint32_t)mask);
+
+    while (index->values[slot] != HASH_INDEX_EMPTY) {
+        slot = (slot + 1) & mask;
+    }
+    index->hashes[slot] = hash;
+    index->values[slot] = value;
+    index->count++;
+}
+
+// Rehash into a larger slot array
+static bool Grow(HashIndex* index) {
+    HashIndex old = *index;
+    int capacity = old.capacity ? old.capacity * 2 : HASH_INDEX_MIN_CAPACITY;
+
+    if (!AllocateSlots(index, capacity)) {
+        *index = old;
+        return false;
+    }
+
+    for (int i = 0; i < old.capacity; ++i) {
+        if (old.values[i] != HASH_INDEX_EMPTY) {
+            InsertSlot(index, old.hashes[i], old.values[i]);
+        }
+    }
+    free(old.hashes);
+    free(old.values);
+    return true;
+}
+
+// Find the slot holding a specific hash/value pair
+static int FindSlot(const HashIndex* index, uint32_t hash, int32_t value) {
+    int cursor;
+    for (int32_t found = HashIndex_FindFirst(index, hash, &cursor); found != HASH_INDEX_EMPTY;
+        found = HashIndex_FindNext(index, hash, &cursor)) {
+        if (found == value) return cursor;
+    }
+    return -1;
+}
+
+// Initialize a hash index
+bool HashIndex_Init(HashIndex* index, int initialCapacity) {
+    if (!index) return false;
+
+    int capacity = HASH_INDEX_MIN_CAPACITY;
+    while (capacity < initialCapacity) {
+        capacity *= 2;
+    }
+    return AllocateSlots(index, capacity);
+}
+
+// Release a hash index
+void HashIndex_Free(HashIndex* index) {
+    if (!index) return;
+
+    free(index->hashes);
+    free(index->values);
+    memset(index, 0, sizeof(HashIndex));
+}
+
+// Remove all entries, keeping capacity
+void HashIndex_Clear(HashIndex* index) {
+    if (!index || !index->values) return;
+
+    memset(index->values, 0xFF, sizeof(int32_t) * index->capacity);
+    index->count = 0;
+}
+
+// Insert a hash/value pair
+bool HashIndex_Insert(HashIndex* index, uint32_t hash, int32_t value) {
+    if (!index || value < 0) return false;
+
+    // Keep load factor under 3/4 so probe sequences stay short
+    if ((index->count + 1) * 4 > index->capacity * 3 && !Grow(index)) {
+        return false;
+    }
+
+    InsertSlot(index, hash, value);
+    return true;
+}
+
+// Remove a hash/value pair (backward-shift deletion, no tombstones)
+bool HashIndex_Remove(HashIndex* index, uint32_t hash, int32_t value) {
+    if (!index || !index->values) return false;
+
+    int slot = FindSlot(index, hash, value);
+    if (slot < 0) return false;
+
+    int mask = index->capacity - 1;
+    int next = (slot + 1) & mask;
+    while (index->values[next] != HASH_INDEX_EMPTY) {
+        int home = (int)(index->hashes[next] & (uint32_t)mask);
+        // Move the entry back if the hole lies between its home slot and its current slot
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            index->hashes[slot] = index->hashes[next];
+            index->values[slot] = index->values[next];
+            slot = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    index->values[slot] = HASH_INDEX_EMPTY;
+    index->count--;
+    return true;
+}
+
+// Change the value stored for a hash/value pair (e.g. after a swap-remove)
+bool HashIndex_Replace(HashIndex* index, uint32_t hash, int32_t oldValue, int32_t newValue) {
+    if (!index || !index->values || newValue < 0) return false;
+
+    int slot = FindSlot(index, hash, oldValue);
+    if (slot < 0) return false;
+
+    index->values[slot] = newValue;
+    return true;
+}
+
+// Find the first value stored under a hash, -1 if none
+int32_t HashIndex_FindFirst(const HashIndex* index, uint32_t hash, int* cursor) {
+    if (!index || !index->values || !cursor) return HASH_INDEX_EMPTY;
+
+    *cursor = (int)(hash & (uint32_t)(index->capacity - 1)) - 1;
+    return HashIndex_FindNext(index, hash, cursor);
+}
+
+// Find the next value stored under a hash, -1 when exhausted
+int32_t HashIndex_FindNext(const HashIndex* index, uint32_t hash, int* cursor) {
+    if (!index || !index->values || !cursor) return HASH_INDEX_EMPTY;
+
+    int mask = index->capacity - 1;
+    int slot = (*cursor + 1) & mask;
+
+    while (index->values[slot] != HASH_INDEX_EMPTY) {
+        if (index->hashes[slot] == hash) {
+            *cursor = slot;
+            return index->values[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    return HASH_INDEX_EMPTY;
+}
+
+// Copy a string into the intern arena
+static const char* ArenaCopyString(const char* str) {
+    size_t length = strlen(str) + 1;
+
+    if (!stringArena || stringArena->capacity - stringArena->used < length) {
+        size_t capacity = length > STRING_ARENA_CHUNK_SIZE ? length : STRING_ARENA_CHUNK_SIZE;
+        StringArenaChunk* chunk = (StringArenaChunk*)malloc(sizeof(StringArenaChunk) + capacity);
+        if (!chunk) {
+            printf("Failed to grow string intern arena.\n");
+            return NULL;
+        }
+        chunk->next = stringArena;
+        chunk->used = 0;
+        chunk->capacity = capacity;
+        stringArena = chunk;
+    }
+
+    char* copy = stringArena->data + stringArena->used;
+    memcpy(copy, str, length);
+    stringArena->used += length;
+    return copy;
+}
+
+// Look up an interned string without adding it
+static StringID FindInterned(const char* str, uint32_t hash) {
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(&internIndex, hash, &cursor); i != HASH_INDEX_EMPTY;
+        i = HashIndex_FindNext(&internIndex, hash, &cursor)) {
+        if (strcmp(internTable[i].str, str) == 0) {
+            return (StringID)(i + 1);
+        }
+    }
+    return STRING_ID_NONE;
+}
+
+// Intern a string, returning a stable ID (the string is copied once into the arena)
+StringID StringID_Intern(const char* str) {
+    if (!str) return STRING_ID_NONE;
+
+    uint32_t hash = Hash_String(str);
+    StringID id = FindInterned(str, hash);
+    if (id != STRING_ID_NONE) return id;
+
+    if (internCount >= internCapacity) {
+        int capacity = internCapacity ? internCapacity * 2 : 256;
+        InternedString* table = (InternedString*)realloc(internTable, sizeof(InternedString) * capacity);
+        if (!table) {
+            printf("Failed to grow string intern table.\n");
+            return STRING_ID_NONE;
+        }
+        internTable = table;
+        internCapacity = capacity;
+    }
+
+    if (!HashIndex_Insert(&internIndex, hash, internCount)) return STRING_ID_NONE;
+
+    const char* copy = ArenaCopyString(str);
+    if (!copy) {
+        HashIndex_Remove(&internIndex, hash, internCount);
+        return STRING_ID_NONE;
+    }
+    internTable[internCount].str = copy;
+    internTable[internCount].hash = hash;
+    return (StringID)(++internCount);
+}
+
+// Get the ID of an already interned string, STRING_ID_NONE if unknown
+StringID StringID_Find(const char* str) {
+    if (!str) return STRING_ID_NONE;
+    return FindInterned(str, Hash_String(str));
+}
+
+// Get the string for an ID
+const char* StringID_GetString(StringID id) {
+    if (id == STRING_ID_NONE || id > (StringID)internCount) return NULL;
+    return internTable[id - 1].str;
+}
+
+// Get the precomputed hash for an ID
+uint32_t StringID_GetHash(StringID id) {
+    if (id == STRING_ID_NONE || id > (StringID)internCount) return 0;
+    return internTable[id - 1].hash;
+}
+
+// Release all interned strings (invalidates every StringID)
+void StringID_Shutdown() {
+    while (stringArena) {
+        StringArenaChunk* next = stringArena->next;
+        free(stringArena);
+        stringArena = next;
+    }
+    free(internTable);
+    internTable = NULL;
+    internCount = 0;
+    internCapacity = 0;
+    HashIndex_Free(&internIndex);
+}
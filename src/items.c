@@ -4,10 +4,12 @@
 #include <string.h>
 #include <stdio.h>
 
-#define MAX_ITEMS 256
+#define ITEM_REGISTRY_INITIAL_CAPACITY 256
 
-static Item* itemRegistry[MAX_ITEMS];
+static Item** itemRegistry = NULL;
 static int itemCount = 0;
+static int itemCapacity = 0;
+static HashIndex itemIndex = { 0 }; // nameHash -> registry slot
 
 // Create a new item
 Item* Item_Create(const char* name, ItemType type, ItemRarity rarity,
@@ -22,13 +24,16 @@ Item* Item_Create(const char* name, ItemType type, ItemRarity rarity,
     item->description = strdup(description);
     item->effectPower = effectPower;
     item->durability = durability;
+    item->nameID = StringID_Intern(name);
+    item->nameHash = StringID_GetHash(item->nameID);
+    item->isDatabaseRecord = false;
 
     return item;
 }
 
 // Destroy an item
 void Item_Destroy(Item* item) {
-    if (!item) return;
+    if (!item || item->isDatabaseRecord) return;
 
     free((void*)item->name);
     free((void*)item->description);
@@ -37,7 +42,20 @@ void Item_Destroy(Item* item) {
 
 // Register an item
 bool Item_Register(Item* item) {
-    if (!item || itemCount >= MAX_ITEMS) return false;
+    if (!item) return false;
+
+    if (itemCount >= itemCapacity) {
+        int capacity = itemCapacity ? itemCapacity * 2 : ITEM_REGISTRY_INITIAL_CAPACITY;
+        Item** registry = (Item**)realloc(itemRegistry, sizeof(Item*) * capacity);
+        if (!registry) {
+            printf("Failed to grow item registry.\n");
+            return false;
+        }
+        itemRegistry = registry;
+        itemCapacity = capacity;
+    }
+
+    if (!HashIndex_Insert(&itemIndex, item->nameHash, itemCount)) return false;
 
     itemRegistry[itemCount++] = item;
     printf("Registered item: %s\n", item->name);
@@ -48,9 +66,18 @@ bool Item_Register(Item* item) {
 void Item_Unregister(Item* item) {
     if (!item) return;
 
-    for (int i = 0; i < itemCount; i++) {
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(&itemIndex, item->nameHash, &cursor); i >= 0;
+        i = HashIndex_FindNext(&itemIndex, item->nameHash, &cursor)) {
         if (itemRegistry[i] == item) {
-            itemRegistry[i] = itemRegistry[--itemCount];
+            HashIndex_Remove(&itemIndex, item->nameHash, i);
+
+            // Move the last item into the freed slot and repoint its index entry
+            int last = --itemCount;
+            if (i != last) {
+                itemRegistry[i] = itemRegistry[last];
+                HashIndex_Replace(&itemIndex, itemRegistry[i]->nameHash, last, i);
+            }
             printf("Unregistered item: %s\n", item->name);
             break;
         }
@@ -59,7 +86,12 @@ void Item_Unregister(Item* item) {
 
 // Get an item by name
 Item* Item_GetByName(const char* name) {
-    for (int i = 0; i < itemCount; i++) {
+    if (!name) return NULL;
+
+    uint32_t hash = Hash_String(name);
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(&itemIndex, hash, &cursor); i >= 0;
+        i = HashIndex_FindNext(&itemIndex, hash, &cursor)) {
         if (strcmp(itemRegistry[i]->name, name) == 0) {
             return itemRegistry[i];
         }
@@ -67,6 +99,33 @@ Item* Item_GetByName(const char* name) {
     return NULL;
 }
 
+// Get an item by precomputed name hash (first match on collision)
+Item* Item_GetByHash(uint32_t nameHash) {
+    int cursor;
+    int32_t i = HashIndex_FindFirst(&itemIndex, nameHash, &cursor);
+    return i >= 0 ? itemRegistry[i] : NULL;
+}
+
+// Get an item by interned name
+Item* Item_GetByID(StringID nameID) {
+    if (nameID == STRING_ID_NONE) return NULL;
+
+    uint32_t hash = StringID_GetHash(nameID);
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(&itemIndex, hash, &cursor); i >= 0;
+        i = HashIndex_FindNext(&itemIndex, hash, &cursor)) {
+        if (itemRegistry[i]->nameID == nameID) {
+            return itemRegistry[i];
+        }
+    }
+    return NULL;
+}
+
+// Get the number of registered items
+int Item_GetCount() {
+    return itemCount;
+}
+
 // Display an item's information
 void Item_Display(const Item* item) {
     if (!item) return;
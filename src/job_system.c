@@ -0,0 +1,207 @@
+// job_system.c
+#include "job_system.h"
+#include "profiler.h" // For job zones
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_JOB_THREADS 16
+#define JOB_QUEUE_INITIAL_CAPACITY 64
+
+// Queued job
+typedef struct {
+    JobFunction function;
+    void* data;
+} Job;
+
+// FIFO of jobs for one priority (growable ring buffer)
+typedef struct {
+    Job* jobs;
+    int capacity;
+    int head;
+    int count;
+} JobQueue;
+
+struct JobPool {
+    char name[32];
+    SDL_Thread* threads[MAX_JOB_THREADS];
+    int threadCount;
+
+    SDL_mutex* mutex;
+    SDL_cond* workAvailable;  // Signalled when a job is queued or on shutdown
+    SDL_cond* idle;           // Signalled when the pool runs out of work
+    JobQueue queues[JOB_PRIORITY_COUNT];
+    int pendingCount;         // Queued jobs
+    int runningCount;         // Jobs currently executing
+    bool isShuttingDown;
+};
+
+// Append a job to a queue, growing it if needed
+static bool JobQueue_Push(JobQueue* queue, Job job) {
+    if (queue->count >= queue->capacity) {
+        int capacity = queue->capacity ? queue->capacity * 2 : JOB_QUEUE_INITIAL_CAPACITY;
+        Job* jobs = (Job*)malloc(sizeof(Job) * capacity);
+        if (!jobs) return false;
+
+        // Unwrap the ring into the new buffer
+        for (int i = 0; i < queue->count; ++i) {
+            jobs[i] = queue->jobs[(queue->head + i) % queue->capacity];
+        }
+        free(queue->jobs);
+        queue->jobs = jobs;
+        queue->capacity = capacity;
+        queue->head = 0;
+    }
+
+    queue->jobs[(queue->head + queue->count) % queue->capacity] = job;
+    queue->count++;
+    return true;
+}
+
+// Take the oldest job from a queue
+static bool JobQueue_Pop(JobQueue* queue, Job* job) {
+    if (queue->count == 0) return false;
+
+    *job = queue->jobs[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+    return true;
+}
+
+// Worker thread loop
+static int SDLCALL JobWorkerThread(void* data) {
+    JobPool* pool = (JobPool*)data;
+    PROFILE_THREAD(pool->name);
+
+    SDL_LockMutex(pool->mutex);
+    for (;;) {
+        while (pool->pendingCount == 0 && !pool->isShuttingDown) {
+            SDL_CondWait(pool->workAvailable, pool->mutex);
+        }
+        if (pool->pendingCount == 0 && pool->isShuttingDown) break;
+
+        Job job = { 0 };
+        for (int priority = 0; priority < JOB_PRIORITY_COUNT; ++priority) {
+            if (JobQueue_Pop(&pool->queues[priority], &job)) break;
+        }
+        pool->pendingCount--;
+        pool->runningCount++;
+        SDL_UnlockMutex(pool->mutex);
+
+        if (job.function) {
+            PROFILE_BEGIN("Job");
+            job.function(job.data);
+            PROFILE_END();
+        }
+
+        SDL_LockMutex(pool->mutex);
+        pool->runningCount--;
+        if (pool->pendingCount == 0 && pool->runningCount == 0) {
+            SDL_CondBroadcast(pool->idle);
+        }
+    }
+    SDL_UnlockMutex(pool->mutex);
+    return 0;
+}
+
+// Create a pool of worker threads
+JobPool* JobPool_Create(const char* name, int threadCount) {
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_JOB_THREADS) threadCount = MAX_JOB_THREADS;
+
+    JobPool* pool = (JobPool*)calloc(1, sizeof(JobPool));
+    if (!pool) return NULL;
+
+    SDL_strlcpy(pool->name, name ? name : "JobPool", sizeof(pool->name));
+    pool->mutex = SDL_CreateMutex();
+    pool->workAvailable = SDL_CreateCond();
+    pool->idle = SDL_CreateCond();
+    if (!pool->mutex || !pool->workAvailable || !pool->idle) {
+        printf("Failed to create job pool '%s': %s\n", pool->name, SDL_GetError());
+        JobPool_Destroy(pool);
+        return NULL;
+    }
+
+    for (int i = 0; i < threadCount; ++i) {
+        pool->threads[i] = SDL_CreateThread(JobWorkerThread, pool->name, pool);
+        if (!pool->threads[i]) {
+            printf("Failed to create job thread for '%s': %s\n", pool->name, SDL_GetError());
+            break;
+        }
+        pool->threadCount++;
+    }
+
+    if (pool->threadCount == 0) {
+        JobPool_Destroy(pool);
+        return NULL;
+    }
+
+    printf("Job pool '%s' created with %d threads.\n", pool->name, pool->threadCount);
+    return pool;
+}
+
+// Destroy a pool; queued jobs are finished first
+void JobPool_Destroy(JobPool* pool) {
+    if (!pool) return;
+
+    if (pool->mutex) {
+        SDL_LockMutex(pool->mutex);
+        pool->isShuttingDown = true;
+        SDL_CondBroadcast(pool->workAvailable);
+        SDL_UnlockMutex(pool->mutex);
+    }
+
+    for (int i = 0; i < pool->threadCount; ++i) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+
+    for (int priority = 0; priority < JOB_PRIORITY_COUNT; ++priority) {
+        free(pool->queues[priority].jobs);
+    }
+    if (pool->idle) SDL_DestroyCond(pool->idle);
+    if (pool->workAvailable) SDL_DestroyCond(pool->workAvailable);
+    if (pool->mutex) SDL_DestroyMutex(pool->mutex);
+    free(pool);
+}
+
+// Queue a job
+bool JobPool_Submit(JobPool* pool, JobFunction function, void* data, JobPriority priority) {
+    if (!pool || !function) return false;
+    if (priority < 0 || priority >= JOB_PRIORITY_COUNT) priority = JOB_PRIORITY_NORMAL;
+
+    SDL_LockMutex(pool->mutex);
+    bool isQueued = !pool->isShuttingDown && JobQueue_Push(&pool->queues[priority], (Job){ function, data });
+    if (isQueued) {
+        pool->pendingCount++;
+        SDL_CondSignal(pool->workAvailable);
+    }
+    SDL_UnlockMutex(pool->mutex);
+    return isQueued;
+}
+
+// Block until every queued and running job has finished
+void JobPool_WaitIdle(JobPool* pool) {
+    if (!pool) return;
+
+    SDL_LockMutex(pool->mutex);
+    while (pool->pendingCount > 0 || pool->runningCount > 0) {
+        SDL_CondWait(pool->idle, pool->mutex);
+    }
+    SDL_UnlockMutex(pool->mutex);
+}
+
+// Get the number of jobs waiting to run
+int JobPool_GetPendingCount(JobPool* pool) {
+    if (!pool) return 0;
+
+    SDL_LockMutex(pool->mutex);
+    int count = pool->pendingCount;
+    SDL_UnlockMutex(pool->mutex);
+    return count;
+}
+
+// Get the number of worker threads
+int JobPool_GetThreadCount(JobPool* pool) {
+    return pool ? pool->threadCount : 0;
+}
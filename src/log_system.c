@@ -0,0 +1,651 @@
+// log_system.c
+#include "log_system.h"
+#include "profiler.h" // For drain zones
+#include "vfs.h" // For log files on writable mounts
+#include <SDL2/SDL.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOG_DRAIN_INTERVAL_MS 10   // Longest a message waits when nothing wakes the drain thread
+#define LOG_OUTPUT_BUFFER 16384    // Lines batched into one write
+#define LOG_TRUNCATION_MARKER "..."  // Ends a message that had to be cut short
+
+// Queued message. Arguments are packed in format order: integers, doubles and pointers as
+// 8 bytes, strings as a u16 length and their bytes.
+typedef struct {
+    const char* format;        // NULL when arguments hold an already formatted message
+    Uint64 ticks;
+    uint8_t level;
+    uint8_t category;
+    uint16_t size;             // Bytes used in arguments (or in overflow)
+    char* overflow;            // Heap copy of a formatted message too long for arguments; freed by the drain thread
+    uint8_t arguments[LOG_MAX_ARGUMENT_BYTES];
+} LogRecord;
+
+// Queue cell; sequence tells producers and the drain thread whose turn it is
+typedef struct {
+    SDL_atomic_t sequence;
+    LogRecord record;
+} LogQueueCell;
+
+// One conversion specification in a format string
+typedef struct {
+    const char* start;         // The '%'
+    const char* end;           // One past the conversion character
+    bool isWidthArgument;      // '*'
+    bool isPrecisionArgument;  // '.*'
+    char length;               // 'H' (hh), 'h', 'l', 'q' (ll), 'z', 'j', 't', 'L' or 0
+    char conversion;
+} LogConversion;
+
+uint8_t gLogLevels[LOG_CATEGORY_COUNT] = {
+    LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL,
+    LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL,
+    LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL
+};
+
+static const char* levelNames[LOG_LEVEL_NONE] = { "TRACE", "DEBUG", "INFO", "WARNING", "ERROR" };
+static const char* categoryNames[LOG_CATEGORY_COUNT] = {
+    "Core", "Renderer", "Physics", "AI", "Gameplay", "Audio", "Assets", "IO", "Save", "Map", "Events"
+};
+
+static LogQueueCell* cells = NULL;
+static SDL_atomic_t enqueuePos;
+static int dequeuePos = 0;              // Owned by the drain thread
+static SDL_atomic_t printedPos;         // Published by the drain thread for LogSystem_Flush
+static SDL_atomic_t isRunning;
+static SDL_atomic_t isShuttingDown;
+static SDL_atomic_t activeWriters;      // Producers that may still touch cells or drainSignal
+static SDL_Thread* drainThread = NULL;
+static SDL_sem* drainSignal = NULL;
+static SDL_mutex* fileMutex = NULL;
+static FILE* logFile = NULL;
+static Uint64 startTicks = 0;
+static double secondsPerTick = 0.0;
+
+static SDL_atomic_t writtenCount;
+static SDL_atomic_t printedCount;
+static SDL_atomic_t droppedCount;
+static SDL_atomic_t preformattedCount;
+static SDL_atomic_t truncatedCount;
+
+// Format Strings
+
+// Parse the conversion starting at a '%'; NULL for a malformed one
+static const char* ParseConversion(const char* cursor, LogConversion* conversion) {
+    memset(conversion, 0, sizeof(LogConversion));
+    conversion->start = cursor++;
+
+    while (*cursor && strchr("-+ #0'", *cursor)) cursor++;
+    if (*cursor == '*') {
+        conversion->isWidthArgument = true;
+        cursor++;
+    }
+    while (*cursor >= '0' && *cursor <= '9') cursor++;
+    if (*cursor == '.') {
+        cursor++;
+        if (*cursor == '*') {
+            conversion->isPrecisionArgument = true;
+            cursor++;
+        }
+        while (*cursor >= '0' && *cursor <= '9') cursor++;
+    }
+
+    if (cursor[0] == 'h' && cursor[1] == 'h') { conversion->length = 'H'; cursor += 2; }
+    else if (cursor[0] == 'l' && cursor[1] == 'l') { conversion->length = 'q'; cursor += 2; }
+    else if (*cursor && strchr("hlzjtL", *cursor)) conversion->length = *cursor++;
+
+    if (!*cursor) return NULL;
+    conversion->conversion = *cursor++;
+    conversion->end = cursor;
+    return cursor;
+}
+
+// Read a signed integer argument of the conversion's length
+static int64_t ReadSigned(va_list* args, char length) {
+    switch (length) {
+    case 'H': return (signed char)va_arg(*args, int);
+    case 'h': return (short)va_arg(*args, int);
+    case 'l': return va_arg(*args, long);
+    case 'q': return va_arg(*args, long long);
+    case 'z': return (int64_t)va_arg(*args, size_t);
+    case 'j': return va_arg(*args, intmax_t);
+    case 't': return va_arg(*args, ptrdiff_t);
+    default: return va_arg(*args, int);
+    }
+}
+
+// Read an unsigned integer argument of the conversion's length
+static uint64_t ReadUnsigned(va_list* args, char length) {
+    switch (length) {
+    case 'H': return (unsigned char)va_arg(*args, unsigned int);
+    case 'h': return (unsigned short)va_arg(*args, unsigned int);
+    case 'l': return va_arg(*args, unsigned long);
+    case 'q': return va_arg(*args, unsigned long long);
+    case 'z': return va_arg(*args, size_t);
+    case 'j': return va_arg(*args, uintmax_t);
+    case 't': return (uint64_t)va_arg(*args, ptrdiff_t);
+    default: return va_arg(*args, unsigned int);
+    }
+}
+
+// Append bytes to a record's arguments
+static bool PutBytes(LogRecord* record, const void* data, size_t size) {
+    if (record->size + size > LOG_MAX_ARGUMENT_BYTES) return false;
+    memcpy(record->arguments + record->size, data, size);
+    record->size += (uint16_t)size;
+    return true;
+}
+
+// Copy the arguments a format string uses; false if one cannot be deferred or they do not fit
+static bool CaptureArguments(LogRecord* record, const char* format, va_list* args) {
+    for (const char* cursor = format; *cursor;) {
+        if (*cursor != '%') {
+            cursor++;
+            continue;
+        }
+
+        LogConversion conversion;
+        cursor = ParseConversion(cursor, &conversion);
+        if (!cursor) return false;
+        if (conversion.conversion == '%') continue;
+
+        if (conversion.isWidthArgument) {
+            int64_t width = va_arg(*args, int);
+            if (!PutBytes(record, &width, sizeof(width))) return false;
+        }
+        if (conversion.isPrecisionArgument) {
+            int64_t precision = va_arg(*args, int);
+            if (!PutBytes(record, &precision, sizeof(precision))) return false;
+        }
+
+        bool isStored;
+        switch (conversion.conversion) {
+        case 'd': case 'i': {
+            int64_t value = ReadSigned(args, conversion.length);
+            isStored = PutBytes(record, &value, sizeof(value));
+            break;
+        }
+        case 'u': case 'o': case 'x': case 'X': {
+            uint64_t value = ReadUnsigned(args, conversion.length);
+            isStored = PutBytes(record, &value, sizeof(value));
+            break;
+        }
+        case 'c': {
+            if (conversion.length) return false; // Wide characters
+            int64_t value = va_arg(*args, int);
+            isStored = PutBytes(record, &value, sizeof(value));
+            break;
+        }
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+            if (conversion.length == 'L') return false;
+            double value = va_arg(*args, double);
+            isStored = PutBytes(record, &value, sizeof(value));
+            break;
+        }
+        case 'p': {
+            uint64_t value = (uint64_t)(uintptr_t)va_arg(*args, void*);
+            isStored = PutBytes(record, &value, sizeof(value));
+            break;
+        }
+        case 's': {
+            if (conversion.length) return false; // Wide strings
+            const char* text = va_arg(*args, const char*);
+            if (!text) text = "(null)";
+            size_t textLength = strlen(text);
+            if (textLength > UINT16_MAX) return false;
+            uint16_t length = (uint16_t)textLength;
+            isStored = PutBytes(record, &length, sizeof(length)) && PutBytes(record, text, length);
+            break;
+        }
+        default:
+            return false; // %n and anything unknown
+        }
+        if (!isStored) return false;
+    }
+    return true;
+}
+
+// Take the next packed argument
+static const uint8_t* TakeArgument(const uint8_t* cursor, void* value, size_t size) {
+    memcpy(value, cursor, size);
+    return cursor + size;
+}
+
+// Append formatted text, keeping the output terminated when it runs out of room
+static size_t AppendFormatted(char* output, size_t size, size_t used, const char* spec, ...) {
+    if (used + 1 >= size) return used;
+    va_list args;
+    va_start(args, spec);
+    int written = vsnprintf(output + used, size - used, spec, args);
+    va_end(args);
+    if (written < 0) return used;
+    return used + (size_t)written < size ? used + (size_t)written : size - 1;
+}
+
+// Format a queued message from its format string and packed arguments
+static size_t FormatRecord(const LogRecord* record, char* output, size_t size) {
+    if (!record->format) {
+        size_t length = record->size < size - 1 ? record->size : size - 1;
+        memcpy(output, record->overflow ? (const uint8_t*)record->overflow : record->arguments, length);
+        output[length] = '\0';
+        return length;
+    }
+
+    const uint8_t* cursor = record->arguments;
+    size_t used = 0;
+    output[0] = '\0';
+    for (const char* text = record->format; *text;) {
+        if (*text != '%') {
+            if (used + 1 < size) {
+                output[used++] = *text;
+                output[used] = '\0';
+            }
+            text++;
+            continue;
+        }
+
+        LogConversion conversion;
+        text = ParseConversion(text, &conversion);
+        if (conversion.conversion == '%') {
+            used = AppendFormatted(output, size, used, "%%");
+            continue;
+        }
+
+        // Rebuild the specification with '*' filled in and integers widened to long long. A %s
+        // precision is taken out and applied with the stored length, as strings are unterminated.
+        char spec[64];
+        size_t specLength = 0;
+        int stringPrecision = -1;
+        for (const char* c = conversion.start; c < conversion.end - 1 && specLength < sizeof(spec) - 24; ++c) {
+            if (*c == '.' && conversion.conversion == 's') {
+                if (c[1] == '*') {
+                    int64_t value;
+                    cursor = TakeArgument(cursor, &value, sizeof(value));
+                    if (value >= 0) stringPrecision = value < INT32_MAX ? (int)value : INT32_MAX;
+                    c++;
+                }
+                else {
+                    stringPrecision = atoi(c + 1);
+                    while (c[1] >= '0' && c[1] <= '9') c++;
+                }
+                continue;
+            }
+            if (*c == '*') {
+                int64_t value;
+                cursor = TakeArgument(cursor, &value, sizeof(value));
+                if (c[-1] == '.' && value < 0) {
+                    specLength--; // A negative precision counts as omitted: drop the '.'
+                    continue;
+                }
+                specLength += (size_t)snprintf(spec + specLength, sizeof(spec) - specLength, "%lld", (long long)value);
+                continue;
+            }
+            if (strchr("hlzjtL", *c)) continue;
+            spec[specLength++] = *c;
+        }
+
+        switch (conversion.conversion) {
+        case 'd': case 'i': case 'c': {
+            int64_t value;
+            cursor = TakeArgument(cursor, &value, sizeof(value));
+            if (conversion.conversion != 'c') {
+                spec[specLength++] = 'l';
+                spec[specLength++] = 'l';
+            }
+            spec[specLength++] = conversion.conversion;
+            spec[specLength] = '\0';
+            if (conversion.conversion == 'c') used = AppendFormatted(output, size, used, spec, (int)value);
+            else used = AppendFormatted(output, size, used, spec, (long long)value);
+            break;
+        }
+        case 'u': case 'o': case 'x': case 'X': {
+            uint64_t value;
+            cursor = TakeArgument(cursor, &value, sizeof(value));
+            spec[specLength++] = 'l';
+            spec[specLength++] = 'l';
+            spec[specLength++] = conversion.conversion;
+            spec[specLength] = '\0';
+            used = AppendFormatted(output, size, used, spec, (unsigned long long)value);
+            break;
+        }
+        case 'p': {
+            uint64_t value;
+            cursor = TakeArgument(cursor, &value, sizeof(value));
+            spec[specLength++] = 'p';
+            spec[specLength] = '\0';
+            used = AppendFormatted(output, size, used, spec, (void*)(uintptr_t)value);
+            break;
+        }
+        case 's': {
+            uint16_t length;
+            cursor = TakeArgument(cursor, &length, sizeof(length));
+            spec[specLength++] = '.';
+            spec[specLength++] = '*';
+            spec[specLength++] = 's';
+            spec[specLength] = '\0';
+
+            int precision = length;
+            if (stringPrecision >= 0 && stringPrecision < precision) precision = stringPrecision;
+            used = AppendFormatted(output, size, used, spec, precision, (const char*)cursor);
+            cursor += length;
+            break;
+        }
+        default: {
+            double value;
+            cursor = TakeArgument(cursor, &value, sizeof(value));
+            spec[specLength++] = conversion.conversion;
+            spec[specLength] = '\0';
+            used = AppendFormatted(output, size, used, spec, value);
+            break;
+        }
+        }
+    }
+    return used;
+}
+
+// Drain Thread
+
+// Print a batch of lines to stdout and the log file
+static void WriteOutput(const char* text, size_t length) {
+    if (length == 0) return;
+    fwrite(text, 1, length, stdout);
+    fflush(stdout);
+
+    SDL_LockMutex(fileMutex);
+    if (logFile) {
+        fwrite(text, 1, length, logFile);
+        fflush(logFile);
+    }
+    SDL_UnlockMutex(fileMutex);
+}
+
+// Format one record as a full line
+static size_t FormatLine(const LogRecord* record, char* line, size_t size) {
+    double seconds = (double)(record->ticks - startTicks) * secondsPerTick;
+    int prefix = snprintf(line, size, "[%10.4f][%s][%s] ", seconds, levelNames[record->level], categoryNames[record->category]);
+    if (prefix < 0 || (size_t)prefix >= size) return 0;
+
+    size_t length = (size_t)prefix + FormatRecord(record, line + prefix, size - (size_t)prefix - 1);
+    line[length++] = '\n';
+    line[length] = '\0';
+    return length;
+}
+
+// Print every published message
+static void DrainQueue() {
+    static char output[LOG_OUTPUT_BUFFER];
+    static uint32_t reportedDrops = 0;
+    char line[LOG_MAX_LINE + 64];
+    size_t used = 0;
+    bool isProfiled = false;
+
+    for (;;) {
+        LogQueueCell* cell = &cells[dequeuePos & (LOG_QUEUE_CAPACITY - 1)];
+        if (SDL_AtomicGet(&cell->sequence) != (int)((unsigned int)dequeuePos + 1)) break;
+        if (!isProfiled) {
+            PROFILE_BEGIN("LogSystem_Drain");
+            isProfiled = true;
+        }
+
+        size_t length = FormatLine(&cell->record, line, sizeof(line));
+        free(cell->record.overflow);
+        cell->record.overflow = NULL;
+        SDL_AtomicSet(&cell->sequence, (int)((unsigned int)dequeuePos + LOG_QUEUE_CAPACITY)); // Free the cell
+        dequeuePos = (int)((unsigned int)dequeuePos + 1);
+
+        if (used + length > sizeof(output)) {
+            WriteOutput(output, used);
+            used = 0;
+        }
+        memcpy(output + used, line, length);
+        used += length;
+        SDL_AtomicAdd(&printedCount, 1);
+    }
+
+    uint32_t drops = (uint32_t)SDL_AtomicGet(&droppedCount);
+    if (drops != reportedDrops) {
+        int length = snprintf(line, sizeof(line), "[WARNING][Core] %u log messages dropped (queue full).\n", drops - reportedDrops);
+        reportedDrops = drops;
+        if (used + (size_t)length > sizeof(output)) {
+            WriteOutput(output, used);
+            used = 0;
+        }
+        memcpy(output + used, line, (size_t)length);
+        used += (size_t)length;
+    }
+
+    WriteOutput(output, used);
+    SDL_AtomicSet(&printedPos, dequeuePos);
+    if (isProfiled) PROFILE_END();
+}
+
+// Background loop: print queued messages until shutdown
+static int SDLCALL LogDrainThread(void* data) {
+    (void)data;
+    PROFILE_THREAD("LogDrain");
+
+    while (!SDL_AtomicGet(&isShuttingDown)) {
+        DrainQueue();
+        SDL_SemWaitTimeout(drainSignal, LOG_DRAIN_INTERVAL_MS);
+    }
+    DrainQueue(); // Everything queued before shutdown
+    return 0;
+}
+
+// System Management
+
+// Start the drain thread
+bool LogSystem_Init() {
+    if (SDL_AtomicGet(&isRunning)) return true;
+
+    cells = (LogQueueCell*)malloc(sizeof(LogQueueCell) * LOG_QUEUE_CAPACITY);
+    drainSignal = SDL_CreateSemaphore(0);
+    fileMutex = SDL_CreateMutex();
+    if (!cells || !drainSignal || !fileMutex) {
+        printf("Failed to initialize logging: %s\n", SDL_GetError());
+        LogSystem_Shutdown();
+        return false;
+    }
+
+    for (int i = 0; i < LOG_QUEUE_CAPACITY; ++i) {
+        SDL_AtomicSet(&cells[i].sequence, i);
+    }
+    SDL_AtomicSet(&enqueuePos, 0);
+    SDL_AtomicSet(&printedPos, 0);
+    SDL_AtomicSet(&isShuttingDown, 0);
+    dequeuePos = 0;
+    startTicks = SDL_GetPerformanceCounter();
+    secondsPerTick = 1.0 / (double)SDL_GetPerformanceFrequency();
+
+    drainThread = SDL_CreateThread(LogDrainThread, "LogDrain", NULL);
+    if (!drainThread) {
+        printf("Failed to create log thread: %s\n", SDL_GetError());
+        LogSystem_Shutdown();
+        return false;
+    }
+
+    SDL_AtomicSet(&isRunning, 1);
+    return true;
+}
+
+// Print what is left and stop the drain thread
+void LogSystem_Shutdown() {
+    // New messages print directly from here on; wait out writers that already saw the queue
+    SDL_AtomicSet(&isRunning, 0);
+    while (SDL_AtomicGet(&activeWriters) > 0) {
+        SDL_Delay(0);
+    }
+
+    if (drainThread) {
+        SDL_AtomicSet(&isShuttingDown, 1);
+        SDL_SemPost(drainSignal);
+        SDL_WaitThread(drainThread, NULL);
+        drainThread = NULL;
+    }
+
+    LogSystem_SetFile(NULL);
+    if (drainSignal) SDL_DestroySemaphore(drainSignal);
+    if (fileMutex) SDL_DestroyMutex(fileMutex);
+    free(cells);
+    drainSignal = NULL;
+    fileMutex = NULL;
+    cells = NULL;
+}
+
+// Wait for the drain thread to print every message queued so far
+void LogSystem_Flush() {
+    if (!SDL_AtomicGet(&isRunning)) return;
+
+    int target = SDL_AtomicGet(&enqueuePos);
+    while ((int)((unsigned int)target - (unsigned int)SDL_AtomicGet(&printedPos)) > 0) {
+        SDL_SemPost(drainSignal);
+        SDL_Delay(1);
+    }
+}
+
+// Append every printed message to a file as well
+bool LogSystem_SetFile(const char* filepath) {
+    FILE* file = NULL;
+    if (filepath) {
+        char hostPath[VFS_MAX_PATH];
+        if (Vfs_GetWritePath(filepath, hostPath, sizeof(hostPath))) file = fopen(hostPath, "a");
+        if (!file) {
+            printf("Failed to open log file: %s\n", filepath);
+            return false;
+        }
+        Vfs_Invalidate(filepath);
+    }
+
+    if (fileMutex) SDL_LockMutex(fileMutex);
+    if (logFile) fclose(logFile);
+    logFile = file;
+    if (fileMutex) SDL_UnlockMutex(fileMutex);
+    return true;
+}
+
+// Filtering
+
+// Set the lowest level a category prints
+void LogSystem_SetLevel(LogCategory category, LogLevel level) {
+    if (category < 0 || category >= LOG_CATEGORY_COUNT) return;
+    gLogLevels[category] = (uint8_t)level;
+}
+
+// Set the lowest level for every category
+void LogSystem_SetAllLevels(LogLevel level) {
+    for (int i = 0; i < LOG_CATEGORY_COUNT; ++i) {
+        gLogLevels[i] = (uint8_t)level;
+    }
+}
+
+LogLevel LogSystem_GetLevel(LogCategory category) {
+    if (category < 0 || category >= LOG_CATEGORY_COUNT) return LOG_LEVEL_NONE;
+    return (LogLevel)gLogLevels[category];
+}
+
+const char* LogSystem_GetCategoryName(LogCategory category) {
+    if (category < 0 || category >= LOG_CATEGORY_COUNT) return "Unknown";
+    return categoryNames[category];
+}
+
+// Writing
+
+// Queue a message for the drain thread (prints directly when it is not running)
+void LogSystem_Write(LogLevel level, LogCategory category, const char* format, ...) {
+    if (!format || level < 0 || level >= LOG_LEVEL_NONE || category < 0 || category >= LOG_CATEGORY_COUNT) return;
+
+    va_list args;
+    SDL_AtomicAdd(&activeWriters, 1); // Keeps LogSystem_Shutdown from freeing the queue under us
+    if (!SDL_AtomicGet(&isRunning)) {
+        SDL_AtomicAdd(&activeWriters, -1);
+        printf("[%s][%s] ", levelNames[level], categoryNames[category]);
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+        printf("\n");
+        return;
+    }
+
+    // Claim a cell (the queue is the event system's bounded multi-producer design)
+    int pos = SDL_AtomicGet(&enqueuePos);
+    LogQueueCell* cell;
+    for (;;) {
+        cell = &cells[pos & (LOG_QUEUE_CAPACITY - 1)];
+        int diff = (int)((unsigned int)SDL_AtomicGet(&cell->sequence) - (unsigned int)pos);
+        if (diff == 0) {
+            if (SDL_AtomicCAS(&enqueuePos, pos, (int)((unsigned int)pos + 1))) break;
+            pos = SDL_AtomicGet(&enqueuePos);
+        }
+        else if (diff < 0) {
+            SDL_AtomicAdd(&droppedCount, 1); // The drain thread is behind
+            SDL_AtomicAdd(&activeWriters, -1);
+            return;
+        }
+        else {
+            pos = SDL_AtomicGet(&enqueuePos);
+        }
+    }
+
+    LogRecord* record = &cell->record;
+    record->format = format;
+    record->ticks = SDL_GetPerformanceCounter();
+    record->level = (uint8_t)level;
+    record->category = (uint8_t)category;
+    record->size = 0;
+    record->overflow = NULL;
+
+    va_list copy;
+    va_start(args, format);
+    va_copy(copy, args);
+    if (!CaptureArguments(record, format, &args)) {
+        // Format here instead; messages longer than the record spill to the heap
+        char text[LOG_MAX_LINE];
+        int formatted = vsnprintf(text, sizeof(text), format, copy);
+        size_t length = formatted < 0 ? 0 : (size_t)formatted;
+        bool isTruncated = length >= sizeof(text);
+        if (isTruncated) length = sizeof(text) - 1;
+
+        if (length >= LOG_MAX_ARGUMENT_BYTES) {
+            record->overflow = (char*)malloc(length);
+            if (!record->overflow) {
+                length = LOG_MAX_ARGUMENT_BYTES - 1;
+                isTruncated = true;
+            }
+        }
+        if (isTruncated) {
+            memcpy(text + length - (sizeof(LOG_TRUNCATION_MARKER) - 1), LOG_TRUNCATION_MARKER, sizeof(LOG_TRUNCATION_MARKER) - 1);
+            SDL_AtomicAdd(&truncatedCount, 1);
+        }
+
+        memcpy(record->overflow ? record->overflow : (char*)record->arguments, text, length);
+        record->format = NULL;
+        record->size = (uint16_t)length;
+        SDL_AtomicAdd(&preformattedCount, 1);
+    }
+    va_end(copy);
+    va_end(args);
+
+    SDL_AtomicSet(&cell->sequence, (int)((unsigned int)pos + 1)); // Publish
+    SDL_AtomicAdd(&writtenCount, 1);
+
+    // Wake the drain thread for problems and before the queue fills; otherwise it polls
+    if (level >= LOG_LEVEL_WARNING || (pos & (LOG_QUEUE_CAPACITY / 2 - 1)) == 0) {
+        SDL_SemPost(drainSignal);
+    }
+    SDL_AtomicAdd(&activeWriters, -1);
+}
+
+// Get logging counters
+LogStats LogSystem_GetStats() {
+    LogStats stats;
+    stats.written = (uint32_t)SDL_AtomicGet(&writtenCount);
+    stats.printed = (uint32_t)SDL_AtomicGet(&printedCount);
+    stats.dropped = (uint32_t)SDL_AtomicGet(&droppedCount);
+    stats.preformatted = (uint32_t)SDL_AtomicGet(&preformattedCount);
+    stats.truncated = (uint32_t)SDL_AtomicGet(&truncatedCount);
+    return stats;
+}
@@ -0,0 +1,143 @@
+// lzss.c
+#include "lzss.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LZSS_HASH_BITS 12
+#define LZSS_HASH_SIZE (1 << LZSS_HASH_BITS)
+#define LZSS_MAX_CHAIN 32 // Candidates tried per position; bounds the worst-case compression time
+
+// Match finder: most recent position for each 3-byte hash, chained to older ones in the window
+typedef struct {
+    int32_t head[LZSS_HASH_SIZE];
+    int32_t previous[LZSS_WINDOW_SIZE];
+} LzssMatchFinder;
+
+// Hash the 3 bytes at a position
+static uint32_t HashTriple(const uint8_t* bytes) {
+    uint32_t value = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16);
+    return (value * 2654435761u) >> (32 - LZSS_HASH_BITS);
+}
+
+// Record a position in the match finder
+static void InsertPosition(LzssMatchFinder* finder, const uint8_t* input, size_t position) {
+    uint32_t hash = HashTriple(input + position);
+    finder->previous[position & (LZSS_WINDOW_SIZE - 1)] = finder->head[hash];
+    finder->head[hash] = (int32_t)position;
+}
+
+// Worst case: every byte a literal, plus one flag byte per 8 literals
+size_t Lzss_GetBound(size_t inputSize) {
+    return inputSize + (inputSize + 7) / 8;
+}
+
+// Compress a buffer
+size_t Lzss_Compress(const void* input, size_t inputSize, void* output, size_t outCapacity) {
+    if (!input || !output || inputSize == 0) return 0;
+
+    LzssMatchFinder* finder = (LzssMatchFinder*)malloc(sizeof(LzssMatchFinder));
+    if (!finder) return 0;
+    memset(finder->head, 0xFF, sizeof(finder->head)); // -1: no position yet
+
+    const uint8_t* in = (const uint8_t*)input;
+    uint8_t* out = (uint8_t*)output;
+    size_t outSize = 0;
+    size_t flagAt = 0;
+    int tokenCount = 8; // Forces a new flag byte on the first token
+
+    size_t position = 0;
+    while (position < inputSize) {
+        if (tokenCount == 8) {
+            if (outSize >= outCapacity) break;
+            flagAt = outSize++;
+            out[flagAt] = 0;
+            tokenCount = 0;
+        }
+
+        // Longest match in the window, walking the hash chain newest first
+        size_t bestLength = 0;
+        size_t bestDistance = 0;
+        size_t remaining = inputSize - position;
+        if (remaining >= LZSS_MIN_MATCH) {
+            size_t maxLength = remaining < LZSS_MAX_MATCH ? remaining : LZSS_MAX_MATCH;
+            int32_t candidate = finder->head[HashTriple(in + position)];
+            for (int chain = 0; chain < LZSS_MAX_CHAIN && candidate >= 0; ++chain) {
+                size_t distance = position - (size_t)candidate;
+                if (distance == 0 || distance > LZSS_WINDOW_SIZE) break;
+
+                size_t length = 0;
+                while (length < maxLength && in[candidate + length] == in[position + length]) length++;
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestDistance = distance;
+                    if (length == maxLength) break;
+                }
+
+                int32_t next = finder->previous[candidate & (LZSS_WINDOW_SIZE - 1)];
+                if (next >= candidate) break; // Slot reused by a newer position
+                candidate = next;
+            }
+        }
+
+        size_t advance;
+        if (bestLength >= LZSS_MIN_MATCH) {
+            if (outCapacity - outSize < 2) break;
+            uint32_t token = (uint32_t)((bestDistance - 1) << 4) | (uint32_t)(bestLength - LZSS_MIN_MATCH);
+            out[outSize++] = (uint8_t)(token >> 8);
+            out[outSize++] = (uint8_t)token;
+            advance = bestLength;
+        }
+        else {
+            if (outSize >= outCapacity) break;
+            out[flagAt] |= (uint8_t)(1 << tokenCount);
+            out[outSize++] = in[position];
+            advance = 1;
+        }
+        tokenCount++;
+
+        for (size_t i = 0; i < advance; ++i, ++position) {
+            if (inputSize - position >= LZSS_MIN_MATCH) InsertPosition(finder, in, position);
+        }
+    }
+
+    free(finder);
+    return position == inputSize ? outSize : 0;
+}
+
+// Decompress a buffer
+bool Lzss_Decompress(const void* input, size_t inputSize, void* output, size_t outputSize) {
+    if (!input || !output) return false;
+
+    const uint8_t* in = (const uint8_t*)input;
+    uint8_t* out = (uint8_t*)output;
+    size_t inPosition = 0;
+    size_t outPosition = 0;
+
+    while (outPosition < outputSize) {
+        if (inPosition >= inputSize) return false;
+        uint8_t flags = in[inPosition++];
+
+        for (int bit = 0; bit < 8 && outPosition < outputSize; ++bit) {
+            if (flags & (1 << bit)) {
+                if (inPosition >= inputSize) return false;
+                out[outPosition++] = in[inPosition++];
+                continue;
+            }
+
+            if (inputSize - inPosition < 2) return false;
+            uint32_t token = ((uint32_t)in[inPosition] << 8) | in[inPosition + 1];
+            inPosition += 2;
+
+            size_t distance = (token >> 4) + 1;
+            size_t length = (token & 0x0F) + LZSS_MIN_MATCH;
+            if (distance > outPosition || length > outputSize - outPosition) return false;
+
+            // Byte by byte: a match may overlap the bytes it is producing
+            const uint8_t* source = out + outPosition - distance;
+            for (size_t i = 0; i < length; ++i) out[outPosition + i] = source[i];
+            outPosition += length;
+        }
+    }
+    return inPosition == inputSize;
+}
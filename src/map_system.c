@@ -1,25 +1,117 @@
 // map_system.c
 #include "map_system.h"
+#include "job_system.h"
+#include "file_utils.h"
+#include <SDL2/SDL.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
+
+#define MAP_STREAMING_THREADS 2
+#define MAP_CHUNK_PATH_MAX 512
+#define MAP_UNLOAD_CHUNKS_PER_FRAME 4
+#define MAP_CHUNK_PAGE_SIZE 4096 // Stride for faulting in mapped chunk files
+#define MAP_CHUNK_RETRY_MS 250       // Wait before retrying a failed chunk load, doubled per failure
+#define MAP_CHUNK_MAX_RETRY_MS 8000  // Longest wait between retries
+
+// Chunk States
+typedef enum {
+    MAP_CHUNK_UNLOADED,
+    MAP_CHUNK_QUEUED,   // Load job submitted, not started (main thread may cancel)
+    MAP_CHUNK_LOADING,  // Owned by a worker thread
+    MAP_CHUNK_LOADED,   // Data in memory, waiting for activation
+    MAP_CHUNK_ACTIVE,   // Handed to onActivate
+    MAP_CHUNK_FAILED    // Load failed; the main thread returns it to UNLOADED with a retry time
+} MapChunkState;
+
+// Streamed Chunk
+typedef struct {
+    MapStreaming* streaming;
+    int x, z;
+    SDL_atomic_t state;       // MapChunkState
+    FileMapping mapping;      // Written by the loader before state becomes LOADED
+    size_t size;
+    bool isTracked;           // Listed in trackedIndices
+    bool isAccounted;         // Counted in residentBytes
+    int failures;             // Consecutive failed loads
+    Uint32 retryTicks;        // SDL_GetTicks time before which a failed chunk is not requested
+} MapChunk;
+
+struct MapStreaming {
+    Map* map;
+    MapStreamingConfig config;
+    char pathFormat[64];
+    MapChunk* chunks;         // gridWidth * gridDepth, row-major along X
+    int* trackedIndices;      // Chunks not in UNLOADED/FAILED state
+    int trackedCount;
+    SDL_atomic_t loadsInFlight;
+    size_t averageChunkSize;  // Running estimate used to budget new loads
+    int focusX, focusZ;
+    int aheadX, aheadZ;       // Predicted focus chunk for prefetching
+    MapStreamingStats stats;
+};
 
 static Map* activeMap = NULL;
+static JobPool* streamingPool = NULL;
+static Map** pendingUnloads = NULL; // Maps released by Map_SetActive, unloaded over several frames
+static int pendingUnloadCount = 0;
+static int pendingUnloadCapacity = 0;
+
+static void ReleaseStreaming(MapStreaming* streaming);
+static int ReleaseChunks(MapStreaming* streaming, int maxChunks);
 
 // Initialize the map system
 bool MapSystem_Init() {
+    streamingPool = JobPool_Create("MapStreaming", MAP_STREAMING_THREADS);
+    if (!streamingPool) {
+        printf("Map streaming unavailable, maps will load as one unit.\n");
+    }
     printf("Map system initialized.\n");
     return true;
 }
 
 // Shutdown the map system
 void MapSystem_Shutdown() {
+    for (int i = 0; i < pendingUnloadCount; ++i) {
+        Map_Unload(pendingUnloads[i]);
+    }
+    free(pendingUnloads);
+    pendingUnloads = NULL;
+    pendingUnloadCount = 0;
+    pendingUnloadCapacity = 0;
+
     if (activeMap) {
         Map_Unload(activeMap);
+        activeMap = NULL;
     }
+
+    JobPool_Destroy(streamingPool);
+    streamingPool = NULL;
     printf("Map system shut down.\n");
 }
 
+// Update the map system: finish releasing maps that are no longer active
+void MapSystem_Update(float deltaTime) {
+    (void)deltaTime;
+
+    int kept = 0;
+    for (int i = 0; i < pendingUnloadCount; ++i) {
+        Map* map = pendingUnloads[i];
+        if (map == activeMap) continue; // Made active again; Map_SetActive normally removes it
+        MapStreaming* streaming = map->streaming;
+
+        // Release a few chunks per frame; unload once nothing is left in flight
+        if (streaming && (ReleaseChunks(streaming, MAP_UNLOAD_CHUNKS_PER_FRAME) > 0 ||
+            SDL_AtomicGet(&streaming->loadsInFlight) > 0)) {
+            pendingUnloads[kept++] = map;
+            continue;
+        }
+        Map_Unload(map);
+    }
+    pendingUnloadCount = kept;
+}
+
 // Load a map
 Map* Map_Load(const char* name, const char* modelPath) {
     if (!name || !modelPath) return NULL;
@@ -31,12 +123,10 @@ Map* Map_Load(const char* name, const char* modelPath) {
     map->modelPath = strdup(modelPath);
     map->modelData = NULL; // Load actual model data here
     map->isLoaded = true;
-    map->npcs = NULL;
-    map->npcCount = 0;
-    map->items = NULL;
-    map->itemCount = 0;
-    map->events = NULL;
-    map->eventCount = 0;
+    EntityArray_Init(&map->npcs);
+    EntityArray_Init(&map->items);
+    EntityArray_Init(&map->events);
+    map->streaming = NULL;
 
     printf("Map '%s' loaded from '%s'.\n", name, modelPath);
     return map;
@@ -46,21 +136,26 @@ Map* Map_Load(const char* name, const char* modelPath) {
 void Map_Unload(Map* map) {
     if (!map) return;
 
+    if (map->streaming) {
+        ReleaseStreaming(map->streaming);
+        map->streaming = NULL;
+    }
+
     free((void*)map->name);
     free((void*)map->modelPath);
 
     // Unload assets
-    for (int i = 0; i < map->npcCount; ++i) {
-        AI_DestroyNPC(map->npcs[i]);
+    for (int i = 0; i < map->npcs.count; ++i) {
+        AI_DestroyNPC((NPC*)map->npcs.entities[i]);
     }
-    free(map->npcs);
+    EntityArray_Free(&map->npcs);
 
-    for (int i = 0; i < map->itemCount; ++i) {
-        Item_Destroy(map->items[i]);
+    for (int i = 0; i < map->items.count; ++i) {
+        Item_Destroy((Item*)map->items.entities[i]);
     }
-    free(map->items);
+    EntityArray_Free(&map->items);
 
-    free(map->events); // Events should be dynamically allocated elsewhere
+    EntityArray_Free(&map->events); // Events should be dynamically allocated elsewhere
 
     free(map);
     printf("Map unloaded.\n");
@@ -73,13 +168,38 @@ void Map_Render(Map* map) {
     // Call renderer to render the model
 }
 
-// Set the active map
+// Set the active map; the previous map is released over the next frames by MapSystem_Update
 void Map_SetActive(Map* map) {
+    if (map == activeMap) return;
+
+    // A map switched back to before its release finished is no longer pending
+    for (int i = 0; i < pendingUnloadCount; ++i) {
+        if (pendingUnloads[i] == map) {
+            memmove(&pendingUnloads[i], &pendingUnloads[i + 1], sizeof(Map*) * (pendingUnloadCount - i - 1));
+            pendingUnloadCount--;
+            break;
+        }
+    }
+
     if (activeMap) {
-        Map_Unload(activeMap);
+        if (pendingUnloadCount >= pendingUnloadCapacity) {
+            int capacity = pendingUnloadCapacity ? pendingUnloadCapacity * 2 : 4;
+            Map** grown = (Map**)realloc(pendingUnloads, sizeof(Map*) * capacity);
+            if (grown) {
+                pendingUnloads = grown;
+                pendingUnloadCapacity = capacity;
+            }
+        }
+
+        if (pendingUnloadCount < pendingUnloadCapacity) {
+            pendingUnloads[pendingUnloadCount++] = activeMap;
+        }
+        else {
+            Map_Unload(activeMap); // Out of memory: fall back to unloading now
+        }
     }
     activeMap = map;
-    printf("Active map set to '%s'.\n", map->name);
+    printf("Active map set to '%s'.\n", map ? map->name : "(none)");
 }
 
 // Get the active map
@@ -88,75 +208,129 @@ Map* Map_GetActive() {
 }
 
 // Add an NPC to the map
-bool Map_AddNPC(Map* map, NPC* npc) {
-    if (!map || !npc) return false;
+EntityHandle Map_AddNPC(Map* map, NPC* npc) {
+    if (!map || !npc) return ENTITY_HANDLE_NONE;
 
-    map->npcs = (NPC**)realloc(map->npcs, sizeof(NPC*) * (map->npcCount + 1));
-    map->npcs[map->npcCount++] = npc;
-    printf("NPC '%s' added to map '%s'.\n", npc->name, map->name);
-    return true;
+    EntityHandle handle = EntityArray_Add(&map->npcs, npc);
+    if (handle != ENTITY_HANDLE_NONE) {
+        printf("NPC '%s' added to map '%s'.\n", npc->name, map->name);
+    }
+    return handle;
 }
 
 // Add an item to the map
-bool Map_AddItem(Map* map, Item* item) {
-    if (!map || !item) return false;
+EntityHandle Map_AddItem(Map* map, Item* item) {
+    if (!map || !item) return ENTITY_HANDLE_NONE;
 
-    map->items = (Item**)realloc(map->items, sizeof(Item*) * (map->itemCount + 1));
-    map->items[map->itemCount++] = item;
-    printf("Item '%s' added to map '%s'.\n", item->name, map->name);
-    return true;
+    EntityHandle handle = EntityArray_Add(&map->items, item);
+    if (handle != ENTITY_HANDLE_NONE) {
+        printf("Item '%s' added to map '%s'.\n", item->name, map->name);
+    }
+    return handle;
 }
 
 // Add an event to the map
-bool Map_AddEvent(Map* map, Event* event) {
-    if (!map || !event) return false;
+EntityHandle Map_AddEvent(Map* map, Event* event) {
+    if (!map || !event) return ENTITY_HANDLE_NONE;
+
+    EntityHandle handle = EntityArray_Add(&map->events, event);
+    if (handle != ENTITY_HANDLE_NONE) {
+        printf("Event added to map '%s'.\n", map->name);
+    }
+    return handle;
+}
+
+// Add many NPCs at once (e.g. a whole map spawn); outHandles may be NULL
+bool Map_AddNPCs(Map* map, NPC** npcs, int count, EntityHandle* outHandles) {
+    if (!map || !npcs) return false;
 
-    map->events = (Event**)realloc(map->events, sizeof(Event*) * (map->eventCount + 1));
-    map->events[map->eventCount++] = event;
-    printf("Event added to map '%s'.\n", map->name);
+    if (!EntityArray_AddBulk(&map->npcs, (void* const*)npcs, count, outHandles)) return false;
+    printf("%d NPCs added to map '%s'.\n", count, map->name);
     return true;
 }
 
-// Remove an NPC from the map
-void Map_RemoveNPC(Map* map, NPC* npc) {
-    if (!map || !npc) return;
+// Add many items at once; outHandles may be NULL
+bool Map_AddItems(Map* map, Item** items, int count, EntityHandle* outHandles) {
+    if (!map || !items) return false;
 
-    for (int i = 0; i < map->npcCount; ++i) {
-        if (map->npcs[i] == npc) {
-            map->npcs[i] = map->npcs[--map->npcCount];
-            map->npcs = (NPC**)realloc(map->npcs, sizeof(NPC*) * map->npcCount);
-            printf("NPC '%s' removed from map '%s'.\n", npc->name, map->name);
-            return;
-        }
+    if (!EntityArray_AddBulk(&map->items, (void* const*)items, count, outHandles)) return false;
+    printf("%d items added to map '%s'.\n", count, map->name);
+    return true;
+}
+
+// Add many events at once; outHandles may be NULL
+bool Map_AddEvents(Map* map, Event** events, int count, EntityHandle* outHandles) {
+    if (!map || !events) return false;
+
+    if (!EntityArray_AddBulk(&map->events, (void* const*)events, count, outHandles)) return false;
+    printf("%d events added to map '%s'.\n", count, map->name);
+    return true;
+}
+
+// Get an NPC by handle, NULL if it was removed
+NPC* Map_GetNPC(Map* map, EntityHandle handle) {
+    return map ? (NPC*)EntityArray_Get(&map->npcs, handle) : NULL;
+}
+
+// Get an item by handle, NULL if it was removed
+Item* Map_GetItem(Map* map, EntityHandle handle) {
+    return map ? (Item*)EntityArray_Get(&map->items, handle) : NULL;
+}
+
+// Get an event by handle, NULL if it was removed
+Event* Map_GetEvent(Map* map, EntityHandle handle) {
+    return map ? (Event*)EntityArray_Get(&map->events, handle) : NULL;
+}
+
+// Remove an NPC by handle in O(1), returning it
+NPC* Map_RemoveNPCByHandle(Map* map, EntityHandle handle) {
+    if (!map) return NULL;
+
+    NPC* npc = (NPC*)EntityArray_Remove(&map->npcs, handle);
+    if (npc) {
+        printf("NPC '%s' removed from map '%s'.\n", npc->name, map->name);
     }
+    return npc;
 }
 
-// Remove an item from the map
-void Map_RemoveItem(Map* map, Item* item) {
-    if (!map || !item) return;
+// Remove an item by handle in O(1), returning it
+Item* Map_RemoveItemByHandle(Map* map, EntityHandle handle) {
+    if (!map) return NULL;
 
-    for (int i = 0; i < map->itemCount; ++i) {
-        if (map->items[i] == item) {
-            map->items[i] = map->items[--map->itemCount];
-            map->items = (Item**)realloc(map->items, sizeof(Item*) * map->itemCount);
-            printf("Item '%s' removed from map '%s'.\n", item->name, map->name);
-            return;
-        }
+    Item* item = (Item*)EntityArray_Remove(&map->items, handle);
+    if (item) {
+        printf("Item '%s' removed from map '%s'.\n", item->name, map->name);
     }
+    return item;
 }
 
-// Remove an event from the map
-void Map_RemoveEvent(Map* map, Event* event) {
-    if (!map || !event) return;
+// Remove an event by handle in O(1), returning it
+Event* Map_RemoveEventByHandle(Map* map, EntityHandle handle) {
+    if (!map) return NULL;
 
-    for (int i = 0; i < map->eventCount; ++i) {
-        if (map->events[i] == event) {
-            map->events[i] = map->events[--map->eventCount];
-            map->events = (Event**)realloc(map->events, sizeof(Event*) * map->eventCount);
-            printf("Event removed from map '%s'.\n", map->name);
-            return;
-        }
+    Event* event = (Event*)EntityArray_Remove(&map->events, handle);
+    if (event) {
+        printf("Event removed from map '%s'.\n", map->name);
     }
+    return event;
+}
+
+// Remove an NPC from the map (prefer Map_RemoveNPCByHandle, this searches the list)
+void Map_RemoveNPC(Map* map, NPC* npc) {
+    if (!map || !npc) return;
+    Map_RemoveNPCByHandle(map, EntityArray_FindHandle(&map->npcs, npc));
+}
+
+// Remove an item from the map (prefer Map_RemoveItemByHandle, this searches the list)
+void Map_RemoveItem(Map* map, Item* item) {
+    if (!map || !item) return;
+    Map_RemoveItemByHandle(map, EntityArray_FindHandle(&map->items, item));
+}
+
+// Remove an event from the map (prefer Map_RemoveEventByHandle, this searches the list)
+void Map_RemoveEvent(Map* map, Event* event) {
+    if (!map || !event) return;
+    Map_RemoveEventByHandle(map, EntityArray_FindHandle(&map->events, event));
 }
 
 // Debug render for SDK integration
@@ -165,3 +339,312 @@ void Map_DebugRender(Map* map) {
     printf("Debug rendering map '%s'.\n", map->name);
     // Implement debug visualization here
 }
+
+// Chunk index for grid coordinates, -1 if outside the map
+static int GetChunkIndex(const MapStreaming* streaming, int x, int z) {
+    if (x < 0 || z < 0 || x >= streaming->config.gridWidth || z >= streaming->config.gridDepth) return -1;
+    return z * streaming->config.gridWidth + x;
+}
+
+// Chebyshev distance in chunks between two grid cells
+static int ChunkDistance(int x0, int z0, int x1, int z1) {
+    int dx = abs(x0 - x1);
+    int dz = abs(z0 - z1);
+    return dx > dz ? dx : dz;
+}
+
+// Check if a chunk should stay resident (current area with one chunk of hysteresis, or the prefetch area)
+static bool IsChunkWanted(const MapStreaming* streaming, const MapChunk* chunk) {
+    int radius = streaming->config.loadRadius;
+    return ChunkDistance(chunk->x, chunk->z, streaming->focusX, streaming->focusZ) <= radius + 1 ||
+        ChunkDistance(chunk->x, chunk->z, streaming->aheadX, streaming->aheadZ) <= radius;
+}
+
+// Load job, runs on a streaming thread
+static void LoadChunkJob(void* data) {
+    MapChunk* chunk = (MapChunk*)data;
+    MapStreaming* streaming = chunk->streaming;
+
+    // The main thread cancels queued loads by moving them back to UNLOADED
+    if (SDL_AtomicCAS(&chunk->state, MAP_CHUNK_QUEUED, MAP_CHUNK_LOADING)) {
+        char path[MAP_CHUNK_PATH_MAX];
+        snprintf(path, sizeof(path), streaming->pathFormat, streaming->map->modelPath, chunk->x, chunk->z);
+
+        // Map instead of copying, then fault the pages in here so activation never waits on the disk
+        bool loaded = File_Map(path, &chunk->mapping);
+        if (loaded && chunk->mapping.isMapped) {
+            File_AdviseMapping(&chunk->mapping, 0, chunk->mapping.size, FILE_ACCESS_WILLNEED);
+
+            const volatile uint8_t* bytes = (const volatile uint8_t*)chunk->mapping.data;
+            for (size_t offset = 0; offset < chunk->mapping.size; offset += MAP_CHUNK_PAGE_SIZE) {
+                (void)bytes[offset];
+            }
+        }
+
+        chunk->size = loaded ? chunk->mapping.size : 0;
+        SDL_AtomicSet(&chunk->state, loaded ? MAP_CHUNK_LOADED : MAP_CHUNK_FAILED);
+    }
+    SDL_AtomicAdd(&streaming->loadsInFlight, -1);
+}
+
+// Drop a chunk's data (main thread, chunk must be LOADED or ACTIVE)
+static void EvictChunk(MapStreaming* streaming, MapChunk* chunk) {
+    if (SDL_AtomicGet(&chunk->state) == MAP_CHUNK_ACTIVE) {
+        if (streaming->config.onDeactivate) {
+            streaming->config.onDeactivate(streaming->map, chunk->x, chunk->z, streaming->config.userData);
+        }
+        streaming->stats.activeChunks--;
+    }
+    if (chunk->isAccounted) {
+        streaming->stats.residentBytes -= chunk->size;
+        chunk->isAccounted = false;
+    }
+
+    File_Unmap(&chunk->mapping);
+    chunk->size = 0;
+    SDL_AtomicSet(&chunk->state, MAP_CHUNK_UNLOADED);
+    streaming->stats.evictions++;
+}
+
+// Remove a chunk from the tracked list by position
+static void UntrackChunkAt(MapStreaming* streaming, int trackedIndex) {
+    streaming->chunks[streaming->trackedIndices[trackedIndex]].isTracked = false;
+    streaming->trackedIndices[trackedIndex] = streaming->trackedIndices[--streaming->trackedCount];
+}
+
+// Queue a background load for a chunk
+static bool RequestChunk(MapStreaming* streaming, int index, JobPriority priority) {
+    MapChunk* chunk = &streaming->chunks[index];
+    if (chunk->isTracked || SDL_AtomicGet(&chunk->state) != MAP_CHUNK_UNLOADED) return true;
+    if (chunk->failures > 0 && !SDL_TICKS_PASSED(SDL_GetTicks(), chunk->retryTicks)) return true; // Backing off
+
+    // Only start loads that fit the budget, assuming average-sized chunks
+    size_t inFlight = (size_t)SDL_AtomicGet(&streaming->loadsInFlight) + 1;
+    if (streaming->stats.residentBytes + inFlight * streaming->averageChunkSize > streaming->config.memoryBudget) {
+        return false;
+    }
+
+    SDL_AtomicSet(&chunk->state, MAP_CHUNK_QUEUED);
+    SDL_AtomicAdd(&streaming->loadsInFlight, 1);
+    if (!JobPool_Submit(streamingPool, LoadChunkJob, chunk, priority)) {
+        SDL_AtomicSet(&chunk->state, MAP_CHUNK_UNLOADED);
+        SDL_AtomicAdd(&streaming->loadsInFlight, -1);
+        return false;
+    }
+
+    chunk->isTracked = true;
+    streaming->trackedIndices[streaming->trackedCount++] = index;
+    return true;
+}
+
+// Request chunks ring by ring around a center, nearest first
+static void RequestArea(MapStreaming* streaming, int centerX, int centerZ, JobPriority priority) {
+    int radius = streaming->config.loadRadius;
+
+    for (int ring = 0; ring <= radius; ++ring) {
+        for (int z = centerZ - ring; z <= centerZ + ring; ++z) {
+            for (int x = centerX - ring; x <= centerX + ring; ++x) {
+                if (ChunkDistance(x, z, centerX, centerZ) != ring) continue;
+
+                int index = GetChunkIndex(streaming, x, z);
+                if (index >= 0 && !RequestChunk(streaming, index, priority)) return; // Over budget
+            }
+        }
+    }
+}
+
+// Release tracked chunks (used when unloading); returns the number still tracked
+static int ReleaseChunks(MapStreaming* streaming, int maxChunks) {
+    int released = 0;
+
+    for (int i = streaming->trackedCount - 1; i >= 0 && released < maxChunks; --i) {
+        MapChunk* chunk = &streaming->chunks[streaming->trackedIndices[i]];
+        int state = SDL_AtomicGet(&chunk->state);
+
+        if (state == MAP_CHUNK_QUEUED && SDL_AtomicCAS(&chunk->state, MAP_CHUNK_QUEUED, MAP_CHUNK_UNLOADED)) {
+            UntrackChunkAt(streaming, i);
+        }
+        else if (state == MAP_CHUNK_LOADED || state == MAP_CHUNK_ACTIVE) {
+            EvictChunk(streaming, chunk);
+            UntrackChunkAt(streaming, i);
+            released++;
+        }
+        else if (state == MAP_CHUNK_FAILED || state == MAP_CHUNK_UNLOADED) {
+            UntrackChunkAt(streaming, i);
+        }
+        // LOADING chunks are picked up on a later call
+    }
+    return streaming->trackedCount;
+}
+
+// Wait for outstanding loads and free all streaming state
+static void ReleaseStreaming(MapStreaming* streaming) {
+    while (ReleaseChunks(streaming, streaming->trackedCount) > 0 || SDL_AtomicGet(&streaming->loadsInFlight) > 0) {
+        SDL_Delay(1);
+    }
+
+    free(streaming->chunks);
+    free(streaming->trackedIndices);
+    free(streaming);
+}
+
+// Split a map into streamed chunks
+bool Map_EnableStreaming(Map* map, const MapStreamingConfig* config) {
+    if (!map || !config || map->streaming) return false;
+    if (config->chunkSize <= 0.0f || config->gridWidth <= 0 || config->gridDepth <= 0 || config->loadRadius < 0) return false;
+
+    if (!streamingPool) {
+        printf("Map streaming requires the map system to be initialized.\n");
+        return false;
+    }
+
+    MapStreaming* streaming = (MapStreaming*)calloc(1, sizeof(MapStreaming));
+    if (!streaming) return false;
+
+    int chunkCount = config->gridWidth * config->gridDepth;
+    streaming->chunks = (MapChunk*)calloc(chunkCount, sizeof(MapChunk));
+    streaming->trackedIndices = (int*)malloc(sizeof(int) * chunkCount);
+    if (!streaming->chunks || !streaming->trackedIndices) {
+        free(streaming->chunks);
+        free(streaming->trackedIndices);
+        free(streaming);
+        return false;
+    }
+
+    streaming->map = map;
+    streaming->config = *config;
+    snprintf(streaming->pathFormat, sizeof(streaming->pathFormat), "%s",
+        config->chunkPathFormat ? config->chunkPathFormat : "%s.%d_%d.chunk");
+    streaming->config.chunkPathFormat = streaming->pathFormat;
+    // Until a chunk has loaded, budget as if the load area's chunks split the budget evenly,
+    // so the first burst of requests cannot overshoot it
+    int areaEdge = config->loadRadius * 2 + 1;
+    streaming->averageChunkSize = config->memoryBudget / (size_t)(areaEdge * areaEdge);
+    SDL_AtomicSet(&streaming->loadsInFlight, 0);
+
+    for (int z = 0; z < config->gridDepth; ++z) {
+        for (int x = 0; x < config->gridWidth; ++x) {
+            MapChunk* chunk = &streaming->chunks[z * config->gridWidth + x];
+            chunk->streaming = streaming;
+            chunk->x = x;
+            chunk->z = z;
+            SDL_AtomicSet(&chunk->state, MAP_CHUNK_UNLOADED);
+        }
+    }
+
+    map->streaming = streaming;
+    printf("Streaming enabled for map '%s' (%dx%d chunks).\n", map->name, config->gridWidth, config->gridDepth);
+    return true;
+}
+
+// Stream chunks around a focus point (camera or player); call once per frame on the main thread
+void Map_UpdateStreaming(Map* map, Vector3 focus, Vector3 velocity) {
+    if (!map || !map->streaming) return;
+
+    MapStreaming* streaming = map->streaming;
+    const MapStreamingConfig* config = &streaming->config;
+
+    streaming->focusX = (int)floorf(focus.x / config->chunkSize);
+    streaming->focusZ = (int)floorf(focus.z / config->chunkSize);
+    int directionX = velocity.x > 0.01f ? 1 : (velocity.x < -0.01f ? -1 : 0);
+    int directionZ = velocity.z > 0.01f ? 1 : (velocity.z < -0.01f ? -1 : 0);
+    streaming->aheadX = streaming->focusX + directionX * config->prefetchDistance;
+    streaming->aheadZ = streaming->focusZ + directionZ * config->prefetchDistance;
+
+    // Account newly loaded chunks and drop the ones we moved away from
+    for (int i = streaming->trackedCount - 1; i >= 0; --i) {
+        MapChunk* chunk = &streaming->chunks[streaming->trackedIndices[i]];
+        int state = SDL_AtomicGet(&chunk->state);
+
+        if (state == MAP_CHUNK_LOADED && !chunk->isAccounted) {
+            chunk->isAccounted = true;
+            streaming->stats.residentBytes += chunk->size;
+            streaming->stats.loadsCompleted++;
+            streaming->averageChunkSize = streaming->stats.loadsCompleted > 1
+                ? (streaming->averageChunkSize * 7 + chunk->size) / 8
+                : chunk->size;
+            chunk->failures = 0;
+        }
+        else if (state == MAP_CHUNK_FAILED) {
+            // Retry later with exponential backoff, so a transient read error does not leave a hole
+            Uint32 delay = MAP_CHUNK_RETRY_MS << (chunk->failures < 5 ? chunk->failures : 5);
+            chunk->failures++;
+            chunk->retryTicks = SDL_GetTicks() + (delay < MAP_CHUNK_MAX_RETRY_MS ? delay : MAP_CHUNK_MAX_RETRY_MS);
+            streaming->stats.failedLoads++;
+            SDL_AtomicSet(&chunk->state, MAP_CHUNK_UNLOADED);
+            UntrackChunkAt(streaming, i);
+            continue;
+        }
+
+        if (IsChunkWanted(streaming, chunk)) continue;
+
+        if (state == MAP_CHUNK_QUEUED) {
+            if (SDL_AtomicCAS(&chunk->state, MAP_CHUNK_QUEUED, MAP_CHUNK_UNLOADED)) {
+                UntrackChunkAt(streaming, i);
+            }
+        }
+        else if (state == MAP_CHUNK_LOADED || state == MAP_CHUNK_ACTIVE) {
+            EvictChunk(streaming, chunk);
+            UntrackChunkAt(streaming, i);
+        }
+    }
+
+    // Enforce the memory budget, dropping the farthest chunks first (never the focus chunk)
+    while (streaming->stats.residentBytes > config->memoryBudget) {
+        int farthest = -1;
+        int farthestDistance = 0;
+        for (int i = 0; i < streaming->trackedCount; ++i) {
+            MapChunk* chunk = &streaming->chunks[streaming->trackedIndices[i]];
+            int state = SDL_AtomicGet(&chunk->state);
+            int distance = ChunkDistance(chunk->x, chunk->z, streaming->focusX, streaming->focusZ);
+            if ((state == MAP_CHUNK_LOADED || state == MAP_CHUNK_ACTIVE) && distance > farthestDistance) {
+                farthest = i;
+                farthestDistance = distance;
+            }
+        }
+        if (farthest < 0) break;
+
+        EvictChunk(streaming, &streaming->chunks[streaming->trackedIndices[farthest]]);
+        UntrackChunkAt(streaming, farthest);
+    }
+
+    // Request what is needed now, then prefetch along the movement direction
+    RequestArea(streaming, streaming->focusX, streaming->focusZ, JOB_PRIORITY_HIGH);
+    if (directionX != 0 || directionZ != 0) {
+        RequestArea(streaming, streaming->aheadX, streaming->aheadZ, JOB_PRIORITY_LOW);
+    }
+
+    // Activate loaded chunks in range, nearest first, within the per-frame time budget
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 budgetTicks = (Uint64)(config->activationBudgetMs * 0.001 * (double)SDL_GetPerformanceFrequency());
+    for (int ring = 0; ring <= config->loadRadius; ++ring) {
+        for (int i = 0; i < streaming->trackedCount; ++i) {
+            MapChunk* chunk = &streaming->chunks[streaming->trackedIndices[i]];
+            if (!chunk->isAccounted || SDL_AtomicGet(&chunk->state) != MAP_CHUNK_LOADED) continue;
+            if (ChunkDistance(chunk->x, chunk->z, streaming->focusX, streaming->focusZ) != ring) continue;
+
+            if (config->onActivate) {
+                config->onActivate(map, chunk->x, chunk->z, chunk->mapping.data, chunk->size, config->userData);
+            }
+            SDL_AtomicSet(&chunk->state, MAP_CHUNK_ACTIVE);
+            streaming->stats.activeChunks++;
+
+            if (SDL_GetPerformanceCounter() - start >= budgetTicks) goto activationDone;
+        }
+    }
+activationDone:
+
+    if (streaming->stats.residentBytes > streaming->stats.peakResidentBytes) {
+        streaming->stats.peakResidentBytes = streaming->stats.residentBytes;
+    }
+}
+
+// Get streaming statistics for a map
+bool Map_GetStreamingStats(Map* map, MapStreamingStats* stats) {
+    if (!map || !map->streaming || !stats) return false;
+
+    *stats = map->streaming->stats;
+    stats->trackedChunks = map->streaming->trackedCount;
+    stats->loadsInFlight = SDL_AtomicGet(&map->streaming->loadsInFlight);
+    return true;
+}
@@ -0,0 +1,687 @@
+// music_stream.c
+#include "music_stream.h"
+#include "pack_archive.h"
+#include "profiler.h" // For decode zones
+#include "vfs.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MUSIC_STREAM_MAX_DECODERS 8
+#define MUSIC_STREAM_WAKE_MS 10 // Decode thread poll interval when the mixer is not signalling
+
+// Slot lifecycle. The main thread moves FREE -> PLAYING -> STOPPING, the mixer moves
+// PLAYING/STOPPING -> RELEASED once it will not touch the ring again, and the main
+// thread frees RELEASED slots back to FREE in MusicStream_Update.
+typedef enum {
+    STREAM_FREE,
+    STREAM_PLAYING,
+    STREAM_STOPPING,
+    STREAM_RELEASED
+} StreamState;
+
+struct MusicSource {
+    FILE* file;              // Loose file, read incrementally
+    const uint8_t* memory;   // Packed entry (in place, or ownedMemory)
+    void* ownedMemory;       // Compressed pack entries are inflated whole; store music uncompressed
+    VfsMountID packMount;    // Retained while memory points into the pack
+    size_t size;
+    size_t position;
+};
+
+// Active stream. The ring is single-producer (decode thread) / single-consumer (mixer);
+// positions are running byte totals and wrap modulo 2^32.
+typedef struct {
+    SDL_atomic_t state;           // StreamState
+    SDL_atomic_t readPosition;    // Bytes consumed by the mixer
+    SDL_atomic_t writePosition;   // Bytes produced by the decode thread
+    SDL_atomic_t volume;          // 0..SDL_MIX_MAXVOLUME
+    SDL_atomic_t isEndOfStream;   // Decoder and converter are drained
+    SDL_mutex* mutex;             // Held by whoever runs the decoder
+
+    uint32_t generation;          // Bumped when the slot is freed (stale handles)
+    bool loop;
+    bool isFlushed;               // Converter flushed after the last decoded block
+    bool hasDecodedSinceRewind;   // Guards against spinning on empty tracks
+    MusicSource source;
+    const MusicDecoder* decoder;
+    void* decoderState;
+    SDL_AudioStream* converter;   // Decoder format -> mixer format
+    uint8_t* ring;
+    uint8_t* staging;             // One chunk of decoded or converted PCM
+    size_t residentBytes;
+    uint64_t decodedBytes;
+} MusicStreamSlot;
+
+static MusicStreamSlot streams[MUSIC_STREAM_MAX_STREAMS];
+static const MusicDecoder* decoders[MUSIC_STREAM_MAX_DECODERS];
+static int decoderCount = 0;
+static bool isInitialized = false;
+static bool isHooked = false;
+
+// Mixer output format
+static int mixerFrequency = 0;
+static Uint16 mixerFormat = 0;
+static int mixerChannels = 0;
+static int mixerFrameBytes = 0;
+
+static SDL_Thread* decodeThread = NULL;
+static SDL_sem* decodeSignal = NULL;       // Posted by the mixer after it consumes data
+static SDL_atomic_t isShuttingDown;
+static SDL_atomic_t masterVolume;
+static SDL_atomic_t underrunCount;
+static size_t peakResidentBytes = 0;
+static uint64_t retiredDecodedBytes = 0;   // decodedBytes of freed streams
+
+// Music Sources
+static bool MusicSource_Open(MusicSource* source, const char* filepath) {
+    memset(source, 0, sizeof(MusicSource));
+
+    VfsResolution resolution;
+    if (!Vfs_ResolveRetained(filepath, &resolution)) return false;
+
+    const PackArchive* pack = resolution.pack;
+    const PackEntry* entry = resolution.entry;
+    if (entry) {
+        source->memory = (const uint8_t*)PackArchive_GetData(pack, entry);
+        if (source->memory) {
+            source->packMount = resolution.mount;
+        }
+        else {
+            size_t size = 0;
+            source->ownedMemory = PackArchive_ReadAlloc(pack, entry, &size);
+            source->memory = (const uint8_t*)source->ownedMemory;
+            Vfs_ReleaseResolution(&resolution);
+        }
+        source->size = (size_t)entry->size;
+        return source->memory != NULL;
+    }
+
+    source->file = fopen(resolution.hostPath, "rb");
+    if (!source->file) return false;
+
+    fseek(source->file, 0, SEEK_END);
+    long size = ftell(source->file);
+    fseek(source->file, 0, SEEK_SET);
+    source->size = size > 0 ? (size_t)size : 0;
+    return true;
+}
+
+static void MusicSource_Close(MusicSource* source) {
+    if (source->file) {
+        fclose(source->file);
+    }
+    free(source->ownedMemory);
+    Vfs_ReleaseMount(source->packMount);
+    memset(source, 0, sizeof(MusicSource));
+}
+
+// Read up to size bytes from the current position
+size_t MusicSource_Read(MusicSource* source, void* buffer, size_t size) {
+    if (!source || !buffer) return 0;
+
+    size_t remaining = source->size > source->position ? source->size - source->position : 0;
+    if (size > remaining) size = remaining;
+
+    size_t read = size;
+    if (source->file) {
+        read = fread(buffer, 1, size, source->file);
+    }
+    else if (size > 0) {
+        memcpy(buffer, source->memory + source->position, size);
+    }
+    source->position += read;
+    return read;
+}
+
+// Move the read position
+bool MusicSource_Seek(MusicSource* source, size_t position) {
+    if (!source || position > source->size) return false;
+    if (source->file && fseek(source->file, (long)position, SEEK_SET) != 0) return false;
+
+    source->position = position;
+    return true;
+}
+
+// Get the size of the encoded data
+size_t MusicSource_GetSize(const MusicSource* source) {
+    return source ? source->size : 0;
+}
+
+// WAV Decoder (integer and float PCM)
+typedef struct {
+    MusicSource* source;
+    size_t dataOffset;   // Start of the data chunk
+    size_t dataSize;
+    size_t position;     // Bytes of the data chunk already decoded
+    int blockAlign;      // Bytes per frame
+} WavDecoderState;
+
+static uint16_t ReadLE16(const uint8_t* bytes) {
+    return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+static uint32_t ReadLE32(const uint8_t* bytes) {
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static void* WavDecoder_Open(MusicSource* source, MusicFormat* outFormat) {
+    uint8_t riff[12];
+    if (MusicSource_Read(source, riff, sizeof(riff)) != sizeof(riff) ||
+        memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) {
+        return NULL;
+    }
+
+    bool hasFormat = false;
+    uint16_t formatTag = 0, channels = 0, bitsPerSample = 0;
+    uint32_t sampleRate = 0, dataSize = 0;
+    size_t position = sizeof(riff);
+
+    // Walk the chunks until the sample data
+    for (;;) {
+        uint8_t chunk[8];
+        if (MusicSource_Read(source, chunk, sizeof(chunk)) != sizeof(chunk)) return NULL;
+        uint32_t chunkSize = ReadLE32(chunk + 4);
+        position += sizeof(chunk);
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            uint8_t format[40];
+            size_t size = chunkSize < sizeof(format) ? chunkSize : sizeof(format);
+            if (chunkSize < 16 || MusicSource_Read(source, format, size) != size) return NULL;
+
+            formatTag = ReadLE16(format);
+            channels = ReadLE16(format + 2);
+            sampleRate = ReadLE32(format + 4);
+            bitsPerSample = ReadLE16(format + 14);
+            if (formatTag == 0xFFFE && size >= 26) {
+                formatTag = ReadLE16(format + 24); // WAVE_FORMAT_EXTENSIBLE: sub-format GUID starts with the tag
+            }
+            hasFormat = true;
+        }
+        else if (memcmp(chunk, "data", 4) == 0) {
+            dataSize = chunkSize;
+            break;
+        }
+
+        position += chunkSize + (chunkSize & 1); // Chunks are word aligned
+        if (!MusicSource_Seek(source, position)) return NULL;
+    }
+
+    Uint16 format = 0;
+    if (formatTag == 1 && bitsPerSample == 8) format = AUDIO_U8;
+    else if (formatTag == 1 && bitsPerSample == 16) format = AUDIO_S16LSB;
+    else if (formatTag == 1 && bitsPerSample == 32) format = AUDIO_S32LSB;
+    else if (formatTag == 3 && bitsPerSample == 32) format = AUDIO_F32LSB;
+
+    if (!hasFormat || format == 0 || channels == 0 || channels > 8 || sampleRate == 0) {
+        printf("Unsupported WAV format (tag %u, %u bits, %u channels).\n", formatTag, bitsPerSample, channels);
+        return NULL;
+    }
+
+    WavDecoderState* wav = (WavDecoderState*)calloc(1, sizeof(WavDecoderState));
+    if (!wav) return NULL;
+
+    wav->source = source;
+    wav->dataOffset = position;
+    wav->dataSize = MusicSource_GetSize(source) - position; // Clamped to the file for truncated tracks
+    if (dataSize < wav->dataSize) wav->dataSize = dataSize;
+    wav->blockAlign = channels * bitsPerSample / 8;
+    outFormat->frequency = (int)sampleRate;
+    outFormat->format = format;
+    outFormat->channels = channels;
+    return wav;
+}
+
+static size_t WavDecoder_Decode(void* state, void* buffer, size_t size) {
+    WavDecoderState* wav = (WavDecoderState*)state;
+    size_t remaining = wav->dataSize - wav->position;
+
+    if (size > remaining) size = remaining;
+    size -= size % wav->blockAlign;
+
+    size_t read = MusicSource_Read(wav->source, buffer, size);
+    read -= read % wav->blockAlign;
+    wav->position = read > 0 ? wav->position + read : wav->dataSize; // Treat a short read as the end
+    return read;
+}
+
+static bool WavDecoder_Rewind(void* state) {
+    WavDecoderState* wav = (WavDecoderState*)state;
+    wav->position = 0;
+    return MusicSource_Seek(wav->source, wav->dataOffset);
+}
+
+static void WavDecoder_Close(void* state) {
+    free(state);
+}
+
+static const MusicDecoder wavDecoder = {
+    "wav", WavDecoder_Open, WavDecoder_Decode, WavDecoder_Rewind, WavDecoder_Close
+};
+
+// Copy converted PCM into the ring (decode thread, or the main thread while prefilling)
+static void RingWrite(MusicStreamSlot* slot, uint32_t writePosition, const uint8_t* data, uint32_t size) {
+    uint32_t offset = writePosition & (MUSIC_STREAM_RING_BYTES - 1);
+    uint32_t first = MUSIC_STREAM_RING_BYTES - offset;
+    if (first > size) first = size;
+
+    memcpy(slot->ring + offset, data, first);
+    memcpy(slot->ring, data + first, size - first);
+    SDL_AtomicSet(&slot->writePosition, (int)(writePosition + size));
+}
+
+// Decode until the ring is full or the track ends (caller holds slot->mutex)
+static void FillStream(MusicStreamSlot* slot) {
+    for (;;) {
+        if (SDL_AtomicGet(&slot->isEndOfStream)) return;
+
+        uint32_t writePosition = (uint32_t)SDL_AtomicGet(&slot->writePosition);
+        uint32_t used = writePosition - (uint32_t)SDL_AtomicGet(&slot->readPosition);
+        uint32_t space = MUSIC_STREAM_RING_BYTES - used;
+        if (space > MUSIC_STREAM_CHUNK_BYTES) space = MUSIC_STREAM_CHUNK_BYTES;
+        space -= space % mixerFrameBytes;
+        if (space == 0) return;
+
+        // Hand over converted data first, then feed the converter
+        int converted = SDL_AudioStreamGet(slot->converter, slot->staging, (int)space);
+        if (converted > 0) {
+            RingWrite(slot, writePosition, slot->staging, (uint32_t)converted);
+            slot->decodedBytes += (uint64_t)converted;
+            continue;
+        }
+        if (converted < 0) {
+            SDL_AtomicSet(&slot->isEndOfStream, 1);
+            return;
+        }
+
+        size_t decoded = slot->isFlushed ? 0 : slot->decoder->decode(slot->decoderState, slot->staging, MUSIC_STREAM_CHUNK_BYTES);
+        if (decoded > 0) {
+            slot->hasDecodedSinceRewind = true;
+            if (SDL_AudioStreamPut(slot->converter, slot->staging, (int)decoded) != 0) {
+                SDL_AtomicSet(&slot->isEndOfStream, 1);
+                return;
+            }
+        }
+        else if (slot->loop && slot->hasDecodedSinceRewind && slot->decoder->rewind(slot->decoderState)) {
+            slot->hasDecodedSinceRewind = false;
+        }
+        else if (!slot->isFlushed) {
+            SDL_AudioStreamFlush(slot->converter); // Push out the resampler's tail
+            slot->isFlushed = true;
+        }
+        else {
+            SDL_AtomicSet(&slot->isEndOfStream, 1);
+            return;
+        }
+    }
+}
+
+// Background decode loop: keeps every playing ring topped up
+static int SDLCALL MusicDecodeThread(void* data) {
+    (void)data;
+    PROFILE_THREAD("MusicDecode");
+
+    while (!SDL_AtomicGet(&isShuttingDown)) {
+        for (int i = 0; i < MUSIC_STREAM_MAX_STREAMS; ++i) {
+            MusicStreamSlot* slot = &streams[i];
+            if (SDL_AtomicGet(&slot->state) != STREAM_PLAYING) continue;
+
+            SDL_LockMutex(slot->mutex);
+            if (SDL_AtomicGet(&slot->state) == STREAM_PLAYING) { // Re-check: the main thread may have freed it
+                PROFILE_BEGIN("MusicStream_Fill");
+                FillStream(slot);
+                PROFILE_END();
+            }
+            SDL_UnlockMutex(slot->mutex);
+        }
+        SDL_SemWaitTimeout(decodeSignal, MUSIC_STREAM_WAKE_MS);
+    }
+    return 0;
+}
+
+// Mixer hook (audio thread): mixes every playing ring into the output, never blocks
+static void SDLCALL MixStreams(void* userData, Uint8* output, int length) {
+    (void)userData;
+    int master = SDL_AtomicGet(&masterVolume);
+    bool hasConsumed = false;
+
+    for (int i = 0; i < MUSIC_STREAM_MAX_STREAMS; ++i) {
+        MusicStreamSlot* slot = &streams[i];
+        int state = SDL_AtomicGet(&slot->state);
+        if (state == STREAM_STOPPING) {
+            SDL_AtomicCAS(&slot->state, STREAM_STOPPING, STREAM_RELEASED);
+            continue;
+        }
+        if (state != STREAM_PLAYING) continue;
+
+        uint32_t readPosition = (uint32_t)SDL_AtomicGet(&slot->readPosition);
+        uint32_t available = (uint32_t)SDL_AtomicGet(&slot->writePosition) - readPosition;
+        uint32_t size = available < (uint32_t)length ? available : (uint32_t)length;
+        int volume = SDL_AtomicGet(&slot->volume) * master / SDL_MIX_MAXVOLUME;
+
+        if (size > 0 && volume > 0) {
+            uint32_t offset = readPosition & (MUSIC_STREAM_RING_BYTES - 1);
+            uint32_t first = MUSIC_STREAM_RING_BYTES - offset;
+            if (first > size) first = size;
+
+            SDL_MixAudioFormat(output, slot->ring + offset, mixerFormat, first, volume);
+            if (size > first) {
+                SDL_MixAudioFormat(output + first, slot->ring, mixerFormat, size - first, volume);
+            }
+        }
+        SDL_AtomicSet(&slot->readPosition, (int)(readPosition + size));
+        hasConsumed = hasConsumed || size > 0;
+
+        if (size < (uint32_t)length) {
+            if (SDL_AtomicGet(&slot->isEndOfStream)) {
+                SDL_AtomicCAS(&slot->state, STREAM_PLAYING, STREAM_RELEASED); // Finished
+            }
+            else {
+                SDL_AtomicIncRef(&underrunCount);
+            }
+        }
+    }
+
+    if (hasConsumed && SDL_SemValue(decodeSignal) == 0) {
+        SDL_SemPost(decodeSignal);
+    }
+}
+
+// Free a slot's buffers (main thread, slot not visible to the mixer)
+static void FreeStream(MusicStreamSlot* slot) {
+    SDL_LockMutex(slot->mutex);
+    if (slot->decoderState) {
+        slot->decoder->close(slot->decoderState);
+    }
+    if (slot->converter) {
+        SDL_FreeAudioStream(slot->converter);
+    }
+    MusicSource_Close(&slot->source);
+    free(slot->ring);
+    free(slot->staging);
+    retiredDecodedBytes += slot->decodedBytes;
+
+    slot->decoder = NULL;
+    slot->decoderState = NULL;
+    slot->converter = NULL;
+    slot->ring = NULL;
+    slot->staging = NULL;
+    slot->residentBytes = 0;
+    slot->decodedBytes = 0;
+    slot->generation++;
+    SDL_AtomicSet(&slot->state, STREAM_FREE);
+    SDL_UnlockMutex(slot->mutex);
+}
+
+// Remove the mixer hook once nothing is streaming so Mix_PlayMusic works again
+static void UpdateHook() {
+    bool isActive = false;
+    for (int i = 0; i < MUSIC_STREAM_MAX_STREAMS; ++i) {
+        isActive = isActive || SDL_AtomicGet(&streams[i].state) != STREAM_FREE;
+    }
+
+    if (isActive && !isHooked) {
+        Mix_HookMusic(MixStreams, NULL);
+        isHooked = true;
+    }
+    else if (!isActive && isHooked) {
+        Mix_HookMusic(NULL, NULL);
+        isHooked = false;
+    }
+}
+
+// Build the handle for a slot's current generation
+static MusicStreamHandle MakeHandle(int index) {
+    return ((streams[index].generation & 0xFFFFFF) << 8) | (uint32_t)(index + 1);
+}
+
+// Find the slot behind a handle
+static MusicStreamSlot* GetStream(MusicStreamHandle handle) {
+    int index = (int)(handle & 0xFF) - 1;
+    if (!isInitialized || index < 0 || index >= MUSIC_STREAM_MAX_STREAMS) return NULL;
+
+    MusicStreamSlot* slot = &streams[index];
+    if (MakeHandle(index) != handle || SDL_AtomicGet(&slot->state) == STREAM_FREE) return NULL;
+    return slot;
+}
+
+// Open a source and find a decoder for it
+static const MusicDecoder* OpenDecoder(MusicSource* source, const char* filepath, void** outState, MusicFormat* outFormat) {
+    if (!MusicSource_Open(source, filepath)) return NULL;
+
+    for (int i = 0; i < decoderCount; ++i) {
+        MusicSource_Seek(source, 0);
+        *outState = decoders[i]->open(source, outFormat);
+        if (*outState) return decoders[i];
+    }
+    MusicSource_Close(source);
+    return NULL;
+}
+
+// Initialize streaming (after Mix_OpenAudio)
+bool MusicStream_Init() {
+    if (isInitialized) return true;
+
+    if (!Mix_QuerySpec(&mixerFrequency, &mixerFormat, &mixerChannels)) {
+        printf("Music streaming needs an open mixer: %s\n", Mix_GetError());
+        return false;
+    }
+    mixerFrameBytes = (SDL_AUDIO_BITSIZE(mixerFormat) / 8) * mixerChannels;
+
+    memset(streams, 0, sizeof(streams));
+    for (int i = 0; i < MUSIC_STREAM_MAX_STREAMS; ++i) {
+        streams[i].mutex = SDL_CreateMutex();
+        if (!streams[i].mutex) return false;
+    }
+
+    SDL_AtomicSet(&isShuttingDown, 0);
+    SDL_AtomicSet(&masterVolume, SDL_MIX_MAXVOLUME);
+    SDL_AtomicSet(&underrunCount, 0);
+    peakResidentBytes = 0;
+    retiredDecodedBytes = 0;
+    decoderCount = 0;
+    MusicStream_RegisterDecoder(&wavDecoder);
+
+    decodeSignal = SDL_CreateSemaphore(0);
+    decodeThread = decodeSignal ? SDL_CreateThread(MusicDecodeThread, "MusicDecode", NULL) : NULL;
+    if (!decodeThread) {
+        printf("Failed to start the music decode thread: %s\n", SDL_GetError());
+        return false;
+    }
+
+    isInitialized = true;
+    printf("Music streaming initialized (%d Hz, %d channels, %d KB per stream).\n",
+        mixerFrequency, mixerChannels, MUSIC_STREAM_RING_BYTES / 1024);
+    return true;
+}
+
+// Stop every stream and the decode thread
+void MusicStream_Shutdown() {
+    if (!isInitialized) return;
+
+    MusicStream_StopAll();
+    SDL_AtomicSet(&isShuttingDown, 1);
+    SDL_SemPost(decodeSignal);
+    SDL_WaitThread(decodeThread, NULL);
+    SDL_DestroySemaphore(decodeSignal);
+    decodeThread = NULL;
+    decodeSignal = NULL;
+
+    for (int i = 0; i < MUSIC_STREAM_MAX_STREAMS; ++i) {
+        SDL_DestroyMutex(streams[i].mutex);
+        streams[i].mutex = NULL;
+    }
+    isInitialized = false;
+}
+
+// Free streams the mixer has released (finished or stopped)
+void MusicStream_Update() {
+    if (!isInitialized) return;
+
+    for (int i = 0; i < MUSIC_STREAM_MAX_STREAMS; ++i) {
+        if (SDL_AtomicGet(&streams[i].state) == STREAM_RELEASED) {
+            FreeStream(&streams[i]);
+        }
+    }
+    UpdateHook();
+}
+
+// Add a decoder (tried in registration order)
+bool MusicStream_RegisterDecoder(const MusicDecoder* decoder) {
+    if (!decoder || !decoder->open || !decoder->decode || !decoder->rewind || !decoder->close) return false;
+    if (decoderCount >= MUSIC_STREAM_MAX_DECODERS) {
+        printf("Error: Maximum number of music decoders reached.\n");
+        return false;
+    }
+
+    decoders[decoderCount++] = decoder;
+    return true;
+}
+
+// Check whether a registered decoder accepts a file
+bool MusicStream_CanStream(const char* filepath) {
+    if (!isInitialized || !filepath) return false;
+
+    MusicSource source;
+    MusicFormat format;
+    void* state = NULL;
+    const MusicDecoder* decoder = OpenDecoder(&source, filepath, &state, &format);
+    if (!decoder) return false;
+
+    decoder->close(state);
+    MusicSource_Close(&source);
+    return true;
+}
+
+// Start streaming a track (the ring is filled before the mixer sees it)
+MusicStreamHandle MusicStream_Play(const char* filepath, bool loop, float volume) {
+    if (!isInitialized || !filepath) return MUSIC_STREAM_NONE;
+
+    MusicStream_Update(); // Reclaim finished slots first
+    MusicStreamSlot* slot = NULL;
+    int index = 0;
+    for (; index < MUSIC_STREAM_MAX_STREAMS; ++index) {
+        if (SDL_AtomicGet(&streams[index].state) == STREAM_FREE) {
+            slot = &streams[index];
+            break;
+        }
+    }
+    if (!slot) {
+        printf("Error: Maximum number of music streams reached.\n");
+        return MUSIC_STREAM_NONE;
+    }
+
+    MusicFormat format;
+    slot->decoder = OpenDecoder(&slot->source, filepath, &slot->decoderState, &format);
+    if (!slot->decoder) {
+        printf("No streaming decoder for %s\n", filepath);
+        return MUSIC_STREAM_NONE;
+    }
+
+    slot->converter = SDL_NewAudioStream(format.format, (Uint8)format.channels, format.frequency,
+        mixerFormat, (Uint8)mixerChannels, mixerFrequency);
+    slot->ring = (uint8_t*)malloc(MUSIC_STREAM_RING_BYTES);
+    slot->staging = (uint8_t*)malloc(MUSIC_STREAM_CHUNK_BYTES);
+    if (!slot->converter || !slot->ring || !slot->staging) {
+        printf("Failed to create music stream for %s\n", filepath);
+        FreeStream(slot);
+        return MUSIC_STREAM_NONE;
+    }
+
+    slot->loop = loop;
+    slot->isFlushed = false;
+    slot->hasDecodedSinceRewind = false;
+    slot->residentBytes = MUSIC_STREAM_RING_BYTES + MUSIC_STREAM_CHUNK_BYTES +
+        (slot->source.ownedMemory ? slot->source.size : 0);
+    SDL_AtomicSet(&slot->readPosition, 0);
+    SDL_AtomicSet(&slot->writePosition, 0);
+    SDL_AtomicSet(&slot->isEndOfStream, 0);
+    MusicStream_SetVolume(MakeHandle(index), volume);
+
+    // Prefill so the first mixer callback has a full ring
+    SDL_LockMutex(slot->mutex);
+    FillStream(slot);
+    SDL_UnlockMutex(slot->mutex);
+    SDL_AtomicSet(&slot->state, STREAM_PLAYING);
+    UpdateHook();
+
+    MusicStreamStats stats = MusicStream_GetStats();
+    if (stats.residentBytes > peakResidentBytes) {
+        peakResidentBytes = stats.residentBytes;
+    }
+    return MakeHandle(index);
+}
+
+// Stop a stream (freed on the next update once the mixer lets go)
+void MusicStream_Stop(MusicStreamHandle handle) {
+    MusicStreamSlot* slot = GetStream(handle);
+    if (slot) {
+        SDL_AtomicCAS(&slot->state, STREAM_PLAYING, STREAM_STOPPING);
+    }
+}
+
+// Stop every stream immediately
+void MusicStream_StopAll() {
+    if (!isInitialized) return;
+
+    // Once unhooked the mixer no longer reads any ring, so everything can be freed now
+    if (isHooked) {
+        Mix_HookMusic(NULL, NULL);
+        isHooked = false;
+    }
+    for (int i = 0; i < MUSIC_STREAM_MAX_STREAMS; ++i) {
+        if (SDL_AtomicGet(&streams[i].state) != STREAM_FREE) {
+            SDL_AtomicSet(&streams[i].state, STREAM_RELEASED);
+            FreeStream(&streams[i]);
+        }
+    }
+}
+
+// Check if a stream is still audible
+bool MusicStream_IsPlaying(MusicStreamHandle handle) {
+    MusicStreamSlot* slot = GetStream(handle);
+    return slot && SDL_AtomicGet(&slot->state) == STREAM_PLAYING;
+}
+
+// Set the volume of one stream (0..1)
+void MusicStream_SetVolume(MusicStreamHandle handle, float volume) {
+    int index = (int)(handle & 0xFF) - 1;
+    if (!isInitialized || index < 0 || index >= MUSIC_STREAM_MAX_STREAMS) return;
+
+    if (MakeHandle(index) != handle) return; // Not GetStream: also used while a slot is being set up
+
+    if (volume < 0.0f) volume = 0.0f;
+    if (volume > 1.0f) volume = 1.0f;
+    SDL_AtomicSet(&streams[index].volume, (int)(volume * SDL_MIX_MAXVOLUME));
+}
+
+// Set the volume applied on top of every stream (0..1)
+void MusicStream_SetMasterVolume(float volume) {
+    if (volume < 0.0f) volume = 0.0f;
+    if (volume > 1.0f) volume = 1.0f;
+    SDL_AtomicSet(&masterVolume, (int)(volume * SDL_MIX_MAXVOLUME));
+}
+
+// Get streaming statistics (main thread)
+MusicStreamStats MusicStream_GetStats() {
+    MusicStreamStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (!isInitialized) return stats;
+
+    stats.decodedBytes = retiredDecodedBytes;
+    for (int i = 0; i < MUSIC_STREAM_MAX_STREAMS; ++i) {
+        MusicStreamSlot* slot = &streams[i];
+        if (SDL_AtomicGet(&slot->state) == STREAM_FREE) continue;
+
+        SDL_LockMutex(slot->mutex);
+        stats.activeStreams++;
+        stats.residentBytes += slot->residentBytes;
+        stats.decodedBytes += slot->decodedBytes;
+        SDL_UnlockMutex(slot->mutex);
+    }
+    stats.peakResidentBytes = peakResidentBytes > stats.residentBytes ? peakResidentBytes : stats.residentBytes;
+    stats.underruns = (uint32_t)SDL_AtomicGet(&underrunCount);
+    return stats;
+}
@@ -0,0 +1,481 @@
+// pack_archive.c
+#include "pack_archive.h"
+#include "hash_utils.h"
+#include "vfs.h" // Mounted archives are VFS pack mounts
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef ZDK_USE_LZ4
+#include <lz4.h>
+#endif
+#ifdef ZDK_USE_ZSTD
+#include <zstd.h>
+#endif
+
+// Entry waiting to be written by the packer
+typedef struct {
+    char* path;
+    uint32_t pathHash;
+    void* data;            // Stored bytes (compressed or raw)
+    size_t storedSize;
+    size_t size;
+    PackCompression compression;
+} PackBuilderEntry;
+
+// Offline packer state
+struct PackBuilder {
+    PackBuilderEntry* entries;
+    int entryCount;
+    int entryCapacity;
+};
+
+// Normalize a path for hashing: forward slashes, no leading "./"
+static bool NormalizePath(const char* path, char* normalized) {
+    while (path[0] == '.' && (path[1] == '/' || path[1] == '\\')) {
+        path += 2;
+    }
+
+    size_t length = 0;
+    for (; path[length]; ++length) {
+        if (length + 1 >= PACK_MAX_PATH) return false;
+        normalized[length] = path[length] == '\\' ? '/' : path[length];
+    }
+    normalized[length] = '\0';
+    return length > 0;
+}
+
+// Round an offset up to the entry alignment
+static uint64_t AlignOffset(uint64_t offset) {
+    return (offset + (PACK_ALIGNMENT - 1)) & ~(uint64_t)(PACK_ALIGNMENT - 1);
+}
+
+// Open and validate an archive
+PackArchive* PackArchive_Open(const char* filepath) {
+    if (!filepath) return NULL;
+
+    PackArchive* pack = (PackArchive*)calloc(1, sizeof(PackArchive));
+    if (!pack) return NULL;
+
+    if (!File_Map(filepath, &pack->mapping)) {
+        printf("Failed to open pack: %s\n", filepath);
+        free(pack);
+        return NULL;
+    }
+
+    const uint8_t* base = (const uint8_t*)pack->mapping.data;
+    const PackHeader* header = (const PackHeader*)base;
+    size_t size = pack->mapping.size;
+    bool isValid = size >= sizeof(PackHeader) &&
+        header->magic == PACK_MAGIC &&
+        header->version == PACK_VERSION &&
+        header->fileSize <= size &&
+        header->entryOffset % 8 == 0 &&
+        header->entryOffset <= size &&
+        (uint64_t)header->entryCount * sizeof(PackEntry) <= size - header->entryOffset &&
+        header->stringPoolOffset <= size &&
+        header->stringPoolSize <= size - header->stringPoolOffset &&
+        (header->stringPoolSize == 0 || base[header->stringPoolOffset + header->stringPoolSize - 1] == '\0');
+
+    if (isValid) {
+        const PackEntry* entries = (const PackEntry*)(base + header->entryOffset);
+        for (uint32_t i = 0; i < header->entryCount && isValid; ++i) {
+            // dataOffset + storedSize <= fileSize, written so it cannot overflow;
+            // raw entries are used in place, so their stored and logical sizes must agree
+            isValid = entries[i].pathOffset < header->stringPoolSize &&
+                entries[i].dataOffset <= header->fileSize &&
+                entries[i].storedSize <= header->fileSize - entries[i].dataOffset &&
+                (entries[i].compression != PACK_COMPRESSION_NONE || entries[i].size == entries[i].storedSize) &&
+                (i == 0 || entries[i - 1].pathHash <= entries[i].pathHash);
+        }
+    }
+
+    if (!isValid) {
+        printf("Invalid pack: %s\n", filepath);
+        File_Unmap(&pack->mapping);
+        free(pack);
+        return NULL;
+    }
+
+    pack->header = header;
+    pack->entries = (const PackEntry*)(base + header->entryOffset);
+    pack->strings = (const char*)(base + header->stringPoolOffset);
+    pack->filepath = strdup(filepath);
+
+    printf("Pack opened: %s (%u entries)\n", filepath, header->entryCount);
+    return pack;
+}
+
+// Close an archive (data pointers into it become invalid)
+void PackArchive_Close(PackArchive* pack) {
+    if (!pack) return;
+
+    File_Unmap(&pack->mapping);
+    free(pack->filepath);
+    free(pack);
+}
+
+// Find an entry by path (binary search on the hash, then compare paths)
+const PackEntry* PackArchive_Find(const PackArchive* pack, const char* path) {
+    char normalized[PACK_MAX_PATH];
+    if (!pack || !path || !NormalizePath(path, normalized)) return NULL;
+
+    uint32_t hash = Hash_String(normalized);
+    uint32_t low = 0;
+    uint32_t high = pack->header->entryCount;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (pack->entries[mid].pathHash < hash) low = mid + 1;
+        else high = mid;
+    }
+
+    for (uint32_t i = low; i < pack->header->entryCount && pack->entries[i].pathHash == hash; ++i) {
+        if (strcmp(pack->strings + pack->entries[i].pathOffset, normalized) == 0) {
+            return &pack->entries[i];
+        }
+    }
+    return NULL;
+}
+
+// Get the stored path of an entry
+const char* PackArchive_GetPath(const PackArchive* pack, const PackEntry* entry) {
+    if (!pack || !entry) return NULL;
+    return pack->strings + entry->pathOffset;
+}
+
+// Get an uncompressed entry's bytes in place
+const void* PackArchive_GetData(const PackArchive* pack, const PackEntry* entry) {
+    if (!pack || !entry || entry->compression != PACK_COMPRESSION_NONE) return NULL;
+    return (const uint8_t*)pack->mapping.data + entry->dataOffset;
+}
+
+// Read an entry into a buffer of at least entry->size bytes, decompressing if needed
+bool PackArchive_Read(const PackArchive* pack, const PackEntry* entry, void* buffer, size_t size) {
+    if (!pack || !entry || !buffer || size < entry->size) return false;
+
+    const uint8_t* stored = (const uint8_t*)pack->mapping.data + entry->dataOffset;
+    switch (entry->compression) {
+    case PACK_COMPRESSION_NONE:
+        memcpy(buffer, stored, (size_t)entry->size);
+        return true;
+#ifdef ZDK_USE_LZ4
+    case PACK_COMPRESSION_LZ4:
+        return LZ4_decompress_safe((const char*)stored, (char*)buffer, (int)entry->storedSize, (int)entry->size) == (int)entry->size;
+#endif
+#ifdef ZDK_USE_ZSTD
+    case PACK_COMPRESSION_ZSTD:
+        return ZSTD_decompress(buffer, (size_t)entry->size, stored, (size_t)entry->storedSize) == (size_t)entry->size;
+#endif
+    default:
+        printf("Unsupported pack compression %u for '%s'.\n", entry->compression, PackArchive_GetPath(pack, entry));
+        return false;
+    }
+}
+
+// Read an entry into a new heap buffer (caller frees)
+void* PackArchive_ReadAlloc(const PackArchive* pack, const PackEntry* entry, size_t* outSize) {
+    if (!pack || !entry) return NULL;
+
+    void* buffer = malloc(entry->size ? (size_t)entry->size : 1);
+    if (!buffer) return NULL;
+
+    if (!PackArchive_Read(pack, entry, buffer, (size_t)entry->size)) {
+        free(buffer);
+        return NULL;
+    }
+    if (outSize) *outSize = (size_t)entry->size;
+    return buffer;
+}
+
+// Mount an archive at the VFS root (later mounts take priority)
+PackArchive* PackArchive_Mount(const char* filepath) {
+    return Vfs_GetPack(Vfs_MountPack(filepath, "", VFS_PRIORITY_BASE));
+}
+
+// Unmount an archive and close it
+void PackArchive_Unmount(PackArchive* pack) {
+    if (pack) Vfs_Unmount(Vfs_FindPackMount(pack));
+}
+
+// Unmount every archive (directory mounts stay); stops at an archive that is still retained
+void PackArchive_UnmountAll() {
+    for (VfsMountID mount = Vfs_FindPackMount(NULL); mount != VFS_MOUNT_NONE; mount = Vfs_FindPackMount(NULL)) {
+        if (!Vfs_Unmount(mount)) break;
+    }
+}
+
+// Find a path in the mounted archives, through the VFS resolution cache
+const PackEntry* PackArchive_Resolve(const char* path, const PackArchive** outPack) {
+    VfsResolution resolution;
+    if (!Vfs_Resolve(path, &resolution) || !resolution.entry) return NULL;
+    if (outPack) *outPack = resolution.pack;
+    return resolution.entry;
+}
+
+// Create an empty packer
+PackBuilder* PackBuilder_Create() {
+    return (PackBuilder*)calloc(1, sizeof(PackBuilder));
+}
+
+// Free a packer
+void PackBuilder_Destroy(PackBuilder* builder) {
+    if (!builder) return;
+
+    for (int i = 0; i < builder->entryCount; ++i) {
+        free(builder->entries[i].path);
+        free(builder->entries[i].data);
+    }
+    free(builder->entries);
+    free(builder);
+}
+
+// Compress data for storage; returns NULL to store it raw
+static void* CompressData(const void* data, size_t size, PackCompression compression, size_t* outSize) {
+    void* compressed = NULL;
+    size_t compressedSize = 0;
+
+#if !defined(ZDK_USE_LZ4) && !defined(ZDK_USE_ZSTD)
+    (void)data;
+#endif
+
+    switch (compression) {
+    case PACK_COMPRESSION_NONE:
+        return NULL;
+#ifdef ZDK_USE_LZ4
+    case PACK_COMPRESSION_LZ4: {
+        int bound = LZ4_compressBound((int)size);
+        compressed = malloc(bound);
+        if (compressed) {
+            int result = LZ4_compress_default((const char*)data, (char*)compressed, (int)size, bound);
+            compressedSize = result > 0 ? (size_t)result : 0;
+        }
+        break;
+    }
+#endif
+#ifdef ZDK_USE_ZSTD
+    case PACK_COMPRESSION_ZSTD: {
+        size_t bound = ZSTD_compressBound(size);
+        compressed = malloc(bound);
+        if (compressed) {
+            size_t result = ZSTD_compress(compressed, bound, data, size, 19);
+            compressedSize = ZSTD_isError(result) ? 0 : result;
+        }
+        break;
+    }
+#endif
+    default:
+        printf("Pack compression %d not built in, storing raw.\n", (int)compression);
+        return NULL;
+    }
+
+    // Keep compression only when it actually saves space
+    if (compressedSize == 0 || compressedSize >= size) {
+        free(compressed);
+        return NULL;
+    }
+    *outSize = compressedSize;
+    return compressed;
+}
+
+// Add a block of data under an archive path
+bool PackBuilder_AddData(PackBuilder* builder, const char* path, const void* data, size_t size, PackCompression compression) {
+    char normalized[PACK_MAX_PATH];
+    if (!builder || !path || (!data && size > 0) || !NormalizePath(path, normalized)) return false;
+
+    if (builder->entryCount >= builder->entryCapacity) {
+        int capacity = builder->entryCapacity ? builder->entryCapacity * 2 : 64;
+        PackBuilderEntry* entries = (PackBuilderEntry*)realloc(builder->entries, sizeof(PackBuilderEntry) * capacity);
+        if (!entries) return false;
+        builder->entries = entries;
+        builder->entryCapacity = capacity;
+    }
+
+    PackBuilderEntry* entry = &builder->entries[builder->entryCount];
+    memset(entry, 0, sizeof(PackBuilderEntry));
+    entry->path = strdup(normalized);
+    entry->pathHash = Hash_String(normalized);
+    entry->size = size;
+
+    entry->data = CompressData(data, size, compression, &entry->storedSize);
+    if (entry->data) {
+        entry->compression = compression;
+    }
+    else {
+        entry->data = malloc(size ? size : 1);
+        if (entry->data) memcpy(entry->data, data, size);
+        entry->storedSize = size;
+        entry->compression = PACK_COMPRESSION_NONE;
+    }
+
+    if (!entry->path || !entry->data) {
+        free(entry->path);
+        free(entry->data);
+        return false;
+    }
+    builder->entryCount++;
+    return true;
+}
+
+// Add a loose file (a host path) under an archive path
+bool PackBuilder_AddFile(PackBuilder* builder, const char* sourcePath, const char* path, PackCompression compression) {
+    if (!builder || !sourcePath) return false;
+
+    // Read the loose source on disk, never a packed copy of it from a mounted archive
+    FileMapping mapping;
+    if (!File_MapHost(sourcePath, &mapping)) {
+        printf("Failed to read pack input: %s\n", sourcePath);
+        return false;
+    }
+
+    bool isAdded = PackBuilder_AddData(builder, path ? path : sourcePath, mapping.data, mapping.size, compression);
+    File_Unmap(&mapping);
+    return isAdded;
+}
+
+// Order builder entries by path hash, then path
+static int CompareBuilderEntries(const void* a, const void* b) {
+    const PackBuilderEntry* left = (const PackBuilderEntry*)a;
+    const PackBuilderEntry* right = (const PackBuilderEntry*)b;
+    if (left->pathHash != right->pathHash) return left->pathHash < right->pathHash ? -1 : 1;
+    return strcmp(left->path, right->path);
+}
+
+// Write padding up to an offset, then a block of data
+static bool WriteAt(FILE* file, uint64_t* position, uint64_t offset, const void* data, size_t size) {
+    static const uint8_t padding[PACK_ALIGNMENT] = { 0 };
+    while (*position < offset) {
+        size_t count = offset - *position < PACK_ALIGNMENT ? (size_t)(offset - *position) : PACK_ALIGNMENT;
+        if (fwrite(padding, 1, count, file) != count) return false;
+        *position += count;
+    }
+    if (size > 0 && fwrite(data, 1, size, file) != size) return false;
+
+    *position += size;
+    return true;
+}
+
+// Write the archive
+bool PackBuilder_Write(PackBuilder* builder, const char* outputPath) {
+    if (!builder || !outputPath) return false;
+
+    qsort(builder->entries, builder->entryCount, sizeof(PackBuilderEntry), CompareBuilderEntries);
+    for (int i = 1; i < builder->entryCount; ++i) {
+        if (strcmp(builder->entries[i - 1].path, builder->entries[i].path) == 0) {
+            printf("Duplicate pack path: %s\n", builder->entries[i].path);
+            return false;
+        }
+    }
+
+    PackEntry* entries = (PackEntry*)calloc(builder->entryCount ? builder->entryCount : 1, sizeof(PackEntry));
+    if (!entries) return false;
+
+    PackHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = PACK_MAGIC;
+    header.version = PACK_VERSION;
+    header.entryCount = (uint32_t)builder->entryCount;
+    header.entryOffset = (uint32_t)AlignOffset(sizeof(PackHeader));
+    header.stringPoolOffset = header.entryOffset + header.entryCount * (uint32_t)sizeof(PackEntry);
+
+    // Lay out the string pool, then the aligned entry data
+    uint32_t stringOffset = 0;
+    for (int i = 0; i < builder->entryCount; ++i) {
+        entries[i].pathHash = builder->entries[i].pathHash;
+        entries[i].pathOffset = stringOffset;
+        stringOffset += (uint32_t)strlen(builder->entries[i].path) + 1;
+    }
+    header.stringPoolSize = stringOffset;
+
+    uint64_t dataOffset = AlignOffset(header.stringPoolOffset + header.stringPoolSize);
+    for (int i = 0; i < builder->entryCount; ++i) {
+        entries[i].dataOffset = dataOffset;
+        entries[i].storedSize = builder->entries[i].storedSize;
+        entries[i].size = builder->entries[i].size;
+        entries[i].compression = (uint32_t)builder->entries[i].compression;
+        dataOffset = AlignOffset(dataOffset + entries[i].storedSize);
+    }
+    header.fileSize = builder->entryCount
+        ? entries[builder->entryCount - 1].dataOffset + entries[builder->entryCount - 1].storedSize
+        : header.stringPoolOffset + header.stringPoolSize;
+
+    FILE* file = fopen(outputPath, "wb");
+    if (!file) {
+        printf("Failed to create pack: %s\n", outputPath);
+        free(entries);
+        return false;
+    }
+
+    uint64_t position = 0;
+    bool isWritten = WriteAt(file, &position, 0, &header, sizeof(header)) &&
+        WriteAt(file, &position, header.entryOffset, entries, header.entryCount * sizeof(PackEntry));
+    for (int i = 0; i < builder->entryCount && isWritten; ++i) {
+        const char* path = builder->entries[i].path;
+        isWritten = WriteAt(file, &position, position, path, strlen(path) + 1);
+    }
+    for (int i = 0; i < builder->entryCount && isWritten; ++i) {
+        isWritten = WriteAt(file, &position, entries[i].dataOffset, builder->entries[i].data, builder->entries[i].storedSize);
+    }
+
+    free(entries);
+    if (fclose(file) != 0) isWritten = false;
+    if (!isWritten) {
+        printf("Failed to write pack: %s\n", outputPath);
+        remove(outputPath);
+        return false;
+    }
+
+    printf("Pack written: %s (%d entries, %llu bytes)\n", outputPath, builder->entryCount,
+        (unsigned long long)header.fileSize);
+    return true;
+}
+
+// Parse a compression name from a list file
+static PackCompression ParseCompression(const char* name) {
+    if (strcmp(name, "lz4") == 0) return PACK_COMPRESSION_LZ4;
+    if (strcmp(name, "zstd") == 0) return PACK_COMPRESSION_ZSTD;
+    return PACK_COMPRESSION_NONE;
+}
+
+// Build an archive from a list file
+bool PackArchive_BuildFromList(const char* listPath, const char* outputPath) {
+    char* text = File_ReadAllText(listPath);
+    if (!text) {
+        printf("Failed to read pack list: %s\n", listPath);
+        return false;
+    }
+
+    PackBuilder* builder = PackBuilder_Create();
+    bool isValid = builder != NULL;
+    int lineNumber = 0;
+    char* line = text;
+    while (isValid && line && *line) {
+        char* next = strchr(line, '\n');
+        if (next) *next++ = '\0';
+        lineNumber++;
+
+        size_t length = strlen(line);
+        if (length > 0 && line[length - 1] == '\r') line[length - 1] = '\0';
+
+        if (line[0] != '\0' && line[0] != '#') {
+            char* fields[3] = { line, NULL, NULL };
+            for (int field = 1; field < 3; ++field) {
+                char* comma = strchr(fields[field - 1], ',');
+                if (!comma) break;
+                *comma = '\0';
+                fields[field] = comma + 1;
+            }
+
+            PackCompression compression = fields[2] ? ParseCompression(fields[2]) : PACK_COMPRESSION_NONE;
+            const char* path = fields[1] && fields[1][0] ? fields[1] : NULL;
+            if (!PackBuilder_AddFile(builder, fields[0], path, compression)) {
+                printf("Invalid entry in %s at line %d.\n", listPath, lineNumber);
+                isValid = false;
+            }
+        }
+        line = next;
+    }
+
+    isValid = isValid && PackBuilder_Write(builder, outputPath);
+    PackBuilder_Destroy(builder);
+    free(text);
+    return isValid;
+}
@@ -2,7 +2,7 @@
 #include "physics_system.h"
 #include <stdlib.h>
 #include <string.h>
-#include <stdio.h>
+#include "log_system.h" // For per-object trace output
 
 #define MAX_PHYSICS_OBJECTS 1024
 
@@ -13,7 +13,7 @@ static int physicsObjectCount = 0;
 void PhysicsSystem_Init() {
     physicsObjectCount = 0;
     memset(physicsObjects, 0, sizeof(physicsObjects));
-    printf("Physics system initialized.\n");
+    LOG_INFO(LOG_CATEGORY_PHYSICS, "Physics system initialized.");
 }
 
 // Shutdown the physics system
@@ -22,7 +22,7 @@ void PhysicsSystem_Shutdown() {
         PhysicsObject_Destroy(physicsObjects[i]);
     }
     physicsObjectCount = 0;
-    printf("Physics system shut down.\n");
+    LOG_INFO(LOG_CATEGORY_PHYSICS, "Physics system shut down.");
 }
 
 // Update the physics system
@@ -35,7 +35,7 @@ void PhysicsSystem_Update(float deltaTime) {
 // Create a physics object
 PhysicsObject* PhysicsObject_Create(Vector3 position, CollisionShape shape, bool isStatic) {
     if (physicsObjectCount >= MAX_PHYSICS_OBJECTS) {
-        printf("Error: Maximum physics objects reached.\n");
+        LOG_ERROR(LOG_CATEGORY_PHYSICS, "Maximum physics objects reached.");
         return NULL;
     }
 
@@ -49,7 +49,7 @@ PhysicsObject* PhysicsObject_Create(Vector3 position, CollisionShape shape, bool
     object->isStatic = isStatic;
 
     physicsObjects[physicsObjectCount++] = object;
-    printf("Physics object created at position (%.2f, %.2f, %.2f).\n", position.x, position.y, position.z);
+    LOG_DEBUG(LOG_CATEGORY_PHYSICS, "Physics object created at position (%.2f, %.2f, %.2f).", position.x, position.y, position.z);
     return object;
 }
 
@@ -65,7 +65,7 @@ void PhysicsObject_Destroy(PhysicsObject* object) {
         }
     }
     free(object);
-    printf("Physics object destroyed.\n");
+    LOG_DEBUG(LOG_CATEGORY_PHYSICS, "Physics object destroyed.");
 }
 
 // Apply a force to a physics object
@@ -73,7 +73,7 @@ void PhysicsObject_ApplyForce(PhysicsObject* object, Vector3 force) {
     if (!object || object->isStatic) return;
 
     object->acceleration = Vector3_Add(object->acceleration, force);
-    printf("Force applied: (%.2f, %.2f, %.2f).\n", force.x, force.y, force.z);
+    LOG_TRACE(LOG_CATEGORY_PHYSICS, "Force applied: (%.2f, %.2f, %.2f).", force.x, force.y, force.z);
 }
 
 // Update a physics object
@@ -87,7 +87,7 @@ void PhysicsObject_Update(PhysicsObject* object, float deltaTime) {
     // Reset acceleration
     object->acceleration = (Vector3){ 0.0f, 0.0f, 0.0f };
 
-    printf("Physics object updated: Position (%.2f, %.2f, %.2f).\n",
+    LOG_TRACE(LOG_CATEGORY_PHYSICS, "Physics object updated: Position (%.2f, %.2f, %.2f).",
         object->position.x, object->position.y, object->position.z);
 }
 
@@ -112,7 +112,7 @@ bool Physics_CheckCollision(CollisionShape* shape1, CollisionShape* shape2) {
 // Perform a raycast
 bool Physics_Raycast(Vector3 origin, Vector3 direction, float maxDistance, Vector3* hitPoint) {
     // Example: Simplistic raycast placeholder
-    printf("Raycast performed from origin (%.2f, %.2f, %.2f).\n", origin.x, origin.y, origin.z);
+    LOG_TRACE(LOG_CATEGORY_PHYSICS, "Raycast performed from origin (%.2f, %.2f, %.2f).", origin.x, origin.y, origin.z);
     if (hitPoint) {
         *hitPoint = Vector3_Add(origin, Vector3_Scale(direction, maxDistance));
     }
@@ -1,13 +1,13 @@
 // player_movement.c
 #include "player_movement.h"
-#include <stdio.h>
+#include "log_system.h" // For per-frame trace output
 #include <stdbool.h>
 
 // Example collision detection function (stub)
 bool CheckCollision(Vector3 newPosition) {
     // Placeholder logic: Replace with actual collision detection
     if (newPosition.x < 0 || newPosition.y < 0 || newPosition.z < 0) {
-        printf("Collision detected at (%.2f, %.2f, %.2f)\n",
+        LOG_TRACE(LOG_CATEGORY_GAMEPLAY, "Collision detected at (%.2f, %.2f, %.2f)",
             newPosition.x, newPosition.y, newPosition.z);
         return true;
     }
@@ -23,7 +23,7 @@ void Player_Init(Player* player) {
     player->speed = 0.0f;
     player->state = PLAYER_STATE_IDLE;
 
-    printf("Player initialized at position (%.2f, %.2f, %.2f)\n",
+    LOG_INFO(LOG_CATEGORY_GAMEPLAY, "Player initialized at position (%.2f, %.2f, %.2f)",
         player->position.x, player->position.y, player->position.z);
 }
 
@@ -45,7 +45,7 @@ void Player_SetState(Player* player, PlayerState state) {
         break;
     }
 
-    printf("Player state set to %d with speed %.2f\n", state, player->speed);
+    LOG_DEBUG(LOG_CATEGORY_GAMEPLAY, "Player state set to %d with speed %.2f", state, player->speed);
 }
 
 // Move the player in a specified direction
@@ -55,7 +55,7 @@ void Player_Move(Player* player, Vector3 direction) {
     player->direction = direction;
     player->direction = Vector3_Normalize(player->direction); // Ensure direction is normalized
 
-    printf("Player moving in direction (%.2f, %.2f, %.2f)\n",
+    LOG_TRACE(LOG_CATEGORY_GAMEPLAY, "Player moving in direction (%.2f, %.2f, %.2f)",
         player->direction.x, player->direction.y, player->direction.z);
 }
 
@@ -72,10 +72,10 @@ void Player_Update(Player* player) {
     // Check for collisions before updating position
     if (!CheckCollision(newPosition)) {
         player->position = newPosition;
-        printf("Player updated position to (%.2f, %.2f, %.2f)\n",
+        LOG_TRACE(LOG_CATEGORY_GAMEPLAY, "Player updated position to (%.2f, %.2f, %.2f)",
             player->position.x, player->position.y, player->position.z);
     }
     else {
-        printf("Player position not updated due to collision.\n");
+        LOG_TRACE(LOG_CATEGORY_GAMEPLAY, "Player position not updated due to collision.");
     }
 }
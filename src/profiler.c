@@ -0,0 +1,508 @@
+// profiler.c
+#include "profiler.h"
+#include "file_utils.h" // For writing captures
+#include "hash_utils.h" // For merging zones by name
+#include "vfs.h" // For trace paths on writable mounts
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#define PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#define PROFILER_THREAD_LOCAL __thread
+#endif
+
+#define PROFILER_RING_MASK (PROFILER_RING_EVENTS - 1)
+#define PROFILER_TRACKED_DEPTH 64 // Zones per thread whose begin was recorded (bits of recordedZones)
+
+// Binary Capture (little-endian):
+//   u32 magic "ZPRF", u16 version, u16 threadCount, u64 ticksPerSecond, u64 baseTicks, u32 nameCount
+//   nameCount x { u16 length, bytes }
+//   threadCount x { u16 nameLength, bytes, u32 eventCount, eventCount x event }
+//   event: varint (tickDelta << 1 | isEnd), then varint nameIndex for begins.
+//   tickDelta is from the thread's previous event, or from baseTicks for its first.
+#define PROFILER_CAPTURE_MAGIC 0x4652505Au
+#define PROFILER_CAPTURE_VERSION 1
+
+// Zone boundary (name is NULL for an end)
+typedef struct {
+    uint64_t ticks;
+    const char* name;
+} ProfilerEvent;
+
+// Open zone while summarizing
+typedef struct {
+    const char* name;
+    uint64_t start;
+    uint64_t childTicks;
+} ProfilerOpenZone;
+
+// One thread's events. Only the owning thread writes; readers go up to the published head.
+typedef struct {
+    ProfilerEvent* events;
+    SDL_atomic_t head;          // Events written (wraps)
+    uint32_t writeIndex;        // Owner's copy of head
+    char name[32];
+
+    // Frame summary scan (main thread)
+    uint32_t scanned;
+    int depth;
+    ProfilerOpenZone stack[PROFILER_MAX_DEPTH];
+} ProfilerRing;
+
+// Zone totals for the frame being summarized
+typedef struct {
+    const char* name;
+    uint64_t totalTicks;
+    uint64_t selfTicks;
+    uint32_t calls;
+} ProfilerZoneTotals;
+
+// Growable output for binary captures
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} ProfilerBuffer;
+
+static ProfilerRing* rings[PROFILER_MAX_THREADS];
+static SDL_atomic_t ringCount;
+static SDL_SpinLock registerLock;
+static SDL_atomic_t isEnabled = { 1 };
+static int generation = 1; // Bumped by Profiler_Shutdown so threads register again
+
+static PROFILER_THREAD_LOCAL ProfilerRing* threadRing;
+static PROFILER_THREAD_LOCAL int threadGeneration;
+static PROFILER_THREAD_LOCAL int zoneDepth;
+static PROFILER_THREAD_LOCAL uint64_t recordedZones;
+
+static uint64_t lastFrameMark = 0;
+static uint64_t frameIndex = 0;
+static ProfilerZoneTotals zoneTotals[PROFILER_MAX_SUMMARY_ZONES];
+static int zoneTotalCount = 0;
+static HashIndex zoneIndex;
+static ProfilerFrameSummary frameSummary;
+
+// Recording
+
+// Ring of the calling thread, registering it on first use (NULL once every slot is taken)
+static ProfilerRing* GetThreadRing() {
+    if (threadGeneration == generation) return threadRing;
+    threadGeneration = generation;
+    threadRing = NULL;
+
+    SDL_AtomicLock(&registerLock);
+    int index = SDL_AtomicGet(&ringCount);
+    if (index < PROFILER_MAX_THREADS) {
+        ProfilerRing* ring = (ProfilerRing*)calloc(1, sizeof(ProfilerRing));
+        ProfilerEvent* events = (ProfilerEvent*)calloc(PROFILER_RING_EVENTS, sizeof(ProfilerEvent)); // Unwritten slots read as ends
+        if (ring && events) {
+            ring->events = events;
+            snprintf(ring->name, sizeof(ring->name), "Thread %d", index);
+            rings[index] = ring;
+            SDL_AtomicSet(&ringCount, index + 1);
+            threadRing = ring;
+        }
+        else {
+            free(ring);
+            free(events);
+        }
+    }
+    SDL_AtomicUnlock(&registerLock);
+    return threadRing;
+}
+
+// Append an event to the calling thread's ring
+static bool RecordEvent(const char* name) {
+    ProfilerRing* ring = GetThreadRing();
+    if (!ring) return false;
+
+    ProfilerEvent* event = &ring->events[ring->writeIndex & PROFILER_RING_MASK];
+    event->ticks = SDL_GetPerformanceCounter();
+    event->name = name;
+    SDL_AtomicSet(&ring->head, (int)++ring->writeIndex);
+    return true;
+}
+
+// Open a zone on the calling thread
+void Profiler_BeginZone(const char* name) {
+    int depth = zoneDepth++;
+    if (depth >= PROFILER_TRACKED_DEPTH) return;
+
+    // Ends are only recorded for recorded begins, so toggling recording keeps zones balanced
+    uint64_t bit = 1ull << depth;
+    if (name && SDL_AtomicGet(&isEnabled) && RecordEvent(name)) recordedZones |= bit;
+    else recordedZones &= ~bit;
+}
+
+// Close the calling thread's innermost zone
+void Profiler_EndZone() {
+    if (zoneDepth == 0) return;
+    int depth = --zoneDepth;
+    if (depth < PROFILER_TRACKED_DEPTH && (recordedZones & (1ull << depth))) RecordEvent(NULL);
+}
+
+// Name the calling thread in captures
+void Profiler_SetThreadName(const char* name) {
+    ProfilerRing* ring = name ? GetThreadRing() : NULL;
+    if (ring) SDL_strlcpy(ring->name, name, sizeof(ring->name));
+}
+
+// Frame Summary
+
+// Add a finished zone to the frame's totals
+static void AddZoneTotals(const char* name, uint64_t totalTicks, uint64_t selfTicks) {
+    uint32_t hash = Hash_String(name);
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(&zoneIndex, hash, &cursor); i >= 0; i = HashIndex_FindNext(&zoneIndex, hash, &cursor)) {
+        ProfilerZoneTotals* totals = &zoneTotals[i];
+        if (totals->name == name || strcmp(totals->name, name) == 0) {
+            totals->totalTicks += totalTicks;
+            totals->selfTicks += selfTicks;
+            totals->calls++;
+            return;
+        }
+    }
+
+    if (zoneTotalCount >= PROFILER_MAX_SUMMARY_ZONES) return;
+    ProfilerZoneTotals* totals = &zoneTotals[zoneTotalCount];
+    totals->name = name;
+    totals->totalTicks = totalTicks;
+    totals->selfTicks = selfTicks;
+    totals->calls = 1;
+    HashIndex_Insert(&zoneIndex, hash, zoneTotalCount++);
+}
+
+// Walk a ring's events since the last summary, matching begins to ends
+static uint32_t ScanRing(ProfilerRing* ring) {
+    uint32_t dropped = 0;
+    uint32_t head = (uint32_t)SDL_AtomicGet(&ring->head);
+    if (head - ring->scanned > PROFILER_RING_EVENTS) {
+        dropped = head - ring->scanned - PROFILER_RING_EVENTS;
+        ring->scanned = head - PROFILER_RING_EVENTS;
+        ring->depth = 0; // The begins of open zones were overwritten
+    }
+
+    for (; ring->scanned != head; ++ring->scanned) {
+        const ProfilerEvent* event = &ring->events[ring->scanned & PROFILER_RING_MASK];
+        if (event->name) {
+            if (ring->depth < PROFILER_MAX_DEPTH) {
+                ProfilerOpenZone* zone = &ring->stack[ring->depth];
+                zone->name = event->name;
+                zone->start = event->ticks;
+                zone->childTicks = 0;
+            }
+            ring->depth++;
+            continue;
+        }
+
+        if (ring->depth == 0) continue;
+        ring->depth--;
+        if (ring->depth >= PROFILER_MAX_DEPTH) continue;
+
+        const ProfilerOpenZone* zone = &ring->stack[ring->depth];
+        uint64_t duration = event->ticks - zone->start;
+        AddZoneTotals(zone->name, duration, duration > zone->childTicks ? duration - zone->childTicks : 0);
+        if (ring->depth > 0 && ring->depth - 1 < PROFILER_MAX_DEPTH) ring->stack[ring->depth - 1].childTicks += duration;
+    }
+    return dropped;
+}
+
+static int CompareZoneSelfTime(const void* a, const void* b) {
+    const ProfilerZoneTotals* left = (const ProfilerZoneTotals*)a;
+    const ProfilerZoneTotals* right = (const ProfilerZoneTotals*)b;
+    return (left->selfTicks < right->selfTicks) - (left->selfTicks > right->selfTicks);
+}
+
+// Close the frame: total up every zone that ended since the previous mark
+void Profiler_FrameMark() {
+    uint64_t now = SDL_GetPerformanceCounter();
+    if (!zoneIndex.hashes && !HashIndex_Init(&zoneIndex, PROFILER_MAX_SUMMARY_ZONES * 2)) return;
+
+    HashIndex_Clear(&zoneIndex);
+    zoneTotalCount = 0;
+    uint32_t dropped = 0;
+    int count = SDL_AtomicGet(&ringCount);
+    for (int i = 0; i < count; ++i) {
+        dropped += ScanRing(rings[i]);
+    }
+
+    if (lastFrameMark != 0) {
+        double msPerTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+        qsort(zoneTotals, zoneTotalCount, sizeof(ProfilerZoneTotals), CompareZoneSelfTime);
+
+        frameSummary.frameIndex = frameIndex++;
+        frameSummary.frameMs = (double)(now - lastFrameMark) * msPerTick;
+        frameSummary.zoneCount = zoneTotalCount;
+        frameSummary.droppedEvents = dropped;
+        for (int i = 0; i < zoneTotalCount; ++i) {
+            ProfilerZoneSummary* zone = &frameSummary.zones[i];
+            zone->name = zoneTotals[i].name;
+            zone->totalMs = (double)zoneTotals[i].totalTicks * msPerTick;
+            zone->selfMs = (double)zoneTotals[i].selfTicks * msPerTick;
+            zone->calls = zoneTotals[i].calls;
+        }
+    }
+    lastFrameMark = now;
+}
+
+// Control
+
+// Pause or resume recording (open zones still record their end)
+void Profiler_SetEnabled(bool enabled) {
+    SDL_AtomicSet(&isEnabled, enabled ? 1 : 0);
+}
+
+bool Profiler_IsEnabled() {
+    return SDL_AtomicGet(&isEnabled) != 0;
+}
+
+// Free every ring
+void Profiler_Shutdown() {
+    int count = SDL_AtomicGet(&ringCount);
+    for (int i = 0; i < count; ++i) {
+        free(rings[i]->events);
+        free(rings[i]);
+        rings[i] = NULL;
+    }
+    SDL_AtomicSet(&ringCount, 0);
+    generation++;
+    HashIndex_Free(&zoneIndex);
+    memset(&zoneIndex, 0, sizeof(zoneIndex));
+    memset(&frameSummary, 0, sizeof(frameSummary));
+    zoneTotalCount = 0;
+    lastFrameMark = 0;
+    frameIndex = 0;
+}
+
+// Reports
+
+// Get the summary of the last completed frame
+const ProfilerFrameSummary* Profiler_GetFrameSummary() {
+    return &frameSummary;
+}
+
+// Print the zones with the most self time in the last frame
+void Profiler_PrintFrameSummary(int topCount) {
+    const ProfilerFrameSummary* summary = &frameSummary;
+    printf("Frame %llu: %.3f ms, %d zones", (unsigned long long)summary->frameIndex, summary->frameMs, summary->zoneCount);
+    if (summary->droppedEvents > 0) printf(" (%u events dropped)", summary->droppedEvents);
+    printf("\n");
+
+    int count = topCount > 0 && topCount < summary->zoneCount ? topCount : summary->zoneCount;
+    for (int i = 0; i < count; ++i) {
+        const ProfilerZoneSummary* zone = &summary->zones[i];
+        printf("  %-32s self %8.3f ms  total %8.3f ms  %6u calls\n", zone->name, zone->selfMs, zone->totalMs, zone->calls);
+    }
+}
+
+// Oldest event still held by a ring, past unwritten slots and ends whose begins were overwritten
+static uint32_t GetCaptureStart(const ProfilerRing* ring, uint32_t head) {
+    uint32_t start = head - PROFILER_RING_EVENTS;
+    while (start != head && !ring->events[start & PROFILER_RING_MASK].name) start++;
+    return start;
+}
+
+// Earliest timestamp across the captured events
+static uint64_t GetCaptureBaseTicks(const uint32_t* heads, int count) {
+    uint64_t base = UINT64_MAX;
+    for (int i = 0; i < count; ++i) {
+        uint32_t start = GetCaptureStart(rings[i], heads[i]);
+        if (start != heads[i] && rings[i]->events[start & PROFILER_RING_MASK].ticks < base) {
+            base = rings[i]->events[start & PROFILER_RING_MASK].ticks;
+        }
+    }
+    return base == UINT64_MAX ? 0 : base;
+}
+
+// Write a JSON string with the characters that need it escaped
+static void WriteJsonString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (; *text; ++text) {
+        if (*text == '"' || *text == '\\') fputc('\\', file);
+        if ((unsigned char)*text >= 0x20) fputc(*text, file);
+    }
+    fputc('"', file);
+}
+
+// Write the captured zones as Chrome trace events
+bool Profiler_ExportChromeTrace(const char* filepath) {
+    char hostPath[VFS_MAX_PATH];
+    if (!filepath || !Vfs_GetWritePath(filepath, hostPath, sizeof(hostPath))) return false;
+    FILE* file = fopen(hostPath, "w");
+    if (!file) {
+        printf("Failed to open trace file: %s\n", filepath);
+        return false;
+    }
+
+    uint32_t heads[PROFILER_MAX_THREADS] = { 0 };
+    int count = SDL_AtomicGet(&ringCount);
+    for (int i = 0; i < count; ++i) heads[i] = (uint32_t)SDL_AtomicGet(&rings[i]->head);
+    uint64_t base = GetCaptureBaseTicks(heads, count);
+    double usPerTick = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+
+    size_t eventCount = 0;
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (int i = 0; i < count; ++i) {
+        const ProfilerRing* ring = rings[i];
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", i > 0 ? ",\n" : "", i);
+        WriteJsonString(file, ring->name);
+        fprintf(file, "}}");
+
+        for (uint32_t index = GetCaptureStart(ring, heads[i]); index != heads[i]; ++index) {
+            const ProfilerEvent* event = &ring->events[index & PROFILER_RING_MASK];
+            double timestamp = (double)(event->ticks - base) * usPerTick;
+            if (event->name) {
+                fprintf(file, ",\n{\"name\":");
+                WriteJsonString(file, event->name);
+                fprintf(file, ",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", timestamp, i);
+            }
+            else {
+                fprintf(file, ",\n{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", timestamp, i);
+            }
+            eventCount++;
+        }
+    }
+    fprintf(file, "\n]}\n");
+
+    bool written = !ferror(file);
+    if (fclose(file) != 0) written = false;
+    Vfs_Invalidate(filepath);
+
+    if (written) printf("Profiler trace written: %s (%zu events, %d threads)\n", filepath, eventCount, count);
+    else printf("Failed to write trace file: %s\n", filepath);
+    return written;
+}
+
+// Append bytes to a capture buffer
+static void Buffer_Write(ProfilerBuffer* buffer, const void* data, size_t size) {
+    if (buffer->failed) return;
+    if (buffer->size + size > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity * 2 : 64 * 1024;
+        while (capacity < buffer->size + size) capacity *= 2;
+        uint8_t* grown = (uint8_t*)realloc(buffer->data, capacity);
+        if (!grown) {
+            buffer->failed = true;
+            return;
+        }
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+}
+
+static void Buffer_WriteU16(ProfilerBuffer* buffer, uint16_t value) {
+    uint8_t bytes[2] = { (uint8_t)value, (uint8_t)(value >> 8) };
+    Buffer_Write(buffer, bytes, sizeof(bytes));
+}
+
+static void Buffer_WriteU32(ProfilerBuffer* buffer, uint32_t value) {
+    uint8_t bytes[4] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+    Buffer_Write(buffer, bytes, sizeof(bytes));
+}
+
+static void Buffer_WriteU64(ProfilerBuffer* buffer, uint64_t value) {
+    Buffer_WriteU32(buffer, (uint32_t)value);
+    Buffer_WriteU32(buffer, (uint32_t)(value >> 32));
+}
+
+static void Buffer_WriteVarint(ProfilerBuffer* buffer, uint64_t value) {
+    uint8_t bytes[10];
+    size_t length = 0;
+    do {
+        bytes[length] = (uint8_t)(value & 0x7F);
+        value >>= 7;
+        if (value) bytes[length] |= 0x80;
+        length++;
+    } while (value);
+    Buffer_Write(buffer, bytes, length);
+}
+
+static void Buffer_WriteString(ProfilerBuffer* buffer, const char* text) {
+    size_t length = strlen(text);
+    if (length > UINT16_MAX) length = UINT16_MAX;
+    Buffer_WriteU16(buffer, (uint16_t)length);
+    Buffer_Write(buffer, text, length);
+}
+
+// Index of a zone name in the capture's name table, adding it if new
+static int FindCaptureName(HashIndex* index, const char*** names, int* nameCount, int* nameCapacity, const char* name) {
+    uint32_t hash = Hash_String(name);
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(index, hash, &cursor); i >= 0; i = HashIndex_FindNext(index, hash, &cursor)) {
+        if (strcmp((*names)[i], name) == 0) return i;
+    }
+
+    if (*nameCount >= *nameCapacity) {
+        int capacity = *nameCapacity ? *nameCapacity * 2 : 64;
+        const char** grown = (const char**)realloc((void*)*names, sizeof(const char*) * capacity);
+        if (!grown) return -1;
+        *names = grown;
+        *nameCapacity = capacity;
+    }
+    (*names)[*nameCount] = name;
+    if (!HashIndex_Insert(index, hash, *nameCount)) return -1;
+    return (*nameCount)++;
+}
+
+// Write the captured zones in the compact binary format
+bool Profiler_ExportCapture(const char* filepath) {
+    if (!filepath) return false;
+
+    uint32_t heads[PROFILER_MAX_THREADS] = { 0 };
+    int count = SDL_AtomicGet(&ringCount);
+    for (int i = 0; i < count; ++i) heads[i] = (uint32_t)SDL_AtomicGet(&rings[i]->head);
+    uint64_t base = GetCaptureBaseTicks(heads, count);
+
+    // Events go to their own buffer first; the name table is only complete afterwards
+    HashIndex nameIndex;
+    const char** names = NULL;
+    int nameCount = 0;
+    int nameCapacity = 0;
+    ProfilerBuffer events = { 0 };
+    if (!HashIndex_Init(&nameIndex, 256)) return false;
+
+    for (int i = 0; i < count && !events.failed; ++i) {
+        const ProfilerRing* ring = rings[i];
+        uint32_t start = GetCaptureStart(ring, heads[i]);
+        Buffer_WriteString(&events, ring->name);
+        Buffer_WriteU32(&events, heads[i] - start);
+
+        uint64_t previous = base;
+        for (uint32_t index = start; index != heads[i]; ++index) {
+            const ProfilerEvent* event = &ring->events[index & PROFILER_RING_MASK];
+            uint64_t delta = event->ticks > previous ? event->ticks - previous : 0;
+            previous = event->ticks > previous ? event->ticks : previous;
+            Buffer_WriteVarint(&events, (delta << 1) | (event->name ? 0 : 1));
+            if (!event->name) continue;
+
+            int name = FindCaptureName(&nameIndex, &names, &nameCount, &nameCapacity, event->name);
+            if (name < 0) events.failed = true;
+            Buffer_WriteVarint(&events, (uint64_t)name);
+        }
+    }
+
+    ProfilerBuffer capture = { 0 };
+    Buffer_WriteU32(&capture, PROFILER_CAPTURE_MAGIC);
+    Buffer_WriteU16(&capture, PROFILER_CAPTURE_VERSION);
+    Buffer_WriteU16(&capture, (uint16_t)count);
+    Buffer_WriteU64(&capture, SDL_GetPerformanceFrequency());
+    Buffer_WriteU64(&capture, base);
+    Buffer_WriteU32(&capture, (uint32_t)nameCount);
+    for (int i = 0; i < nameCount; ++i) Buffer_WriteString(&capture, names[i]);
+    Buffer_Write(&capture, events.data, events.size);
+
+    bool written = !events.failed && !capture.failed && File_WriteBinary(filepath, capture.data, capture.size);
+    if (written) printf("Profiler capture written: %s (%zu bytes, %d threads, %d zones)\n", filepath, capture.size, count, nameCount);
+    else printf("Failed to write profiler capture: %s\n", filepath);
+
+    free(capture.data);
+    free(events.data);
+    free((void*)names);
+    HashIndex_Free(&nameIndex);
+    return written;
+}
@@ -1,6 +1,7 @@
 // renderer.c
 #include "renderer.h"
 #include "math_utils.h" // Use math utilities for transformations
+#include "time_utils.h" // For GPU wait accounting
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -11,6 +12,25 @@
 #include <GL/gl.h>
 #endif
 
+#ifndef DREAMCAST
+// Packed pixel types are GL 1.2; some platform headers stop at 1.1
+#ifndef GL_BGRA
+#define GL_BGRA 0x80E1
+#endif
+#ifndef GL_UNSIGNED_SHORT_5_6_5
+#define GL_UNSIGNED_SHORT_5_6_5 0x8363
+#endif
+#ifndef GL_UNSIGNED_SHORT_4_4_4_4_REV
+#define GL_UNSIGNED_SHORT_4_4_4_4_REV 0x8365
+#endif
+#ifndef GL_UNSIGNED_SHORT_1_5_5_5_REV
+#define GL_UNSIGNED_SHORT_1_5_5_5_REV 0x8366
+#endif
+#ifndef GL_TEXTURE_MAX_LEVEL
+#define GL_TEXTURE_MAX_LEVEL 0x813D
+#endif
+#endif
+
 // Texture structure for Dreamcast and fallback
 typedef struct {
     uint32_t id;         // Texture ID
@@ -54,7 +74,9 @@ void Renderer_Shutdown() {
 // Scene Management
 void Renderer_BeginScene() {
 #ifdef DREAMCAST
+    Timer_BeginGPUWait();
     pvr_wait_ready();
+    Timer_EndGPUWait();
     pvr_scene_begin();
 #else
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -185,6 +207,66 @@ void Renderer_UnloadTexture(uint32_t textureID) {
     memset(texture, 0, sizeof(Texture));
 }
 
+// Upload a cooked texture as-is (no conversion); returns the GL name or PVR address, 0 on failure
+uintptr_t Renderer_UploadTexture(const CookedTextureHeader* header, const void* data) {
+    if (!header || !data) return 0;
+
+#ifdef DREAMCAST
+    if (header->format == TEXTURE_FORMAT_RGBA8888) {
+        printf("The PVR cannot sample RGBA8888 textures; cook them as a 16-bit format.\n");
+        return 0;
+    }
+
+    // The whole mip chain is one block in the PVR's layout, so it is a single copy into VRAM
+    pvr_ptr_t tex = pvr_mem_malloc(header->dataSize);
+    if (!tex) {
+        printf("Out of texture memory (%u bytes).\n", (unsigned)header->dataSize);
+        return 0;
+    }
+    pvr_txr_load((const uint8_t*)data + header->dataOffset, tex, header->dataSize);
+    return (uintptr_t)tex;
+#else
+    static const GLenum glFormats[TEXTURE_FORMAT_COUNT] = { GL_RGBA, GL_RGB, GL_BGRA, GL_BGRA };
+    static const GLenum glTypes[TEXTURE_FORMAT_COUNT] = {
+        GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT_5_6_5, GL_UNSIGNED_SHORT_1_5_5_5_REV, GL_UNSIGNED_SHORT_4_4_4_4_REV
+    };
+
+    if (header->format >= TEXTURE_FORMAT_COUNT || (header->flags & COOKED_TEXTURE_TWIDDLED)) {
+        printf("Cooked texture is not in a GL upload format.\n");
+        return 0;
+    }
+
+    GLuint texID;
+    glGenTextures(1, &texID);
+    glBindTexture(GL_TEXTURE_2D, texID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Small mips have rows narrower than 4 bytes
+
+    for (uint32_t level = 0; level < header->mipCount; ++level) {
+        int width, height;
+        const void* pixels = CookedTexture_GetMip(header, data, (int)level, &width, &height);
+        glTexImage2D(GL_TEXTURE_2D, (GLint)level, header->format == TEXTURE_FORMAT_RGB565 ? GL_RGB : GL_RGBA,
+            width, height, 0, glFormats[header->format], glTypes[header->format], pixels);
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)header->mipCount - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, header->mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return (uintptr_t)texID;
+#endif
+}
+
+// Release a texture created by Renderer_UploadTexture
+void Renderer_DestroyTexture(uintptr_t texture) {
+    if (texture == 0) return;
+
+#ifdef DREAMCAST
+    pvr_mem_free((pvr_ptr_t)texture);
+#else
+    GLuint texID = (GLuint)texture;
+    glDeleteTextures(1, &texID);
+#endif
+}
+
 // Utility Functions
 void Renderer_SetClearColor(float r, float g, float b, float a) {
     clearColor[0] = r;
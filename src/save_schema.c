@@ -0,0 +1,476 @@
+// save_schema.c
+#include "save_schema.h"
+#include "hash_utils.h" // For schema identifiers and interned strings
+#include "stats_system.h" // For CharacterStats
+#include "items.h" // For Item
+#include "player_movement.h" // For Player
+#include "ai_system.h" // For NPC
+#include <stdio.h>
+#include <string.h>
+
+// Wire Types (low 2 bits of a field key; the tag is in the bits above)
+#define WIRE_FIXED32 0  // 4-byte value
+#define WIRE_BYTES 1    // uint32 length, then that many bytes
+
+// Header of an encoded block; count records of {uint32 length, fields} follow it
+typedef struct {
+    uint32_t schemaHash;  // Hash_String(schema->name)
+    uint16_t version;     // schema->version when written
+    uint16_t reserved;
+    uint32_t count;
+    uint32_t payloadSize;
+} SaveBlockHeader;
+
+static void EncodeRecord(const SaveSchema* schema, const uint8_t* record, SaveWriter* writer);
+static bool DecodeRecord(const SaveSchema* schema, const uint8_t* data, size_t size, uint8_t* record);
+
+// Start encoding into a caller-owned buffer (NULL and 0 to measure)
+void SaveWriter_Init(SaveWriter* writer, void* buffer, size_t capacity) {
+    if (!writer) return;
+    writer->data = (uint8_t*)buffer;
+    writer->capacity = buffer ? capacity : 0;
+    writer->size = 0;
+    writer->overflow = false;
+}
+
+// Append bytes, or just count them once the buffer is full
+static void WriteBytes(SaveWriter* writer, const void* bytes, size_t size) {
+    if (size == 0) return;
+    if (!writer->overflow && size <= writer->capacity - writer->size) {
+        memcpy(writer->data + writer->size, bytes, size);
+    }
+    else {
+        writer->overflow = true;
+    }
+    writer->size += size;
+}
+
+static void WriteU32(SaveWriter* writer, uint32_t value) {
+    WriteBytes(writer, &value, sizeof(value));
+}
+
+// Fill in a length written as a placeholder earlier
+static void PatchU32(SaveWriter* writer, size_t at, uint32_t value) {
+    if (!writer->overflow) memcpy(writer->data + at, &value, sizeof(value));
+}
+
+static uint32_t ReadU32(const uint8_t* data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Size of one element in a packed array payload (0 for types that are not packed)
+static size_t PackedElementSize(SchemaFieldType type) {
+    switch (type) {
+    case SCHEMA_FIELD_INT32:
+    case SCHEMA_FIELD_UINT32:
+    case SCHEMA_FIELD_FLOAT:
+    case SCHEMA_FIELD_BOOL:
+    case SCHEMA_FIELD_ENUM:
+        return 4;
+    case SCHEMA_FIELD_VECTOR3:
+        return sizeof(Vector3);
+    default:
+        return 0;
+    }
+}
+
+// Single 4-byte values are written inline; everything else is length-delimited
+static bool IsFixed32(const SaveSchemaField* field) {
+    return field->count == 1 && field->countOffset < 0 && PackedElementSize((SchemaFieldType)field->type) == 4;
+}
+
+// Elements of an array field in use
+static int LiveCount(const SaveSchemaField* field, const uint8_t* record) {
+    if (field->countOffset < 0) return field->count;
+
+    int count;
+    memcpy(&count, record + field->countOffset, sizeof(count));
+    if (count < 0) return 0;
+    return count > field->count ? field->count : count;
+}
+
+// Encode one field
+static void EncodeField(const SaveSchemaField* field, const uint8_t* record, SaveWriter* writer) {
+    const uint8_t* member = record + field->offset;
+    uint32_t key = ((uint32_t)field->tag << 2);
+
+    if (IsFixed32(field)) {
+        uint32_t value;
+        if (field->type == SCHEMA_FIELD_BOOL) {
+            value = *(const bool*)member ? 1u : 0u;
+        }
+        else {
+            memcpy(&value, member, sizeof(value));
+        }
+        WriteU32(writer, key | WIRE_FIXED32);
+        WriteU32(writer, value);
+        return;
+    }
+
+    if (field->type == SCHEMA_FIELD_STRING) {
+        const char* str = *(const char* const*)member;
+        if (!str) return; // Absent: the decoder keeps its default
+        size_t length = strlen(str) + 1;
+        WriteU32(writer, key | WIRE_BYTES);
+        WriteU32(writer, (uint32_t)length);
+        WriteBytes(writer, str, length);
+        return;
+    }
+
+    int count = LiveCount(field, record);
+    WriteU32(writer, key | WIRE_BYTES);
+
+    if (field->type == SCHEMA_FIELD_RECORD) {
+        size_t lengthAt = writer->size;
+        WriteU32(writer, 0);
+        size_t stride = field->record->structSize;
+        for (int i = 0; i < count; ++i) {
+            EncodeRecord(field->record, member + stride * i, writer);
+        }
+        PatchU32(writer, lengthAt, (uint32_t)(writer->size - lengthAt - sizeof(uint32_t)));
+        return;
+    }
+
+    size_t elementSize = PackedElementSize((SchemaFieldType)field->type);
+    WriteU32(writer, (uint32_t)(elementSize * count));
+    if (field->type == SCHEMA_FIELD_BOOL) {
+        for (int i = 0; i < count; ++i) {
+            WriteU32(writer, ((const bool*)member)[i] ? 1u : 0u);
+        }
+    }
+    else {
+        WriteBytes(writer, member, elementSize * count); // Packed in the struct exactly as on disk
+    }
+}
+
+// Encode one record as {uint32 length, fields}
+static void EncodeRecord(const SaveSchema* schema, const uint8_t* record, SaveWriter* writer) {
+    size_t lengthAt = writer->size;
+    WriteU32(writer, 0);
+    for (int i = 0; i < schema->fieldCount; ++i) {
+        EncodeField(&schema->fields[i], record, writer);
+    }
+    PatchU32(writer, lengthAt, (uint32_t)(writer->size - lengthAt - sizeof(uint32_t)));
+}
+
+// Encode records as one block
+bool SaveSchema_Encode(const SaveSchema* schema, const void* records, int count, size_t stride, SaveWriter* writer) {
+    if (!schema || !writer || count < 0 || (!records && count > 0)) return false;
+    if (stride == 0) stride = schema->structSize;
+
+    SaveBlockHeader header = { 0 };
+    header.schemaHash = Hash_String(schema->name);
+    header.version = schema->version;
+    header.count = (uint32_t)count;
+
+    size_t headerAt = writer->size;
+    WriteBytes(writer, &header, sizeof(header));
+    const uint8_t* bytes = (const uint8_t*)records;
+    for (int i = 0; i < count; ++i) {
+        EncodeRecord(schema, bytes + stride * i, writer);
+    }
+
+    header.payloadSize = (uint32_t)(writer->size - headerAt - sizeof(header));
+    if (!writer->overflow) memcpy(writer->data + headerAt, &header, sizeof(header));
+    return !writer->overflow;
+}
+
+// Measure the encoded size of records
+size_t SaveSchema_Measure(const SaveSchema* schema, const void* records, int count, size_t stride) {
+    SaveWriter writer;
+    SaveWriter_Init(&writer, NULL, 0);
+    SaveSchema_Encode(schema, records, count, stride, &writer);
+    return writer.size;
+}
+
+// Find the field for a tag, trying the one after the last match first (fields usually arrive in order)
+static const SaveSchemaField* FindField(const SaveSchema* schema, uint16_t tag, int* cursor) {
+    if (*cursor < schema->fieldCount && schema->fields[*cursor].tag == tag) {
+        return &schema->fields[(*cursor)++];
+    }
+    for (int i = 0; i < schema->fieldCount; ++i) {
+        if (schema->fields[i].tag == tag) {
+            *cursor = i + 1;
+            return &schema->fields[i];
+        }
+    }
+    return NULL;
+}
+
+// Decode a length-delimited field payload into its member
+static bool DecodeBytesField(const SaveSchemaField* field, const uint8_t* payload, size_t length, uint8_t* record) {
+    uint8_t* member = record + field->offset;
+
+    if (field->type == SCHEMA_FIELD_STRING) {
+        if (length == 0 || payload[length - 1] != '\0') return false;
+        *(const char**)member = StringID_GetString(StringID_Intern((const char*)payload));
+        return true;
+    }
+
+    int count = 0;
+    if (field->type == SCHEMA_FIELD_RECORD) {
+        size_t stride = field->record->structSize;
+        size_t offset = 0;
+        while (offset < length) {
+            if (length - offset < sizeof(uint32_t)) return false;
+            uint32_t recordSize = ReadU32(payload + offset);
+            offset += sizeof(uint32_t);
+            if (recordSize > length - offset) return false;
+
+            // Extra elements from a build with a larger array are dropped
+            if (count < field->count) {
+                if (!DecodeRecord(field->record, payload + offset, recordSize, member + stride * count)) return false;
+                count++;
+            }
+            offset += recordSize;
+        }
+    }
+    else {
+        size_t elementSize = PackedElementSize((SchemaFieldType)field->type);
+        if (elementSize == 0 || length % elementSize != 0) return false;
+        count = (int)(length / elementSize);
+        if (count > field->count) count = field->count;
+
+        if (field->type == SCHEMA_FIELD_BOOL) {
+            for (int i = 0; i < count; ++i) {
+                ((bool*)member)[i] = ReadU32(payload + i * 4) != 0;
+            }
+        }
+        else {
+            memcpy(member, payload, elementSize * count);
+        }
+    }
+
+    if (field->countOffset >= 0) {
+        memcpy(record + field->countOffset, &count, sizeof(count));
+    }
+    return true;
+}
+
+// Decode the fields of one record
+static bool DecodeRecord(const SaveSchema* schema, const uint8_t* data, size_t size, uint8_t* record) {
+    size_t offset = 0;
+    int cursor = 0;
+    while (offset < size) {
+        if (size - offset < sizeof(uint32_t)) return false;
+        uint32_t key = ReadU32(data + offset);
+        offset += sizeof(uint32_t);
+
+        uint32_t wire = key & 3;
+        const SaveSchemaField* field = FindField(schema, (uint16_t)(key >> 2), &cursor);
+
+        if (wire == WIRE_FIXED32) {
+            if (size - offset < 4) return false;
+            if (field && IsFixed32(field)) {
+                if (field->type == SCHEMA_FIELD_BOOL) {
+                    *(bool*)(record + field->offset) = ReadU32(data + offset) != 0;
+                }
+                else {
+                    memcpy(record + field->offset, data + offset, 4);
+                }
+            }
+            offset += 4;
+        }
+        else if (wire == WIRE_BYTES) {
+            if (size - offset < sizeof(uint32_t)) return false;
+            uint32_t length = ReadU32(data + offset);
+            offset += sizeof(uint32_t);
+            if (length > size - offset) return false;
+
+            // A field whose wire type changed is skipped like an unknown one
+            if (field && !IsFixed32(field) && !DecodeBytesField(field, data + offset, length, record)) return false;
+            offset += length;
+        }
+        else {
+            return false; // Wire types are never added, so this is corruption
+        }
+    }
+    return true;
+}
+
+// Validate a block header and return it
+static bool ReadBlockHeader(const SaveSchema* schema, const void* data, size_t size, SaveBlockHeader* header) {
+    if (!schema || !data || size < sizeof(SaveBlockHeader)) return false;
+    memcpy(header, data, sizeof(SaveBlockHeader));
+    return header->schemaHash == Hash_String(schema->name) && header->payloadSize <= size - sizeof(SaveBlockHeader);
+}
+
+// Count the records in an encoded block
+int SaveSchema_GetRecordCount(const SaveSchema* schema, const void* data, size_t size) {
+    SaveBlockHeader header;
+    if (!ReadBlockHeader(schema, data, size, &header) || header.count > INT32_MAX) return -1;
+    return (int)header.count;
+}
+
+// Decode up to maxCount records from an encoded block
+int SaveSchema_Decode(const SaveSchema* schema, const void* data, size_t size,
+    void* records, int maxCount, size_t stride, size_t* outConsumed) {
+    if (outConsumed) *outConsumed = 0;
+
+    SaveBlockHeader header;
+    if (!ReadBlockHeader(schema, data, size, &header) || (!records && maxCount > 0)) {
+        printf("Save block is not a valid %s block.\n", schema ? schema->name : "(null)");
+        return -1;
+    }
+    if (stride == 0) stride = schema->structSize;
+
+    const uint8_t* payload = (const uint8_t*)data + sizeof(header);
+    uint8_t* out = (uint8_t*)records;
+    size_t offset = 0;
+    int decoded = 0;
+    for (uint32_t i = 0; i < header.count; ++i) {
+        if (header.payloadSize - offset < sizeof(uint32_t)) return -1;
+        uint32_t recordSize = ReadU32(payload + offset);
+        offset += sizeof(uint32_t);
+        if (recordSize > header.payloadSize - offset) return -1;
+
+        if (decoded < maxCount) {
+            uint8_t* record = out + stride * decoded;
+            if (!DecodeRecord(schema, payload + offset, recordSize, record)) {
+                printf("Malformed %s record %u in save block.\n", schema->name, i);
+                return -1;
+            }
+            if (schema->postLoad) schema->postLoad(record, header.version);
+            decoded++;
+        }
+        offset += recordSize;
+    }
+
+    if (outConsumed) *outConsumed = sizeof(header) + header.payloadSize;
+    return decoded;
+}
+
+// Encode records straight into a snapshot section
+bool SaveSchema_Capture(SaveSnapshot* snapshot, const char* section, const SaveSchema* schema,
+    const void* records, int count, size_t stride) {
+    size_t size = SaveSchema_Measure(schema, records, count, stride);
+    void* out = SaveSnapshot_Reserve(snapshot, section, size);
+    if (!out) return false;
+
+    SaveWriter writer;
+    SaveWriter_Init(&writer, out, size);
+    return SaveSchema_Encode(schema, records, count, stride, &writer);
+}
+
+// Built-in Schemas
+
+// Modifiers are restored as saved; the stat cache is rebuilt on first access
+static void CharacterStatsPostLoad(void* record, uint16_t savedVersion) {
+    (void)savedVersion;
+    CharacterStats* stats = (CharacterStats*)record;
+    stats->isDirty = true;
+
+    // Saves without adjustment IDs leave whatever the record held; keep only IDs that still match
+    for (int stat = 0; stat < STAT_COUNT; ++stat) {
+        bool isValid = false;
+        for (int i = 0; i < stats->modifierCount && stats->adjustmentIDs[stat] != 0; ++i) {
+            const StatModifier* modifier = &stats->modifiers[i];
+            isValid |= modifier->id == stats->adjustmentIDs[stat] && (int)modifier->stat == stat &&
+                modifier->type == STAT_MODIFIER_FLAT && modifier->duration <= 0.0f;
+        }
+        if (!isValid) stats->adjustmentIDs[stat] = 0;
+    }
+}
+
+// Loaded items point at interned strings, so Item_Destroy must leave them alone
+static void ItemPostLoad(void* record, uint16_t savedVersion) {
+    (void)savedVersion;
+    Item* item = (Item*)record;
+    if (item->name) {
+        item->nameID = StringID_Intern(item->name);
+        item->nameHash = StringID_GetHash(item->nameID);
+    }
+    item->isDatabaseRecord = true;
+}
+
+static const SaveSchemaField statModifierFields[] = {
+    { 1, SCHEMA_FIELD_ENUM, 1, offsetof(StatModifier, stat), -1, NULL },
+    { 2, SCHEMA_FIELD_ENUM, 1, offsetof(StatModifier, type), -1, NULL },
+    { 3, SCHEMA_FIELD_INT32, 1, offsetof(StatModifier, value), -1, NULL },
+    { 4, SCHEMA_FIELD_FLOAT, 1, offsetof(StatModifier, duration), -1, NULL },
+    { 5, SCHEMA_FIELD_UINT32, 1, offsetof(StatModifier, id), -1, NULL }
+};
+
+static const SaveSchema statModifierSchema = {
+    "StatModifier", 1, sizeof(StatModifier),
+    statModifierFields, sizeof(statModifierFields) / sizeof(statModifierFields[0]), NULL
+};
+
+static const SaveSchemaField characterStatsFields[] = {
+    { 1, SCHEMA_FIELD_INT32, 1, offsetof(CharacterStats, level), -1, NULL },
+    { 2, SCHEMA_FIELD_INT32, STAT_COUNT, offsetof(CharacterStats, baseStats.values), -1, NULL },
+    { 3, SCHEMA_FIELD_RECORD, MAX_STAT_MODIFIERS, offsetof(CharacterStats, modifiers),
+        offsetof(CharacterStats, modifierCount), &statModifierSchema },
+    { 4, SCHEMA_FIELD_UINT32, 1, offsetof(CharacterStats, nextModifierID), -1, NULL },
+    { 5, SCHEMA_FIELD_UINT32, STAT_COUNT, offsetof(CharacterStats, adjustmentIDs), -1, NULL }
+};
+
+static const SaveSchema characterStatsSchema = {
+    "CharacterStats", 1, sizeof(CharacterStats),
+    characterStatsFields, sizeof(characterStatsFields) / sizeof(characterStatsFields[0]), CharacterStatsPostLoad
+};
+
+static const SaveSchemaField itemFields[] = {
+    { 1, SCHEMA_FIELD_STRING, 1, offsetof(Item, name), -1, NULL },
+    { 2, SCHEMA_FIELD_ENUM, 1, offsetof(Item, type), -1, NULL },
+    { 3, SCHEMA_FIELD_ENUM, 1, offsetof(Item, rarity), -1, NULL },
+    { 4, SCHEMA_FIELD_INT32, 1, offsetof(Item, value), -1, NULL },
+    { 5, SCHEMA_FIELD_STRING, 1, offsetof(Item, description), -1, NULL },
+    { 6, SCHEMA_FIELD_INT32, 1, offsetof(Item, effectPower), -1, NULL },
+    { 7, SCHEMA_FIELD_INT32, 1, offsetof(Item, durability), -1, NULL }
+};
+
+static const SaveSchema itemSchema = {
+    "Item", 1, sizeof(Item),
+    itemFields, sizeof(itemFields) / sizeof(itemFields[0]), ItemPostLoad
+};
+
+static const SaveSchemaField playerFields[] = {
+    { 1, SCHEMA_FIELD_VECTOR3, 1, offsetof(Player, position), -1, NULL },
+    { 2, SCHEMA_FIELD_VECTOR3, 1, offsetof(Player, direction), -1, NULL },
+    { 3, SCHEMA_FIELD_FLOAT, 1, offsetof(Player, speed), -1, NULL },
+    { 4, SCHEMA_FIELD_ENUM, 1, offsetof(Player, state), -1, NULL }
+};
+
+static const SaveSchema playerSchema = {
+    "Player", 1, sizeof(Player),
+    playerFields, sizeof(playerFields) / sizeof(playerFields[0]), NULL
+};
+
+// NPC behaviour callbacks are code, not state; they are re-attached by the game after loading
+static const SaveSchemaField npcFields[] = {
+    { 1, SCHEMA_FIELD_STRING, 1, offsetof(NPC, name), -1, NULL },
+    { 2, SCHEMA_FIELD_VECTOR3, 1, offsetof(NPC, position), -1, NULL },
+    { 3, SCHEMA_FIELD_VECTOR3, 1, offsetof(NPC, targetPosition), -1, NULL },
+    { 4, SCHEMA_FIELD_ENUM, 1, offsetof(NPC, behavior), -1, NULL },
+    { 5, SCHEMA_FIELD_FLOAT, 1, offsetof(NPC, speed), -1, NULL },
+    { 6, SCHEMA_FIELD_STRING, 1, offsetof(NPC, shopInventory), -1, NULL },
+    { 7, SCHEMA_FIELD_STRING, 1, offsetof(NPC, dialogue), -1, NULL }
+};
+
+static const SaveSchema npcSchema = {
+    "NPC", 1, sizeof(NPC),
+    npcFields, sizeof(npcFields) / sizeof(npcFields[0]), NULL
+};
+
+// Get the CharacterStats schema
+const SaveSchema* SaveSchema_GetCharacterStats() {
+    return &characterStatsSchema;
+}
+
+// Get the Item schema
+const SaveSchema* SaveSchema_GetItem() {
+    return &itemSchema;
+}
+
+// Get the Player schema
+const SaveSchema* SaveSchema_GetPlayer() {
+    return &playerSchema;
+}
+
+// Get the NPC schema
+const SaveSchema* SaveSchema_GetNPC() {
+    return &npcSchema;
+}
@@ -1,20 +1,145 @@
 // save_system.c
 #include "save_system.h"
+#include "async_io.h" // For queueing save writes behind streaming reads
+#include "file_utils.h" // For atomic writes, deletes and mapping saves back in
+#include "hash_utils.h" // For snapshot and journal checksums
+#include "job_system.h" // For the save thread
+#include "vfs.h" // For save paths on writable mounts
+#include "vmu_storage.h" // For VMU saves and the emulated card
+#include <SDL2/SDL.h> // For timing commits
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#ifdef _WIN32
-#include <windows.h> // For PC-specific file operations
-#else
-#include <dc/vmu.h>  // For Dreamcast VMU operations
+#if defined(_WIN32)
+#include <windows.h> // For free disk space
+#elif !defined(DREAMCAST)
+#include <sys/statvfs.h> // For free disk space
 #endif
 
+#define SAVE_SNAPSHOT_MAGIC 0x5641535A // "ZSAV"
+#define SAVE_DELTA_MAGIC 0x544C445A    // "ZDLT"
+#define SAVE_SNAPSHOT_VERSION 1
+#define SAVE_SECTIONS_MAGIC 0x4345535A // "ZSEC"
+#define SAVE_SECTIONS_VERSION 1
+#define SAVE_SECTION_ALIGNMENT 8
+#define SAVE_ARENA_INITIAL_CAPACITY (64 * 1024)
+
+// Header of a full snapshot file; the state follows it
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sequence;  // Commit that produced the snapshot
+    uint32_t size;      // Bytes of state
+    uint32_t crc;       // CRC-32 of the state
+    uint32_t reserved;
+} SaveSnapshotHeader;
+
+// Header of a journal record; runCount runs of {SaveDeltaRun, bytes} follow it
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;     // Commit the record produces (must follow the previous one)
+    uint32_t size;         // Snapshot size the record applies to
+    uint32_t runCount;
+    uint32_t payloadSize;
+    uint32_t crc;          // CRC-32 of this header (with crc = 0) and the payload
+} SaveDeltaHeader;
+
+// Changed byte range inside a delta record
+typedef struct {
+    uint32_t offset;
+    uint32_t length;
+} SaveDeltaRun;
+
+struct SaveJournal {
+    char* fileName;
+    char* journalFileName;
+    FILE* journalFile;        // Opened for appending on the first delta after a checkpoint
+    uint8_t* image;           // Snapshot header followed by the current state, written as-is on checkpoints
+    size_t size;              // Bytes of state
+    uint8_t* record;          // Delta record being built (sized for the worst case)
+    size_t recordCapacity;
+    bool hasSnapshot;
+    bool needsCheckpoint;     // Last write failed, or the journal has a torn or stale tail
+    int checkpointInterval;
+    SaveJournalStats stats;
+};
+
+// Header of captured save data; named sections follow, each padded to SAVE_SECTION_ALIGNMENT
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sectionCount;
+    uint32_t size;        // Total bytes, including this header
+} SaveSectionsHeader;
+
+typedef struct {
+    uint32_t nameHash;    // Hash_String of the section name
+    uint32_t size;        // Bytes of data, excluding padding
+} SaveSectionHeader;
+
+// Snapshot Lifecycle
+enum {
+    SNAPSHOT_FREE,
+    SNAPSHOT_CAPTURING,   // Owned by the main thread between Begin and Submit
+    SNAPSHOT_QUEUED,      // Owned by the save thread
+    SNAPSHOT_DONE         // Waiting for SaveSystem_Update to report it
+};
+
+struct SaveSnapshot {
+    SDL_atomic_t state;
+    char fileName[256];
+    uint8_t* arena;       // Captured sections; grow-only and kept between saves
+    size_t used;
+    size_t capacity;
+    uint32_t sectionCount;
+    bool captureFailed;
+    uint32_t order;       // Submission order, so completions are reported in sequence
+    Uint64 captureStart;
+    SaveJournal* journal;
+    SaveTransformFunction transform;
+    void* transformData;
+    SaveCompleteCallback callback;
+    void* userData;
+
+    // Written by the save thread before the state becomes SNAPSHOT_DONE
+    bool success;
+    size_t bytesWritten;
+    float backgroundMilliseconds;
+};
+
 static SavePlatform currentPlatform;
+static VmuDevice* vmuDevice = NULL; // Memory card when saving to the VMU
+static JobPool* savePool = NULL; // Single thread, so saves land in submission order
+static SaveSnapshot snapshots[SAVE_SNAPSHOT_POOL_SIZE];
+static uint32_t nextSaveOrder = 0;
+static SaveStats saveStats;
 
 // Initialize the save system
 bool SaveSystem_Init(SavePlatform platform) {
+#ifdef DREAMCAST
+    platform = SAVE_PLATFORM_DREAMCAST_VMU; // The only writable storage
+#endif
     currentPlatform = platform;
+    memset(&saveStats, 0, sizeof(saveStats));
+
+    if (platform == SAVE_PLATFORM_DREAMCAST_VMU) {
+#ifdef DREAMCAST
+        vmuDevice = VmuDevice_OpenPort(0, 1);
+#else
+        vmuDevice = VmuDevice_OpenImage(SAVE_VMU_IMAGE_PATH);
+#endif
+        if (!vmuDevice) {
+            printf("No VMU available for saving.\n");
+            return false;
+        }
+    }
+
+    savePool = JobPool_Create("SaveIO", 1);
+    if (!savePool) {
+        printf("Failed to start the save thread; saves will be written synchronously.\n");
+    }
+
     printf("Save system initialized for platform: %s\n",
         platform == SAVE_PLATFORM_PC ? "PC" : "Dreamcast VMU");
     return true;
@@ -22,26 +147,102 @@ bool SaveSystem_Init(SavePlatform platform) {
 
 // Shutdown the save system
 void SaveSystem_Shutdown() {
+    SaveSystem_Flush();
+    if (savePool) {
+        JobPool_Destroy(savePool);
+        savePool = NULL;
+    }
+
+    for (int i = 0; i < SAVE_SNAPSHOT_POOL_SIZE; ++i) {
+        free(snapshots[i].arena);
+    }
+    memset(snapshots, 0, sizeof(snapshots));
+
+    VmuDevice_Close(vmuDevice);
+    vmuDevice = NULL;
     printf("Save system shut down.\n");
 }
 
+// VMU file name for a save path: its last component, at most VMU_MAX_FILE_NAME characters
+static bool GetVmuFileName(const char* fileName, char* name) {
+    const char* slash = strrchr(fileName, '/');
+    const char* base = slash ? slash + 1 : fileName;
+    if (*base == '\0' || strlen(base) > VMU_MAX_FILE_NAME) {
+        printf("Save name does not fit a VMU file name (%d characters): %s\n", VMU_MAX_FILE_NAME, fileName);
+        return false;
+    }
+    strcpy(name, base);
+    return true;
+}
+
+// Write a whole save: atomically on PC, as a compressed block container on the VMU
+static bool WriteSave(const char* fileName, const void* data, size_t size) {
+    if (!vmuDevice) {
+        // Through the shared I/O queue at background priority, so saves never delay streaming
+        AsyncIORequest request = AsyncIO_Write(fileName, 0, data, size, ASYNC_IO_WRITE_ATOMIC,
+            ASYNC_IO_PRIORITY_BACKGROUND, NULL, NULL);
+        if (request != ASYNC_IO_REQUEST_NONE) return AsyncIO_Wait(request, NULL, NULL) == ASYNC_IO_COMPLETE;
+        return File_WriteAtomic(fileName, data, size);
+    }
+
+    char name[VMU_MAX_FILE_NAME + 1];
+    if (!GetVmuFileName(fileName, name)) return false;
+
+    size_t bound = VmuContainer_GetBound(size);
+    void* container = malloc(bound);
+    if (!container) return false;
+
+    size_t packed = VmuContainer_Pack(data, size, container, bound);
+    bool written = packed > 0 && VmuDevice_WriteFile(vmuDevice, name, container, packed);
+    free(container);
+    return written;
+}
+
+// Read a whole save (free with free())
+static void* ReadSave(const char* fileName, size_t* outSize) {
+    *outSize = 0;
+    if (vmuDevice) {
+        char name[VMU_MAX_FILE_NAME + 1];
+        if (!GetVmuFileName(fileName, name)) return NULL;
+
+        size_t containerSize = 0;
+        void* container = VmuDevice_ReadFile(vmuDevice, name, &containerSize);
+        if (!container) return NULL;
+        void* data = VmuContainer_Unpack(container, containerSize, outSize);
+        free(container);
+        return data;
+    }
+
+    VfsResolution resolution;
+    if (!Vfs_Resolve(fileName, &resolution)) return NULL;
+    FILE* file = fopen(resolution.hostPath, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    rewind(file);
+
+    void* data = fileSize > 0 ? malloc((size_t)fileSize) : NULL;
+    if (!data || fread(data, 1, (size_t)fileSize, file) != (size_t)fileSize) {
+        fclose(file);
+        free(data);
+        return NULL;
+    }
+    fclose(file);
+
+    *outSize = (size_t)fileSize;
+    return data;
+}
+
 // Create a save file
 bool SaveFile_Create(const char* fileName, void* data, size_t size) {
     if (!fileName || !data || size == 0) return false;
 
-#ifdef _WIN32
-    FILE* file = fopen(fileName, "wb");
-    if (!file) {
+    if (!WriteSave(fileName, data, size)) {
         printf("Failed to create save file: %s\n", fileName);
         return false;
     }
-    fwrite(data, 1, size, file);
-    fclose(file);
     printf("Save file created: %s\n", fileName);
-#else
-    // Dreamcast VMU save (example stub)
-    printf("VMU save functionality is not implemented yet.\n");
-#endif
     return true;
 }
 
@@ -49,116 +250,676 @@ bool SaveFile_Create(const char* fileName, void* data, size_t size) {
 SaveFile* SaveFile_Load(const char* fileName) {
     if (!fileName) return NULL;
 
-#ifdef _WIN32
-    FILE* file = fopen(fileName, "rb");
-    if (!file) {
+    size_t size = 0;
+    void* data = ReadSave(fileName, &size);
+    if (!data) {
         printf("Failed to load save file: %s\n", fileName);
         return NULL;
     }
 
-    fseek(file, 0, SEEK_END);
-    size_t fileSize = ftell(file);
-    rewind(file);
-
-    void* data = malloc(fileSize);
-    if (!data) {
-        fclose(file);
-        printf("Failed to allocate memory for save file: %s\n", fileName);
+    SaveFile* saveFile = (SaveFile*)malloc(sizeof(SaveFile));
+    if (!saveFile) {
+        free(data);
         return NULL;
     }
-
-    fread(data, 1, fileSize, file);
-    fclose(file);
-
-    SaveFile* saveFile = (SaveFile*)malloc(sizeof(SaveFile));
     saveFile->fileName = strdup(fileName);
     saveFile->data = data;
-    saveFile->size = fileSize;
+    saveFile->size = size;
 
     printf("Save file loaded: %s\n", fileName);
     return saveFile;
-#else
-    // Dreamcast VMU load (example stub)
-    printf("VMU load functionality is not implemented yet.\n");
-    return NULL;
-#endif
 }
 
 // Delete a save file
 bool SaveFile_Delete(const char* fileName) {
     if (!fileName) return false;
 
-#ifdef _WIN32
-    if (remove(fileName) == 0) {
+    bool deleted;
+    if (vmuDevice) {
+        char name[VMU_MAX_FILE_NAME + 1];
+        deleted = GetVmuFileName(fileName, name) && VmuDevice_DeleteFile(vmuDevice, name);
+    }
+    else {
+        deleted = File_Delete(fileName);
+    }
+
+    if (deleted) {
         printf("Save file deleted: %s\n", fileName);
-        return true;
     }
     else {
         printf("Failed to delete save file: %s\n", fileName);
-        return false;
     }
-#else
-    // Dreamcast VMU delete (example stub)
-    printf("VMU delete functionality is not implemented yet.\n");
-    return false;
-#endif
+    return deleted;
 }
 
 // Copy a save file
 bool SaveFile_Copy(const char* sourceFileName, const char* destFileName) {
     if (!sourceFileName || !destFileName) return false;
 
-#ifdef _WIN32
-    FILE* source = fopen(sourceFileName, "rb");
-    if (!source) {
-        printf("Failed to open source file: %s\n", sourceFileName);
-        return false;
+    bool copied;
+    if (vmuDevice) {
+        // The packed container is copied as-is, without unpacking it
+        char sourceName[VMU_MAX_FILE_NAME + 1];
+        char destName[VMU_MAX_FILE_NAME + 1];
+        if (!GetVmuFileName(sourceFileName, sourceName) || !GetVmuFileName(destFileName, destName)) return false;
+
+        size_t size = 0;
+        void* container = VmuDevice_ReadFile(vmuDevice, sourceName, &size);
+        if (!container) {
+            printf("Failed to open source file: %s\n", sourceFileName);
+            return false;
+        }
+        copied = VmuDevice_WriteFile(vmuDevice, destName, container, size);
+        free(container);
+    }
+    else {
+        FileMapping source;
+        if (!File_Map(sourceFileName, &source)) {
+            printf("Failed to open source file: %s\n", sourceFileName);
+            return false;
+        }
+        copied = File_WriteAtomic(destFileName, source.data, source.size);
+        File_Unmap(&source);
     }
 
-    FILE* dest = fopen(destFileName, "wb");
-    if (!dest) {
-        fclose(source);
+    if (!copied) {
         printf("Failed to create destination file: %s\n", destFileName);
         return false;
     }
+    printf("Save file copied from %s to %s\n", sourceFileName, destFileName);
+    return true;
+}
+
+// Milliseconds elapsed since a performance counter reading
+static float ElapsedMilliseconds(Uint64 start) {
+    return (float)((double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+}
 
-    char buffer[1024];
-    size_t bytesRead;
-    while ((bytesRead = fread(buffer, 1, sizeof(buffer), source)) > 0) {
-        fwrite(buffer, 1, bytesRead, dest);
+// Current state inside the snapshot image
+static uint8_t* SnapshotData(const SaveJournal* journal) {
+    return journal->image + sizeof(SaveSnapshotHeader);
+}
+
+// Size the snapshot image and the worst-case delta record for a state size
+static bool ReserveSnapshot(SaveJournal* journal, size_t size) {
+    if (journal->image && journal->size == size) return true;
+
+    // Worst case: every other block changed, so each changed block is its own run
+    size_t blocks = (size + SAVE_JOURNAL_BLOCK_SIZE - 1) / SAVE_JOURNAL_BLOCK_SIZE;
+    size_t recordCapacity = sizeof(SaveDeltaHeader) + size + ((blocks + 1) / 2) * sizeof(SaveDeltaRun);
+
+    uint8_t* image = (uint8_t*)realloc(journal->image, sizeof(SaveSnapshotHeader) + size);
+    if (!image) return false;
+    journal->image = image;
+
+    uint8_t* record = (uint8_t*)realloc(journal->record, recordCapacity);
+    if (!record) return false;
+    journal->record = record;
+    journal->recordCapacity = recordCapacity;
+
+    journal->size = size;
+    return true;
+}
+
+// Read the last checkpoint, if it is intact
+static bool LoadCheckpoint(SaveJournal* journal) {
+    size_t size = 0;
+    uint8_t* data = (uint8_t*)ReadSave(journal->fileName, &size);
+    if (!data) return false;
+
+    SaveSnapshotHeader header;
+    bool valid = size >= sizeof(header);
+    if (valid) {
+        memcpy(&header, data, sizeof(header));
+        const uint8_t* state = data + sizeof(header);
+        valid = header.magic == SAVE_SNAPSHOT_MAGIC && header.version == SAVE_SNAPSHOT_VERSION
+            && header.size > 0 && (size_t)header.size == size - sizeof(header)
+            && Hash_CRC32(0, state, header.size) == header.crc
+            && ReserveSnapshot(journal, header.size);
+        if (valid) {
+            memcpy(SnapshotData(journal), state, header.size);
+            journal->stats.sequence = header.sequence;
+            journal->hasSnapshot = true;
+        }
     }
 
-    fclose(source);
-    fclose(dest);
-    printf("Save file copied from %s to %s\n", sourceFileName, destFileName);
+    if (!valid) printf("Save checkpoint is corrupt: %s\n", journal->fileName);
+    free(data);
+    return valid;
+}
+
+// Check a journal record and its runs without applying anything
+static bool ValidateRecord(const SaveJournal* journal, const SaveDeltaHeader* header, const uint8_t* payload) {
+    SaveDeltaHeader unsignedHeader = *header;
+    unsignedHeader.crc = 0;
+    uint32_t crc = Hash_CRC32(Hash_CRC32(0, &unsignedHeader, sizeof(unsignedHeader)), payload, header->payloadSize);
+    if (crc != header->crc) return false;
+
+    size_t offset = 0;
+    for (uint32_t i = 0; i < header->runCount; ++i) {
+        SaveDeltaRun run;
+        if (header->payloadSize - offset < sizeof(run)) return false;
+        memcpy(&run, payload + offset, sizeof(run));
+        offset += sizeof(run);
+        if (run.length > header->payloadSize - offset) return false;
+        if (run.offset > journal->size || run.length > journal->size - run.offset) return false;
+        offset += run.length;
+    }
+    return offset == header->payloadSize;
+}
+
+// Apply the runs of a validated record to the snapshot
+static void ApplyRecord(SaveJournal* journal, uint32_t runCount, const uint8_t* payload) {
+    uint8_t* state = SnapshotData(journal);
+    for (uint32_t i = 0; i < runCount; ++i) {
+        SaveDeltaRun run;
+        memcpy(&run, payload, sizeof(run));
+        memcpy(state + run.offset, payload + sizeof(run), run.length);
+        payload += sizeof(run) + run.length;
+    }
+}
+
+// Replay the journal on top of the checkpoint, stopping at the first torn or stale record
+static void ReplayJournal(SaveJournal* journal) {
+    FileMapping mapping;
+    if (!File_Map(journal->journalFileName, &mapping)) return;
+
+    const uint8_t* bytes = (const uint8_t*)mapping.data;
+    size_t offset = 0;
+    while (mapping.size - offset >= sizeof(SaveDeltaHeader)) {
+        SaveDeltaHeader header;
+        memcpy(&header, bytes + offset, sizeof(header));
+        const uint8_t* payload = bytes + offset + sizeof(header);
+
+        if (header.magic != SAVE_DELTA_MAGIC || header.sequence != journal->stats.sequence + 1
+            || (size_t)header.size != journal->size
+            || header.payloadSize > mapping.size - offset - sizeof(header)
+            || !ValidateRecord(journal, &header, payload)) {
+            break;
+        }
+
+        ApplyRecord(journal, header.runCount, payload);
+        journal->stats.sequence = header.sequence;
+        journal->stats.deltasSinceCheckpoint++;
+        offset += sizeof(header) + header.payloadSize;
+    }
+
+    // New records must not land behind a torn tail, so the next commit starts a fresh checkpoint
+    if (offset < mapping.size) {
+        printf("Save journal %s: ignoring %zu torn or stale bytes\n", journal->journalFileName, mapping.size - offset);
+        journal->needsCheckpoint = true;
+    }
+    journal->stats.journalBytes = offset;
+    File_Unmap(&mapping);
+}
+
+// Open an autosave journal and recover the latest snapshot from disk
+SaveJournal* SaveJournal_Open(const char* fileName) {
+    if (!fileName) return NULL;
+
+    SaveJournal* journal = (SaveJournal*)calloc(1, sizeof(SaveJournal));
+    if (!journal) return NULL;
+
+    size_t length = strlen(fileName);
+    journal->fileName = strdup(fileName);
+    journal->journalFileName = (char*)malloc(length + sizeof(".journal"));
+    if (!journal->fileName || !journal->journalFileName) {
+        SaveJournal_Close(journal);
+        return NULL;
+    }
+    memcpy(journal->journalFileName, fileName, length);
+    memcpy(journal->journalFileName + length, ".journal", sizeof(".journal"));
+
+    SaveJournal_SetCheckpointInterval(journal, SAVE_JOURNAL_CHECKPOINT_INTERVAL);
+    if (LoadCheckpoint(journal) && !vmuDevice) {
+        ReplayJournal(journal);
+    }
+    return journal;
+}
+
+// Close an autosave journal (everything committed is already on disk)
+void SaveJournal_Close(SaveJournal* journal) {
+    if (!journal) return;
+    if (journal->journalFile) fclose(journal->journalFile);
+    free(journal->fileName);
+    free(journal->journalFileName);
+    free(journal->image);
+    free(journal->record);
+    free(journal);
+}
+
+// Rewrite the whole state atomically and restart the journal
+bool SaveJournal_Checkpoint(SaveJournal* journal, const void* data, size_t size) {
+    if (!journal || !data || size == 0 || size > UINT32_MAX) return false;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (!ReserveSnapshot(journal, size)) {
+        printf("Failed to allocate save snapshot: %s\n", journal->fileName);
+        return false;
+    }
+
+    // Callers may pass the snapshot returned by SaveJournal_GetSnapshot
+    memmove(SnapshotData(journal), data, size);
+    journal->hasSnapshot = true;
+
+    SaveSnapshotHeader header = { 0 };
+    header.magic = SAVE_SNAPSHOT_MAGIC;
+    header.version = SAVE_SNAPSHOT_VERSION;
+    header.sequence = journal->stats.sequence + 1;
+    header.size = (uint32_t)size;
+    header.crc = Hash_CRC32(0, SnapshotData(journal), size);
+    memcpy(journal->image, &header, sizeof(header));
+
+    size_t bytes = sizeof(header) + size;
+    if (!WriteSave(journal->fileName, journal->image, bytes)) {
+        printf("Failed to write save checkpoint: %s\n", journal->fileName);
+        journal->needsCheckpoint = true;
+        return false;
+    }
+
+    // Records left behind by a crash here are older than the checkpoint and are skipped on load
+    if (journal->journalFile) {
+        fclose(journal->journalFile);
+        journal->journalFile = NULL;
+    }
+    if (!vmuDevice) File_Delete(journal->journalFileName);
+
+    journal->needsCheckpoint = false;
+    journal->stats.sequence = header.sequence;
+    journal->stats.checkpoints++;
+    journal->stats.deltasSinceCheckpoint = 0;
+    journal->stats.journalBytes = 0;
+    journal->stats.lastBytesWritten = bytes;
+    journal->stats.totalBytesWritten += bytes;
+    journal->stats.lastChangedRatio = 1.0f;
+    journal->stats.lastCommitMilliseconds = ElapsedMilliseconds(start);
+    return true;
+}
+
+// Diff the state against the snapshot in blocks; returns the payload size of the record built
+static size_t BuildDelta(SaveJournal* journal, const uint8_t* data, uint32_t* outRunCount, size_t* outChangedBlocks) {
+    const uint8_t* previous = SnapshotData(journal);
+    uint8_t* payload = journal->record + sizeof(SaveDeltaHeader);
+    size_t payloadSize = 0;
+    size_t changedBlocks = 0;
+    uint32_t runCount = 0;
+
+    size_t offset = 0;
+    while (offset < journal->size) {
+        size_t length = journal->size - offset;
+        if (length > SAVE_JOURNAL_BLOCK_SIZE) length = SAVE_JOURNAL_BLOCK_SIZE;
+        if (memcmp(previous + offset, data + offset, length) == 0) {
+            offset += length;
+            continue;
+        }
+
+        // Extend the run over consecutive changed blocks
+        size_t runStart = offset;
+        do {
+            offset += length;
+            changedBlocks++;
+            length = journal->size - offset;
+            if (length > SAVE_JOURNAL_BLOCK_SIZE) length = SAVE_JOURNAL_BLOCK_SIZE;
+        } while (offset < journal->size && memcmp(previous + offset, data + offset, length) != 0);
+
+        SaveDeltaRun run = { (uint32_t)runStart, (uint32_t)(offset - runStart) };
+        memcpy(payload + payloadSize, &run, sizeof(run));
+        memcpy(payload + payloadSize + sizeof(run), data + runStart, run.length);
+        payloadSize += sizeof(run) + run.length;
+        runCount++;
+    }
+
+    *outRunCount = runCount;
+    *outChangedBlocks = changedBlocks;
+    return payloadSize;
+}
+
+// Commit the current state: a delta of the changed blocks, or a checkpoint when one is due
+bool SaveJournal_Commit(SaveJournal* journal, const void* data, size_t size) {
+    if (!journal || !data || size == 0 || size > UINT32_MAX) return false;
+
+    if (!journal->hasSnapshot || journal->needsCheckpoint || size != journal->size
+        || journal->stats.deltasSinceCheckpoint >= (uint32_t)journal->checkpointInterval) {
+        return SaveJournal_Checkpoint(journal, data, size);
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    uint32_t runCount = 0;
+    size_t changedBlocks = 0;
+    size_t payloadSize = BuildDelta(journal, (const uint8_t*)data, &runCount, &changedBlocks);
+    size_t blocks = (size + SAVE_JOURNAL_BLOCK_SIZE - 1) / SAVE_JOURNAL_BLOCK_SIZE;
+
+    if (runCount == 0) {
+        journal->stats.lastBytesWritten = 0;
+        journal->stats.lastChangedRatio = 0.0f;
+        journal->stats.lastCommitMilliseconds = ElapsedMilliseconds(start);
+        return true;
+    }
+
+    // Once replaying the journal would cost more than reading a full snapshot, rewrite it instead
+    size_t recordSize = sizeof(SaveDeltaHeader) + payloadSize;
+    if (journal->stats.journalBytes + recordSize >= size) {
+        return SaveJournal_Checkpoint(journal, data, size);
+    }
+
+    SaveDeltaHeader header = { 0 };
+    header.magic = SAVE_DELTA_MAGIC;
+    header.sequence = journal->stats.sequence + 1;
+    header.size = (uint32_t)size;
+    header.runCount = runCount;
+    header.payloadSize = (uint32_t)payloadSize;
+    header.crc = Hash_CRC32(Hash_CRC32(0, &header, sizeof(header)), journal->record + sizeof(header), payloadSize);
+    memcpy(journal->record, &header, sizeof(header));
+
+    if (!journal->journalFile) {
+        char hostPath[VFS_MAX_PATH];
+        if (Vfs_GetWritePath(journal->journalFileName, hostPath, sizeof(hostPath))) {
+            journal->journalFile = fopen(hostPath, "ab");
+            Vfs_Invalidate(journal->journalFileName); // The journal may not have existed before
+        }
+    }
+    bool written = journal->journalFile
+        && fwrite(journal->record, 1, recordSize, journal->journalFile) == recordSize
+        && File_Sync(journal->journalFile);
+    if (!written) {
+        printf("Failed to append save journal: %s\n", journal->journalFileName);
+        journal->needsCheckpoint = true;
+        return false;
+    }
+
+    ApplyRecord(journal, runCount, journal->record + sizeof(header));
+    journal->stats.sequence = header.sequence;
+    journal->stats.deltas++;
+    journal->stats.deltasSinceCheckpoint++;
+    journal->stats.journalBytes += recordSize;
+    journal->stats.lastBytesWritten = recordSize;
+    journal->stats.totalBytesWritten += recordSize;
+    journal->stats.lastChangedRatio = (float)changedBlocks / (float)blocks;
+    journal->stats.lastCommitMilliseconds = ElapsedMilliseconds(start);
+    return true;
+}
+
+// Get the latest committed state
+const void* SaveJournal_GetSnapshot(const SaveJournal* journal, size_t* outSize) {
+    if (!journal || !journal->hasSnapshot) {
+        if (outSize) *outSize = 0;
+        return NULL;
+    }
+    if (outSize) *outSize = journal->size;
+    return SnapshotData(journal);
+}
+
+// Set how many deltas may pile up before the next full checkpoint
+void SaveJournal_SetCheckpointInterval(SaveJournal* journal, int deltas) {
+    if (!journal) return;
+    if (vmuDevice) deltas = 0; // VMU files cannot be appended to, so every commit is a checkpoint
+    journal->checkpointInterval = deltas < 0 ? 0 : deltas;
+}
+
+// Get autosave statistics
+SaveJournalStats SaveJournal_GetStats(const SaveJournal* journal) {
+    SaveJournalStats stats = { 0 };
+    if (journal) stats = journal->stats;
+    return stats;
+}
+
+// Write a submitted snapshot (save thread)
+static void SaveJob(void* data) {
+    SaveSnapshot* snapshot = (SaveSnapshot*)data;
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    const void* output = snapshot->arena;
+    size_t outputSize = snapshot->used;
+    void* transformed = NULL;
+    bool success = true;
+
+    if (snapshot->transform) {
+        success = snapshot->transform(snapshot->arena, snapshot->used, &transformed, &outputSize, snapshot->transformData)
+            && transformed;
+        output = transformed;
+    }
+
+    if (success && snapshot->journal) {
+        success = SaveJournal_Commit(snapshot->journal, output, outputSize);
+        outputSize = SaveJournal_GetStats(snapshot->journal).lastBytesWritten;
+    }
+    else if (success) {
+        success = WriteSave(snapshot->fileName, output, outputSize);
+    }
+    free(transformed);
+
+    snapshot->success = success;
+    snapshot->bytesWritten = success ? outputSize : 0;
+    snapshot->backgroundMilliseconds = ElapsedMilliseconds(start);
+    SDL_AtomicSet(&snapshot->state, SNAPSHOT_DONE);
+}
+
+// Report finished saves in submission order
+void SaveSystem_Update(float deltaTime) {
+    (void)deltaTime;
+    for (;;) {
+        SaveSnapshot* next = NULL;
+        for (int i = 0; i < SAVE_SNAPSHOT_POOL_SIZE; ++i) {
+            SaveSnapshot* snapshot = &snapshots[i];
+            if (SDL_AtomicGet(&snapshot->state) != SNAPSHOT_DONE) continue;
+            if (!next || (int32_t)(snapshot->order - next->order) < 0) next = snapshot;
+        }
+        if (!next) return;
+
+        if (next->success) {
+            saveStats.completed++;
+            saveStats.lastBytesWritten = next->bytesWritten;
+        }
+        else {
+            saveStats.failed++;
+            printf("Background save failed: %s\n", next->fileName);
+        }
+        saveStats.lastBackgroundMilliseconds = next->backgroundMilliseconds;
+        saveStats.pending--;
+
+        // Free the snapshot first so the callback can start another save
+        char fileName[sizeof(next->fileName)];
+        memcpy(fileName, next->fileName, sizeof(fileName));
+        SaveCompleteCallback callback = next->callback;
+        void* userData = next->userData;
+        bool success = next->success;
+        SDL_AtomicSet(&next->state, SNAPSHOT_FREE);
+
+        if (callback) callback(fileName, success, userData);
+    }
+}
+
+// Block until every submitted save has been written and reported
+void SaveSystem_Flush() {
+    if (savePool) JobPool_WaitIdle(savePool);
+    SaveSystem_Update(0.0f);
+}
+
+// Get background save statistics
+SaveStats SaveSystem_GetStats() {
+    return saveStats;
+}
+
+// Make room for more captured bytes, growing the arena geometrically
+static bool ReserveArena(SaveSnapshot* snapshot, size_t bytes) {
+    if (snapshot->captureFailed) return false;
+    if (bytes <= snapshot->capacity - snapshot->used) return true;
+
+    size_t capacity = snapshot->capacity ? snapshot->capacity : SAVE_ARENA_INITIAL_CAPACITY;
+    while (capacity - snapshot->used < bytes) {
+        if (capacity > UINT32_MAX / 2) {
+            snapshot->captureFailed = true;
+            return false;
+        }
+        capacity *= 2;
+    }
+
+    uint8_t* arena = (uint8_t*)realloc(snapshot->arena, capacity);
+    if (!arena) {
+        printf("Failed to grow save snapshot to %zu bytes: %s\n", capacity, snapshot->fileName);
+        snapshot->captureFailed = true;
+        return false;
+    }
+    snapshot->arena = arena;
+    snapshot->capacity = capacity;
     return true;
-#else
-    // Dreamcast VMU copy (example stub)
-    printf("VMU copy functionality is not implemented yet.\n");
-    return false;
-#endif
 }
 
-// Check if there's enough free space
+// Start capturing a save
+SaveSnapshot* SaveSnapshot_Begin(const char* fileName) {
+    if (!fileName || strlen(fileName) >= sizeof(snapshots[0].fileName)) return NULL;
+
+    SaveSnapshot* snapshot = NULL;
+    for (int i = 0; i < SAVE_SNAPSHOT_POOL_SIZE; ++i) {
+        if (SDL_AtomicCAS(&snapshots[i].state, SNAPSHOT_FREE, SNAPSHOT_CAPTURING)) {
+            snapshot = &snapshots[i];
+            break;
+        }
+    }
+    if (!snapshot) {
+        saveStats.dropped++;
+        return NULL;
+    }
+
+    snapshot->captureStart = SDL_GetPerformanceCounter();
+    strcpy(snapshot->fileName, fileName);
+    snapshot->used = 0;
+    snapshot->sectionCount = 0;
+    snapshot->captureFailed = false;
+    snapshot->journal = NULL;
+    snapshot->transform = NULL;
+    snapshot->transformData = NULL;
+    if (ReserveArena(snapshot, sizeof(SaveSectionsHeader))) {
+        snapshot->used = sizeof(SaveSectionsHeader);
+    }
+    return snapshot;
+}
+
+// Reserve a section to be filled in place
+void* SaveSnapshot_Reserve(SaveSnapshot* snapshot, const char* section, size_t size) {
+    if (!snapshot || !section || size > UINT32_MAX) return NULL;
+    if (SDL_AtomicGet(&snapshot->state) != SNAPSHOT_CAPTURING) return NULL;
+
+    size_t padded = (size + SAVE_SECTION_ALIGNMENT - 1) & ~(size_t)(SAVE_SECTION_ALIGNMENT - 1);
+    if (!ReserveArena(snapshot, sizeof(SaveSectionHeader) + padded)) return NULL;
+
+    SaveSectionHeader header = { Hash_String(section), (uint32_t)size };
+    uint8_t* out = snapshot->arena + snapshot->used;
+    memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    memset(out + size, 0, padded - size);
+
+    snapshot->used += sizeof(header) + padded;
+    snapshot->sectionCount++;
+    return out;
+}
+
+// Copy a section into the snapshot
+bool SaveSnapshot_Capture(SaveSnapshot* snapshot, const char* section, const void* data, size_t size) {
+    if (!data && size > 0) return false;
+
+    void* out = SaveSnapshot_Reserve(snapshot, section, size);
+    if (!out) return false;
+    if (size > 0) memcpy(out, data, size);
+    return true;
+}
+
+// Run a transform over the captured sections on the save thread
+void SaveSnapshot_SetTransform(SaveSnapshot* snapshot, SaveTransformFunction transform, void* userData) {
+    if (!snapshot || SDL_AtomicGet(&snapshot->state) != SNAPSHOT_CAPTURING) return;
+    snapshot->transform = transform;
+    snapshot->transformData = userData;
+}
+
+// Hand a captured snapshot to the save thread
+bool SaveSnapshot_Submit(SaveSnapshot* snapshot, SaveJournal* journal, SaveCompleteCallback callback, void* userData) {
+    if (!snapshot || SDL_AtomicGet(&snapshot->state) != SNAPSHOT_CAPTURING) return false;
+    if (snapshot->captureFailed) {
+        SaveSnapshot_Cancel(snapshot);
+        return false;
+    }
+
+    SaveSectionsHeader header;
+    header.magic = SAVE_SECTIONS_MAGIC;
+    header.version = SAVE_SECTIONS_VERSION;
+    header.sectionCount = snapshot->sectionCount;
+    header.size = (uint32_t)snapshot->used;
+    memcpy(snapshot->arena, &header, sizeof(header));
+
+    snapshot->journal = journal;
+    snapshot->callback = callback;
+    snapshot->userData = userData;
+    snapshot->order = nextSaveOrder++;
+
+    float captureMicroseconds = ElapsedMilliseconds(snapshot->captureStart) * 1000.0f;
+    saveStats.lastCaptureMicroseconds = captureMicroseconds;
+    if (captureMicroseconds > saveStats.peakCaptureMicroseconds) saveStats.peakCaptureMicroseconds = captureMicroseconds;
+    saveStats.pending++;
+
+    SDL_AtomicSet(&snapshot->state, SNAPSHOT_QUEUED);
+    if (!savePool || !JobPool_Submit(savePool, SaveJob, snapshot, JOB_PRIORITY_NORMAL)) {
+        SaveJob(snapshot); // No save thread: write now, still reported from SaveSystem_Update
+    }
+    return true;
+}
+
+// Abandon a snapshot that is still being captured
+void SaveSnapshot_Cancel(SaveSnapshot* snapshot) {
+    if (!snapshot) return;
+    SDL_AtomicCAS(&snapshot->state, SNAPSHOT_CAPTURING, SNAPSHOT_FREE);
+}
+
+// Find a named section in captured save data
+const void* SaveData_FindSection(const void* data, size_t size, const char* section, size_t* outSize) {
+    if (outSize) *outSize = 0;
+    if (!data || !section || size < sizeof(SaveSectionsHeader)) return NULL;
+
+    SaveSectionsHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != SAVE_SECTIONS_MAGIC || header.version != SAVE_SECTIONS_VERSION || header.size > size) return NULL;
+
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t hash = Hash_String(section);
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; i < header.sectionCount; ++i) {
+        SaveSectionHeader entry;
+        if (header.size - offset < sizeof(entry)) return NULL;
+        memcpy(&entry, bytes + offset, sizeof(entry));
+        offset += sizeof(entry);
+
+        size_t padded = ((size_t)entry.size + SAVE_SECTION_ALIGNMENT - 1) & ~(size_t)(SAVE_SECTION_ALIGNMENT - 1);
+        if (padded > header.size - offset) return NULL;
+        if (entry.nameHash == hash) {
+            if (outSize) *outSize = entry.size;
+            return bytes + offset;
+        }
+        offset += padded;
+    }
+    return NULL;
+}
+
+// Check if there's enough free space for a save of sizeNeeded bytes
 bool SaveSystem_CheckSpace(size_t sizeNeeded) {
-#ifdef _WIN32
-    printf("Free space check not implemented for PC platform.\n");
-    return true; // Assume enough space on PC for simplicity
-#else
-    // Dreamcast VMU free space check (example stub)
-    printf("VMU space check not implemented yet.\n");
-    return false;
-#endif
+    if (vmuDevice) {
+        // Assume the save will not compress; the container never grows past this
+        int blocksNeeded = VmuDevice_GetBlocksNeeded(VmuContainer_GetBound(sizeNeeded));
+        return blocksNeeded <= VmuDevice_GetFreeBlocks(vmuDevice);
+    }
+    return SaveSystem_GetFreeSpace() >= sizeNeeded;
 }
 
-// Get free space on the platform
+// Get free space on the platform in bytes (whole free blocks on the VMU)
 size_t SaveSystem_GetFreeSpace() {
-#ifdef _WIN32
-    printf("Free space retrieval not implemented for PC platform.\n");
-    return (size_t)-1; // Unlimited for simplicity
-#else
-    // Dreamcast VMU free space retrieval (example stub)
-    printf("VMU space retrieval not implemented yet.\n");
-    return 0;
+    if (vmuDevice) {
+        return (size_t)VmuDevice_GetFreeBlocks(vmuDevice) * VMU_BLOCK_SIZE;
+    }
+
+#if defined(_WIN32)
+    ULARGE_INTEGER available;
+    if (GetDiskFreeSpaceExA(NULL, &available, NULL, NULL)) return (size_t)available.QuadPart;
+#elif !defined(DREAMCAST)
+    struct statvfs info;
+    if (statvfs(".", &info) == 0) return (size_t)info.f_bavail * (size_t)info.f_frsize;
 #endif
+    return (size_t)-1; // Unknown: assume unlimited
 }
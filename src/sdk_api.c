@@ -1,5 +1,8 @@
 // sdk_api.c
 #include "sdk_api.h"
+#include "async_io.h" // For the shared I/O queue used by saves and asset streaming
+#include "profiler.h" // For per-subsystem zones
+#include "log_system.h" // For queued log output
 #include <stdio.h>
 #include <stdbool.h> // Include stdbool.h for bool type
 
@@ -19,6 +22,7 @@ void AI_Init();
 void EventSystem_Init();
 bool SaveSystem_Init(int platform);
 bool AudioSystem_Init();
+bool AssetSystem_Init();
 
 // Forward declarations of the shutdown functions
 void EventSystem_Shutdown();
@@ -33,6 +37,19 @@ void ShaderSystem_Shutdown();
 void Renderer_Shutdown();
 void AudioSystem_Shutdown();
 void SaveSystem_Shutdown();
+void AssetSystem_Shutdown();
+
+static GameDatabase* gameDatabase = NULL; // Compiled content, used in place from the mapped file
+
+// Register items and skills from the compiled database (the built-in set stays opt-in)
+static void LoadContent() {
+    gameDatabase = GameDB_Open(GAMEDB_DEFAULT_PATH);
+    if (gameDatabase && GameDB_RegisterContent(gameDatabase)) return;
+
+    GameDB_Close(gameDatabase);
+    gameDatabase = NULL;
+    LOG_WARNING(LOG_CATEGORY_CORE, "No usable game database at %s, no content registered.", GAMEDB_DEFAULT_PATH);
+}
 
 // Forward declarations of the update functions
 void Camera_Update(float deltaTime);
@@ -43,18 +60,23 @@ void Dialogue_Update(float deltaTime);
 void CutsceneSystem_Update(float deltaTime);
 void BattleSystem_Update(float deltaTime);
 void AudioSystem_Update(float deltaTime);
+void AssetSystem_Update(float deltaTime);
+void SaveSystem_Update(float deltaTime);
+int EventSystem_DispatchQueued();
 
 // Initialize the SDK and its subsystems
 bool SDK_Init() {
-    printf("Initializing SDK...\n");
+    PROFILE_THREAD("Main");
+    LogSystem_Init(); // On failure messages print directly instead
+    LOG_INFO(LOG_CATEGORY_CORE, "Initializing SDK...");
 
     // Initialize Core Systems
     if (!Renderer_Init()) {
-        printf("Failed to initialize Renderer.\n");
+        LOG_ERROR(LOG_CATEGORY_CORE, "Failed to initialize Renderer.");
         return false;
     }
     if (!ShaderSystem_Init()) {
-        printf("Failed to initialize Shader System.\n");
+        LOG_ERROR(LOG_CATEGORY_CORE, "Failed to initialize Shader System.");
         return false;
     }
     Camera_Init(1920, 1080); // Pass appropriate arguments
@@ -63,13 +85,14 @@ bool SDK_Init() {
 
     // Initialize Game Systems
     if (!BattleSystem_Init()) {
-        printf("Failed to initialize Battle System.\n");
+        LOG_ERROR(LOG_CATEGORY_CORE, "Failed to initialize Battle System.");
         return false;
     }
     StatsSystem_Init();
     Skills_Init();
+    LoadContent(); // Maps the database through the VFS
     if (!CutsceneSystem_Init()) {
-        printf("Failed to initialize Cutscene System.\n");
+        LOG_ERROR(LOG_CATEGORY_CORE, "Failed to initialize Cutscene System.");
         return false;
     }
     Dialogue_Init();
@@ -78,22 +101,30 @@ bool SDK_Init() {
     EventSystem_Init();
 
     // Initialize Utilities
+    if (!AsyncIO_Init(NULL)) {
+        LOG_ERROR(LOG_CATEGORY_CORE, "Failed to initialize Async I/O.");
+        return false;
+    }
     if (!SaveSystem_Init(SAVE_PLATFORM_PC)) { // Default to PC
-        printf("Failed to initialize Save System.\n");
+        LOG_ERROR(LOG_CATEGORY_CORE, "Failed to initialize Save System.");
         return false;
     }
     if (!AudioSystem_Init()) {
-        printf("Failed to initialize Audio System.\n");
+        LOG_ERROR(LOG_CATEGORY_CORE, "Failed to initialize Audio System.");
+        return false;
+    }
+    if (!AssetSystem_Init()) {
+        LOG_ERROR(LOG_CATEGORY_CORE, "Failed to initialize Asset System.");
         return false;
     }
 
-    printf("SDK initialized successfully.\n");
+    LOG_INFO(LOG_CATEGORY_CORE, "SDK initialized successfully.");
     return true;
 }
 
 // Shutdown the SDK and its subsystems
 void SDK_Shutdown() {
-    printf("Shutting down SDK...\n");
+    LOG_INFO(LOG_CATEGORY_CORE, "Shutting down SDK...");
 
     // Shutdown Game Systems
     EventSystem_Shutdown();
@@ -103,6 +134,12 @@ void SDK_Shutdown() {
     CutsceneSystem_Shutdown();
     StatsSystem_Shutdown();
     BattleSystem_Shutdown();
+    GameDB_Close(gameDatabase); // Unregisters its items and skills
+    gameDatabase = NULL;
+
+    // Release cached assets while the renderer and audio device still exist
+    AssetSystem_Shutdown(); // Frees textures and audio chunks
+    AudioSystem_Shutdown();
 
     // Shutdown Core Systems
     PhysicsSystem_Shutdown();
@@ -110,23 +147,56 @@ void SDK_Shutdown() {
     Renderer_Shutdown();
 
     // Shutdown Utilities
-    AudioSystem_Shutdown();
     SaveSystem_Shutdown();
-
-    printf("SDK shut down successfully.\n");
+    AsyncIO_Shutdown(); // After the systems that queue I/O
+    StringID_Shutdown(); // After the database, items, skills, stats and saves that hold interned names
+    LOG_INFO(LOG_CATEGORY_CORE, "SDK shut down successfully.");
+    LogSystem_Shutdown(); // Prints what is still queued
+    Profiler_Shutdown(); // After every thread that records zones
 }
 
 // Update the SDK subsystems
 void SDK_Update(float deltaTime) {
+    PROFILE_FRAME(); // Summarize the frame that ended here
+    PROFILE_BEGIN("SDK_Update");
+
     // Update subsystems
+    PROFILE_BEGIN("Camera_Update");
     Camera_Update(deltaTime);
+    PROFILE_END();
+    PROFILE_BEGIN("PhysicsSystem_Update");
     PhysicsSystem_Update(deltaTime);
+    PROFILE_END();
+    PROFILE_BEGIN("MapSystem_Update");
     MapSystem_Update(deltaTime);
+    PROFILE_END();
+    PROFILE_BEGIN("AI_Update");
     AI_Update(deltaTime);
+    PROFILE_END();
+    PROFILE_BEGIN("Dialogue_Update");
     Dialogue_Update(deltaTime);
+    PROFILE_END();
+    PROFILE_BEGIN("CutsceneSystem_Update");
     CutsceneSystem_Update(deltaTime);
+    PROFILE_END();
+    PROFILE_BEGIN("BattleSystem_Update");
     BattleSystem_Update(deltaTime);
+    PROFILE_END();
+    PROFILE_BEGIN("AudioSystem_Update");
     AudioSystem_Update(deltaTime);
+    PROFILE_END();
+    PROFILE_BEGIN("AssetSystem_Update");
+    AssetSystem_Update(deltaTime); // Finalize background loads within the frame budget
+    PROFILE_END();
+    PROFILE_BEGIN("SaveSystem_Update");
+    SaveSystem_Update(deltaTime); // Report background saves that have finished
+    PROFILE_END();
+
+    // Sync point: deliver events raised during this update
+    PROFILE_BEGIN("EventSystem_DispatchQueued");
+    EventSystem_DispatchQueued();
+    PROFILE_END();
 
-    printf("SDK updated with deltaTime: %.2f\n", deltaTime);
+    LOG_TRACE(LOG_CATEGORY_CORE, "SDK updated with deltaTime: %.2f", deltaTime);
+    PROFILE_END();
 }
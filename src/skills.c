@@ -4,10 +4,12 @@
 #include <string.h>
 #include <stdio.h>
 
-#define MAX_SKILLS 256
+#define SKILL_REGISTRY_INITIAL_CAPACITY 256
 
-static Skill* skillRegistry[MAX_SKILLS];
+static Skill** skillRegistry = NULL;
 static int skillCount = 0;
+static int skillCapacity = 0;
+static HashIndex skillIndex = { 0 }; // nameHash -> registry slot
 
 // Create a new skill
 Skill* Skills_Create(const char* name, SkillType type, int power, ElementType element,
@@ -24,13 +26,16 @@ Skill* Skills_Create(const char* name, SkillType type, int power, ElementType el
     skill->description = strdup(description);
     skill->fusionIDs[0] = -1;
     skill->fusionIDs[1] = -1;
+    skill->nameID = StringID_Intern(name);
+    skill->nameHash = StringID_GetHash(skill->nameID);
+    skill->isDatabaseRecord = false;
 
     return skill;
 }
 
 // Destroy a skill
 void Skills_Destroy(Skill* skill) {
-    if (!skill) return;
+    if (!skill || skill->isDatabaseRecord) return;
 
     free((void*)skill->name);
     free((void*)skill->description);
@@ -39,7 +44,20 @@ void Skills_Destroy(Skill* skill) {
 
 // Register a skill
 bool Skills_Register(Skill* skill) {
-    if (!skill || skillCount >= MAX_SKILLS) return false;
+    if (!skill) return false;
+
+    if (skillCount >= skillCapacity) {
+        int capacity = skillCapacity ? skillCapacity * 2 : SKILL_REGISTRY_INITIAL_CAPACITY;
+        Skill** registry = (Skill**)realloc(skillRegistry, sizeof(Skill*) * capacity);
+        if (!registry) {
+            printf("Failed to grow skill registry.\n");
+            return false;
+        }
+        skillRegistry = registry;
+        skillCapacity = capacity;
+    }
+
+    if (!HashIndex_Insert(&skillIndex, skill->nameHash, skillCount)) return false;
 
     skillRegistry[skillCount++] = skill;
     printf("Registered skill: %s\n", skill->name);
@@ -50,9 +68,18 @@ bool Skills_Register(Skill* skill) {
 void Skills_Unregister(Skill* skill) {
     if (!skill) return;
 
-    for (int i = 0; i < skillCount; i++) {
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(&skillIndex, skill->nameHash, &cursor); i >= 0;
+        i = HashIndex_FindNext(&skillIndex, skill->nameHash, &cursor)) {
         if (skillRegistry[i] == skill) {
-            skillRegistry[i] = skillRegistry[--skillCount];
+            HashIndex_Remove(&skillIndex, skill->nameHash, i);
+
+            // Move the last skill into the freed slot and repoint its index entry
+            int last = --skillCount;
+            if (i != last) {
+                skillRegistry[i] = skillRegistry[last];
+                HashIndex_Replace(&skillIndex, skillRegistry[i]->nameHash, last, i);
+            }
             printf("Unregistered skill: %s\n", skill->name);
             break;
         }
@@ -61,7 +88,12 @@ void Skills_Unregister(Skill* skill) {
 
 // Get a skill by name
 Skill* Skills_GetByName(const char* name) {
-    for (int i = 0; i < skillCount; i++) {
+    if (!name) return NULL;
+
+    uint32_t hash = Hash_String(name);
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(&skillIndex, hash, &cursor); i >= 0;
+        i = HashIndex_FindNext(&skillIndex, hash, &cursor)) {
         if (strcmp(skillRegistry[i]->name, name) == 0) {
             return skillRegistry[i];
         }
@@ -69,6 +101,33 @@ Skill* Skills_GetByName(const char* name) {
     return NULL;
 }
 
+// Get a skill by precomputed name hash (first match on collision)
+Skill* Skills_GetByHash(uint32_t nameHash) {
+    int cursor;
+    int32_t i = HashIndex_FindFirst(&skillIndex, nameHash, &cursor);
+    return i >= 0 ? skillRegistry[i] : NULL;
+}
+
+// Get a skill by interned name
+Skill* Skills_GetByID(StringID nameID) {
+    if (nameID == STRING_ID_NONE) return NULL;
+
+    uint32_t hash = StringID_GetHash(nameID);
+    int cursor;
+    for (int32_t i = HashIndex_FindFirst(&skillIndex, hash, &cursor); i >= 0;
+        i = HashIndex_FindNext(&skillIndex, hash, &cursor)) {
+        if (skillRegistry[i]->nameID == nameID) {
+            return skillRegistry[i];
+        }
+    }
+    return NULL;
+}
+
+// Get the number of registered skills
+int Skills_GetCount() {
+    return skillCount;
+}
+
 // Add predefined standard skills
 void Skills_AddStandardSkills() {
     Skills_Register(Skills_Create("Fireball", SKILL_TYPE_ELEMENTAL, 50, ELEMENT_FIRE, 10.0f, false, "A basic fire attack."));
@@ -3,6 +3,63 @@
 #include <stdio.h>
 #include <string.h>
 
+// Stat names, indexed by StatType
+static const char* statNames[STAT_COUNT] = { "hp", "sp", "atk", "def", "spd", "res", "intel", "luck" };
+
+// Per-level growth, indexed by StatType (example scaling)
+static const int statGrowth[STAT_COUNT] = { 10, 5, 2, 2, 1, 2, 3, 1 };
+
+// Clamp a stat total to its valid range
+static int ClampStat(int value) {
+    if (value < 0) return 0;
+    if (value > MAX_STAT_VALUE) return MAX_STAT_VALUE;
+    return value;
+}
+
+// Compute base + modifier totals without touching the cache
+static void ComputeTotals(const CharacterStats* stats, Stats* totals) {
+    int flat[STAT_COUNT] = { 0 };
+    int percent[STAT_COUNT] = { 0 };
+
+    for (int i = 0; i < stats->modifierCount; ++i) {
+        const StatModifier* modifier = &stats->modifiers[i];
+        if (modifier->type == STAT_MODIFIER_FLAT) {
+            flat[modifier->stat] += modifier->value;
+        }
+        else {
+            percent[modifier->stat] += modifier->value;
+        }
+    }
+
+    for (int stat = 0; stat < STAT_COUNT; ++stat) {
+        int value = stats->baseStats.values[stat] + flat[stat];
+        if (percent[stat] != 0) {
+            value = (int)((int64_t)value * (100 + percent[stat]) / 100);
+        }
+        totals->values[stat] = ClampStat(value);
+    }
+
+    // HP and SP buffs heal up to the base maximum, never past it
+    if (totals->hp > stats->baseStats.hp) totals->hp = stats->baseStats.hp;
+    if (totals->sp > stats->baseStats.sp) totals->sp = stats->baseStats.sp;
+}
+
+// Recompute cached totals if the modifier stack changed
+static void RefreshStats(CharacterStats* stats) {
+    if (!stats->isDirty) return;
+
+    ComputeTotals(stats, &stats->currentStats);
+    stats->isDirty = false;
+}
+
+// Remove the modifier at index, keeping stack order
+static void RemoveModifierAt(CharacterStats* stats, int index) {
+    memmove(&stats->modifiers[index], &stats->modifiers[index + 1],
+        sizeof(StatModifier) * (stats->modifierCount - index - 1));
+    stats->modifierCount--;
+    stats->isDirty = true;
+}
+
 // Initialize character stats
 void Stats_Init(CharacterStats* stats, int level, Stats baseStats) {
     if (!stats) return;
@@ -10,6 +67,10 @@ void Stats_Init(CharacterStats* stats, int level, Stats baseStats) {
     stats->level = (level > 0 && level <= MAX_LEVEL) ? level : 1;
     stats->baseStats = baseStats;
     stats->currentStats = baseStats;
+    stats->modifierCount = 0;
+    stats->nextModifierID = 1;
+    memset(stats->adjustmentIDs, 0, sizeof(stats->adjustmentIDs));
+    stats->isDirty = true;
 
     printf("Character stats initialized at level %d.\n", stats->level);
 }
@@ -20,105 +81,185 @@ void Stats_LevelUp(CharacterStats* stats) {
 
     stats->level++;
 
-    // Increase base stats on level up (example scaling)
-    stats->baseStats.hp += 10;
-    stats->baseStats.sp += 5;
-    stats->baseStats.atk += 2;
-    stats->baseStats.def += 2;
-    stats->baseStats.spd += 1;
-    stats->baseStats.res += 2;
-    stats->baseStats.intel += 3;
-    stats->baseStats.luck += 1;
-
-    // Ensure stats do not exceed the cap
-    if (stats->baseStats.hp > MAX_STAT_VALUE) stats->baseStats.hp = MAX_STAT_VALUE;
-    if (stats->baseStats.sp > MAX_STAT_VALUE) stats->baseStats.sp = MAX_STAT_VALUE;
-    if (stats->baseStats.atk > MAX_STAT_VALUE) stats->baseStats.atk = MAX_STAT_VALUE;
-    if (stats->baseStats.def > MAX_STAT_VALUE) stats->baseStats.def = MAX_STAT_VALUE;
-    if (stats->baseStats.spd > MAX_STAT_VALUE) stats->baseStats.spd = MAX_STAT_VALUE;
-    if (stats->baseStats.res > MAX_STAT_VALUE) stats->baseStats.res = MAX_STAT_VALUE;
-    if (stats->baseStats.intel > MAX_STAT_VALUE) stats->baseStats.intel = MAX_STAT_VALUE;
-    if (stats->baseStats.luck > MAX_STAT_VALUE) stats->baseStats.luck = MAX_STAT_VALUE;
-
-    // Update current stats to match base stats (remove buffs/debuffs)
-    stats->currentStats = stats->baseStats;
+    // Increase base stats on level up, ensuring they do not exceed the cap
+    for (int stat = 0; stat < STAT_COUNT; ++stat) {
+        stats->baseStats.values[stat] = ClampStat(stats->baseStats.values[stat] + statGrowth[stat]);
+    }
+
+    // Active buffs/debuffs carry over; totals are recomputed on next access
+    stats->isDirty = true;
 
     printf("Character leveled up to level %d.\n", stats->level);
 }
 
-// Apply a temporary buff to a stat
-void Stats_ApplyBuff(CharacterStats* stats, const char* statName, int value) {
-    if (!stats || !statName) return;
+// Look up a stat by its name ("hp", "atk", ...)
+StatType Stats_GetTypeByName(const char* statName) {
+    if (!statName) return STAT_INVALID;
 
-    if (strcmp(statName, "hp") == 0) {
-        stats->currentStats.hp += value;
-        if (stats->currentStats.hp > stats->baseStats.hp) {
-            stats->currentStats.hp = stats->baseStats.hp;
+    for (int stat = 0; stat < STAT_COUNT; ++stat) {
+        if (strcmp(statName, statNames[stat]) == 0) {
+            return (StatType)stat;
         }
     }
-    else if (strcmp(statName, "sp") == 0) {
-        stats->currentStats.sp += value;
-        if (stats->currentStats.sp > stats->baseStats.sp) {
-            stats->currentStats.sp = stats->baseStats.sp;
+    return STAT_INVALID;
+}
+
+// Get a base stat value
+int Stats_GetBase(const CharacterStats* stats, StatType stat) {
+    if (!stats || stat < 0 || stat >= STAT_COUNT) return 0;
+    return stats->baseStats.values[stat];
+}
+
+// Get a stat value including modifiers
+int Stats_GetCurrent(CharacterStats* stats, StatType stat) {
+    if (!stats || stat < 0 || stat >= STAT_COUNT) return 0;
+
+    RefreshStats(stats);
+    return stats->currentStats.values[stat];
+}
+
+// Get all stat values including modifiers
+const Stats* Stats_GetCurrentStats(CharacterStats* stats) {
+    if (!stats) return NULL;
+
+    RefreshStats(stats);
+    return &stats->currentStats;
+}
+
+// Push a modifier onto the stack, returns its ID (0 on failure)
+uint32_t Stats_AddModifier(CharacterStats* stats, StatType stat, StatModifierType type,
+    int value, float duration) {
+    if (!stats || stat < 0 || stat >= STAT_COUNT) return 0;
+
+    if (stats->modifierCount >= MAX_STAT_MODIFIERS) {
+        printf("Error: Maximum number of stat modifiers reached.\n");
+        return 0;
+    }
+
+    StatModifier* modifier = &stats->modifiers[stats->modifierCount++];
+    modifier->stat = stat;
+    modifier->type = type;
+    modifier->value = value;
+    modifier->duration = duration;
+    modifier->id = stats->nextModifierID++;
+    if (stats->nextModifierID == 0) stats->nextModifierID = 1;
+
+    stats->isDirty = true;
+    return modifier->id;
+}
+
+// Remove a modifier by ID
+bool Stats_RemoveModifier(CharacterStats* stats, uint32_t modifierID) {
+    if (!stats || modifierID == 0) return false;
+
+    for (int i = 0; i < stats->modifierCount; ++i) {
+        if (stats->modifiers[i].id == modifierID) {
+            RemoveModifierAt(stats, i);
+            return true;
         }
     }
-    else if (strcmp(statName, "atk") == 0) {
-        stats->currentStats.atk += value;
+    return false;
+}
+
+// Remove all modifiers
+void Stats_ClearModifiers(CharacterStats* stats) {
+    if (!stats) return;
+
+    stats->modifierCount = 0;
+    stats->isDirty = true;
+}
+
+// Advance timed modifiers, dropping the ones that expire
+void Stats_TickModifiers(CharacterStats* stats, float elapsed) {
+    if (!stats) return;
+
+    int kept = 0;
+    for (int i = 0; i < stats->modifierCount; ++i) {
+        StatModifier* modifier = &stats->modifiers[i];
+        if (modifier->duration > 0.0f) {
+            modifier->duration -= elapsed;
+            if (modifier->duration <= 0.0f) {
+                stats->isDirty = true;
+                continue;
+            }
+        }
+        if (kept != i) {
+            stats->modifiers[kept] = *modifier;
+        }
+        kept++;
     }
-    else if (strcmp(statName, "def") == 0) {
-        stats->currentStats.def += value;
+    stats->modifierCount = kept;
+}
+
+// Advance timed modifiers for a whole group of characters (e.g. a battle turn)
+void Stats_TickModifiersBatch(CharacterStats** characters, int count, float elapsed) {
+    if (!characters) return;
+
+    for (int i = 0; i < count; ++i) {
+        if (characters[i] && characters[i]->modifierCount > 0) {
+            Stats_TickModifiers(characters[i], elapsed);
+        }
     }
-    else if (strcmp(statName, "spd") == 0) {
-        stats->currentStats.spd += value;
+}
+
+// Add to a stat's running adjustment, the one permanent modifier ApplyBuff/ApplyDebuff share
+static void AdjustStat(CharacterStats* stats, StatType stat, int delta) {
+    StatModifier* adjustment = NULL;
+    int otherFlat = 0;
+    for (int i = 0; i < stats->modifierCount; ++i) {
+        StatModifier* modifier = &stats->modifiers[i];
+        if (modifier->id == stats->adjustmentIDs[stat]) {
+            adjustment = modifier;
+        }
+        else if (modifier->stat == stat && modifier->type == STAT_MODIFIER_FLAT) {
+            otherFlat += modifier->value;
+        }
     }
-    else if (strcmp(statName, "res") == 0) {
-        stats->currentStats.res += value;
+
+    int64_t value = (int64_t)(adjustment ? adjustment->value : 0) + delta;
+    if (stat == STAT_HP || stat == STAT_SP) {
+        // Healing only restores what was lost, damage stops at zero
+        int64_t floor = -(int64_t)(stats->baseStats.values[stat] + otherFlat);
+        if (value > 0) value = 0;
+        if (value < floor) value = floor < 0 ? floor : 0;
     }
-    else if (strcmp(statName, "intel") == 0) {
-        stats->currentStats.intel += value;
+    else if (value > MAX_STAT_VALUE) value = MAX_STAT_VALUE;
+    else if (value < -MAX_STAT_VALUE) value = -MAX_STAT_VALUE;
+
+    if (adjustment) {
+        if (value == 0) {
+            Stats_RemoveModifier(stats, adjustment->id);
+            stats->adjustmentIDs[stat] = 0;
+        }
+        else {
+            adjustment->value = (int)value;
+            stats->isDirty = true;
+        }
     }
-    else if (strcmp(statName, "luck") == 0) {
-        stats->currentStats.luck += value;
+    else if (value != 0) {
+        stats->adjustmentIDs[stat] = Stats_AddModifier(stats, stat, STAT_MODIFIER_FLAT, (int)value, 0.0f);
     }
+}
+
+// Apply a buff to a stat, lasting until removed
+void Stats_ApplyBuff(CharacterStats* stats, const char* statName, int value) {
+    if (!stats || !statName) return;
+
+    StatType stat = Stats_GetTypeByName(statName);
+    if (stat == STAT_INVALID) return;
 
+    AdjustStat(stats, stat, value);
     printf("Buff applied to %s: %+d\n", statName, value);
 }
 
-// Apply a temporary debuff to a stat
+// Apply a debuff to a stat, lasting until removed
 void Stats_ApplyDebuff(CharacterStats* stats, const char* statName, int value) {
     if (!stats || !statName) return;
 
-    if (strcmp(statName, "hp") == 0) {
-        stats->currentStats.hp -= value;
-        if (stats->currentStats.hp < 0) {
-            stats->currentStats.hp = 0;
-        }
-    }
-    else if (strcmp(statName, "sp") == 0) {
-        stats->currentStats.sp -= value;
-        if (stats->currentStats.sp < 0) {
-            stats->currentStats.sp = 0;
-        }
-    }
-    else if (strcmp(statName, "atk") == 0) {
-        stats->currentStats.atk -= value;
-    }
-    else if (strcmp(statName, "def") == 0) {
-        stats->currentStats.def -= value;
-    }
-    else if (strcmp(statName, "spd") == 0) {
-        stats->currentStats.spd -= value;
-    }
-    else if (strcmp(statName, "res") == 0) {
-        stats->currentStats.res -= value;
-    }
-    else if (strcmp(statName, "intel") == 0) {
-        stats->currentStats.intel -= value;
-    }
-    else if (strcmp(statName, "luck") == 0) {
-        stats->currentStats.luck -= value;
-    }
+    StatType stat = Stats_GetTypeByName(statName);
+    if (stat == STAT_INVALID) return;
 
+    AdjustStat(stats, stat, -value);
     printf("Debuff applied to %s: %d\n", statName, value);
 }
 
@@ -136,13 +277,21 @@ bool Stats_IsStatMaxed(int stat) {
 void Stats_Display(const CharacterStats* stats) {
     if (!stats) return;
 
+    Stats current = stats->currentStats;
+    if (stats->isDirty) {
+        ComputeTotals(stats, &current);
+    }
+
     printf("Level: %d\n", stats->level);
-    printf("HP: %d / %d\n", stats->currentStats.hp, stats->baseStats.hp);
-    printf("SP: %d / %d\n", stats->currentStats.sp, stats->baseStats.sp);
-    printf("ATK: %d\n", stats->currentStats.atk);
-    printf("DEF: %d\n", stats->currentStats.def);
-    printf("SPD: %d\n", stats->currentStats.spd);
-    printf("RES: %d\n", stats->currentStats.res);
-    printf("INT: %d\n", stats->currentStats.intel);
-    printf("LCK: %d\n", stats->currentStats.luck);
+    printf("HP: %d / %d\n", current.hp, stats->baseStats.hp);
+    printf("SP: %d / %d\n", current.sp, stats->baseStats.sp);
+    printf("ATK: %d\n", current.atk);
+    printf("DEF: %d\n", current.def);
+    printf("SPD: %d\n", current.spd);
+    printf("RES: %d\n", current.res);
+    printf("INT: %d\n", current.intel);
+    printf("LCK: %d\n", current.luck);
+    if (stats->modifierCount > 0) {
+        printf("Active modifiers: %d\n", stats->modifierCount);
+    }
 }
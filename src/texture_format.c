@@ -0,0 +1,273 @@
+// texture_format.c
+#include "texture_format.h"
+#include "file_utils.h" // For writing cooked files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef DREAMCAST
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#endif
+
+#define PVR_MIP_BASE_OFFSET_16BPP 6 // The PVR expects the 1x1 level of a 16-bit mip chain at byte 6
+
+static const char* formatNames[TEXTURE_FORMAT_COUNT] = { "rgba8888", "rgb565", "argb1555", "argb4444" };
+
+// Get the size of one texel
+int TextureFormat_GetBytesPerPixel(TextureFormat format) {
+    return format == TEXTURE_FORMAT_RGBA8888 ? 4 : 2;
+}
+
+// Get the name of a format (as used by cooker command lines and manifests)
+const char* TextureFormat_GetName(TextureFormat format) {
+    if (format < 0 || format >= TEXTURE_FORMAT_COUNT) return "unknown";
+    return formatNames[format];
+}
+
+// Look up a format by name, TEXTURE_FORMAT_COUNT if unknown
+TextureFormat TextureFormat_GetByName(const char* name) {
+    for (int i = 0; name && i < TEXTURE_FORMAT_COUNT; ++i) {
+        if (strcmp(formatNames[i], name) == 0) return (TextureFormat)i;
+    }
+    return TEXTURE_FORMAT_COUNT;
+}
+
+// Size of one mip level
+static uint32_t MipDimension(uint32_t size, int level) {
+    uint32_t mip = size >> level;
+    return mip ? mip : 1;
+}
+
+// Check that a cooked texture is complete and well formed
+const CookedTextureHeader* CookedTexture_Validate(const void* data, size_t size) {
+    if (!data || size < sizeof(CookedTextureHeader)) return NULL;
+
+    const CookedTextureHeader* header = (const CookedTextureHeader*)data;
+    if (header->magic != COOKED_TEXTURE_MAGIC || header->version != COOKED_TEXTURE_VERSION ||
+        header->format >= TEXTURE_FORMAT_COUNT || header->width == 0 || header->height == 0 ||
+        header->mipCount == 0 || header->mipCount > COOKED_TEXTURE_MAX_MIPS ||
+        header->dataOffset < sizeof(CookedTextureHeader) || header->dataOffset > size ||
+        header->dataSize > size - header->dataOffset) {
+        return NULL;
+    }
+
+    int bytesPerPixel = TextureFormat_GetBytesPerPixel((TextureFormat)header->format);
+    for (uint32_t level = 0; level < header->mipCount; ++level) {
+        uint64_t levelSize = (uint64_t)MipDimension(header->width, level) * MipDimension(header->height, level) * bytesPerPixel;
+        if (header->mipOffsets[level] > header->dataSize || levelSize > header->dataSize - header->mipOffsets[level]) {
+            return NULL;
+        }
+    }
+    return header;
+}
+
+// Get the pixels of one mip level of a validated texture
+const void* CookedTexture_GetMip(const CookedTextureHeader* header, const void* data, int level, int* outWidth, int* outHeight) {
+    if (!header || !data || level < 0 || (uint32_t)level >= header->mipCount) return NULL;
+
+    if (outWidth) *outWidth = (int)MipDimension(header->width, level);
+    if (outHeight) *outHeight = (int)MipDimension(header->height, level);
+    return (const uint8_t*)data + header->dataOffset + header->mipOffsets[level];
+}
+
+// Check for a power of two
+static bool IsPowerOfTwo(int value) {
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+// Dreamcast twiddled index: x/y bits interleaved (y in the low bit), non-square textures are a run of square blocks
+static uint32_t TwiddleIndex(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    uint32_t size = width < height ? width : height;
+    uint32_t block = x / size + y / size;
+    uint32_t index = 0;
+
+    x %= size;
+    y %= size;
+    for (uint32_t bit = 0; (1u << bit) < size; ++bit) {
+        index |= ((y >> bit) & 1u) << (2 * bit);
+        index |= ((x >> bit) & 1u) << (2 * bit + 1);
+    }
+    return block * size * size + index;
+}
+
+// Pack one RGBA8888 texel into a 16-bit format
+static uint16_t PackTexel16(const uint8_t* texel, TextureFormat format) {
+    uint8_t r = texel[0], g = texel[1], b = texel[2], a = texel[3];
+
+    switch (format) {
+    case TEXTURE_FORMAT_RGB565:
+        return (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+    case TEXTURE_FORMAT_ARGB1555:
+        return (uint16_t)(((a >= 128) << 15) | ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3));
+    case TEXTURE_FORMAT_ARGB4444:
+    default:
+        return (uint16_t)(((a >> 4) << 12) | ((r >> 4) << 8) | ((g >> 4) << 4) | (b >> 4));
+    }
+}
+
+// Convert one RGBA8888 level into the target format and texel order
+static void ConvertLevel(const uint8_t* rgba, int width, int height, const TextureCookOptions* options, uint8_t* output) {
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const uint8_t* texel = rgba + ((size_t)y * width + x) * 4;
+            uint32_t index = options->twiddle ? TwiddleIndex(x, y, width, height) : (uint32_t)(y * width + x);
+
+            if (options->format == TEXTURE_FORMAT_RGBA8888) {
+                memcpy(output + (size_t)index * 4, texel, 4);
+            }
+            else {
+                uint16_t packed = PackTexel16(texel, options->format);
+                memcpy(output + (size_t)index * 2, &packed, 2);
+            }
+        }
+    }
+}
+
+// Box-filter one level down to the next
+static void DownsampleLevel(const uint8_t* source, int width, int height, uint8_t* destination) {
+    int mipWidth = width > 1 ? width / 2 : 1;
+    int mipHeight = height > 1 ? height / 2 : 1;
+
+    for (int y = 0; y < mipHeight; ++y) {
+        int y0 = y * 2 < height ? y * 2 : height - 1;
+        int y1 = y * 2 + 1 < height ? y * 2 + 1 : height - 1;
+        for (int x = 0; x < mipWidth; ++x) {
+            int x0 = x * 2 < width ? x * 2 : width - 1;
+            int x1 = x * 2 + 1 < width ? x * 2 + 1 : width - 1;
+            for (int channel = 0; channel < 4; ++channel) {
+                int sum = source[((size_t)y0 * width + x0) * 4 + channel] + source[((size_t)y0 * width + x1) * 4 + channel] +
+                    source[((size_t)y1 * width + x0) * 4 + channel] + source[((size_t)y1 * width + x1) * 4 + channel];
+                destination[((size_t)y * mipWidth + x) * 4 + channel] = (uint8_t)((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+// Cook RGBA8888 pixels into a cooked texture blob (caller frees *outData)
+bool TextureCooker_Cook(const uint8_t* rgba, int width, int height, const TextureCookOptions* options,
+    void** outData, size_t* outSize) {
+    if (!rgba || !options || !outData || !outSize || width <= 0 || height <= 0) return false;
+    if (options->format < 0 || options->format >= TEXTURE_FORMAT_COUNT) return false;
+
+    if (options->twiddle && (options->format == TEXTURE_FORMAT_RGBA8888 || !IsPowerOfTwo(width) || !IsPowerOfTwo(height))) {
+        printf("Twiddled textures must be 16-bit with power-of-two sizes.\n");
+        return false;
+    }
+    if (options->generateMips && (!IsPowerOfTwo(width) || !IsPowerOfTwo(height) || (options->twiddle && width != height))) {
+        printf("Mipmapped textures must have power-of-two sizes (and be square when twiddled).\n");
+        return false;
+    }
+
+    int mipCount = 1;
+    if (options->generateMips) {
+        while ((width >> mipCount) > 0 || (height >> mipCount) > 0) {
+            mipCount++;
+        }
+    }
+    if (mipCount > COOKED_TEXTURE_MAX_MIPS) {
+        printf("Texture too large to cook (%dx%d).\n", width, height);
+        return false;
+    }
+
+    CookedTextureHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = COOKED_TEXTURE_MAGIC;
+    header.version = COOKED_TEXTURE_VERSION;
+    header.format = (uint32_t)options->format;
+    header.flags = (options->twiddle ? COOKED_TEXTURE_TWIDDLED : 0) |
+        (options->twiddle && mipCount > 1 ? COOKED_TEXTURE_PVR_MIPMAPS : 0);
+    header.width = (uint32_t)width;
+    header.height = (uint32_t)height;
+    header.mipCount = (uint32_t)mipCount;
+    header.dataOffset = (sizeof(CookedTextureHeader) + COOKED_TEXTURE_ALIGNMENT - 1) & ~(uint32_t)(COOKED_TEXTURE_ALIGNMENT - 1);
+
+    // PVR mip chains run smallest first after a small pad; other layouts run largest first
+    int bytesPerPixel = TextureFormat_GetBytesPerPixel(options->format);
+    uint32_t offset = (header.flags & COOKED_TEXTURE_PVR_MIPMAPS) ? PVR_MIP_BASE_OFFSET_16BPP : 0;
+    for (int i = 0; i < mipCount; ++i) {
+        int level = (header.flags & COOKED_TEXTURE_PVR_MIPMAPS) ? mipCount - 1 - i : i;
+        header.mipOffsets[level] = offset;
+        offset += MipDimension(header.width, level) * MipDimension(header.height, level) * bytesPerPixel;
+    }
+    header.dataSize = offset;
+
+    size_t size = header.dataOffset + header.dataSize;
+    uint8_t* blob = (uint8_t*)calloc(1, size);
+    uint8_t* levelPixels = (uint8_t*)malloc((size_t)width * height * 4);
+    uint8_t* nextPixels = (uint8_t*)malloc((size_t)width * height * 4);
+    if (!blob || !levelPixels || !nextPixels) {
+        free(blob);
+        free(levelPixels);
+        free(nextPixels);
+        return false;
+    }
+
+    memcpy(blob, &header, sizeof(header));
+    memcpy(levelPixels, rgba, (size_t)width * height * 4);
+    for (int level = 0; level < mipCount; ++level) {
+        int levelWidth = (int)MipDimension(header.width, level);
+        int levelHeight = (int)MipDimension(header.height, level);
+        ConvertLevel(levelPixels, levelWidth, levelHeight, options, blob + header.dataOffset + header.mipOffsets[level]);
+
+        if (level + 1 < mipCount) {
+            DownsampleLevel(levelPixels, levelWidth, levelHeight, nextPixels);
+            uint8_t* swap = levelPixels;
+            levelPixels = nextPixels;
+            nextPixels = swap;
+        }
+    }
+
+    free(levelPixels);
+    free(nextPixels);
+    *outData = blob;
+    *outSize = size;
+    return true;
+}
+
+// Cook an image file (PNG/JPEG/...) into a cooked texture file
+bool TextureCooker_CookFile(const char* sourcePath, const char* outputPath, const TextureCookOptions* options) {
+#ifdef DREAMCAST
+    printf("The texture cooker is an offline tool and is not available on Dreamcast.\n");
+    return false;
+#else
+    if (!sourcePath || !outputPath || !options) return false;
+
+    SDL_Surface* source = IMG_Load(sourcePath);
+    if (!source) {
+        printf("Failed to load texture source: %s\n", sourcePath);
+        return false;
+    }
+
+    // ABGR8888 is R, G, B, A in memory on little-endian hosts
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_ABGR8888, 0);
+    SDL_FreeSurface(source);
+    if (!surface) {
+        printf("Failed to convert texture source: %s\n", sourcePath);
+        return false;
+    }
+
+    // Repack rows in case the surface pitch has padding
+    uint8_t* rgba = (uint8_t*)malloc((size_t)surface->w * surface->h * 4);
+    bool isCooked = false;
+    if (rgba) {
+        for (int y = 0; y < surface->h; ++y) {
+            memcpy(rgba + (size_t)y * surface->w * 4, (const uint8_t*)surface->pixels + (size_t)y * surface->pitch, (size_t)surface->w * 4);
+        }
+
+        void* data = NULL;
+        size_t size = 0;
+        isCooked = TextureCooker_Cook(rgba, surface->w, surface->h, options, &data, &size) &&
+            File_WriteBinary(outputPath, data, size);
+        if (isCooked) {
+            printf("Cooked %s -> %s (%dx%d %s%s%s, %zu bytes)\n", sourcePath, outputPath, surface->w, surface->h,
+                TextureFormat_GetName(options->format), options->generateMips ? ", mips" : "",
+                options->twiddle ? ", twiddled" : "", size);
+        }
+        free(data);
+        free(rgba);
+    }
+
+    SDL_FreeSurface(surface);
+    return isCooked;
+#endif
+}
@@ -1,32 +1,135 @@
 // time_utils.c
 #include "time_utils.h"
+#include <SDL2/SDL.h> // For the performance counter where there is no monotonic clock
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #ifdef _WIN32
 #include <windows.h>
+#elif defined(DREAMCAST)
+#include <arch/timer.h> // For the microsecond timer
+#include <unistd.h>
 #else
+#define TIME_UTILS_HAVE_CLOCK_GETTIME
 #include <unistd.h>
 #endif
 
-static clock_t startTime;
-static clock_t frameStartTime;
+#if defined(TIME_UTILS_HAVE_CLOCK_GETTIME) || defined(_WIN32)
+#define TIME_UTILS_HAVE_THREAD_CLOCK
+#endif
+
+#define TIMER_MIN_SPIN_MARGIN_NS 200000ull      // Spin at least the last 0.2 ms
+#define TIMER_MAX_SPIN_MARGIN_NS 4000000ull     // Coarse sleep timers (Windows) need more
+#define TIMER_DEFAULT_SPIN_MARGIN_NS 1000000ull
+#define TIMER_VSYNC_MARGIN_NS 500000ull         // Wake this long before the refresh to present in time
+
+static uint64_t startTime = 0;
+static uint64_t frameStartTime = 0;     // 0 until the first Timer_BeginFrame
+static uint64_t frameStartCPUTime = 0;
+static uint64_t frameEndTime = 0;       // Timer_EndFrame of the current frame, 0 if not reached
+static uint64_t frameGPUWait = 0;
+static uint64_t frameIdle = 0;
+static uint64_t gpuWaitStart = 0;
 static float deltaTime = 0.0f;
+static float rawDeltaTime = 0.0f;
+static float deltaSmoothing = TIMER_DEFAULT_SMOOTHING;
+static float maxDeltaTime = TIMER_DEFAULT_MAX_DELTA;
 static int targetFPS = 60;
 static float currentFPS = 0.0f;
+static FrameTiming lastFrame;
+
+// Pacing
+static TimerPacingMode pacingMode = TIMER_PACING_HYBRID;
+static uint64_t nextDeadline = 0;       // 0 to start a new cadence from the current frame
+static uint64_t spinMargin = TIMER_DEFAULT_SPIN_MARGIN_NS;
+static uint32_t missedDeadlines = 0;
+static uint32_t resyncs = 0;
+static int refreshRate = 0;
+static uint64_t frameHistory[TIMER_FRAME_HISTORY]; // Wall time per frame, ring buffer
+static int frameHistoryCount = 0;
+static int frameHistoryNext = 0;
+
+// Clocks
+
+// Read the monotonic clock in nanoseconds
+uint64_t Timer_GetTimeNs() {
+#if defined(TIME_UTILS_HAVE_CLOCK_GETTIME)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * TIMER_NS_PER_SECOND + (uint64_t)now.tv_nsec;
+#elif defined(DREAMCAST)
+    return timer_us_gettime64() * 1000;
+#else
+    // Split so counter * 1e9 cannot overflow
+    static Uint64 frequency = 0;
+    if (frequency == 0) frequency = SDL_GetPerformanceFrequency();
+    Uint64 counter = SDL_GetPerformanceCounter();
+    return (counter / frequency) * TIMER_NS_PER_SECOND + (counter % frequency) * TIMER_NS_PER_SECOND / frequency;
+#endif
+}
+
+// Read the CPU time the calling thread has used
+uint64_t Timer_GetThreadCPUTimeNs() {
+#if defined(TIME_UTILS_HAVE_CLOCK_GETTIME)
+    struct timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0) return 0;
+    return (uint64_t)now.tv_sec * TIMER_NS_PER_SECOND + (uint64_t)now.tv_nsec;
+#elif defined(_WIN32)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) return 0;
+    uint64_t kernel = ((uint64_t)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+    uint64_t user = ((uint64_t)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+    return (kernel + user) * 100; // 100 ns units
+#else
+    return 0;
+#endif
+}
+
+// Get the seconds elapsed since Timer_Start
+double Timer_GetElapsedSeconds() {
+    return (double)(Timer_GetTimeNs() - startTime) / (double)TIMER_NS_PER_SECOND;
+}
+
+// Timing Functions
 
 // Start the timer
 void Timer_Start() {
-    startTime = clock();
-    frameStartTime = clock();
+    startTime = Timer_GetTimeNs();
+    frameStartTime = 0;
+    frameEndTime = 0;
+    frameGPUWait = 0;
+    frameIdle = 0;
+    gpuWaitStart = 0;
     deltaTime = 0.0f;
+    rawDeltaTime = 0.0f;
     currentFPS = 0.0f;
+    memset(&lastFrame, 0, sizeof(lastFrame));
+    nextDeadline = 0;
+    missedDeadlines = 0;
+    resyncs = 0;
+    frameHistoryCount = 0;
+    frameHistoryNext = 0;
 }
 
-// Get the time elapsed since the last frame
+// Get the time elapsed over the last frame, smoothed and clamped
 float Timer_GetDeltaTime() {
     return deltaTime;
 }
 
+// Get the measured time of the last frame
+float Timer_GetRawDeltaTime() {
+    return rawDeltaTime;
+}
+
+// Set how strongly deltas are averaged and the longest delta reported
+void Timer_SetDeltaSmoothing(float smoothing, float maxDelta) {
+    if (smoothing < 0.0f) smoothing = 0.0f;
+    if (smoothing > 0.95f) smoothing = 0.95f;
+    deltaSmoothing = smoothing;
+    maxDeltaTime = maxDelta > 0.0f ? maxDelta : TIMER_DEFAULT_MAX_DELTA;
+}
+
 // Delay for a specified number of milliseconds
 void Timer_Delay(uint32_t milliseconds) {
 #ifdef _WIN32
@@ -36,34 +139,212 @@ void Timer_Delay(uint32_t milliseconds) {
 #endif
 }
 
-// Set the target frames per second
+// Sleep for about a duration; may oversleep by the OS timer slack
+static void SleepNs(uint64_t nanoseconds) {
+#if defined(TIME_UTILS_HAVE_CLOCK_GETTIME)
+    struct timespec duration = { (time_t)(nanoseconds / TIMER_NS_PER_SECOND), (long)(nanoseconds % TIMER_NS_PER_SECOND) };
+    nanosleep(&duration, NULL);
+#elif defined(_WIN32)
+    Sleep((DWORD)(nanoseconds / 1000000));
+#else
+    usleep((useconds_t)(nanoseconds / 1000));
+#endif
+}
+
+// Sleep until shortly before a deadline, then spin the rest against the clock
+void Timer_SleepUntil(uint64_t deadlineNs) {
+    uint64_t now = Timer_GetTimeNs();
+    if (now >= deadlineNs) return;
+
+    if (deadlineNs - now > spinMargin) {
+        uint64_t requested = deadlineNs - now - spinMargin;
+        SleepNs(requested);
+        uint64_t woke = Timer_GetTimeNs();
+
+        // Track the worst recent oversleep: grow at once, shrink slowly
+        uint64_t overslept = woke - now > requested ? woke - now - requested : 0;
+        uint64_t wanted = overslept + overslept / 4;
+        if (wanted > spinMargin) spinMargin = wanted;
+        else spinMargin -= (spinMargin - wanted) / 16;
+        if (spinMargin < TIMER_MIN_SPIN_MARGIN_NS) spinMargin = TIMER_MIN_SPIN_MARGIN_NS;
+        if (spinMargin > TIMER_MAX_SPIN_MARGIN_NS) spinMargin = TIMER_MAX_SPIN_MARGIN_NS;
+        now = woke;
+    }
+
+    while (now < deadlineNs) {
+        SDL_CPUPauseInstruction();
+        now = Timer_GetTimeNs();
+    }
+}
+
+// Frame Rate Control
+
+// Display refresh rate, 0 when SDL video is not running or does not know it
+static int QueryRefreshRate() {
+#ifdef DREAMCAST
+    return 60;
+#else
+    SDL_DisplayMode mode;
+    if (!SDL_WasInit(SDL_INIT_VIDEO) || SDL_GetCurrentDisplayMode(0, &mode) != 0) return 0;
+    return mode.refresh_rate;
+#endif
+}
+
+// Length of a paced frame (0 runs uncapped)
+static uint64_t GetFrameInterval() {
+    if (pacingMode == TIMER_PACING_VSYNC && refreshRate > 0) {
+        // Whole refreshes closest to the target rate, so frames present on a steady cadence
+        uint64_t refresh = TIMER_NS_PER_SECOND / (uint64_t)refreshRate;
+        int refreshes = targetFPS > 0 ? (refreshRate + targetFPS / 2) / targetFPS : 1;
+        return refresh * (uint64_t)(refreshes > 0 ? refreshes : 1);
+    }
+    return targetFPS > 0 ? TIMER_NS_PER_SECOND / (uint64_t)targetFPS : 0;
+}
+
+// Set how Timer_EndFrame waits out the frame
+void Timer_SetPacingMode(TimerPacingMode mode) {
+    pacingMode = mode;
+    refreshRate = mode == TIMER_PACING_VSYNC ? QueryRefreshRate() : 0;
+    if (mode == TIMER_PACING_VSYNC && refreshRate == 0) {
+        printf("Display refresh rate unknown; frame pacing falls back to the target FPS.\n");
+    }
+    nextDeadline = 0;
+}
+
+// Get the current pacing mode
+TimerPacingMode Timer_GetPacingMode() {
+    return pacingMode;
+}
+
+
+// Set the target frames per second (0 or less runs uncapped)
 void Timer_SetTargetFPS(int fps) {
     targetFPS = fps;
+    nextDeadline = 0;
 }
 
-// Begin tracking a frame
+// Close the previous frame's accounting and start a new frame
 void Timer_BeginFrame() {
-    frameStartTime = clock();
+    uint64_t now = Timer_GetTimeNs();
+    uint64_t cpuNow = Timer_GetThreadCPUTimeNs();
+
+    if (frameStartTime != 0) {
+        uint64_t wall = now - frameStartTime;
+        uint64_t work = frameEndTime != 0 ? frameEndTime - frameStartTime : wall - frameIdle;
+
+        lastFrame.frameIndex++;
+        lastFrame.wallNs = wall;
+        lastFrame.workNs = work;
+        lastFrame.gpuWaitNs = frameGPUWait;
+        lastFrame.idleNs = frameIdle;
+#ifdef TIME_UTILS_HAVE_THREAD_CLOCK
+        lastFrame.cpuNs = cpuNow - frameStartCPUTime;
+#else
+        lastFrame.cpuNs = work > frameGPUWait ? work - frameGPUWait : 0;
+#endif
+
+        rawDeltaTime = (float)((double)wall / (double)TIMER_NS_PER_SECOND);
+        float clamped = rawDeltaTime < maxDeltaTime ? rawDeltaTime : maxDeltaTime;
+        deltaTime = deltaTime <= 0.0f ? clamped : deltaTime * deltaSmoothing + clamped * (1.0f - deltaSmoothing);
+        currentFPS = rawDeltaTime > 0.0f ? 1.0f / rawDeltaTime : 0.0f;
+
+        lastFrame.rawDelta = rawDeltaTime;
+        lastFrame.smoothedDelta = deltaTime;
+
+        frameHistory[frameHistoryNext] = wall;
+        frameHistoryNext = (frameHistoryNext + 1) % TIMER_FRAME_HISTORY;
+        if (frameHistoryCount < TIMER_FRAME_HISTORY) frameHistoryCount++;
+    }
+
+    frameStartTime = now;
+    frameStartCPUTime = cpuNow;
+    frameEndTime = 0;
+    frameGPUWait = 0;
+    frameIdle = 0;
 }
 
-// End tracking a frame and apply frame rate control
+// End the frame's work and wait for its deadline
 void Timer_EndFrame() {
-    clock_t frameEndTime = clock();
-    deltaTime = (float)(frameEndTime - frameStartTime) / CLOCKS_PER_SEC;
+    if (frameStartTime == 0) return;
+    frameEndTime = Timer_GetTimeNs();
 
-    // Calculate current FPS
-    if (deltaTime > 0.0f) {
-        currentFPS = 1.0f / deltaTime;
+    uint64_t interval = GetFrameInterval();
+    if (interval == 0) return;
+    if (nextDeadline == 0) nextDeadline = frameStartTime + interval;
+
+    if (frameEndTime > nextDeadline) {
+        // A little late is made up next frame; a whole frame behind starts a new cadence
+        missedDeadlines++;
+        if (frameEndTime - nextDeadline > interval) {
+            nextDeadline = frameEndTime;
+            resyncs++;
+        }
     }
+    else {
+        // VSYNC wakes early enough to make the refresh; the present then blocks until it
+        uint64_t wake = nextDeadline;
+        if (pacingMode == TIMER_PACING_VSYNC && refreshRate > 0 && wake - frameEndTime > TIMER_VSYNC_MARGIN_NS) {
+            wake -= TIMER_VSYNC_MARGIN_NS;
+        }
 
-    // Frame rate control
-    float targetFrameTime = 1.0f / targetFPS;
-    if (deltaTime < targetFrameTime) {
-        Timer_Delay((uint32_t)((targetFrameTime - deltaTime) * 1000));
+        if (pacingMode == TIMER_PACING_SLEEP) SleepNs(wake - frameEndTime);
+        else Timer_SleepUntil(wake);
+        frameIdle += Timer_GetTimeNs() - frameEndTime;
     }
+    nextDeadline += interval;
 }
 
 // Get the current frames per second
 float Timer_GetCurrentFPS() {
     return currentFPS;
 }
+
+static int CompareFrameTimes(const void* a, const void* b) {
+    uint64_t left = *(const uint64_t*)a;
+    uint64_t right = *(const uint64_t*)b;
+    return (left > right) - (left < right);
+}
+
+// Summarize recent frame times
+FramePacingStats Timer_GetPacingStats() {
+    FramePacingStats stats = { 0 };
+    stats.missedDeadlines = missedDeadlines;
+    stats.resyncs = resyncs;
+    stats.spinMarginUs = (double)spinMargin / 1000.0;
+    stats.refreshRate = refreshRate;
+    stats.frames = frameHistoryCount;
+    if (frameHistoryCount == 0) return stats;
+
+    uint64_t sorted[TIMER_FRAME_HISTORY];
+    memcpy(sorted, frameHistory, sizeof(uint64_t) * frameHistoryCount);
+    qsort(sorted, frameHistoryCount, sizeof(uint64_t), CompareFrameTimes);
+
+    uint64_t total = 0;
+    for (int i = 0; i < frameHistoryCount; ++i) total += sorted[i];
+    int p99 = (frameHistoryCount * 99 + 99) / 100 - 1; // Nearest rank
+    stats.meanMs = (double)total / frameHistoryCount / 1e6;
+    stats.p50Ms = (double)sorted[(frameHistoryCount - 1) / 2] / 1e6;
+    stats.p99Ms = (double)sorted[p99] / 1e6;
+    stats.minMs = (double)sorted[0] / 1e6;
+    stats.maxMs = (double)sorted[frameHistoryCount - 1] / 1e6;
+    return stats;
+}
+
+// Frame Accounting
+
+// Mark the start of a wait on the GPU (present, vsync, fences)
+void Timer_BeginGPUWait() {
+    gpuWaitStart = Timer_GetTimeNs();
+}
+
+// Add the wait since Timer_BeginGPUWait to the current frame
+void Timer_EndGPUWait() {
+    if (gpuWaitStart == 0) return;
+    frameGPUWait += Timer_GetTimeNs() - gpuWaitStart;
+    gpuWaitStart = 0;
+}
+
+// Get the accounting of the last completed frame
+FrameTiming Timer_GetFrameTiming() {
+    return lastFrame;
+}
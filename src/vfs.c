@@ -0,0 +1,542 @@
+// vfs.c
+#include "vfs.h"
+#include "hash_utils.h"
+#include <SDL2/SDL.h> // For the mount and cache locks
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef DREAMCAST
+#include <kos.h>
+#else
+#include <sys/stat.h> // For probing directory mounts
+#endif
+
+#define VFS_CACHE_CAPACITY 4096 // Cached paths before the cache starts over
+
+typedef struct {
+    VfsMountID id;
+    VfsMountType type;
+    int priority;
+    bool isWritable;
+    char mountPoint[VFS_MAX_PATH]; // Normalized, "" for the root
+    size_t mountPointLength;
+    char* directory;             // Directory mounts
+    PackArchive* pack;           // Pack mounts
+    int references;              // Vfs_RetainMount calls not yet released; blocks unmounting
+} VfsMount;
+
+typedef struct {
+    char* path;                  // Key, exactly as looked up
+    char* normalized;            // For invalidation by any spelling of the path
+    uint32_t hash;
+    VfsMountID mount;
+    const PackArchive* pack;
+    const PackEntry* entry;
+    char* hostPath;              // NULL when the path itself is the host path
+} VfsCacheEntry;
+
+static VfsMount mounts[VFS_MAX_MOUNTS]; // Highest priority first (mountLock held)
+static int mountCount = 0;
+static VfsMountID nextMountID = 1;
+static SDL_mutex* mountLock = NULL;     // Created by the first mount and kept, as resolvers may hold it
+static SDL_atomic_t hasMounts;          // mountCount > 0, for the lock-free unmounted path
+
+static SDL_SpinLock cacheLock = 0;
+static VfsCacheEntry* cacheEntries = NULL;
+static int cacheCount = 0;
+static uint32_t cacheGeneration = 0;    // Bumped by every invalidation (cacheLock held)
+static HashIndex cacheIndex = { 0 };
+static VfsStats vfsStats;
+
+// Path Helpers
+
+// Normalize a path: forward slashes, no empty or "." segments, ".." folded into its parent
+bool Vfs_NormalizePath(const char* path, char* normalized, size_t size) {
+    if (!path || !normalized || size == 0) return false;
+
+    bool isAbsolute = path[0] == '/' || path[0] == '\\';
+    size_t base = isAbsolute ? 1 : 0;
+    size_t length = 0;
+    if (isAbsolute) {
+        if (size < 2) return false;
+        normalized[length++] = '/';
+    }
+
+    const char* cursor = path;
+    while (*cursor) {
+        while (*cursor == '/' || *cursor == '\\') cursor++;
+        const char* start = cursor;
+        while (*cursor && *cursor != '/' && *cursor != '\\') cursor++;
+        size_t segmentLength = (size_t)(cursor - start);
+        if (segmentLength == 0 || (segmentLength == 1 && start[0] == '.')) continue;
+
+        if (segmentLength == 2 && start[0] == '.' && start[1] == '.') {
+            // Drop the previous segment unless it is a ".." that could not be folded itself
+            size_t lastStart = length;
+            while (lastStart > base && normalized[lastStart - 1] != '/') lastStart--;
+            bool isParent = length - lastStart == 2 && normalized[lastStart] == '.' && normalized[lastStart + 1] == '.';
+            if (length > base && !isParent) {
+                length = lastStart > base ? lastStart - 1 : base;
+                continue;
+            }
+            if (isAbsolute) continue; // Nothing above the root
+        }
+
+        if (length > base) {
+            if (length + 1 >= size) return false;
+            normalized[length++] = '/';
+        }
+        if (length + segmentLength >= size) return false;
+        memcpy(normalized + length, start, segmentLength);
+        length += segmentLength;
+    }
+
+    normalized[length] = '\0';
+    return length > 0;
+}
+
+// Host paths outside the virtual tree ("/abs/path", "C:/path", "../path") are never mounted
+static bool IsHostAbsolute(const char* normalized) {
+    if (normalized[0] == '.' && normalized[1] == '.' && (normalized[2] == '/' || normalized[2] == '\0')) return true;
+    return normalized[0] == '/' || (normalized[0] != '\0' && normalized[1] == ':');
+}
+
+// Path relative to a mount point, or NULL if the mount does not cover it
+static const char* GetRelativePath(const VfsMount* mount, const char* normalized) {
+    if (mount->mountPointLength == 0) return normalized;
+    if (strncmp(normalized, mount->mountPoint, mount->mountPointLength) != 0) return NULL;
+    if (normalized[mount->mountPointLength] != '/') return NULL;
+    return normalized + mount->mountPointLength + 1;
+}
+
+// Check for a regular file on the host
+static bool IsHostFile(const char* hostPath) {
+#ifdef DREAMCAST
+    file_t file = fs_open(hostPath, O_RDONLY);
+    if (file == FILEHND_INVALID) return false;
+    fs_close(file);
+    return true;
+#else
+    struct stat info;
+    return stat(hostPath, &info) == 0 && (info.st_mode & S_IFMT) == S_IFREG;
+#endif
+}
+
+// Cache (cacheLock held)
+
+// Find a cached resolution of exactly this path
+static int FindCached(const char* path, uint32_t hash) {
+    int cursor = 0;
+    for (int32_t index = HashIndex_FindFirst(&cacheIndex, hash, &cursor); index >= 0;
+        index = HashIndex_FindNext(&cacheIndex, hash, &cursor)) {
+        if (strcmp(cacheEntries[index].path, path) == 0) return index;
+    }
+    return -1;
+}
+
+// Free one cache entry's strings
+static void FreeCacheEntry(VfsCacheEntry* entry) {
+    free(entry->path);
+    free(entry->normalized);
+    free(entry->hostPath);
+}
+
+// Drop every cached resolution
+static void ClearCache() {
+    for (int i = 0; i < cacheCount; ++i) {
+        FreeCacheEntry(&cacheEntries[i]);
+    }
+    cacheCount = 0;
+    HashIndex_Clear(&cacheIndex);
+    cacheGeneration++;
+}
+
+// Remove one entry, moving the last entry into its place
+static void RemoveCached(int index) {
+    VfsCacheEntry* entry = &cacheEntries[index];
+    HashIndex_Remove(&cacheIndex, entry->hash, index);
+    FreeCacheEntry(entry);
+
+    int last = --cacheCount;
+    if (index != last) {
+        cacheEntries[index] = cacheEntries[last];
+        HashIndex_Replace(&cacheIndex, cacheEntries[index].hash, last, index);
+    }
+}
+
+// Remember a resolution (a full cache starts over rather than tracking recency)
+static void InsertCached(const char* path, const char* normalized, uint32_t hash, const VfsResolution* resolution) {
+    if (!cacheEntries) {
+        cacheEntries = (VfsCacheEntry*)malloc(sizeof(VfsCacheEntry) * VFS_CACHE_CAPACITY);
+        if (!cacheEntries || !HashIndex_Init(&cacheIndex, VFS_CACHE_CAPACITY)) {
+            free(cacheEntries);
+            cacheEntries = NULL;
+            return;
+        }
+    }
+    if (cacheCount >= VFS_CACHE_CAPACITY) ClearCache();
+
+    VfsCacheEntry entry;
+    entry.path = strdup(path);
+    entry.normalized = strdup(normalized);
+    entry.hash = hash;
+    entry.mount = resolution->mount;
+    entry.pack = resolution->pack;
+    entry.entry = resolution->entry;
+    entry.hostPath = strcmp(resolution->hostPath, path) != 0 ? strdup(resolution->hostPath) : NULL;
+    if (!entry.path || !entry.normalized || (!entry.hostPath && strcmp(resolution->hostPath, path) != 0)) {
+        FreeCacheEntry(&entry);
+        return;
+    }
+
+    if (!HashIndex_Insert(&cacheIndex, hash, cacheCount)) {
+        FreeCacheEntry(&entry);
+        return;
+    }
+    cacheEntries[cacheCount++] = entry;
+}
+
+// Resolution
+
+// Walk the mounts for a path (mountLock held)
+static void ResolveUncached(const char* path, char* normalized, VfsResolution* resolution, uint32_t* probes) {
+    memset(resolution, 0, sizeof(VfsResolution));
+    strcpy(resolution->hostPath, path);
+    if (!Vfs_NormalizePath(path, normalized, VFS_MAX_PATH)) {
+        strcpy(normalized, path);
+        return;
+    }
+    if (IsHostAbsolute(normalized)) return;
+
+    for (int i = 0; i < mountCount; ++i) {
+        const VfsMount* mount = &mounts[i];
+        const char* relative = GetRelativePath(mount, normalized);
+        if (!relative) continue;
+
+        if (mount->type == VFS_MOUNT_PACK) {
+            const PackEntry* entry = PackArchive_Find(mount->pack, relative);
+            if (entry) {
+                resolution->mount = mount->id;
+                resolution->pack = mount->pack;
+                resolution->entry = entry;
+                return;
+            }
+            continue;
+        }
+
+        char hostPath[VFS_MAX_PATH];
+        if (snprintf(hostPath, sizeof(hostPath), "%s/%s", mount->directory, relative) >= (int)sizeof(hostPath)) continue;
+        (*probes)++;
+        if (IsHostFile(hostPath)) {
+            resolution->mount = mount->id;
+            strcpy(resolution->hostPath, hostPath);
+            return;
+        }
+    }
+}
+
+// Find where a path lives: a pack entry, a file in a mounted directory, or the host path itself
+bool Vfs_Resolve(const char* path, VfsResolution* resolution) {
+    if (!path || !resolution) return false;
+    size_t length = strlen(path);
+    if (length == 0 || length >= VFS_MAX_PATH) return false;
+
+    // Nothing mounted: every path is a host path
+    if (!SDL_AtomicGet(&hasMounts)) {
+        resolution->mount = VFS_MOUNT_NONE;
+        resolution->pack = NULL;
+        resolution->entry = NULL;
+        memcpy(resolution->hostPath, path, length + 1);
+        return true;
+    }
+
+    uint32_t hash = Hash_String(path);
+    SDL_AtomicLock(&cacheLock);
+    vfsStats.lookups++;
+    int index = FindCached(path, hash);
+    if (index >= 0) {
+        const VfsCacheEntry* entry = &cacheEntries[index];
+        resolution->mount = entry->mount;
+        resolution->pack = entry->pack;
+        resolution->entry = entry->entry;
+        strcpy(resolution->hostPath, entry->hostPath ? entry->hostPath : path);
+        vfsStats.cacheHits++;
+        SDL_AtomicUnlock(&cacheLock);
+        return true;
+    }
+    uint32_t generation = cacheGeneration;
+    SDL_AtomicUnlock(&cacheLock);
+
+    // Probing directories can block, so this holds the mount lock rather than the cache spin lock
+    char normalized[VFS_MAX_PATH];
+    uint32_t probes = 0;
+    SDL_LockMutex(mountLock);
+    ResolveUncached(path, normalized, resolution, &probes);
+    SDL_UnlockMutex(mountLock);
+
+    // An invalidation or mount change since the lookup may have made this answer stale: use it
+    // once, but do not cache it
+    SDL_AtomicLock(&cacheLock);
+    vfsStats.hostProbes += probes;
+    if (generation == cacheGeneration && FindCached(path, hash) < 0) InsertCached(path, normalized, hash, resolution);
+    SDL_AtomicUnlock(&cacheLock);
+    return true;
+}
+
+// Find a mount by ID (mountLock held)
+static VfsMount* FindMount(VfsMountID mount) {
+    for (int i = 0; i < mountCount; ++i) {
+        if (mounts[i].id == mount) return &mounts[i];
+    }
+    return NULL;
+}
+
+// Keep a mount from being unmounted; false if it is gone
+bool Vfs_RetainMount(VfsMountID mount) {
+    if (mount == VFS_MOUNT_NONE || !mountLock) return false;
+
+    SDL_LockMutex(mountLock);
+    VfsMount* found = FindMount(mount);
+    if (found) found->references++;
+    SDL_UnlockMutex(mountLock);
+    return found != NULL;
+}
+
+// Release a Vfs_RetainMount reference
+void Vfs_ReleaseMount(VfsMountID mount) {
+    if (mount == VFS_MOUNT_NONE || !mountLock) return;
+
+    SDL_LockMutex(mountLock);
+    VfsMount* found = FindMount(mount);
+    if (found && found->references > 0) found->references--;
+    SDL_UnlockMutex(mountLock);
+}
+
+// Resolve a path, keeping the pack behind a pack entry mounted until Vfs_ReleaseResolution
+bool Vfs_ResolveRetained(const char* path, VfsResolution* resolution) {
+    for (int attempt = 0; attempt <= VFS_MAX_MOUNTS; ++attempt) {
+        if (!Vfs_Resolve(path, resolution)) return false;
+        if (!resolution->entry || Vfs_RetainMount(resolution->mount)) return true;
+        // Unmounted since it was resolved; the unmount cleared the cache, so look again
+    }
+    return false;
+}
+
+// Release what Vfs_ResolveRetained retained
+void Vfs_ReleaseResolution(const VfsResolution* resolution) {
+    if (resolution && resolution->entry) Vfs_ReleaseMount(resolution->mount);
+}
+
+// Host path a write should go to: the highest-priority writable directory mount covering it
+bool Vfs_GetWritePath(const char* path, char* hostPath, size_t size) {
+    if (!path || !hostPath || size == 0) return false;
+
+    char normalized[VFS_MAX_PATH];
+    if (SDL_AtomicGet(&hasMounts) && Vfs_NormalizePath(path, normalized, sizeof(normalized)) && !IsHostAbsolute(normalized)) {
+        SDL_LockMutex(mountLock);
+        for (int i = 0; i < mountCount; ++i) {
+            const VfsMount* mount = &mounts[i];
+            if (!mount->isWritable) continue;
+            const char* relative = GetRelativePath(mount, normalized);
+            if (relative) {
+                bool isWritten = snprintf(hostPath, size, "%s/%s", mount->directory, relative) < (int)size;
+                SDL_UnlockMutex(mountLock);
+                return isWritten;
+            }
+        }
+        SDL_UnlockMutex(mountLock);
+    }
+
+    size_t length = strlen(path);
+    if (length >= size) return false;
+    memcpy(hostPath, path, length + 1);
+    return true;
+}
+
+// Forget cached resolutions of a path, however it was spelled
+void Vfs_Invalidate(const char* path) {
+    if (!path) return;
+    char normalized[VFS_MAX_PATH];
+    if (!Vfs_NormalizePath(path, normalized, sizeof(normalized))) return;
+
+    SDL_AtomicLock(&cacheLock);
+    for (int i = cacheCount - 1; i >= 0; --i) {
+        if (strcmp(cacheEntries[i].normalized, normalized) == 0) RemoveCached(i);
+    }
+    cacheGeneration++; // Resolutions in progress may predate the change
+    SDL_AtomicUnlock(&cacheLock);
+}
+
+// Forget every cached resolution
+void Vfs_InvalidateAll() {
+    SDL_AtomicLock(&cacheLock);
+    ClearCache();
+    SDL_AtomicUnlock(&cacheLock);
+}
+
+// Mounting
+
+// Insert a mount in priority order and drop resolutions it may change
+static VfsMountID AddMount(VfsMount* mount, const char* mountPoint, int priority) {
+    if (!mountLock) {
+        mountLock = SDL_CreateMutex();
+        if (!mountLock) {
+            printf("Failed to create VFS lock: %s\n", SDL_GetError());
+            PackArchive_Close(mount->pack);
+            free(mount->directory);
+            return VFS_MOUNT_NONE;
+        }
+    }
+
+    if (!Vfs_NormalizePath(mountPoint, mount->mountPoint, sizeof(mount->mountPoint))) {
+        mount->mountPoint[0] = '\0'; // "" and "." mount at the root
+    }
+    mount->mountPointLength = strlen(mount->mountPoint);
+    mount->priority = priority;
+
+    SDL_LockMutex(mountLock);
+    mount->id = nextMountID++;
+
+    // Ahead of existing mounts with the same priority, so the newest wins ties
+    int position = 0;
+    while (position < mountCount && mounts[position].priority > priority) position++;
+    memmove(&mounts[position + 1], &mounts[position], sizeof(VfsMount) * (size_t)(mountCount - position));
+    mounts[position] = *mount;
+    mountCount++;
+    SDL_AtomicSet(&hasMounts, 1);
+
+    Vfs_InvalidateAll();
+    SDL_UnlockMutex(mountLock);
+    return mount->id;
+}
+
+// Mount a pack archive
+VfsMountID Vfs_MountPack(const char* packPath, const char* mountPoint, int priority) {
+    if (!packPath) return VFS_MOUNT_NONE;
+    if (mountCount >= VFS_MAX_MOUNTS) {
+        printf("Too many mounts (%d).\n", VFS_MAX_MOUNTS);
+        return VFS_MOUNT_NONE;
+    }
+
+    VfsMount mount;
+    memset(&mount, 0, sizeof(mount));
+    mount.type = VFS_MOUNT_PACK;
+    mount.pack = PackArchive_Open(packPath);
+    if (!mount.pack) return VFS_MOUNT_NONE;
+    return AddMount(&mount, mountPoint ? mountPoint : "", priority);
+}
+
+// Mount a host directory (writable mounts receive File_Write* calls for paths they cover)
+VfsMountID Vfs_MountDirectory(const char* directory, const char* mountPoint, int priority, bool isWritable) {
+    if (!directory || directory[0] == '\0') return VFS_MOUNT_NONE;
+    if (mountCount >= VFS_MAX_MOUNTS) {
+        printf("Too many mounts (%d).\n", VFS_MAX_MOUNTS);
+        return VFS_MOUNT_NONE;
+    }
+
+    VfsMount mount;
+    memset(&mount, 0, sizeof(mount));
+    mount.type = VFS_MOUNT_DIRECTORY;
+    mount.isWritable = isWritable;
+    mount.directory = strdup(directory);
+    if (!mount.directory) return VFS_MOUNT_NONE;
+
+    size_t length = strlen(mount.directory);
+    while (length > 1 && (mount.directory[length - 1] == '/' || mount.directory[length - 1] == '\\')) {
+        mount.directory[--length] = '\0';
+    }
+    return AddMount(&mount, mountPoint ? mountPoint : "", priority);
+}
+
+// Remove a mount, closing its pack; refused while the mount is retained
+bool Vfs_Unmount(VfsMountID mount) {
+    if (!mountLock) return false;
+
+    SDL_LockMutex(mountLock);
+    for (int i = 0; i < mountCount; ++i) {
+        if (mounts[i].id != mount) continue;
+
+        if (mounts[i].references > 0) {
+            printf("Cannot unmount mount %d: %d references still in use.\n", mount, mounts[i].references);
+            SDL_UnlockMutex(mountLock);
+            return false;
+        }
+
+        PackArchive_Close(mounts[i].pack);
+        free(mounts[i].directory);
+        memmove(&mounts[i], &mounts[i + 1], sizeof(VfsMount) * (size_t)(mountCount - i - 1));
+        mountCount--;
+        SDL_AtomicSet(&hasMounts, mountCount > 0);
+
+        // Before the lock is released, so a failed Vfs_RetainMount always resolves afresh
+        Vfs_InvalidateAll();
+        SDL_UnlockMutex(mountLock);
+        return true;
+    }
+    SDL_UnlockMutex(mountLock);
+    return false;
+}
+
+// Remove every mount that is not retained; the cache is released once none are left
+void Vfs_UnmountAll() {
+    if (!mountLock) return;
+
+    SDL_LockMutex(mountLock);
+    for (int i = mountCount - 1; i >= 0; --i) {
+        Vfs_Unmount(mounts[i].id);
+    }
+    bool isEmpty = mountCount == 0;
+    SDL_UnlockMutex(mountLock);
+    if (!isEmpty) return;
+
+    SDL_AtomicLock(&cacheLock);
+    ClearCache();
+    free(cacheEntries);
+    cacheEntries = NULL;
+    HashIndex_Free(&cacheIndex);
+    SDL_AtomicUnlock(&cacheLock);
+}
+
+// Get the archive behind a pack mount
+PackArchive* Vfs_GetPack(VfsMountID mount) {
+    if (!mountLock) return NULL;
+
+    SDL_LockMutex(mountLock);
+    VfsMount* found = FindMount(mount);
+    PackArchive* pack = found ? found->pack : NULL;
+    SDL_UnlockMutex(mountLock);
+    return pack;
+}
+
+// Find the mount serving an archive
+VfsMountID Vfs_FindPackMount(const PackArchive* pack) {
+    if (!mountLock) return VFS_MOUNT_NONE;
+
+    VfsMountID found = VFS_MOUNT_NONE;
+    SDL_LockMutex(mountLock);
+    for (int i = 0; i < mountCount; ++i) {
+        if (mounts[i].type == VFS_MOUNT_PACK && (!pack || mounts[i].pack == pack)) {
+            found = mounts[i].id;
+            break;
+        }
+    }
+    SDL_UnlockMutex(mountLock);
+    return found;
+}
+
+// Get lookup and cache statistics
+VfsStats Vfs_GetStats() {
+    SDL_AtomicLock(&cacheLock);
+    VfsStats stats = vfsStats;
+    stats.cachedPaths = cacheCount;
+    SDL_AtomicUnlock(&cacheLock);
+
+    stats.mountCount = 0;
+    if (mountLock) {
+        SDL_LockMutex(mountLock);
+        stats.mountCount = mountCount;
+        SDL_UnlockMutex(mountLock);
+    }
+    return stats;
+}
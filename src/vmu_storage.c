@@ -0,0 +1,644 @@
+// vmu_storage.c
+#include "vmu_storage.h"
+#include "hash_utils.h" // For block checksums
+#include "lzss.h" // For compressing containers
+#include <SDL2/SDL.h> // For the device lock
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef DREAMCAST
+#include <dc/maple.h>     // For finding memory cards
+#include <dc/maple/vmu.h> // For raw block access
+#endif
+
+// Root Block Layout
+#define VMU_ROOT_BLOCK 255
+#define VMU_ROOT_FORMAT_MAGIC 0x55      // Bytes 0x00-0x0F of a formatted card
+#define VMU_ROOT_FAT_LOCATION 0x46
+#define VMU_ROOT_FAT_SIZE 0x48
+#define VMU_ROOT_DIRECTORY_LOCATION 0x4A
+#define VMU_ROOT_DIRECTORY_SIZE 0x4C
+#define VMU_ROOT_USER_BLOCKS 0x50
+#define VMU_DEFAULT_DIRECTORY_BLOCKS 13
+
+// FAT Entries
+#define VMU_FAT_FREE 0xFFFC
+#define VMU_FAT_END 0xFFFA
+
+// Directory Entries (32 bytes each)
+#define VMU_DIRECTORY_ENTRY_SIZE 32
+#define VMU_FILE_TYPE_NONE 0x00
+#define VMU_FILE_TYPE_DATA 0x33
+
+// VMS Header (start of every data file, so the BIOS file manager can list it)
+#define VMU_VMS_DESCRIPTION 0x00        // 16 bytes shown on the VMU, space padded
+#define VMU_VMS_BOOT_DESCRIPTION 0x10   // 32 bytes shown in the boot ROM, space padded
+#define VMU_VMS_APP_ID 0x30             // 16 bytes, NUL padded
+#define VMU_VMS_ICON_COUNT 0x40
+#define VMU_VMS_ICON_SPEED 0x42
+#define VMU_VMS_EYECATCH 0x44
+#define VMU_VMS_CRC 0x46
+#define VMU_VMS_DATA_SIZE 0x48          // Bytes that follow the header and icons
+#define VMU_VMS_PALETTE 0x60            // 16 ARGB4444 colors
+#define VMU_VMS_ICON 0x80               // One 32x32 4bpp icon, left blank (palette entry 0 is transparent)
+#define VMU_VMS_HEADER_SIZE (VMU_VMS_ICON + 512)
+#define VMU_VMS_APP_NAME "ProjectZDK"
+
+#define VMU_CONTAINER_MAGIC 0x434D565A // "ZVMC"
+#define VMU_CONTAINER_VERSION 1
+#define VMU_CONTAINER_COMPRESSED 0x0001
+
+typedef struct {
+    uint8_t type;              // VMU_FILE_TYPE_*
+    uint8_t copyProtect;
+    uint16_t firstBlock;
+    char name[VMU_MAX_FILE_NAME]; // NUL-padded, not terminated when 12 characters long
+    uint8_t timestamp[8];      // BCD: century, year, month, day, hour, minute, second, weekday
+    uint16_t sizeInBlocks;
+    uint16_t headerOffset;     // Block of the VMS header within the file
+    uint8_t unused[4];
+} VmuDirectoryEntry;
+
+// Header at the start of a container's payload
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;            // VMU_CONTAINER_*
+    uint32_t size;             // Bytes after unpacking
+    uint32_t storedSize;       // Bytes that follow this header
+} VmuContainerHeader;
+
+struct VmuDevice {
+    FILE* image;               // Emulation backend
+#ifdef DREAMCAST
+    maple_device_t* maple;     // Hardware backend
+#endif
+    SDL_mutex* mutex;
+
+    uint16_t fat[VMU_TOTAL_BLOCKS];
+    uint8_t* directory;        // All directory blocks, in on-card order (first block is the highest)
+    int fatBlock;
+    int directoryBlock;
+    int directoryBlocks;
+    int userBlocks;
+};
+
+// Read one block from the card
+static bool ReadBlock(VmuDevice* device, int block, void* buffer) {
+    if (device->image) {
+        return fseek(device->image, (long)block * VMU_BLOCK_SIZE, SEEK_SET) == 0
+            && fread(buffer, 1, VMU_BLOCK_SIZE, device->image) == VMU_BLOCK_SIZE;
+    }
+#ifdef DREAMCAST
+    return vmu_block_read(device->maple, (uint16_t)block, (uint8_t*)buffer) == MAPLE_EOK;
+#else
+    return false;
+#endif
+}
+
+// Write one block to the card
+static bool WriteBlock(VmuDevice* device, int block, const void* buffer) {
+    if (device->image) {
+        return fseek(device->image, (long)block * VMU_BLOCK_SIZE, SEEK_SET) == 0
+            && fwrite(buffer, 1, VMU_BLOCK_SIZE, device->image) == VMU_BLOCK_SIZE
+            && fflush(device->image) == 0;
+    }
+#ifdef DREAMCAST
+    return vmu_block_write(device->maple, (uint16_t)block, (const uint8_t*)buffer) == MAPLE_EOK;
+#else
+    return false;
+#endif
+}
+
+static uint16_t ReadU16(const uint8_t* bytes) {
+    return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+static void WriteU16(uint8_t* bytes, uint16_t value) {
+    bytes[0] = (uint8_t)value;
+    bytes[1] = (uint8_t)(value >> 8);
+}
+
+static uint32_t ReadU32(const uint8_t* bytes) {
+    return (uint32_t)ReadU16(bytes) | ((uint32_t)ReadU16(bytes + 2) << 16);
+}
+
+static void WriteU32(uint8_t* bytes, uint32_t value) {
+    WriteU16(bytes, (uint16_t)value);
+    WriteU16(bytes + 2, (uint16_t)(value >> 16));
+}
+
+// CRC-16/CCITT over a whole file, computed with the header's CRC field zeroed
+static uint16_t VmsCrc(const uint8_t* bytes, size_t size) {
+    uint32_t crc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        uint8_t byte = i == VMU_VMS_CRC || i == VMU_VMS_CRC + 1 ? 0 : bytes[i];
+        crc ^= (uint32_t)byte << 8;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return (uint16_t)crc;
+}
+
+// Copy text into a fixed header field, padding the rest
+static void WriteVmsText(uint8_t* field, size_t size, const char* text, uint8_t padding) {
+    size_t length = strlen(text) < size ? strlen(text) : size;
+    memset(field, padding, size);
+    memcpy(field, text, length);
+}
+
+// Write the cached FAT back to the card
+static bool WriteFat(VmuDevice* device) {
+    uint8_t block[VMU_BLOCK_SIZE];
+    for (int i = 0; i < VMU_TOTAL_BLOCKS; ++i) {
+        WriteU16(block + i * 2, device->fat[i]);
+    }
+    return WriteBlock(device, device->fatBlock, block);
+}
+
+// Write one cached directory block back to the card
+static bool WriteDirectoryBlock(VmuDevice* device, int index) {
+    return WriteBlock(device, device->directoryBlock - index, device->directory + index * VMU_BLOCK_SIZE);
+}
+
+// Format a blank card: root, FAT and directory blocks allocated, every user block free
+static bool Format(VmuDevice* device) {
+    uint8_t block[VMU_BLOCK_SIZE];
+    memset(block, 0, sizeof(block));
+    for (int i = 0; i < VMU_TOTAL_BLOCKS; ++i) {
+        if (!WriteBlock(device, i, block)) return false;
+    }
+
+    memset(block, VMU_ROOT_FORMAT_MAGIC, 16);
+    WriteU16(block + VMU_ROOT_FAT_LOCATION, VMU_ROOT_BLOCK - 1);
+    WriteU16(block + VMU_ROOT_FAT_SIZE, 1);
+    WriteU16(block + VMU_ROOT_DIRECTORY_LOCATION, VMU_ROOT_BLOCK - 2);
+    WriteU16(block + VMU_ROOT_DIRECTORY_SIZE, VMU_DEFAULT_DIRECTORY_BLOCKS);
+    WriteU16(block + VMU_ROOT_USER_BLOCKS, VMU_USER_BLOCKS);
+    if (!WriteBlock(device, VMU_ROOT_BLOCK, block)) return false;
+
+    device->fatBlock = VMU_ROOT_BLOCK - 1;
+    device->directoryBlock = VMU_ROOT_BLOCK - 2;
+    device->directoryBlocks = VMU_DEFAULT_DIRECTORY_BLOCKS;
+    device->userBlocks = VMU_USER_BLOCKS;
+
+    for (int i = 0; i < VMU_TOTAL_BLOCKS; ++i) {
+        device->fat[i] = VMU_FAT_FREE;
+    }
+    device->fat[VMU_ROOT_BLOCK] = VMU_FAT_END;
+    device->fat[device->fatBlock] = VMU_FAT_END;
+    for (int i = 0; i < device->directoryBlocks; ++i) {
+        int current = device->directoryBlock - i;
+        device->fat[current] = i + 1 < device->directoryBlocks ? (uint16_t)(current - 1) : VMU_FAT_END;
+    }
+    return WriteFat(device);
+}
+
+// Read the root block and FAT into the device
+static bool Mount(VmuDevice* device) {
+    uint8_t block[VMU_BLOCK_SIZE];
+    if (!ReadBlock(device, VMU_ROOT_BLOCK, block)) return false;
+
+    for (int i = 0; i < 16; ++i) {
+        if (block[i] != VMU_ROOT_FORMAT_MAGIC) {
+            printf("VMU is not formatted.\n");
+            return false;
+        }
+    }
+
+    device->fatBlock = ReadU16(block + VMU_ROOT_FAT_LOCATION);
+    device->directoryBlock = ReadU16(block + VMU_ROOT_DIRECTORY_LOCATION);
+    device->directoryBlocks = ReadU16(block + VMU_ROOT_DIRECTORY_SIZE);
+    device->userBlocks = ReadU16(block + VMU_ROOT_USER_BLOCKS);
+    if (device->fatBlock >= VMU_TOTAL_BLOCKS || device->directoryBlock >= VMU_TOTAL_BLOCKS
+        || device->directoryBlocks == 0 || device->directoryBlocks > device->directoryBlock + 1
+        || device->userBlocks > VMU_TOTAL_BLOCKS) {
+        printf("VMU root block is corrupt.\n");
+        return false;
+    }
+
+    if (!ReadBlock(device, device->fatBlock, block)) return false;
+    for (int i = 0; i < VMU_TOTAL_BLOCKS; ++i) {
+        device->fat[i] = ReadU16(block + i * 2);
+    }
+    return true;
+}
+
+// Read the directory blocks (after Mount or Format has set their location)
+static bool ReadDirectory(VmuDevice* device) {
+    if (!device->directory) {
+        device->directory = (uint8_t*)malloc((size_t)device->directoryBlocks * VMU_BLOCK_SIZE);
+        if (!device->directory) return false;
+    }
+
+    for (int i = 0; i < device->directoryBlocks; ++i) {
+        if (!ReadBlock(device, device->directoryBlock - i, device->directory + i * VMU_BLOCK_SIZE)) return false;
+    }
+    return true;
+}
+
+// Finish opening a device whose backend is set up
+static VmuDevice* OpenDevice(VmuDevice* device, bool format) {
+    device->mutex = SDL_CreateMutex();
+    bool ready = device->mutex && (format ? Format(device) : Mount(device)) && ReadDirectory(device);
+    if (!ready) {
+        VmuDevice_Close(device);
+        return NULL;
+    }
+    return device;
+}
+
+// Open a file-backed VMU image
+VmuDevice* VmuDevice_OpenImage(const char* path) {
+    if (!path) return NULL;
+
+    VmuDevice* device = (VmuDevice*)calloc(1, sizeof(VmuDevice));
+    if (!device) return NULL;
+
+    bool format = false;
+    device->image = fopen(path, "r+b");
+    if (!device->image) {
+        device->image = fopen(path, "w+b");
+        format = true;
+    }
+    if (!device->image) {
+        printf("Failed to open VMU image: %s\n", path);
+        free(device);
+        return NULL;
+    }
+    return OpenDevice(device, format);
+}
+
+#ifdef DREAMCAST
+// Open the memory card in a controller slot
+VmuDevice* VmuDevice_OpenPort(int port, int unit) {
+    maple_device_t* maple = maple_enum_dev(port, unit);
+    if (!maple || !(maple->info.functions & MAPLE_FUNC_MEMCARD)) {
+        printf("No VMU found in port %d, unit %d.\n", port, unit);
+        return NULL;
+    }
+
+    VmuDevice* device = (VmuDevice*)calloc(1, sizeof(VmuDevice));
+    if (!device) return NULL;
+    device->maple = maple;
+    return OpenDevice(device, false);
+}
+#endif
+
+// Close a device (every write has already reached the card)
+void VmuDevice_Close(VmuDevice* device) {
+    if (!device) return;
+    if (device->image) fclose(device->image);
+    if (device->mutex) SDL_DestroyMutex(device->mutex);
+    free(device->directory);
+    free(device);
+}
+
+// Directory entry by index
+static uint8_t* EntryAt(VmuDevice* device, int index) {
+    return device->directory + (size_t)index * VMU_DIRECTORY_ENTRY_SIZE;
+}
+
+static int EntryCount(const VmuDevice* device) {
+    return device->directoryBlocks * (VMU_BLOCK_SIZE / VMU_DIRECTORY_ENTRY_SIZE);
+}
+
+// Find a file's directory entry, -1 if missing
+static int FindEntry(VmuDevice* device, const char* name) {
+    for (int i = 0; i < EntryCount(device); ++i) {
+        VmuDirectoryEntry entry;
+        memcpy(&entry, EntryAt(device, i), sizeof(entry));
+        if (entry.type != VMU_FILE_TYPE_NONE && strncmp(entry.name, name, VMU_MAX_FILE_NAME) == 0) return i;
+    }
+    return -1;
+}
+
+// Count free user blocks (caller holds the lock)
+static int CountFreeBlocks(const VmuDevice* device) {
+    int count = 0;
+    for (int i = 0; i < device->userBlocks; ++i) {
+        if (device->fat[i] == VMU_FAT_FREE) count++;
+    }
+    return count;
+}
+
+// Mark a file's chain free in the cached FAT
+static void FreeChain(VmuDevice* device, uint16_t block, int blockCount) {
+    for (int i = 0; i < blockCount && block < device->userBlocks; ++i) {
+        uint16_t next = device->fat[block];
+        device->fat[block] = VMU_FAT_FREE;
+        block = next;
+    }
+}
+
+// Current time as a VMU BCD timestamp
+static void MakeTimestamp(uint8_t timestamp[8]) {
+    time_t now = time(NULL);
+    struct tm* local = localtime(&now);
+    if (!local) {
+        memset(timestamp, 0, 8);
+        return;
+    }
+
+    int year = local->tm_year + 1900;
+    int values[8] = { year / 100, year % 100, local->tm_mon + 1, local->tm_mday,
+        local->tm_hour, local->tm_min, local->tm_sec, (local->tm_wday + 6) % 7 }; // VMU weeks start on Monday
+    for (int i = 0; i < 8; ++i) {
+        timestamp[i] = (uint8_t)(((values[i] / 10) << 4) | (values[i] % 10));
+    }
+}
+
+// Count free blocks
+int VmuDevice_GetFreeBlocks(VmuDevice* device) {
+    if (!device) return 0;
+    SDL_LockMutex(device->mutex);
+    int count = CountFreeBlocks(device);
+    SDL_UnlockMutex(device->mutex);
+    return count;
+}
+
+// Get a file's size in blocks
+int VmuDevice_GetFileBlocks(VmuDevice* device, const char* name) {
+    if (!device || !name) return -1;
+    SDL_LockMutex(device->mutex);
+    int index = FindEntry(device, name);
+    int blocks = index >= 0 ? ReadU16(EntryAt(device, index) + offsetof(VmuDirectoryEntry, sizeInBlocks)) : -1;
+    SDL_UnlockMutex(device->mutex);
+    return blocks;
+}
+
+// Count the blocks a file of size bytes takes on the card
+int VmuDevice_GetBlocksNeeded(size_t size) {
+    return (int)((VMU_VMS_HEADER_SIZE + size + VMU_BLOCK_SIZE - 1) / VMU_BLOCK_SIZE);
+}
+
+// Write a file. The new copy goes to free blocks and the directory is switched over last, so an
+// interrupted write keeps the old file; only when the card is too full is the old copy freed first.
+bool VmuDevice_WriteFile(VmuDevice* device, const char* name, const void* data, size_t size) {
+    if (!device || !name || !data || size == 0 || strlen(name) > VMU_MAX_FILE_NAME) return false;
+
+    size_t fileSize = VMU_VMS_HEADER_SIZE + size;
+    int blockCount = VmuDevice_GetBlocksNeeded(size);
+    if (blockCount > device->userBlocks) return false;
+
+    // Lay out the file: VMS header and blank icon, then the data
+    uint8_t* file = (uint8_t*)calloc(1, fileSize);
+    if (!file) return false;
+    WriteVmsText(file + VMU_VMS_DESCRIPTION, 16, name, ' ');
+    WriteVmsText(file + VMU_VMS_BOOT_DESCRIPTION, 32, name, ' ');
+    WriteVmsText(file + VMU_VMS_APP_ID, 16, VMU_VMS_APP_NAME, 0);
+    WriteU16(file + VMU_VMS_ICON_COUNT, 1);
+    WriteU32(file + VMU_VMS_DATA_SIZE, (uint32_t)size);
+    memcpy(file + VMU_VMS_HEADER_SIZE, data, size);
+    WriteU16(file + VMU_VMS_CRC, VmsCrc(file, fileSize));
+
+    SDL_LockMutex(device->mutex);
+    bool success = false;
+    int index = FindEntry(device, name);
+    VmuDirectoryEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    if (index >= 0) {
+        memcpy(&entry, EntryAt(device, index), sizeof(entry));
+    }
+    else {
+        for (int i = 0; i < EntryCount(device) && index < 0; ++i) {
+            if (EntryAt(device, i)[0] == VMU_FILE_TYPE_NONE) index = i;
+        }
+    }
+
+    int freeBlocks = CountFreeBlocks(device);
+    bool hasOldCopy = entry.type != VMU_FILE_TYPE_NONE;
+    if (index < 0) {
+        printf("VMU directory is full.\n");
+    }
+    else if (freeBlocks < blockCount && (!hasOldCopy || freeBlocks + entry.sizeInBlocks < blockCount)) {
+        printf("Not enough VMU space for %s: %d blocks needed, %d free.\n", name, blockCount, freeBlocks);
+    }
+    else {
+        if (freeBlocks < blockCount) {
+            FreeChain(device, entry.firstBlock, entry.sizeInBlocks);
+            hasOldCopy = false;
+        }
+
+        // Allocate from the top of the user area down, as the BIOS does
+        uint16_t chain[VMU_TOTAL_BLOCKS];
+        int allocated = 0;
+        for (int block = device->userBlocks - 1; block >= 0 && allocated < blockCount; --block) {
+            if (device->fat[block] == VMU_FAT_FREE) chain[allocated++] = (uint16_t)block;
+        }
+
+        // Data first: until the FAT and directory are written these blocks are still free
+        uint8_t block[VMU_BLOCK_SIZE];
+        success = true;
+        for (int i = 0; i < blockCount && success; ++i) {
+            size_t offset = (size_t)i * VMU_BLOCK_SIZE;
+            size_t length = fileSize - offset < VMU_BLOCK_SIZE ? fileSize - offset : VMU_BLOCK_SIZE;
+            memcpy(block, file + offset, length);
+            memset(block + length, 0, VMU_BLOCK_SIZE - length);
+            success = WriteBlock(device, chain[i], block);
+        }
+
+        if (success) {
+            for (int i = 0; i < blockCount; ++i) {
+                device->fat[chain[i]] = i + 1 < blockCount ? chain[i + 1] : VMU_FAT_END;
+            }
+            success = WriteFat(device);
+        }
+
+        if (success) {
+            VmuDirectoryEntry updated;
+            memset(&updated, 0, sizeof(updated));
+            updated.type = VMU_FILE_TYPE_DATA;
+            updated.firstBlock = chain[0];
+            memcpy(updated.name, name, strlen(name)); // Length checked above; the rest stays NUL
+            MakeTimestamp(updated.timestamp);
+            updated.sizeInBlocks = (uint16_t)blockCount;
+            updated.headerOffset = 0; // The VMS header is the file's first block
+            memcpy(EntryAt(device, index), &updated, sizeof(updated));
+            success = WriteDirectoryBlock(device, index * VMU_DIRECTORY_ENTRY_SIZE / VMU_BLOCK_SIZE);
+        }
+
+        if (success && hasOldCopy) {
+            FreeChain(device, entry.firstBlock, entry.sizeInBlocks);
+            WriteFat(device); // Failing here only leaks the old blocks until the next write
+        }
+        else if (!success) {
+            // Reload the card's FAT and directory so the cache matches what was actually recorded
+            if (Mount(device)) ReadDirectory(device);
+        }
+    }
+
+    SDL_UnlockMutex(device->mutex);
+    free(file);
+    return success;
+}
+
+// Read a whole file
+void* VmuDevice_ReadFile(VmuDevice* device, const char* name, size_t* outSize) {
+    if (outSize) *outSize = 0;
+    if (!device || !name) return NULL;
+
+    SDL_LockMutex(device->mutex);
+    uint8_t* data = NULL;
+    int index = FindEntry(device, name);
+    if (index >= 0) {
+        VmuDirectoryEntry entry;
+        memcpy(&entry, EntryAt(device, index), sizeof(entry));
+        data = (uint8_t*)malloc((size_t)entry.sizeInBlocks * VMU_BLOCK_SIZE);
+
+        uint16_t block = entry.firstBlock;
+        for (int i = 0; data && i < entry.sizeInBlocks; ++i) {
+            if (block >= device->userBlocks || !ReadBlock(device, block, data + (size_t)i * VMU_BLOCK_SIZE)) {
+                printf("VMU file %s has a broken block chain.\n", name);
+                free(data);
+                data = NULL;
+                break;
+            }
+            block = device->fat[block];
+        }
+
+        // Check the VMS header, then hand back only the data that follows it
+        size_t fileSize = (size_t)entry.sizeInBlocks * VMU_BLOCK_SIZE;
+        size_t size = data && fileSize >= VMU_VMS_HEADER_SIZE ? ReadU32(data + VMU_VMS_DATA_SIZE) : 0;
+        if (data && (fileSize < VMU_VMS_HEADER_SIZE || size > fileSize - VMU_VMS_HEADER_SIZE
+            || VmsCrc(data, VMU_VMS_HEADER_SIZE + size) != ReadU16(data + VMU_VMS_CRC))) {
+            printf("VMU file %s has a bad VMS header.\n", name);
+            free(data);
+            data = NULL;
+        }
+        if (data) {
+            memmove(data, data + VMU_VMS_HEADER_SIZE, size);
+            if (outSize) *outSize = size;
+        }
+    }
+    SDL_UnlockMutex(device->mutex);
+    return data;
+}
+
+// Delete a file
+bool VmuDevice_DeleteFile(VmuDevice* device, const char* name) {
+    if (!device || !name) return false;
+
+    SDL_LockMutex(device->mutex);
+    int index = FindEntry(device, name);
+    bool success = index >= 0;
+    if (success) {
+        VmuDirectoryEntry entry;
+        memcpy(&entry, EntryAt(device, index), sizeof(entry));
+        memset(EntryAt(device, index), 0, VMU_DIRECTORY_ENTRY_SIZE);
+
+        // Directory first: a crash before the FAT is written only leaks the blocks
+        success = WriteDirectoryBlock(device, index * VMU_DIRECTORY_ENTRY_SIZE / VMU_BLOCK_SIZE);
+        if (success) {
+            FreeChain(device, entry.firstBlock, entry.sizeInBlocks);
+            success = WriteFat(device);
+        }
+    }
+    SDL_UnlockMutex(device->mutex);
+    return success;
+}
+
+// Largest container for size bytes: stored raw plus the header, in whole blocks
+size_t VmuContainer_GetBound(size_t size) {
+    size_t payload = sizeof(VmuContainerHeader) + size;
+    return (payload + VMU_CONTAINER_BLOCK_PAYLOAD - 1) / VMU_CONTAINER_BLOCK_PAYLOAD * VMU_BLOCK_SIZE;
+}
+
+// Compress data and lay it out in CRC-checked blocks
+size_t VmuContainer_Pack(const void* data, size_t size, void* output, size_t outCapacity) {
+    if (!data || !output || size == 0 || size > UINT32_MAX) return 0;
+
+    // Compress straight into a scratch payload; keep the raw bytes if that does not help
+    uint8_t* payload = (uint8_t*)malloc(sizeof(VmuContainerHeader) + size);
+    if (!payload) return 0;
+
+    VmuContainerHeader header;
+    header.magic = VMU_CONTAINER_MAGIC;
+    header.version = VMU_CONTAINER_VERSION;
+    header.size = (uint32_t)size;
+
+    size_t compressed = Lzss_Compress(data, size, payload + sizeof(header), size - 1);
+    if (compressed > 0) {
+        header.flags = VMU_CONTAINER_COMPRESSED;
+        header.storedSize = (uint32_t)compressed;
+    }
+    else {
+        header.flags = 0;
+        header.storedSize = (uint32_t)size;
+        memcpy(payload + sizeof(header), data, size);
+    }
+    memcpy(payload, &header, sizeof(header));
+
+    size_t payloadSize = sizeof(header) + header.storedSize;
+    size_t blockCount = (payloadSize + VMU_CONTAINER_BLOCK_PAYLOAD - 1) / VMU_CONTAINER_BLOCK_PAYLOAD;
+    if (blockCount * VMU_BLOCK_SIZE > outCapacity) {
+        free(payload);
+        return 0;
+    }
+
+    uint8_t* out = (uint8_t*)output;
+    for (size_t i = 0; i < blockCount; ++i) {
+        uint8_t* block = out + i * VMU_BLOCK_SIZE;
+        size_t offset = i * VMU_CONTAINER_BLOCK_PAYLOAD;
+        size_t length = payloadSize - offset < VMU_CONTAINER_BLOCK_PAYLOAD ? payloadSize - offset : VMU_CONTAINER_BLOCK_PAYLOAD;
+        memcpy(block, payload + offset, length);
+        memset(block + length, 0, VMU_CONTAINER_BLOCK_PAYLOAD - length);
+
+        uint32_t crc = Hash_CRC32(0, block, VMU_CONTAINER_BLOCK_PAYLOAD);
+        memcpy(block + VMU_CONTAINER_BLOCK_PAYLOAD, &crc, sizeof(crc));
+    }
+
+    free(payload);
+    return blockCount * VMU_BLOCK_SIZE;
+}
+
+// Check every block and unpack the original data
+void* VmuContainer_Unpack(const void* container, size_t size, size_t* outSize) {
+    if (outSize) *outSize = 0;
+    if (!container || size < VMU_BLOCK_SIZE) return NULL;
+
+    const uint8_t* blocks = (const uint8_t*)container;
+    VmuContainerHeader header;
+    memcpy(&header, blocks, sizeof(header));
+    if (header.magic != VMU_CONTAINER_MAGIC || header.version != VMU_CONTAINER_VERSION) return NULL;
+
+    size_t payloadSize = sizeof(header) + (size_t)header.storedSize;
+    size_t blockCount = (payloadSize + VMU_CONTAINER_BLOCK_PAYLOAD - 1) / VMU_CONTAINER_BLOCK_PAYLOAD;
+    if (blockCount * VMU_BLOCK_SIZE > size) return NULL;
+
+    // Gather the payload, checking each block on the way
+    uint8_t* payload = (uint8_t*)malloc(blockCount * VMU_CONTAINER_BLOCK_PAYLOAD);
+    if (!payload) return NULL;
+    for (size_t i = 0; i < blockCount; ++i) {
+        const uint8_t* block = blocks + i * VMU_BLOCK_SIZE;
+        uint32_t crc;
+        memcpy(&crc, block + VMU_CONTAINER_BLOCK_PAYLOAD, sizeof(crc));
+        if (Hash_CRC32(0, block, VMU_CONTAINER_BLOCK_PAYLOAD) != crc) {
+            printf("Save container block %zu is corrupt.\n", i);
+            free(payload);
+            return NULL;
+        }
+        memcpy(payload + i * VMU_CONTAINER_BLOCK_PAYLOAD, block, VMU_CONTAINER_BLOCK_PAYLOAD);
+    }
+
+    uint8_t* data = (uint8_t*)malloc(header.size ? header.size : 1);
+    bool valid = data != NULL;
+    if (valid && (header.flags & VMU_CONTAINER_COMPRESSED)) {
+        valid = Lzss_Decompress(payload + sizeof(header), header.storedSize, data, header.size);
+    }
+    else if (valid) {
+        valid = header.storedSize == header.size;
+        if (valid) memcpy(data, payload + sizeof(header), header.size);
+    }
+    free(payload);
+
+    if (!valid) {
+        free(data);
+        return NULL;
+    }
+    if (outSize) *outSize = header.size;
+    return data;
+}